@@ -0,0 +1,335 @@
+/**
+ * @file adjoint.cpp
+ * @brief Adjoint sweep with binomial checkpointing.
+ */
+
+#include "adjoint.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace ensiie {
+
+namespace {
+
+/// Linear functional u ↦ Σ weight·u[index] of one probe and its series
+struct Observation {
+    std::vector<int> index;              ///< Nodes around the probe
+    std::vector<double> weight;          ///< Interpolation weights
+    const std::vector<double>* values;   ///< Measured series
+};
+
+/// Derivative of the step with respect to one parameter
+struct StepDerivative {
+    CsrMatrix dA;               ///< ∂A/∂θ
+    std::vector<double> db;     ///< ∂b/∂θ
+};
+
+/**
+ * @brief Number of steps c checkpoints reverse with t recomputations: C(c + t, c).
+ */
+double reach(int c, int t) {
+    double b = 1.0;
+    for (int i = 1; i <= t; i++) b = b * (c + i) / i;
+    return b;
+}
+
+/**
+ * @brief (a - b) / h over the union of both sparsity patterns.
+ */
+StepDerivative difference(const LinearStep& a, const LinearStep& b, double h) {
+    StepDerivative d;
+    CsrMatrix& m = d.dA;
+    m.n = a.A.n;
+    m.row_ptr.assign(m.n + 1, 0);
+    for (int i = 0; i < m.n; i++) {
+        int p = a.A.row_ptr[i], q = b.A.row_ptr[i];
+        const int pe = a.A.row_ptr[i + 1], qe = b.A.row_ptr[i + 1];
+        while (p < pe || q < qe) {
+            const int ca = (p < pe) ? a.A.col[p] : m.n;
+            const int cb = (q < qe) ? b.A.col[q] : m.n;
+            const int c = std::min(ca, cb);
+            const double v = ((ca == c) ? a.A.val[p++] : 0.0) - ((cb == c) ? b.A.val[q++] : 0.0);
+            if (v == 0.0) continue;
+            m.col.push_back(c);
+            m.val.push_back(v / h);
+        }
+        m.row_ptr[i + 1] = static_cast<int>(m.col.size());
+    }
+    d.db.resize(a.b.size());
+    for (std::size_t k = 0; k < a.b.size(); k++) d.db[k] = (a.b[k] - b.b[k]) / h;
+    return d;
+}
+
+/**
+ * @class Sweep
+ * @brief Forward steps of a LinearStep and the adjoint sweep over them.
+ */
+class Sweep {
+public:
+    Sweep(const LinearStep& step, const std::vector<StepDerivative>& derivatives,
+          std::vector<double> u_init, std::vector<Observation> observations,
+          double rhoc, double tmax, const AdjointOptions& options)
+        : step_(step)
+        , derivatives_(derivatives)
+        , u_init_(std::move(u_init))
+        , observations_(std::move(observations))
+        , rhoc_(rhoc)
+        , checkpoints_(options.checkpoints)
+        , forward_(step.A, options.solve)
+        , backward_(step.A.transpose(), options.solve)
+        , psi_(step.A.n, 0.0)
+        , dtheta_(derivatives.size(), 0.0)
+        , drhoc_(0.0)
+        , held_(0)
+    {
+        // Same time levels as the solvers: t += dt until tmax
+        times_.push_back(0.0);
+        for (double t = 0.0; t < tmax;) {
+            t += step.dt;
+            times_.push_back(t);
+        }
+        grad_.source.assign(step.sources.size(), 0.0);
+    }
+
+    /**
+     * @brief Run the checkpointed reverse sweep from uⁿ = u_init.
+     *
+     * @param dtheta Output: ∂J/∂θ of each derivative
+     * @param drhoc Output: ∂J/∂(ρc)
+     */
+    Gradient run(std::vector<double>& dtheta, double& drhoc) {
+        const int steps = static_cast<int>(times_.size()) - 1;
+        if (steps > 0) reverse(0, steps, checkpoints_, u_init_);
+        dtheta = dtheta_;
+        drhoc = drhoc_;
+        return grad_;
+    }
+
+private:
+    const LinearStep& step_;
+    const std::vector<StepDerivative>& derivatives_;
+    std::vector<double> u_init_;
+    std::vector<Observation> observations_;
+    double rhoc_;
+    int checkpoints_;
+    KrylovSolver forward_;   ///< Solves with A
+    KrylovSolver backward_;  ///< Solves with Aᵀ
+    std::vector<double> times_;  ///< tⁿ, n = 0..N
+
+    std::vector<double> psi_;     ///< ψⁿ⁺¹, then ψⁿ
+    std::vector<double> dtheta_;  ///< Accumulated ∂J/∂θ
+    double drhoc_;                ///< Accumulated ∂J/∂(ρc)
+    int held_;                    ///< Checkpoints alive
+    Gradient grad_;
+
+    double amplitude(std::size_t j, int n) const {
+        const auto& mod = step_.modulations[j];
+        return mod ? mod(times_[n]) : 1.0;
+    }
+
+    /// uⁿ → uⁿ⁺¹
+    void advance(std::vector<double>& u, int n) {
+        std::vector<double> rhs(step_.b);
+        for (std::size_t k = 0; k < rhs.size(); k++) {
+            if (!step_.fixed[k]) rhs[k] += u[k];
+        }
+        for (std::size_t j = 0; j < step_.sources.size(); j++) {
+            const double a = amplitude(j, n + 1);
+            if (a == 0.0) continue;
+            for (std::size_t k = 0; k < rhs.size(); k++) rhs[k] += a * step_.sources[j][k];
+        }
+        forward_.solve(rhs, u);
+        grad_.forward_steps++;
+    }
+
+    /**
+     * @brief Reverse steps s+1..s+l from us = uˢ with c checkpoints (revolve).
+     */
+    void reverse(int s, int l, int c, const std::vector<double>& us) {
+        if (l == 1) {
+            std::vector<double> un(us);
+            advance(un, s);
+            adjoint(s + 1, un, us);
+            return;
+        }
+        if (c == 0) {
+            // No memory left: recompute every state from uˢ
+            for (int n = s + l; n > s; n--) {
+                std::vector<double> prev(us);
+                for (int m = s; m < n - 1; m++) advance(prev, m);
+                std::vector<double> un(prev);
+                advance(un, n - 1);
+                adjoint(n, un, prev);
+            }
+            return;
+        }
+
+        // Repetitions t needed for l steps; the right part fits c - 1
+        // checkpoints within t, the left part c checkpoints within t - 1
+        int t = 0;
+        while (reach(c, t) < l) t++;
+        const int right = static_cast<int>(std::min<double>(reach(c - 1, t), l - 1));
+        const int m = l - right;
+
+        std::vector<double> um(us);
+        for (int k = s; k < s + m; k++) advance(um, k);
+        grad_.stored = std::max(grad_.stored, ++held_);
+        reverse(s + m, right, c - 1, um);
+        held_--;
+        um.clear();
+        um.shrink_to_fit();
+        reverse(s, m, c, us);
+    }
+
+    /**
+     * @brief Adjoint step n: solve for ψⁿ and accumulate -ψⁿ·∂Fⁿ/∂θ.
+     */
+    void adjoint(int n, const std::vector<double>& un, const std::vector<double>& prev) {
+        const std::size_t nn = un.size();
+
+        // ∇j_n + D·ψⁿ⁺¹
+        std::vector<double> rhs(nn, 0.0);
+        for (std::size_t k = 0; k < nn; k++) {
+            if (!step_.fixed[k]) rhs[k] = psi_[k];
+        }
+        for (const Observation& o : observations_) {
+            if (static_cast<int>(o.values->size()) < n) continue;
+            const double y = (*o.values)[n - 1];
+            if (std::isnan(y)) continue;
+            double T = 0.0;
+            for (std::size_t m = 0; m < o.index.size(); m++) T += o.weight[m] * un[o.index[m]];
+            const double r = T - y;
+            grad_.objective += 0.5 * r * r;
+            for (std::size_t m = 0; m < o.index.size(); m++) rhs[o.index[m]] += r * o.weight[m];
+        }
+        backward_.solve(rhs, psi_);
+
+        // Conductivities: ∂F/∂θ = ∂A/∂θ·uⁿ - ∂b/∂θ
+        std::vector<double> au;
+        for (std::size_t p = 0; p < derivatives_.size(); p++) {
+            derivatives_[p].dA.apply(un, au);
+            for (std::size_t k = 0; k < nn; k++) au[k] -= derivatives_[p].db[k];
+            dtheta_[p] -= dot(psi_, au);
+        }
+
+        // Heat capacity: on the free rows ∂F/∂(ρc) = (uⁿ - uⁿ⁻¹) / ρc
+        double s = 0.0;
+        for (std::size_t k = 0; k < nn; k++) {
+            if (!step_.fixed[k]) s += psi_[k] * (un[k] - prev[k]);
+        }
+        drhoc_ -= s / rhoc_;
+
+        // Source powers: ∂F/∂p_j = -a_j(tⁿ)·s_j
+        for (std::size_t j = 0; j < step_.sources.size(); j++) {
+            grad_.source[j] += amplitude(j, n) * dot(psi_, step_.sources[j]);
+        }
+
+        // Initial temperature: ∂F¹/∂u0 = -D·1
+        if (n == 1) {
+            for (std::size_t k = 0; k < nn; k++) {
+                if (!step_.fixed[k]) grad_.u0 += psi_[k];
+            }
+        }
+    }
+};
+
+/**
+ * @brief Gradient common to bars and plates once the steps are extracted.
+ *
+ * @param steps Step at mat, then at λ doubled (and λ_y doubled)
+ */
+Gradient differentiate(const std::vector<LinearStep>& steps, const Material& mat,
+                       std::vector<double> u_init, std::vector<Observation> observations,
+                       double tmax, const AdjointOptions& options) {
+    std::vector<StepDerivative> derivatives;
+    derivatives.push_back(difference(steps[1], steps[0], mat.lambda));
+    if (steps.size() > 2) derivatives.push_back(difference(steps[2], steps[0], mat.lambda_y));
+
+    const double rhoc = mat.rho * mat.c;
+    Sweep sweep(steps[0], derivatives, std::move(u_init), std::move(observations), rhoc, tmax, options);
+    std::vector<double> dtheta;
+    double drhoc = 0.0;
+    Gradient g = sweep.run(dtheta, drhoc);
+    g.lambda = dtheta[0];
+    g.lambda_y = (dtheta.size() > 1) ? dtheta[1] : 0.0;
+    g.rho = drhoc * mat.c;
+    g.c = drhoc * mat.rho;
+    return g;
+}
+
+void check(const Material& mat, const AdjointOptions& options) {
+    if (!(mat.lambda > 0.0) || !(mat.rho * mat.c > 0.0)) {
+        throw std::invalid_argument("adjoint gradient needs positive λ and ρc");
+    }
+    if (options.checkpoints < 0) throw std::invalid_argument("checkpoint budget must be non-negative");
+}
+
+/**
+ * @brief Materials with λ doubled, then λ_y doubled if it is set.
+ */
+std::vector<Material> perturbed(const Material& mat) {
+    std::vector<Material> out;
+    Material m = mat;
+    m.lambda *= 2.0;
+    out.push_back(m);
+    if (mat.lambda_y > 0.0) {
+        m = mat;
+        m.lambda_y *= 2.0;
+        out.push_back(m);
+    }
+    return out;
+}
+
+} // namespace
+
+Gradient adjoint_gradient_1d(const SolverFactory1D& make, const Material& mat,
+                             const std::vector<ProbeData>& data, const AdjointOptions& options) {
+    check(mat, options);
+    std::unique_ptr<HeatSolver1D> solver = make(mat);
+    std::vector<LinearStep> steps{solver->linear_step()};
+    for (const Material& m : perturbed(mat)) steps.push_back(make(m)->linear_step());
+
+    const std::vector<double> x = solver->get_x();
+    std::vector<Observation> observations;
+    for (const ProbeData& p : data) {
+        int i;
+        double s;
+        grid::locate(x, p.x, i, s);
+        observations.push_back({{i, i + 1}, {1.0 - s, s}, &p.values});
+    }
+    return differentiate(steps, mat, solver->get_temperature(), std::move(observations),
+                         solver->get_tmax(), options);
+}
+
+Gradient adjoint_gradient_2d(const SolverFactory2D& make, const Material& mat,
+                             const std::vector<ProbeData>& data, const AdjointOptions& options) {
+    check(mat, options);
+    std::unique_ptr<HeatSolver2D> solver = make(mat);
+    std::vector<LinearStep> steps{solver->linear_step()};
+    for (const Material& m : perturbed(mat)) steps.push_back(make(m)->linear_step());
+
+    const int nx = solver->get_n();
+    const std::vector<double> x = solver->get_x();
+    const std::vector<double> y = solver->get_y();
+    std::vector<Observation> observations;
+    for (const ProbeData& p : data) {
+        int i, j;
+        double s, r;
+        grid::locate(x, p.x, i, s);
+        grid::locate(y, p.y, j, r);
+        observations.push_back({{j * nx + i, j * nx + i + 1, (j + 1) * nx + i, (j + 1) * nx + i + 1},
+                                {(1.0 - r) * (1.0 - s), (1.0 - r) * s, r * (1.0 - s), r * s},
+                                &p.values});
+    }
+
+    std::vector<double> u_init;
+    for (const std::vector<double>& row : solver->get_temperature_2d()) {
+        u_init.insert(u_init.end(), row.begin(), row.end());
+    }
+    return differentiate(steps, mat, std::move(u_init), std::move(observations),
+                         solver->get_tmax(), options);
+}
+
+} // namespace ensiie
@@ -0,0 +1,118 @@
+/**
+ * @file adjoint.hpp
+ * @brief Gradients of a probe misfit by the discrete adjoint of backward Euler.
+ *
+ * The objective compares the simulated temperature at a few probes with
+ * measured series:
+ * @f[
+ *   J = \frac{1}{2} \sum_{n=1}^{N} \sum_m \left(P_m u^n - y_m^n\right)^2
+ * @f]
+ * where each step solves A·uⁿ = D·uⁿ⁻¹ + b + Σ_j p_j·a_j(tⁿ)·s_j
+ * (LinearStep). One backward sweep of the adjoint equations
+ * @f[
+ *   A^T \psi^N = \nabla_u j_N, \qquad
+ *   A^T \psi^n = \nabla_u j_n + D\,\psi^{n+1}
+ * @f]
+ * gives every derivative at once: dJ/dθ = -Σ_n ψⁿ·∂Fⁿ/∂θ, with
+ * Fⁿ = A·uⁿ - D·uⁿ⁻¹ - b - S(tⁿ) the residual of step n. The cost is
+ * that of about two forward runs, whatever the number of parameters;
+ * finite differences would need one run per parameter.
+ *
+ * Parameters: conductivity λ (and λ_y of anisotropic plates), density
+ * ρ, heat capacity c, the uniform initial temperature and a power scale
+ * p_j per heat source. A and b are linear in λ, and every term except
+ * the identity scales with 1/(ρc), so their derivatives are exact:
+ * ∂A/∂λ comes from one extra matrix extraction at 2λ.
+ *
+ * The reverse sweep needs uⁿ in reverse order. Storing the run costs N
+ * fields; the binomial checkpointing schedule of revolve (Griewank &
+ * Walther) keeps at most c of them and recomputes the others from the
+ * nearest checkpoint. With t the smallest integer such that
+ * C(c + t, c) ≥ N, each step is recomputed at most t times: 32
+ * checkpoints cover 1000 steps with t = 3.
+ */
+
+#ifndef ADJOINT_HPP
+#define ADJOINT_HPP
+
+#include "heat_equation_solver.hpp"
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace ensiie {
+
+/**
+ * @struct ProbeData
+ * @brief Temperature series measured at one point.
+ */
+struct ProbeData {
+    double x;                    ///< Position along x [m]
+    double y = 0.0;              ///< Position along y [m] (plates only)
+    std::vector<double> values;  ///< values[n]: temperature after step n + 1 [K] (NaN: not measured)
+};
+
+/**
+ * @struct AdjointOptions
+ * @brief Memory budget and linear solves of an adjoint gradient.
+ */
+struct AdjointOptions {
+    int checkpoints = 32;  ///< Fields stored by the reverse sweep
+    KrylovOptions solve{KrylovMethod::BICGSTAB, PreconditionerKind::ILU0,
+                        MatrixFormat::CSR, 1e-12, 10000, 30};  ///< Forward and adjoint solves
+};
+
+/**
+ * @struct Gradient
+ * @brief Misfit and its derivatives.
+ */
+struct Gradient {
+    double objective = 0.0;      ///< J [K²]
+    double lambda = 0.0;         ///< ∂J/∂λ (both directions unless lambda_y is set)
+    double lambda_y = 0.0;       ///< ∂J/∂λ_y (anisotropic materials only)
+    double rho = 0.0;            ///< ∂J/∂ρ
+    double c = 0.0;              ///< ∂J/∂c
+    double u0 = 0.0;             ///< ∂J/∂u0, uniform initial temperature (edge values fixed)
+    std::vector<double> source;  ///< ∂J/∂p_j, p_j scaling the power of source j
+    int forward_steps = 0;       ///< Forward steps taken, recomputations included
+    int stored = 0;              ///< Largest number of fields held by the checkpoints
+};
+
+/// Builds the solver to differentiate (edges, sources) for a material
+using SolverFactory1D = std::function<std::unique_ptr<HeatSolver1D>(const Material&)>;
+
+/// Builds the plate solver to differentiate for a material
+using SolverFactory2D = std::function<std::unique_ptr<HeatSolver2D>(const Material&)>;
+
+/**
+ * @brief Misfit of a bar and its gradient in one forward and one adjoint sweep.
+ *
+ * The forward model is the LinearStep of make(mat), solved to
+ * options.solve.tol, from the initial temperature of that solver.
+ *
+ * @param make Solver factory, called for mat and with λ doubled
+ * @param mat Material at which the gradient is taken (λ > 0)
+ * @param data Measured probe series (ProbeData::y is ignored)
+ * @throws std::invalid_argument if the step is not linear (LinearStep)
+ *         or the checkpoint budget is negative
+ */
+Gradient adjoint_gradient_1d(const SolverFactory1D& make, const Material& mat,
+                             const std::vector<ProbeData>& data,
+                             const AdjointOptions& options = {});
+
+/**
+ * @brief Misfit of a plate and its gradient in one forward and one adjoint sweep.
+ *
+ * @param make Solver factory, called for mat and with λ (and λ_y) doubled
+ * @param mat Material at which the gradient is taken (λ > 0)
+ * @param data Measured probe series
+ * @throws std::invalid_argument if the step is not linear (LinearStep)
+ *         or the checkpoint budget is negative
+ */
+Gradient adjoint_gradient_2d(const SolverFactory2D& make, const Material& mat,
+                             const std::vector<ProbeData>& data,
+                             const AdjointOptions& options = {});
+
+} // namespace ensiie
+
+#endif
@@ -0,0 +1,184 @@
+/**
+ * @file bench_common.hpp
+ * @brief Options, results and JSON output shared by the benchmarks.
+ *
+ * solver_bench and render_bench write the same JSON schema, so that
+ * `solver_bench --compare` reads the runs of both: one object per case
+ * with its name, kernel, timed calls and median seconds, followed by the
+ * fields of its kind (solver cases: backend, material, grid size,
+ * throughput; render cases: surface size, percentiles, draw calls).
+ */
+
+#ifndef BENCH_COMMON_HPP
+#define BENCH_COMMON_HPP
+
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/**
+ * @namespace bench
+ * @brief Pieces shared by the benchmark programs.
+ */
+namespace bench {
+
+/// Simulation parameters of the menu defaults
+constexpr double LENGTH = 1.0;
+constexpr double TMAX = 16.0;
+constexpr double U0 = 13.0;
+constexpr double SOURCE = 80.0;
+
+/**
+ * @struct Options
+ * @brief Command line of a benchmark run.
+ */
+struct Options {
+    std::string filter;          ///< Run only the cases whose name contains this
+    std::string json;            ///< Output file ("" : none)
+    std::string trace;           ///< Chrome trace of the zones ("" : none; needs -DHEAT_PROFILE)
+
+    // solver_bench
+    bool quick = false;          ///< Small grids, one material
+    double min_time = 0.25;      ///< Seconds of timed calls per case (at least one call)
+    double max_memory = 2.0;     ///< Resident memory of one case at most [GB]
+    std::vector<int> threads;    ///< Thread counts of the threaded backends
+
+    // render_bench
+    int warmup = 20;             ///< Simulation frames before the timings
+    int frames = 60;             ///< Timed frames per case
+};
+
+/**
+ * @struct Result
+ * @brief Timing of one case.
+ *
+ * Render cases have a surface (width > 0); the others are solver cases.
+ */
+struct Result {
+    std::string name;            ///< kernel/backend/material/n=/threads=, or render/<bar|plate>/<single|grid>/<w>x<h>
+    std::string kernel;          ///< step_1d, step_2d, field_2d or render
+    int calls = 0;               ///< Timed calls
+    double median = 0.0;         ///< Median seconds per call
+    double mean = 0.0;           ///< Mean seconds per call
+
+    // Solver cases
+    std::string backend;         ///< Solver configuration
+    std::string material;        ///< Material key
+    long n = 0;                  ///< Nodes along x (plates: n × n)
+    int threads = 1;             ///< Threads of the worker pool
+    bool skipped = false;        ///< Over the memory budget
+    double min = 0.0;            ///< Fastest call [s]
+    double cells_per_second = 0.0;
+    double iterations_per_step = -1.0;  ///< -1: not an iterative kernel
+    long unconverged_steps = 0;         ///< Steps that hit their iteration limit
+    double gb_per_second = 0.0;
+
+    // Render cases
+    int width = 0;               ///< Surface width [px]
+    int height = 0;              ///< Surface height [px]
+    double p90 = 0.0;            ///< 90th percentile [s]
+    double p99 = 0.0;            ///< 99th percentile [s]
+    double max = 0.0;            ///< Slowest frame [s]
+    double draw_calls = 0.0;         ///< Draw calls per frame
+    double pixels_per_second = 0.0;  ///< Surface pixels / median frame time
+};
+
+/**
+ * @brief s as a JSON string literal.
+ */
+inline std::string quoted(const std::string& s) {
+    std::string q = "\"";
+    for (char c : s) {
+        if (c == '"' || c == '\\') q += '\\';
+        q += c;
+    }
+    return q + "\"";
+}
+
+/**
+ * @brief v as a JSON number.
+ */
+inline std::string number(double v) {
+    std::ostringstream s;
+    s.precision(9);
+    s << v;
+    return s.str();
+}
+
+/**
+ * @brief Write a run: schema, date, compiler and hardware threads, the
+ *        settings of the run, then one object per case.
+ *
+ * @param settings Run-wide members as (key, JSON value) pairs
+ * @throws std::invalid_argument if the file cannot be written
+ */
+inline void write_json(const std::vector<std::pair<std::string, std::string>>& settings,
+                       const std::vector<Result>& results, const std::string& path) {
+    std::ofstream f(path);
+    if (!f) throw std::invalid_argument("cannot write '" + path + "'");
+    f.precision(9);
+
+    char date[32];
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof date, "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    f << "{\n  \"schema\": 1,\n"
+      << "  \"date\": " << quoted(date) << ",\n"
+#ifdef __VERSION__
+      << "  \"compiler\": " << quoted(__VERSION__) << ",\n"
+#endif
+      << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n";
+    for (const auto& [key, value] : settings) f << "  " << quoted(key) << ": " << value << ",\n";
+    f << "  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const Result& r = results[i];
+        const bool render = r.width > 0;
+        f << (i ? ",\n" : "\n") << "    {\"name\": " << quoted(r.name)
+          << ", \"kernel\": " << quoted(r.kernel);
+        if (render) {
+            f << ", \"width\": " << r.width
+              << ", \"height\": " << r.height;
+        } else {
+            f << ", \"backend\": " << quoted(r.backend)
+              << ", \"material\": " << quoted(r.material)
+              << ", \"n\": " << r.n
+              << ", \"threads\": " << r.threads;
+        }
+        if (r.skipped) {
+            f << ", \"skipped\": true}";
+            continue;
+        }
+        f << ", \"calls\": " << r.calls
+          << ", \"seconds_median\": " << r.median;
+        if (render) {
+            f << ", \"seconds_p90\": " << r.p90
+              << ", \"seconds_p99\": " << r.p99
+              << ", \"seconds_max\": " << r.max;
+        } else {
+            f << ", \"seconds_min\": " << r.min;
+        }
+        f << ", \"seconds_mean\": " << r.mean;
+        if (render) {
+            f << ", \"draw_calls\": " << r.draw_calls
+              << ", \"pixels_per_second\": " << r.pixels_per_second;
+        } else {
+            f << ", \"cells_per_second\": " << r.cells_per_second
+              << ", \"gb_per_second\": " << r.gb_per_second;
+        }
+        if (r.iterations_per_step >= 0.0) {
+            f << ", \"iterations_per_step\": " << r.iterations_per_step
+              << ", \"unconverged_steps\": " << r.unconverged_steps;
+        }
+        f << "}";
+    }
+    f << "\n  ]\n}\n";
+}
+
+} // namespace bench
+
+#endif
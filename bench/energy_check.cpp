@@ -0,0 +1,211 @@
+/**
+ * @file energy_check.cpp
+ * @brief Energy balance of point sources on insulated bars and plates.
+ *
+ * With every edge insulated, all the power of a source stays in the
+ * domain: after time t the heat content
+ * @f[
+ *   E = \rho c \sum_i V_i\,(u_i - u_0)
+ * @f]
+ * integrated over the finite-volume cells V_i of the nodes (half cells
+ * on the edges, quarter cells in the corners) equals P·t. Each case puts
+ * a point source inside the domain, on an edge or in a corner, fixed or
+ * moving along an edge, on uniform grids and on grids refined around
+ * the point, and reports the relative error of E. A periodic bar
+ * conserves energy as well; its end nodes have whole cells.
+ *
+ * The sums behind these balances run on the worker pool, so a last case
+ * resizes the pool before every loop and checks that each loop still
+ * covers its whole range exactly once.
+ *
+ * Build (from the repository root, without the SDL front end):
+ * @code
+ * g++ -O2 -pthread -I. -o energy_check bench/energy_check.cpp \
+ *     $(ls *.cpp | grep -v -e '^main.cpp' -e '^sdl_')
+ * ./energy_check              # exit status 1 if a case is off
+ * @endcode
+ */
+
+#include "heat_equation_solver.hpp"
+#include "grid.hpp"
+#include "material.hpp"
+#include "parallel.hpp"
+#include "source.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ensiie;
+
+namespace {
+
+/// Bar length / plate side [m]
+constexpr double LENGTH = 1.0;
+constexpr double TMAX = 16.0;
+constexpr double U0 = 13.0;
+/// Power of the point source [W] (per unit area in 1D, per unit depth in 2D)
+constexpr double POWER = 1e4;
+/// Relative error above which a case fails (the plates converge to 1e-6 K per sweep)
+constexpr double TOLERANCE = 1e-4;
+/// Resize-then-run rounds of the pool case
+constexpr int POOL_ROUNDS = 2000;
+
+/**
+ * @brief Finite-volume cell widths of the nodes of an axis.
+ *
+ * @param period Axis length if node n is node 0 (0: insulated ends)
+ */
+std::vector<double> cells(const std::vector<double>& x, double period = 0.0) {
+    const std::size_t n = x.size();
+    const double wrap = period > 0.0 ? 0.5 * (x[0] + period - x[n - 1]) : 0.0;
+    std::vector<double> w(n);
+    for (std::size_t i = 0; i < n; i++) {
+        const double lo = i > 0 ? 0.5 * (x[i - 1] + x[i]) : x[0] - wrap;
+        const double hi = i + 1 < n ? 0.5 * (x[i] + x[i + 1]) : x[n - 1] + wrap;
+        w[i] = hi - lo;
+    }
+    return w;
+}
+
+/**
+ * @brief Heat content gained since t = 0 by a bar [J/m²].
+ *
+ * @param period Length of a periodic bar (0: insulated)
+ */
+double energy(const HeatSolver1D& s, const Material& mat, double period = 0.0) {
+    const std::vector<double> w = cells(s.get_x(), period);
+    const std::vector<double> u = s.get_temperature();
+    double e = 0.0;
+    for (std::size_t i = 0; i < u.size(); i++) e += w[i] * (u[i] - (U0 + 273.15));
+    return mat.rho * mat.c * e;
+}
+
+/**
+ * @brief Heat content gained since t = 0 by a plate [J/m].
+ *
+ * @param period Side of a plate periodic along both axes (0: insulated)
+ */
+double energy(const HeatSolver2D& s, const Material& mat, double period = 0.0) {
+    const std::vector<double> wx = cells(s.get_x(), period);
+    const std::vector<double> wy = cells(s.get_y(), period);
+    const std::vector<std::vector<double>> u = s.get_temperature_2d();
+    double e = 0.0;
+    for (std::size_t j = 0; j < u.size(); j++) {
+        for (std::size_t i = 0; i < u[j].size(); i++) e += wx[i] * wy[j] * (u[j][i] - (U0 + 273.15));
+    }
+    return mat.rho * mat.c * e;
+}
+
+/**
+ * @brief Run a solver to tmax and compare its heat content with P·t.
+ * @return false if the relative error exceeds TOLERANCE
+ */
+template <typename Solver>
+bool check(const std::string& name, Solver& solver, const Material& mat, double period = 0.0) {
+    while (solver.step()) {}
+    const double expected = POWER * solver.get_time();
+    const double got = energy(solver, mat, period);
+    const double error = std::abs(got - expected) / expected;
+    const bool ok = error <= TOLERANCE;
+    std::printf("%-32s %12.1f J  expected %12.1f J  error %9.2e  %s\n",
+                name.c_str(), got, expected, error, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+/// 41 nodes over [0, LENGTH] refined around the point p
+std::vector<double> refined_axis(double p) {
+    return grid::refined(LENGTH, 41, grid::source_regions({HeatSource::point(p, p, POWER)}));
+}
+
+bool bar(const std::string& name, double x, bool periodic = false, bool refine = false) {
+    const Material mat = Materials::COPPER;
+    const BoundaryCondition edge = periodic ? BoundaryCondition::periodic() : BoundaryCondition::neumann();
+    auto solver = refine ? make_solver_1d(mat, refined_axis(x), TMAX, U0, 0.0, {edge, edge})
+                         : make_solver_1d(mat, LENGTH, TMAX, U0, 0.0, 101, {edge, edge});
+    solver->set_sources({HeatSource::point(x, 0.0, POWER)});
+    return check(name, *solver, mat, periodic ? LENGTH : 0.0);
+}
+
+/**
+ * @brief Insulated plate, uniform or refined around (rx, ry).
+ */
+bool plate(const std::string& name, const std::function<void(HeatSolver2D&)>& place,
+           bool refine = false, double rx = 0.0, double ry = 0.0) {
+    const Material mat = Materials::COPPER;
+    const BoundaryCondition n = BoundaryCondition::neumann();
+    auto solver = refine ? make_solver_2d(mat, refined_axis(rx), refined_axis(ry), TMAX, U0, 0.0, {n, n, n, n})
+                         : make_solver_2d(mat, LENGTH, TMAX, U0, 0.0, 41, {n, n, n, n});
+    place(*solver);
+    return check(name, *solver, mat);
+}
+
+bool plate_point(const std::string& name, double x, double y, bool refine = false) {
+    return plate(name, [&](HeatSolver2D& s) { s.set_sources({HeatSource::point(x, y, POWER)}); },
+                 refine, x, y);
+}
+
+/**
+ * @brief Resize the pool before every loop and check each loop's coverage.
+ *
+ * Workers started by a resize must join the next loop only: one that
+ * replayed an earlier loop would let the caller return while chunks are
+ * still running.
+ */
+bool pool_resize() {
+    const int n = 16 * parallel::MIN_CHUNK;
+    std::vector<int> hits(n);
+    int bad = 0;
+    for (int round = 0; round < POOL_ROUNDS; round++) {
+        parallel::set_threads(1 + round % 4);
+        // Vary how far the new workers get before the loop starts
+        for (int y = 0; y < round % 3; y++) std::this_thread::yield();
+        std::fill(hits.begin(), hits.end(), 0);
+        parallel::for_range(n, [&](int begin, int end) {
+            for (int i = begin; i < end; i++) hits[i]++;
+        });
+        const double total = parallel::sum(n, [&](int begin, int end) {
+            double s = 0.0;
+            for (int i = begin; i < end; i++) s += hits[i];
+            return s;
+        });
+        if (total != n || std::count(hits.begin(), hits.end(), 1) != n) bad++;
+    }
+    parallel::set_threads(0);
+    std::printf("%-32s %12d rounds, %d with a chunk missed or repeated  %s\n",
+                "pool/resize then run", POOL_ROUNDS, bad, bad == 0 ? "ok" : "FAIL");
+    return bad == 0;
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    ok &= bar("bar/interior", 0.5 * LENGTH);
+    ok &= bar("bar/end x=0", 0.0);
+    ok &= bar("bar/end x=L", LENGTH);
+    ok &= bar("bar/periodic x=0", 0.0, true);
+    ok &= bar("bar/stretched interior", 0.3 * LENGTH, false, true);
+    ok &= bar("bar/stretched end x=0", 0.0, false, true);
+    ok &= bar("bar/stretched periodic x=0", 0.0, true, true);
+
+    ok &= plate_point("plate/interior", 0.5 * LENGTH, 0.5 * LENGTH);
+    ok &= plate_point("plate/edge (0, L/2)", 0.0, 0.5 * LENGTH);
+    ok &= plate_point("plate/edge (L/2, L)", 0.5 * LENGTH, LENGTH);
+    ok &= plate_point("plate/corner (0, 0)", 0.0, 0.0);
+    ok &= plate_point("plate/corner (L, L)", LENGTH, LENGTH);
+    ok &= plate_point("plate/stretched edge (0, L/2)", 0.0, 0.5 * LENGTH, true);
+    ok &= plate_point("plate/stretched corner (0, 0)", 0.0, 0.0, true);
+    ok &= plate("plate/moving along y=0", [](HeatSolver2D& s) {
+        s.set_sources({});
+        s.set_moving_sources({{HeatSource::point(0.0, 0.0, POWER),
+                               trajectory::linear(0.0, 0.0, LENGTH, 0.0, 0.0, TMAX)}});
+    });
+
+    ok &= pool_resize();
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,197 @@
+/**
+ * @file gradient_check.cpp
+ * @brief Adjoint gradients against central finite differences.
+ *
+ * A bar and an anisotropic plate record probe series for a reference
+ * material; the misfit J of another material is then differentiated by
+ * adjoint_gradient_1d() / adjoint_gradient_2d() and by central
+ * differences of J:
+ * @f[
+ *   \frac{\partial J}{\partial \theta} \approx
+ *   \frac{J(\theta + h) - J(\theta - h)}{2h}
+ * @f]
+ * for λ (and λ_y), ρ, c, the initial temperature u0 and the power scale
+ * p of the source. Each gradient is taken twice: with a checkpoint per
+ * step (no recomputation) and with the revolve schedule on a few
+ * checkpoints, which replays most steps. A derivative whose relative
+ * error exceeds TOLERANCE fails the check.
+ *
+ * Build (from the repository root, without the SDL front end):
+ * @code
+ * g++ -O2 -pthread -I. -o gradient_check bench/gradient_check.cpp \
+ *     $(ls *.cpp | grep -v -e '^main.cpp' -e '^sdl_')
+ * ./gradient_check              # exit status 1 if a derivative is off
+ * @endcode
+ */
+
+#include "adjoint.hpp"
+#include "heat_equation_solver.hpp"
+#include "material.hpp"
+#include "source.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace ensiie;
+
+namespace {
+
+constexpr double TMAX = 40.0;
+/// Initial temperature [°C]
+constexpr double U0 = 20.0;
+/// Relative step of the finite differences of λ, ρ and c
+constexpr double REL_STEP = 1e-3;
+/// Step of the finite difference of u0 [K]
+constexpr double U0_STEP = 1e-2;
+/// Relative error above which a derivative fails (the forward model is solved to 1e-12)
+constexpr double TOLERANCE = 1e-4;
+/// Checkpoint budget of the revolve runs
+constexpr int FEW_CHECKPOINTS = 4;
+/// Checkpoint budget storing every step (the runs take tmax / 1000)
+constexpr int ALL_CHECKPOINTS = 1000;
+
+/**
+ * @brief Model of a case: the initial temperature and the source power
+ *        scale are the two inputs that are not material properties.
+ */
+struct Model {
+    double u0 = U0;     ///< Initial temperature [°C]
+    double power = 1.0; ///< Scale of the source power
+};
+
+/// Misfit and gradient of a material for a model, given the checkpoint budget
+using Evaluate = std::function<Gradient(const Material&, const Model&, int checkpoints)>;
+
+/**
+ * @brief Compare one adjoint derivative with its central difference.
+ * @return false if the relative error exceeds TOLERANCE
+ */
+bool compare(const std::string& name, double adjoint, double jp, double jm, double h) {
+    const double fd = (jp - jm) / (2.0 * h);
+    const double error = std::abs(adjoint - fd) / std::max(std::abs(fd), 1e-300);
+    const bool ok = error <= TOLERANCE;
+    std::printf("%-36s adjoint %14.8g  fd %14.8g  error %9.2e  %s\n",
+                name.c_str(), adjoint, fd, error, ok ? "ok" : "FAIL");
+    return ok;
+}
+
+/**
+ * @brief Check every derivative of a case, with and without recomputation.
+ */
+bool check(const std::string& name, const Evaluate& evaluate, const Material& mat, bool anisotropic) {
+    const Model model;
+    auto J = [&](const Material& m, const Model& p) { return evaluate(m, p, ALL_CHECKPOINTS).objective; };
+    auto material = [&](double Material::*field, double h) {
+        Material plus = mat, minus = mat;
+        plus.*field += h;
+        minus.*field -= h;
+        return std::make_pair(J(plus, model), J(minus, model));
+    };
+
+    // Finite differences, once per parameter
+    const double hl = REL_STEP * mat.lambda;
+    const double hly = REL_STEP * mat.lambda_y;
+    const double hr = REL_STEP * mat.rho;
+    const double hc = REL_STEP * mat.c;
+    const auto dl = material(&Material::lambda, hl);
+    const auto dly = anisotropic ? material(&Material::lambda_y, hly) : std::make_pair(0.0, 0.0);
+    const auto dr = material(&Material::rho, hr);
+    const auto dc = material(&Material::c, hc);
+    Model hot = model, cold = model, strong = model, weak = model;
+    hot.u0 += U0_STEP;
+    cold.u0 -= U0_STEP;
+    strong.power += REL_STEP;
+    weak.power -= REL_STEP;
+    const std::pair<double, double> du0{J(mat, hot), J(mat, cold)};
+    const std::pair<double, double> dp{J(mat, strong), J(mat, weak)};
+
+    bool ok = true;
+    for (int checkpoints : {ALL_CHECKPOINTS, FEW_CHECKPOINTS}) {
+        const Gradient g = evaluate(mat, model, checkpoints);
+        const std::string tag = name + (checkpoints == FEW_CHECKPOINTS ? " revolve " : " stored ");
+        std::printf("%s: J %.10g, %d forward steps, %d fields held\n",
+                    tag.c_str(), g.objective, g.forward_steps, g.stored);
+        ok &= compare(tag + "dJ/dlambda", g.lambda, dl.first, dl.second, hl);
+        if (anisotropic) ok &= compare(tag + "dJ/dlambda_y", g.lambda_y, dly.first, dly.second, hly);
+        ok &= compare(tag + "dJ/drho", g.rho, dr.first, dr.second, hr);
+        ok &= compare(tag + "dJ/dc", g.c, dc.first, dc.second, hc);
+        ok &= compare(tag + "dJ/du0", g.u0, du0.first, du0.second, U0_STEP);
+        ok &= compare(tag + "dJ/dp", g.source[0], dp.first, dp.second, REL_STEP);
+    }
+    return ok;
+}
+
+/**
+ * @brief 41-node steel bar, convective at x=0, fixed at x=L, pulsed box source.
+ */
+bool bar() {
+    const std::array<BoundaryCondition, 2> edges{BoundaryCondition::robin(30.0, 20.0),
+                                                 BoundaryCondition::dirichlet(20.0)};
+    auto make = [&](const Material& m, const Model& p) {
+        auto s = make_solver_1d(m, 0.1, TMAX, p.u0, 0.0, 41, edges);
+        s->set_sources({HeatSource::box(0.02, 0.05, p.power * 2e5).modulate(modulation::pulsed(10.0, 0.5))});
+        return s;
+    };
+
+    // Series of the reference material, every third sample of one probe missing
+    const Material truth{"reference", 80.0, 7800.0, 460.0};
+    std::vector<ProbeData> data{{0.03, 0.0, {}}, {0.07, 0.0, {}}};
+    auto s = make(truth, Model{});
+    while (s->step()) {
+        for (ProbeData& d : data) d.values.push_back(s->probe(d.x));
+    }
+    for (std::size_t n = 0; n < data[1].values.size(); n += 3) data[1].values[n] = NAN;
+
+    const Evaluate evaluate = [&](const Material& m, const Model& p, int checkpoints) {
+        AdjointOptions options;
+        options.checkpoints = checkpoints;
+        return adjoint_gradient_1d([&](const Material& mm) { return make(mm, p); }, m, data, options);
+    };
+    return check("bar", evaluate, Material{"guess", 60.0, 7000.0, 500.0}, false);
+}
+
+/**
+ * @brief 21×17 anisotropic plate with mixed edges and a Gaussian source.
+ */
+bool plate() {
+    const std::array<BoundaryCondition, 4> edges{
+        BoundaryCondition::robin(20.0, 13.0), BoundaryCondition::dirichlet(30.0),
+        BoundaryCondition::neumann(500.0), BoundaryCondition::robin(50.0, 5.0)};
+    auto make = [&](const Material& m, const Model& p) {
+        auto s = make_solver_2d(m, 0.1, 0.08, TMAX, p.u0, 0.0, 21, 17, edges);
+        s->set_sources({HeatSource::gaussian(0.05, 0.04, 0.01, p.power * 3e5)});
+        return s;
+    };
+
+    Material truth{"reference", 80.0, 7800.0, 460.0};
+    truth.lambda_y = 40.0;
+    std::vector<ProbeData> data{{0.033, 0.021, {}}, {0.071, 0.05, {}}};
+    auto s = make(truth, Model{});
+    while (s->step()) {
+        for (ProbeData& d : data) d.values.push_back(s->probe(d.x, d.y));
+    }
+
+    const Evaluate evaluate = [&](const Material& m, const Model& p, int checkpoints) {
+        AdjointOptions options;
+        options.checkpoints = checkpoints;
+        return adjoint_gradient_2d([&](const Material& mm) { return make(mm, p); }, m, data, options);
+    };
+    Material guess{"guess", 60.0, 7000.0, 500.0};
+    guess.lambda_y = 50.0;
+    return check("plate", evaluate, guess, true);
+}
+
+} // namespace
+
+int main() {
+    bool ok = true;
+    ok &= bar();
+    ok &= plate();
+    return ok ? 0 : 1;
+}
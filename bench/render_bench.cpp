@@ -0,0 +1,148 @@
+/**
+ * @file render_bench.cpp
+ * @brief Frame timings of the viewer's render paths on an offscreen renderer.
+ *
+ * Every case drives an SDLApp (bar or plate, one material or the 2×2
+ * material grid) drawing into an offscreen surface of a given size
+ * through SDL's software renderer, so it runs without a display. The
+ * simulation is first advanced by a few frames, so that the fields are
+ * not uniform. Then render_frame() is timed on its own: the solver steps
+ * of the viewer are measured by solver_bench. Each case reports
+ * - frame time percentiles (50, 90, 99, max),
+ * - draw calls per frame (sdl_draw.hpp),
+ * - surface pixels per second (width × height / median frame time).
+ *
+ * The JSON results use the names and fields of solver_bench, so two runs
+ * are compared with `solver_bench --compare`.
+ *
+ * Build (from the repository root):
+ * @code
+ * g++ -O3 -march=native -pthread -I. -o render_bench bench/render_bench.cpp \
+ *     $(ls *.cpp | grep -v '^main.cpp') $(pkg-config --cflags --libs sdl2)
+ * ./render_bench --json render.json
+ * @endcode
+ */
+
+#include "bench_common.hpp"
+#include "sdl_app.hpp"
+#include "sdl_draw.hpp"
+#include "heat_equation_solver.hpp"
+#include "profile.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace sdl;
+using namespace bench;
+
+namespace {
+
+// ============================================================================
+// Cases
+// ============================================================================
+
+const Offscreen SIZES[] = {{800, 600}, {1280, 720}, {1920, 1080}, {2560, 1440}};
+
+/**
+ * @brief Value below which a fraction q of the sorted samples lie.
+ */
+double percentile(const std::vector<double>& sorted, double q) {
+    const std::size_t i = static_cast<std::size_t>(q * (sorted.size() - 1) + 0.5);
+    return sorted[std::min(i, sorted.size() - 1)];
+}
+
+Result run_case(const Options& opt, const std::string& name, SDLApp::SimType type, bool grid,
+                const Offscreen& size) {
+    const auto bc = ensiie::default_boundaries_2d(U0);
+    auto app = grid
+        ? std::make_unique<SDLApp>(type, LENGTH, LENGTH, TMAX, U0, SOURCE, bc, size)
+        : std::make_unique<SDLApp>(type, ensiie::Materials::COPPER, LENGTH, LENGTH, TMAX, U0, SOURCE, bc, size);
+    for (int f = 0; f < opt.warmup; f++) app->advance();
+    app->render_frame();
+
+    std::vector<double> times;
+    long calls = 0;
+    for (int f = 0; f < opt.frames; f++) {
+        draw::reset_calls();
+        const auto start = std::chrono::steady_clock::now();
+        app->render_frame();
+        times.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        calls += draw::calls();
+    }
+
+    Result r;
+    r.name = name;
+    r.kernel = "render";
+    r.width = size.width;
+    r.height = size.height;
+    r.calls = opt.frames;
+    std::sort(times.begin(), times.end());
+    r.median = percentile(times, 0.5);
+    r.p90 = percentile(times, 0.9);
+    r.p99 = percentile(times, 0.99);
+    r.max = times.back();
+    for (double t : times) r.mean += t / opt.frames;
+    r.draw_calls = static_cast<double>(calls) / opt.frames;
+    r.pixels_per_second = static_cast<double>(size.width) * size.height / r.median;
+    return r;
+}
+
+void usage() {
+    std::printf("usage: render_bench [--json FILE] [--filter TEXT] [--frames N] [--warmup N] [--trace FILE]\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        Options opt;
+        std::vector<std::string> args(argv + 1, argv + argc);
+        for (std::size_t i = 0; i < args.size(); i++) {
+            const std::string& a = args[i];
+            const bool has_value = i + 1 < args.size();
+            if (a == "--json" && has_value) opt.json = args[++i];
+            else if (a == "--filter" && has_value) opt.filter = args[++i];
+            else if (a == "--trace" && has_value) opt.trace = args[++i];
+            else if (a == "--frames" && has_value) opt.frames = std::max(1, std::stoi(args[++i]));
+            else if (a == "--warmup" && has_value) opt.warmup = std::max(0, std::stoi(args[++i]));
+            else {
+                usage();
+                return 2;
+            }
+        }
+
+        std::vector<Result> results;
+        for (SDLApp::SimType type : {SDLApp::SimType::BAR_1D, SDLApp::SimType::PLATE_2D}) {
+            for (bool grid : {false, true}) {
+                for (const Offscreen& size : SIZES) {
+                    const std::string name = std::string("render/")
+                        + (type == SDLApp::SimType::BAR_1D ? "bar" : "plate")
+                        + (grid ? "/grid/" : "/single/")
+                        + std::to_string(size.width) + "x" + std::to_string(size.height);
+                    if (!opt.filter.empty() && name.find(opt.filter) == std::string::npos) continue;
+
+                    const Result r = run_case(opt, name, type, grid, size);
+                    std::printf("%-30s p50 %7.2f  p90 %7.2f  p99 %7.2f  max %7.2f ms  %9.0f calls  %9.3e px/s\n",
+                                r.name.c_str(), 1e3 * r.median, 1e3 * r.p90, 1e3 * r.p99, 1e3 * r.max,
+                                r.draw_calls, r.pixels_per_second);
+                    std::fflush(stdout);
+                    results.push_back(r);
+                }
+            }
+        }
+        if (!opt.json.empty()) {
+            write_json({{"renderer", quoted("software")}, {"frames", number(opt.frames)}},
+                       results, opt.json);
+        }
+        if (!opt.trace.empty()) ensiie::profile::write_chrome_trace(opt.trace);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "render_bench: %s\n", e.what());
+        return 2;
+    }
+    return 0;
+}
@@ -0,0 +1,568 @@
+/**
+ * @file solver_bench.cpp
+ * @brief Throughput benchmarks of the solvers, with JSON results and run comparison.
+ *
+ * Every case builds a solver (not timed), takes one warm-up call, then
+ * times single calls until the minimum time is spent. It reports the
+ * median time per call together with
+ * - cells updated per second (grid nodes / median time),
+ * - iterations per step (sweeps or Krylov iterations, plates only) and
+ *   the steps that hit their iteration limit without converging,
+ * - GB/s from a streaming model of each kernel: the bytes a call must
+ *   move when no array fits in cache. The figure is a model and not a
+ *   counter reading, so it is only comparable between runs of the same
+ *   backend.
+ *
+ * Cases whose resident memory would exceed --max-memory are listed as
+ * skipped: a 10⁸-node bar needs about 8 GB in double precision.
+ *
+ * Build (from the repository root, without the SDL front end):
+ * @code
+ * g++ -O3 -march=native -pthread -I. -o solver_bench bench/solver_bench.cpp \
+ *     $(ls *.cpp | grep -v -e '^main.cpp' -e '^sdl_')
+ * ./solver_bench --json base.json                 # full sweep
+ * ./solver_bench --quick --json new.json          # small grids only
+ * ./solver_bench --compare base.json new.json     # exit status 1 on a regression
+ * @endcode
+ *
+ * Built with -DHEAT_PROFILE, `--trace FILE` also writes the solver phases
+ * (profile.hpp) of the run as a Chrome trace; the rings keep the last
+ * RING_CAPACITY zones of each thread.
+ * @code
+ * g++ -O3 -march=native -pthread -I. -DHEAT_PROFILE -o solver_bench ...
+ * ./solver_bench --quick --filter step_2d --trace solver_trace.json
+ * @endcode
+ */
+
+#include "bench_common.hpp"
+#include "heat_equation_solver.hpp"
+#include "material.hpp"
+#include "parallel.hpp"
+#include "profile.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace ensiie;
+using namespace bench;
+
+namespace {
+
+// ============================================================================
+// Cases
+// ============================================================================
+
+/**
+ * @struct Backend1D
+ * @brief A bar solver configuration.
+ */
+struct Backend1D {
+    std::string name;
+    Precision precision;
+    double resident;   ///< Bytes held per node
+    double traffic;    ///< Bytes moved per node and step
+};
+
+/**
+ * @struct Backend2D
+ * @brief A plate solver configuration.
+ */
+struct Backend2D {
+    std::string name;
+    Precision precision;
+    StencilKind stencil;
+    std::optional<KrylovOptions> krylov;
+    bool threaded;     ///< Uses the worker pool (swept over thread counts)
+    double resident;   ///< Bytes held per node
+    double step;       ///< Bytes moved per node and step, outside the iterations
+    double iteration;  ///< Bytes moved per node and iteration
+    int real;          ///< sizeof the storage type
+};
+
+/*
+ * Traffic models (double storage, 8-byte words):
+ * - Thomas step: u → d, d → d_real, forward pass (d, a, 1/den in; d out),
+ *   backward pass (d, c' in; u out): 11 words per node.
+ * - Plate step: u_new = u and rhs = u (2 in, 2 out); each sweep streams
+ *   u_new in and out and rhs in, the neighbour rows staying in cache.
+ * - Krylov iteration: about 5 stored nonzeros (value + column, 12 bytes)
+ *   per row for each of the two products of BiCGStab, plus 12 vector words.
+ */
+std::vector<Backend1D> backends_1d() {
+    return {
+        {"thomas", Precision::DOUBLE, 80.0, 88.0},
+        {"thomas-mixed", Precision::MIXED, 48.0, 56.0},
+    };
+}
+
+std::vector<Backend2D> backends_2d() {
+    KrylovOptions amg;
+    amg.method = KrylovMethod::BICGSTAB;
+    amg.preconditioner = PreconditionerKind::AMG;
+    amg.tol = 1e-8;
+    return {
+        {"gauss-seidel", Precision::DOUBLE, StencilKind::GAUSS_SEIDEL, std::nullopt, false, 32.0, 32.0, 24.0, 8},
+        {"gauss-seidel-mixed", Precision::MIXED, StencilKind::GAUSS_SEIDEL, std::nullopt, false, 24.0, 16.0, 12.0, 4},
+        {"sor", Precision::DOUBLE, StencilKind::SOR, std::nullopt, false, 32.0, 32.0, 24.0, 8},
+        {"bicgstab-amg", Precision::DOUBLE, StencilKind::GAUSS_SEIDEL, amg, true, 400.0, 96.0, 216.0, 8},
+    };
+}
+
+std::vector<std::pair<std::string, Material>> materials(bool quick) {
+    std::vector<std::pair<std::string, Material>> all = {
+        {"copper", Materials::COPPER},
+        {"iron", Materials::IRON},
+        {"glass", Materials::GLASS},
+        {"polystyrene", Materials::POLYSTYRENE},
+    };
+    if (quick) all.resize(1);
+    return all;
+}
+
+std::vector<long> sizes_1d(bool quick) {
+    if (quick) return {1000, 10000, 100000};
+    return {1000, 10000, 100000, 1000000, 10000000, 100000000};
+}
+
+std::vector<long> sizes_2d(bool quick) {
+    if (quick) return {64, 128, 256};
+    return {64, 128, 256, 512, 1024, 2048, 4096};
+}
+
+// ============================================================================
+// Timing
+// ============================================================================
+
+double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @brief Time single calls of `call` after one warm-up call.
+ *
+ * `call` returns false once the timed state must be restored (a solver
+ * at tmax); `restore` then runs outside the timings.
+ */
+void time_calls(const Options& opt, Result& r,
+                const std::function<bool()>& call, const std::function<void()>& restore) {
+    if (!call()) restore();
+
+    std::vector<double> times;
+    double total = 0.0;
+    while (times.empty() || total < opt.min_time) {
+        const auto start = std::chrono::steady_clock::now();
+        const bool more = call();
+        const double s = seconds_since(start);
+        times.push_back(s);
+        total += s;
+        if (!more) restore();
+    }
+
+    std::vector<double> sorted = times;
+    std::sort(sorted.begin(), sorted.end());
+    const std::size_t c = sorted.size();
+    r.calls = static_cast<int>(c);
+    r.median = c % 2 ? sorted[c / 2] : 0.5 * (sorted[c / 2 - 1] + sorted[c / 2]);
+    r.min = sorted.front();
+    r.mean = total / static_cast<double>(c);
+}
+
+std::string case_name(const Result& r) {
+    return r.kernel + "/" + r.backend + "/" + r.material + "/n=" + std::to_string(r.n)
+         + "/threads=" + std::to_string(r.threads);
+}
+
+/**
+ * @brief Fill the identity of a case; false if it is filtered out.
+ */
+bool prepare(const Options& opt, Result& r, const char* kernel, const std::string& backend,
+             const std::string& material, long n, int threads, double resident_bytes) {
+    r.kernel = kernel;
+    r.backend = backend;
+    r.material = material;
+    r.n = n;
+    r.threads = threads;
+    r.name = case_name(r);
+    if (!opt.filter.empty() && r.name.find(opt.filter) == std::string::npos) return false;
+    r.skipped = resident_bytes > opt.max_memory * 1e9;
+    return true;
+}
+
+void report(const Result& r) {
+    if (r.skipped) {
+        std::printf("%-58s skipped (over the memory budget)\n", r.name.c_str());
+    } else {
+        std::printf("%-58s %10.3e s  %9.3e cells/s  %6.2f GB/s", r.name.c_str(),
+                    r.median, r.cells_per_second, r.gb_per_second);
+        if (r.iterations_per_step >= 0.0) std::printf("  %6.1f it/step", r.iterations_per_step);
+        if (r.unconverged_steps > 0) std::printf("  %ld unconverged", r.unconverged_steps);
+        std::printf("\n");
+    }
+    std::fflush(stdout);
+}
+
+// ============================================================================
+// Kernels
+// ============================================================================
+
+void bench_step_1d(const Options& opt, std::vector<Result>& out) {
+    for (const Backend1D& b : backends_1d()) {
+        for (const auto& [key, mat] : materials(opt.quick)) {
+            for (long n : sizes_1d(opt.quick)) {
+                Result r;
+                if (!prepare(opt, r, "step_1d", b.name, key, n, 1, b.resident * n)) continue;
+                if (!r.skipped) {
+                    parallel::set_threads(1);
+                    auto solver = make_solver_1d(mat, LENGTH, TMAX, U0, SOURCE, static_cast<int>(n),
+                                                 default_boundaries_1d(U0), b.precision);
+                    time_calls(opt, r, [&] {
+                        solver->step();
+                        return solver->get_time() < solver->get_tmax();
+                    }, [&] { solver->reset(); });
+                    r.cells_per_second = n / r.median;
+                    r.gb_per_second = b.traffic * n / r.median * 1e-9;
+                }
+                report(r);
+                out.push_back(r);
+            }
+        }
+    }
+}
+
+void bench_step_2d(const Options& opt, std::vector<Result>& out) {
+    for (const Backend2D& b : backends_2d()) {
+        const std::vector<int> counts = b.threaded ? opt.threads : std::vector<int>{1};
+        for (const auto& [key, mat] : materials(opt.quick)) {
+            for (long n : sizes_2d(opt.quick)) {
+                for (int t : counts) {
+                    const double nn = static_cast<double>(n) * n;
+                    Result r;
+                    if (!prepare(opt, r, "step_2d", b.name, key, n, t, b.resident * nn)) continue;
+                    if (!r.skipped) {
+                        parallel::set_threads(t);
+                        auto solver = make_solver_2d(mat, LENGTH, TMAX, U0, SOURCE, static_cast<int>(n),
+                                                     default_boundaries_2d(U0), b.precision, b.stencil);
+                        if (b.krylov) solver->set_krylov(b.krylov);
+                        long iterations = 0;
+                        long steps = 0;
+                        time_calls(opt, r, [&] {
+                            solver->step();
+                            iterations += solver->get_last_iterations();
+                            steps++;
+                            return solver->get_time() < solver->get_tmax();
+                        }, [&] {
+                            r.unconverged_steps += solver->get_unconverged_steps();
+                            solver->reset();
+                        });
+                        r.unconverged_steps += solver->get_unconverged_steps();
+                        // The warm-up step is counted as well: its iterations are representative
+                        r.iterations_per_step = static_cast<double>(iterations) / steps;
+                        r.cells_per_second = nn / r.median;
+                        r.gb_per_second = (b.step + b.iteration * r.iterations_per_step) * nn / r.median * 1e-9;
+                    }
+                    report(r);
+                    out.push_back(r);
+                }
+            }
+        }
+    }
+    parallel::set_threads(0);
+}
+
+void bench_field_2d(const Options& opt, std::vector<Result>& out) {
+    // The copy does not depend on the material or the solve, only on the storage type
+    for (const Backend2D& b : backends_2d()) {
+        if (b.krylov || b.stencil != StencilKind::GAUSS_SEIDEL) continue;
+        const auto [key, mat] = materials(opt.quick).front();
+        for (long n : sizes_2d(opt.quick)) {
+            const double nn = static_cast<double>(n) * n;
+            Result r;
+            if (!prepare(opt, r, "field_2d", b.name, key, n, 1, (b.resident + 8.0) * nn)) continue;
+            if (!r.skipped) {
+                auto solver = make_solver_2d(mat, LENGTH, TMAX, U0, SOURCE, static_cast<int>(n),
+                                             default_boundaries_2d(U0), b.precision, b.stencil);
+                volatile double sink = 0.0;
+                time_calls(opt, r, [&] {
+                    sink = solver->get_temperature_2d()[n / 2][n / 2];
+                    return true;
+                }, [] {});
+                r.cells_per_second = nn / r.median;
+                r.gb_per_second = (b.real + 8.0) * nn / r.median * 1e-9;
+            }
+            report(r);
+            out.push_back(r);
+        }
+    }
+}
+
+// ============================================================================
+// JSON input (the subset written above: objects, arrays, strings, numbers, literals)
+// ============================================================================
+
+/**
+ * @struct Json
+ * @brief Parsed JSON value.
+ */
+struct Json {
+    enum class Kind { NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT } kind = Kind::NUL;
+    double number = 0.0;
+    std::string string;
+    std::vector<Json> items;                            ///< Array elements
+    std::vector<std::pair<std::string, Json>> fields;   ///< Object members, in order
+
+    const Json* find(const std::string& key) const {
+        for (const auto& [k, v] : fields) {
+            if (k == key) return &v;
+        }
+        return nullptr;
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(std::string text) : s_(std::move(text)), p_(0) {}
+
+    Json parse() {
+        Json v = value();
+        skip();
+        if (p_ != s_.size()) fail("trailing characters");
+        return v;
+    }
+
+private:
+    std::string s_;
+    std::size_t p_;
+
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::invalid_argument("benchmark JSON: " + what + " at offset " + std::to_string(p_));
+    }
+
+    void skip() {
+        while (p_ < s_.size() && std::isspace(static_cast<unsigned char>(s_[p_]))) p_++;
+    }
+
+    /// Next significant character ('\0' at the end)
+    char peek() {
+        skip();
+        return p_ < s_.size() ? s_[p_] : '\0';
+    }
+
+    /// Consume c if it is the next significant character
+    bool accept(char c) {
+        if (peek() != c) return false;
+        p_++;
+        return true;
+    }
+
+    void expect(char c) {
+        skip();
+        if (p_ >= s_.size() || s_[p_] != c) fail(std::string("expected '") + c + "'");
+        p_++;
+    }
+
+    std::string string() {
+        expect('"');
+        std::string out;
+        while (p_ < s_.size() && s_[p_] != '"') {
+            if (s_[p_] == '\\' && ++p_ >= s_.size()) break;
+            out += s_[p_++];
+        }
+        if (p_ >= s_.size()) fail("unterminated string");
+        p_++;
+        return out;
+    }
+
+    Json value() {
+        const char c = peek();
+        if (c == '\0') fail("unexpected end");
+        Json v;
+        if (c == '{') {
+            v.kind = Json::Kind::OBJECT;
+            p_++;
+            if (accept('}')) return v;
+            do {
+                std::string key = string();
+                expect(':');
+                v.fields.emplace_back(std::move(key), value());
+            } while (accept(','));
+            expect('}');
+        } else if (c == '[') {
+            v.kind = Json::Kind::ARRAY;
+            p_++;
+            if (accept(']')) return v;
+            do {
+                v.items.push_back(value());
+            } while (accept(','));
+            expect(']');
+        } else if (c == '"') {
+            v.kind = Json::Kind::STRING;
+            v.string = string();
+        } else if (s_.compare(p_, 4, "true") == 0 || s_.compare(p_, 5, "false") == 0) {
+            v.kind = Json::Kind::BOOL;
+            v.number = (c == 't') ? 1.0 : 0.0;
+            p_ += (c == 't') ? 4 : 5;
+        } else if (s_.compare(p_, 4, "null") == 0) {
+            p_ += 4;
+        } else {
+            char* end = nullptr;
+            v.kind = Json::Kind::NUMBER;
+            v.number = std::strtod(s_.c_str() + p_, &end);
+            if (end == s_.c_str() + p_) fail("invalid value");
+            p_ = static_cast<std::size_t>(end - s_.c_str());
+        }
+        return v;
+    }
+};
+
+/**
+ * @brief Median time and iterations of every timed case of a result file.
+ */
+std::map<std::string, std::pair<double, double>> load_results(const std::string& path) {
+    std::ifstream f(path);
+    if (!f) throw std::invalid_argument("cannot read '" + path + "'");
+    std::stringstream text;
+    text << f.rdbuf();
+
+    const Json root = JsonParser(text.str()).parse();
+    const Json* results = root.find("results");
+    if (!results || results->kind != Json::Kind::ARRAY) {
+        throw std::invalid_argument("'" + path + "' has no results array");
+    }
+
+    std::map<std::string, std::pair<double, double>> cases;
+    for (const Json& r : results->items) {
+        const Json* name = r.find("name");
+        const Json* median = r.find("seconds_median");
+        if (!name || !median) continue;  // skipped case
+        const Json* it = r.find("iterations_per_step");
+        cases[name->string] = {median->number, it ? it->number : -1.0};
+    }
+    return cases;
+}
+
+/**
+ * @brief Print the cases of `after` slower than `before` beyond the threshold.
+ * @return Number of regressions
+ */
+int compare(const std::string& before_path, const std::string& after_path, double threshold) {
+    const auto before = load_results(before_path);
+    const auto after = load_results(after_path);
+
+    int regressions = 0, improvements = 0, matched = 0;
+    for (const auto& [name, now] : after) {
+        const auto was = before.find(name);
+        if (was == before.end()) continue;
+        matched++;
+        const double ratio = now.first / was->second.first;
+        const char* verdict = nullptr;
+        if (ratio > 1.0 + threshold) {
+            verdict = "REGRESSION";
+            regressions++;
+        } else if (ratio < 1.0 / (1.0 + threshold)) {
+            verdict = "improvement";
+            improvements++;
+        }
+        if (verdict) {
+            std::printf("%-11s %-58s %10.3e -> %10.3e s  (%+.1f%%)\n", verdict, name.c_str(),
+                        was->second.first, now.first, 100.0 * (ratio - 1.0));
+        }
+        // Iteration counts are deterministic: a change is a change of algorithm, not noise
+        const double it0 = was->second.second, it1 = now.second;
+        if (it0 >= 0.0 && it1 >= 0.0 && std::abs(it1 - it0) > 1e-3 * std::max(1.0, it0)) {
+            std::printf("%-11s %-58s %10.2f -> %10.2f it/step\n", "iterations", name.c_str(), it0, it1);
+        }
+    }
+    std::printf("%d cases compared, %d regressions, %d improvements (threshold %.0f%%)\n",
+                matched, regressions, improvements, 100.0 * threshold);
+    return regressions;
+}
+
+// ============================================================================
+// Command line
+// ============================================================================
+
+void usage() {
+    std::printf(
+        "usage: solver_bench [--quick] [--json FILE] [--filter TEXT] [--min-time S]\n"
+        "                    [--max-memory GB] [--threads N,N,...] [--trace FILE]\n"
+        "       solver_bench --compare BEFORE.json AFTER.json [--threshold FRACTION]\n");
+}
+
+std::vector<int> parse_counts(const std::string& list) {
+    std::vector<int> counts;
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        const int t = std::stoi(item);
+        if (t < 1) throw std::invalid_argument("thread counts must be positive");
+        counts.push_back(t);
+    }
+    return counts;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    try {
+        Options opt;
+        std::vector<std::string> args(argv + 1, argv + argc);
+        std::string before, after;
+        double threshold = 0.10;
+
+        for (std::size_t i = 0; i < args.size(); i++) {
+            const std::string& a = args[i];
+            const bool has_value = i + 1 < args.size();
+            if (a == "--quick") opt.quick = true;
+            else if (a == "--json" && has_value) opt.json = args[++i];
+            else if (a == "--filter" && has_value) opt.filter = args[++i];
+            else if (a == "--trace" && has_value) opt.trace = args[++i];
+            else if (a == "--min-time" && has_value) opt.min_time = std::stod(args[++i]);
+            else if (a == "--max-memory" && has_value) opt.max_memory = std::stod(args[++i]);
+            else if (a == "--threads" && has_value) opt.threads = parse_counts(args[++i]);
+            else if (a == "--threshold" && has_value) threshold = std::stod(args[++i]);
+            else if (a == "--compare" && i + 2 < args.size()) {
+                before = args[++i];
+                after = args[++i];
+            } else {
+                usage();
+                return 2;
+            }
+        }
+
+        if (!before.empty()) return compare(before, after, threshold) > 0 ? 1 : 0;
+
+        if (opt.threads.empty()) {
+            // Serial, then every hardware thread
+            const int hw = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+            opt.threads = {1};
+            if (hw > 1) opt.threads.push_back(hw);
+        }
+
+        std::vector<Result> results;
+        bench_step_1d(opt, results);
+        bench_step_2d(opt, results);
+        bench_field_2d(opt, results);
+        if (!opt.json.empty()) write_json({{"min_time", number(opt.min_time)}}, results, opt.json);
+        if (!opt.trace.empty()) profile::write_chrome_trace(opt.trace);
+    } catch (const std::exception& e) {
+        std::fprintf(stderr, "solver_bench: %s\n", e.what());
+        return 2;
+    }
+    return 0;
+}
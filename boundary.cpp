@@ -0,0 +1,34 @@
+/**
+ * @file boundary.cpp
+ * @brief Boundary condition helpers.
+ */
+
+#include "boundary.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace ensiie {
+
+BoundaryCondition BoundaryCondition::dirichlet_series(std::vector<std::pair<double, double>> samples) {
+    if (samples.empty()) {
+        throw std::invalid_argument("time series needs at least one sample");
+    }
+    if (!std::is_sorted(samples.begin(), samples.end(),
+                        [](const auto& a, const auto& b) { return a.first < b.first; })) {
+        throw std::invalid_argument("time series samples must be sorted by time");
+    }
+
+    return dirichlet([samples = std::move(samples)](double t) {
+        if (t <= samples.front().first) return samples.front().second;
+        if (t >= samples.back().first) return samples.back().second;
+
+        // First sample strictly after t
+        auto hi = std::upper_bound(samples.begin(), samples.end(), t,
+                                   [](double v, const auto& s) { return v < s.first; });
+        auto lo = hi - 1;
+        double w = (t - lo->first) / (hi->first - lo->first);
+        return (1.0 - w) * lo->second + w * hi->second;
+    });
+}
+
+} // namespace ensiie
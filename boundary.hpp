@@ -0,0 +1,255 @@
+/**
+ * @file boundary.hpp
+ * @brief Boundary condition descriptions and compile-time edge policies.
+ *
+ * A boundary condition is described at runtime by a BoundaryCondition
+ * (kind + parameters) and at compile time by an edge policy type from
+ * the ensiie::bc namespace. The solvers are templates over a bundle of
+ * edge policies (Boundary1D / Boundary2D) so that the kind of every
+ * edge is known when the kernel is compiled; only the parameters
+ * (temperatures, fluxes, exchange coefficients) remain runtime values.
+ *
+ * Supported kinds:
+ * - Dirichlet: u = value, or u = g(t) for a time series
+ * - Neumann:   heat flux entering the domain, -λ ∂u/∂n = flux
+ * - Robin:     convective exchange, -λ ∂u/∂n = h (u - T∞), optionally
+ *              with radiation: + εσ (u⁴ - T∞⁴) (absolute temperatures)
+ * - Periodic:  opposite edges are identified (must be used in pairs)
+ */
+
+#ifndef BOUNDARY_HPP
+#define BOUNDARY_HPP
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace ensiie {
+
+/// Stefan–Boltzmann constant σ [W/(m²K⁴)]
+constexpr double STEFAN_BOLTZMANN = 5.670374419e-8;
+
+/**
+ * @brief Kind of boundary condition applied on an edge
+ */
+enum class BoundaryKind {
+    DIRICHLET,  ///< Fixed temperature
+    NEUMANN,    ///< Prescribed heat flux
+    ROBIN,      ///< Convective (and radiative) exchange with an ambient temperature
+    PERIODIC    ///< Wraps around to the opposite edge
+};
+
+/**
+ * @brief Edge indices for 1D (LEFT/RIGHT) and 2D (WEST/EAST/SOUTH/NORTH)
+ */
+enum Edge {
+    LEFT = 0,   ///< x = 0 (1D)
+    RIGHT = 1,  ///< x = L (1D)
+    WEST = 0,   ///< x = 0 (2D)
+    EAST = 1,   ///< x = L (2D)
+    SOUTH = 2,  ///< y = 0 (2D)
+    NORTH = 3   ///< y = L (2D)
+};
+
+/**
+ * @struct BoundaryCondition
+ * @brief Runtime description of the condition applied on one edge.
+ *
+ * Temperatures are given in °C like the solver initial temperature.
+ */
+struct BoundaryCondition {
+    BoundaryKind kind = BoundaryKind::NEUMANN;  ///< Condition kind
+    double value = 0.0;   ///< Dirichlet temperature [°C]
+    double flux = 0.0;    ///< Neumann heat flux into the domain [W/m²]
+    double h = 0.0;       ///< Robin heat transfer coefficient [W/(m²K)]
+    double t_inf = 0.0;   ///< Robin ambient temperature [°C]
+    double emissivity = 0.0;  ///< Robin surface emissivity ε (0 = no radiation)
+    std::function<double(double)> series;  ///< Dirichlet temperature g(t) [°C], overrides value
+
+    /**
+     * @brief Dirichlet temperature at time t [°C]
+     */
+    double value_at(double t) const { return series ? series(t) : value; }
+
+    /**
+     * @brief Whether the edge data changes with time
+     */
+    bool is_time_dependent() const { return static_cast<bool>(series); }
+
+    /**
+     * @brief Whether the edge loses heat by radiation
+     */
+    bool is_radiative() const { return kind == BoundaryKind::ROBIN && emissivity > 0.0; }
+
+    /// Fixed temperature u = value [°C]
+    static BoundaryCondition dirichlet(double value) {
+        BoundaryCondition bc;
+        bc.kind = BoundaryKind::DIRICHLET;
+        bc.value = value;
+        return bc;
+    }
+
+    /// Time-dependent temperature u = g(t) [°C]
+    static BoundaryCondition dirichlet(std::function<double(double)> g) {
+        BoundaryCondition bc;
+        bc.kind = BoundaryKind::DIRICHLET;
+        bc.value = g(0.0);
+        bc.series = std::move(g);
+        return bc;
+    }
+
+    /**
+     * @brief Temperature read from a sampled time series [°C]
+     *
+     * Linear interpolation between samples, held constant outside them.
+     *
+     * @param samples (time [s], temperature [°C]) pairs, sorted by time
+     * @throws std::invalid_argument if samples is empty or unsorted
+     */
+    static BoundaryCondition dirichlet_series(std::vector<std::pair<double, double>> samples);
+
+    /// Prescribed inward heat flux [W/m²] (0 = insulated)
+    static BoundaryCondition neumann(double flux = 0.0) {
+        BoundaryCondition bc;
+        bc.kind = BoundaryKind::NEUMANN;
+        bc.flux = flux;
+        return bc;
+    }
+
+    /// Convective exchange with coefficient h [W/(m²K)] towards t_inf [°C]
+    static BoundaryCondition robin(double h, double t_inf) {
+        BoundaryCondition bc;
+        bc.kind = BoundaryKind::ROBIN;
+        bc.h = h;
+        bc.t_inf = t_inf;
+        return bc;
+    }
+
+    /**
+     * @brief Radiation towards surroundings at t_inf, plus optional convection.
+     *
+     * Heat loss εσ(u⁴ - T∞⁴) + h(u - T∞). The solvers treat it as a Robin
+     * edge whose exchange is linearised by Newton's method at every step.
+     *
+     * @param emissivity Surface emissivity ε in (0, 1]
+     * @param t_inf Surroundings temperature [°C]
+     * @param h Convective coefficient [W/(m²K)] (0: radiation only)
+     */
+    static BoundaryCondition radiative(double emissivity, double t_inf, double h = 0.0) {
+        BoundaryCondition bc = robin(h, t_inf);
+        bc.emissivity = emissivity;
+        return bc;
+    }
+
+    /// Periodic edge (the opposite edge must be periodic too)
+    static BoundaryCondition periodic() {
+        BoundaryCondition bc;
+        bc.kind = BoundaryKind::PERIODIC;
+        return bc;
+    }
+};
+
+/**
+ * @namespace bc
+ * @brief Compile-time edge policies.
+ *
+ * Each policy fixes the kind of one edge. The Generic policy defers the
+ * choice to the runtime BoundaryCondition and serves as the fallback for
+ * combinations that have no dedicated instantiation.
+ */
+namespace bc {
+
+/// Edge held at a fixed temperature
+struct Dirichlet {
+    static constexpr bool runtime = false;
+    static constexpr BoundaryKind kind = BoundaryKind::DIRICHLET;
+};
+
+/// Edge with a prescribed heat flux (mirror ghost node)
+struct Neumann {
+    static constexpr bool runtime = false;
+    static constexpr BoundaryKind kind = BoundaryKind::NEUMANN;
+};
+
+/// Edge exchanging heat by convection/radiation (mirror ghost node + exchange term)
+struct Robin {
+    static constexpr bool runtime = false;
+    static constexpr BoundaryKind kind = BoundaryKind::ROBIN;
+};
+
+/// Edge wrapping around to the opposite edge
+struct Periodic {
+    static constexpr bool runtime = false;
+    static constexpr BoundaryKind kind = BoundaryKind::PERIODIC;
+};
+
+/// Edge whose kind is only known at runtime
+struct Generic {
+    static constexpr bool runtime = true;
+    static constexpr BoundaryKind kind = BoundaryKind::NEUMANN;
+};
+
+/**
+ * @brief Resolve the kind of an edge.
+ *
+ * Folds to a constant for concrete policies, so that branches on the
+ * result disappear from the compiled kernel.
+ */
+template <typename Policy>
+constexpr BoundaryKind resolve(BoundaryKind runtime_kind) {
+    return Policy::runtime ? runtime_kind : Policy::kind;
+}
+
+} // namespace bc
+
+/**
+ * @struct Boundary1D
+ * @brief Edge policies of a 1D domain.
+ */
+template <typename Left, typename Right>
+struct Boundary1D {
+    using left = Left;    ///< Policy at x = 0
+    using right = Right;  ///< Policy at x = L
+
+    static_assert(Left::runtime || Right::runtime ||
+                  (Left::kind == BoundaryKind::PERIODIC) == (Right::kind == BoundaryKind::PERIODIC),
+                  "periodic edges must come in pairs");
+};
+
+/**
+ * @struct Boundary2D
+ * @brief Edge policies of a 2D domain.
+ */
+template <typename West, typename East, typename South, typename North>
+struct Boundary2D {
+    using west = West;    ///< Policy at x = 0
+    using east = East;    ///< Policy at x = L
+    using south = South;  ///< Policy at y = 0
+    using north = North;  ///< Policy at y = L
+
+    static_assert(West::runtime || East::runtime ||
+                  (West::kind == BoundaryKind::PERIODIC) == (East::kind == BoundaryKind::PERIODIC),
+                  "periodic edges must come in pairs");
+    static_assert(South::runtime || North::runtime ||
+                  (South::kind == BoundaryKind::PERIODIC) == (North::kind == BoundaryKind::PERIODIC),
+                  "periodic edges must come in pairs");
+};
+
+/// Historical configuration: insulated at x = 0, fixed temperature at x = L
+using DefaultBoundary1D = Boundary1D<bc::Neumann, bc::Dirichlet>;
+
+/// Historical configuration: insulated west/south, fixed temperature east/north
+using DefaultBoundary2D = Boundary2D<bc::Neumann, bc::Dirichlet, bc::Neumann, bc::Dirichlet>;
+
+/// Cooled fin: base held at x = 0, convection on the other edges
+using FinBoundary2D = Boundary2D<bc::Dirichlet, bc::Robin, bc::Robin, bc::Robin>;
+
+/// Ring: periodic along x, insulated along y
+using RingBoundary2D = Boundary2D<bc::Periodic, bc::Periodic, bc::Neumann, bc::Neumann>;
+
+/// Fully runtime-dispatched 2D edges (fallback instantiation)
+using GenericBoundary2D = Boundary2D<bc::Generic, bc::Generic, bc::Generic, bc::Generic>;
+
+} // namespace ensiie
+
+#endif
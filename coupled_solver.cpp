@@ -0,0 +1,230 @@
+/**
+ * @file coupled_solver.cpp
+ * @brief Assembly and time stepping of the coupled-field 1D solver.
+ */
+
+#include "coupled_solver.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace ensiie {
+
+namespace {
+
+constexpr double KELVIN_OFFSET = 273.15;
+
+} // namespace
+
+template <int B>
+CoupledHeatSolver1D<B>::CoupledHeatSolver1D(
+    const std::array<CoupledField, B>& fields,
+    const Exchange& exchange,
+    double L,
+    double tmax,
+    int n
+)
+    : fields_(fields)
+    , exchange_(exchange)
+    , L_(L)
+    , tmax_(tmax)
+    , dx_(L / (n - 1))
+    , dt_(tmax / 1000.0)
+    , t_(0.0)
+    , n_(n)
+    , u_(static_cast<size_t>(n) * B)
+    , d_(static_cast<size_t>(n) * B)
+    , f_(n)
+{
+    if (n < 3) throw std::invalid_argument("coupled solver needs at least 3 nodes");
+    for (int a = 0; a < B; a++) {
+        const CoupledField& field = fields_[a];
+        if (field.mat.changes_phase()) {
+            throw std::invalid_argument("phase change is not supported by the coupled solver");
+        }
+        if (!(field.mat.rho * field.mat.c > 0.0) || field.mat.lambda < 0.0) {
+            throw std::invalid_argument("coupled field needs a positive heat capacity");
+        }
+        for (const BoundaryCondition& c : field.bc) {
+            if (c.kind == BoundaryKind::PERIODIC) {
+                throw std::invalid_argument("periodic edges are not supported by the coupled solver");
+            }
+            if (c.is_radiative()) {
+                throw std::invalid_argument("radiative edges are not supported by the coupled solver");
+            }
+        }
+        for (int b = 0; b < B; b++) {
+            const double g = exchange_[a][b];
+            if ((a == b && g != 0.0) || g < 0.0 || g != exchange_[b][a]) {
+                throw std::invalid_argument("exchange matrix must be symmetric, non-negative, with zero diagonal");
+            }
+        }
+    }
+    assemble();
+    reset();
+}
+
+template <int B>
+void CoupledHeatSolver1D<B>::assemble() {
+    using Block = typename BlockTridiagonal<B>::Block;
+    std::vector<Block> lower(n_, Block{});
+    std::vector<Block> diag(n_, Block{});
+    std::vector<Block> upper(n_, Block{});
+
+    for (int a = 0; a < B; a++) {
+        const Material& mat = fields_[a].mat;
+        const double r = mat.alpha() * dt_ / (dx_ * dx_);
+        const int aa = a * B + a;
+
+        // Conduction within the field: the end nodes couple inwards only (mirror ghost)
+        for (int i = 0; i < n_; i++) {
+            const double lo = (i == 0) ? 0.0 : (i == n_ - 1) ? 2.0 * r : r;
+            const double hi = (i == n_ - 1) ? 0.0 : (i == 0) ? 2.0 * r : r;
+            lower[i][aa] = -lo;
+            upper[i][aa] = -hi;
+            diag[i][aa] = 1.0 + lo + hi;
+
+            // Exchange with the other fields at the same node
+            for (int b = 0; b < B; b++) {
+                const double g = dt_ * exchange_[a][b] / (mat.rho * mat.c);
+                diag[i][aa] += g;
+                diag[i][a * B + b] -= g;
+            }
+        }
+
+        // Edges: flux and convection terms, or an identity row for Dirichlet
+        for (int e : {LEFT, RIGHT}) {
+            const BoundaryCondition& c = fields_[a].bc[e];
+            const int i = (e == LEFT) ? 0 : n_ - 1;
+            edge_rhs_[a][e] = 0.0;
+            if (c.kind == BoundaryKind::DIRICHLET) {
+                for (int b = 0; b < B; b++) {
+                    lower[i][a * B + b] = 0.0;
+                    diag[i][a * B + b] = 0.0;
+                    upper[i][a * B + b] = 0.0;
+                }
+                diag[i][aa] = 1.0;
+                edge_rhs_[a][e] = c.value + KELVIN_OFFSET;
+            } else if (mat.lambda > 0.0) {
+                const double scale = 2.0 * r * dx_ / mat.lambda;
+                if (c.kind == BoundaryKind::NEUMANN) {
+                    edge_rhs_[a][e] = scale * c.flux;
+                } else if (c.kind == BoundaryKind::ROBIN) {
+                    diag[i][aa] += scale * c.h;
+                    edge_rhs_[a][e] = scale * c.h * (c.t_inf + KELVIN_OFFSET);
+                }
+            }
+        }
+    }
+
+    system_.factor(lower, diag, upper);
+}
+
+template <int B>
+bool CoupledHeatSolver1D<B>::step() {
+    if (t_ >= tmax_) return false;
+    const double tn = t_ + dt_;
+
+    d_ = u_;
+    for (int a = 0; a < B; a++) {
+        const Material& mat = fields_[a].mat;
+        std::fill(f_.begin(), f_.end(), 0.0);
+        sources_[a].move_to(tn);
+        sources_[a].add_to(f_, tn, dt_ / (mat.rho * mat.c));
+        for (int i = 0; i < n_; i++) d_[i * B + a] += f_[i];
+
+        // Edge rows: Dirichlet value replaces the RHS, other kinds add to it
+        for (int e : {LEFT, RIGHT}) {
+            const BoundaryCondition& c = fields_[a].bc[e];
+            const int k = ((e == LEFT) ? 0 : n_ - 1) * B + a;
+            if (c.kind == BoundaryKind::DIRICHLET) {
+                d_[k] = c.is_time_dependent() ? c.value_at(tn) + KELVIN_OFFSET : edge_rhs_[a][e];
+            } else {
+                d_[k] += edge_rhs_[a][e];
+            }
+        }
+    }
+
+    system_.solve(d_, u_);
+    t_ = tn;
+    return true;
+}
+
+template <int B>
+std::vector<double> CoupledHeatSolver1D<B>::get_temperature(int field) const {
+    if (field < 0 || field >= B) throw std::invalid_argument("no such field");
+    std::vector<double> u(n_);
+    for (int i = 0; i < n_; i++) u[i] = u_[i * B + field];
+    return u;
+}
+
+template <int B>
+std::vector<double> CoupledHeatSolver1D<B>::get_x() const {
+    std::vector<double> x(n_);
+    for (int i = 0; i < n_; i++) x[i] = i * dx_;
+    return x;
+}
+
+template <int B>
+void CoupledHeatSolver1D<B>::set_time_step(double dt) {
+    if (!(dt > 0.0)) throw std::invalid_argument("time step must be positive");
+    dt_ = dt;
+    assemble();
+}
+
+template <int B>
+void CoupledHeatSolver1D<B>::reset() {
+    t_ = 0.0;
+    for (int i = 0; i < n_; i++) {
+        for (int a = 0; a < B; a++) u_[i * B + a] = fields_[a].u0 + KELVIN_OFFSET;
+    }
+}
+
+template <int B>
+void CoupledHeatSolver1D<B>::set_field_sources(int field, const std::vector<HeatSource>& sources) {
+    if (field < 0 || field >= B) throw std::invalid_argument("no such field");
+    sources_[field].rasterise_1d(sources, n_, dx_);
+}
+
+template <int B>
+void CoupledHeatSolver1D<B>::set_moving_sources(const std::vector<MovingSource>& sources) {
+    sources_[0].set_moving_1d(sources, n_, dx_);
+}
+
+template <int B>
+void CoupledHeatSolver1D<B>::set_geometry(Geometry geometry, double) {
+    if (geometry != Geometry::CARTESIAN) {
+        throw std::invalid_argument("the coupled solver is Cartesian only");
+    }
+}
+
+template <int B>
+LinearStep CoupledHeatSolver1D<B>::linear_step() const {
+    throw std::invalid_argument("linear step: the coupled fields have no scalar step");
+}
+
+template <int B>
+double CoupledHeatSolver1D<B>::probe(double x, double) const {
+    const double s = std::clamp(x / dx_, 0.0, static_cast<double>(n_ - 1));
+    const int i = std::min(static_cast<int>(s), n_ - 2);
+    const double w = s - i;
+    return (1.0 - w) * u_[i * B] + w * u_[(i + 1) * B];
+}
+
+template <int B>
+double CoupledHeatSolver1D<B>::energy() const {
+    double e = 0.0;
+    for (int i = 0; i < n_; i++) {
+        const double cell = (i == 0 || i == n_ - 1) ? 0.5 * dx_ : dx_;
+        for (int a = 0; a < B; a++) {
+            e += cell * fields_[a].mat.rho * fields_[a].mat.c * u_[i * B + a];
+        }
+    }
+    return e;
+}
+
+template class CoupledHeatSolver1D<2>;
+template class CoupledHeatSolver1D<3>;
+template class CoupledHeatSolver1D<4>;
+
+} // namespace ensiie
@@ -0,0 +1,175 @@
+/**
+ * @file coupled_solver.hpp
+ * @brief 1D solver for several temperature fields exchanging heat.
+ *
+ * Each field a has its own heat capacity, conductivity and edge
+ * conditions, and exchanges heat with every other field in proportion to
+ * their temperature difference:
+ * @f[
+ *   \rho_a c_a \frac{\partial u_a}{\partial t}
+ *     = \frac{\partial}{\partial x}\left(\lambda_a \frac{\partial u_a}{\partial x}\right)
+ *     + \sum_b G_{ab}\,(u_b - u_a) + F_a
+ * @f]
+ *
+ * Examples:
+ * - Two-temperature model of a laser-heated metal: electrons (small
+ *   capacity, high conductivity) and lattice, coupled by the
+ *   electron–phonon constant G
+ * - Porous media and packed beds: solid matrix and fluid, coupled by
+ *   the volumetric heat transfer coefficient h·a
+ *
+ * Backward Euler couples the fields at every node, so the system is
+ * block-tridiagonal with one B×B block per node (block_tridiagonal.hpp).
+ * The matrix is constant: it is factored at construction and each step
+ * is one block substitution, O(n·B²).
+ */
+
+#ifndef COUPLED_SOLVER_HPP
+#define COUPLED_SOLVER_HPP
+
+#include "heat_equation_solver.hpp"
+#include "block_tridiagonal.hpp"
+#include <array>
+#include <vector>
+
+namespace ensiie {
+
+/**
+ * @struct CoupledField
+ * @brief One temperature field of a coupled model.
+ */
+struct CoupledField {
+    Material mat;                          ///< λ, ρ, c of the field (λ = 0: no conduction)
+    std::array<BoundaryCondition, 2> bc;   ///< Conditions at LEFT and RIGHT
+    double u0;                             ///< Initial temperature (°C)
+};
+
+/**
+ * @class CoupledHeatSolver1D
+ * @brief Implicit solver for B coupled temperature fields on a bar [0, L].
+ *
+ * Uses the same uniform grid, time step (tmax / 1000) and edge
+ * treatment as HeatEquationSolver1D; with no exchange every field
+ * evolves exactly as that solver would. Dirichlet, Neumann and Robin
+ * edges are supported. A field without conduction ignores its edge
+ * conditions unless they are Dirichlet.
+ *
+ * The HeatSolver1D interface exposes field 0 (the electrons of a
+ * two-temperature model, the solid of a packed bed): get_temperature(),
+ * probe() and set_sources() refer to it. get_temperature(a) and
+ * set_field_sources(a, ...) reach the other fields.
+ *
+ * @tparam B Number of fields (2 to 4)
+ */
+template <int B>
+class CoupledHeatSolver1D : public HeatSolver1D {
+public:
+    /// Exchange coefficients G_ab [W/(m³·K)]
+    using Exchange = std::array<std::array<double, B>, B>;
+
+private:
+    std::array<CoupledField, B> fields_;  /**< Field properties and conditions */
+    Exchange exchange_;   /**< Exchange coefficients */
+    double L_;            /**< Length of the domain */
+    double tmax_;         /**< Maximum simulation time */
+    double dx_;           /**< Spatial step */
+    double dt_;           /**< Time step */
+    double t_;            /**< Current time */
+    int n_;               /**< Number of grid points */
+
+    BlockTridiagonal<B> system_;  /**< Factored block-tridiagonal matrix */
+    double edge_rhs_[B][2];       /**< Constant RHS contribution of each field edge */
+    std::array<SparseSource, B> sources_;  /**< Rasterised heat sources of each field */
+
+    std::vector<double> u_;    /**< Temperatures, node-major: u_[i·B + a] [K] */
+    std::vector<double> d_;    /**< Work: right-hand side */
+    std::vector<double> f_;    /**< Work: source term of one field */
+
+    /**
+     * @brief Build the block rows and factor them.
+     */
+    void assemble();
+
+public:
+    /**
+     * @brief Construct a coupled solver.
+     *
+     * @param fields Properties, edge conditions and initial temperature of each field
+     * @param exchange Exchange coefficients G_ab [W/(m³·K)]: symmetric,
+     *        non-negative, zero diagonal
+     * @param L Length of the domain [m]
+     * @param tmax Maximum simulation time
+     * @param n Number of spatial grid points
+     * @throws std::invalid_argument for an invalid exchange matrix, a
+     *         material with phase change, or periodic or radiative edges
+     */
+    CoupledHeatSolver1D(
+        const std::array<CoupledField, B>& fields,
+        const Exchange& exchange,
+        double L,
+        double tmax,
+        int n
+    );
+
+    bool step() override;
+
+    /**
+     * @brief Get the temperature of field 0 [K].
+     */
+    std::vector<double> get_temperature() const override { return get_temperature(0); }
+
+    /**
+     * @brief Get the temperature of one field [K].
+     */
+    std::vector<double> get_temperature(int field) const;
+
+    double get_time() const override { return t_; }
+    double get_tmax() const override { return tmax_; }
+    double get_time_step() const override { return dt_; }
+    void set_time_step(double dt) override;
+    int get_n() const override { return n_; }
+    std::vector<double> get_x() const override;
+
+    void reset() override;
+    void set_sources(const std::vector<HeatSource>& sources) override { set_field_sources(0, sources); }
+    void set_moving_sources(const std::vector<MovingSource>& sources) override;
+
+    /**
+     * @brief Replace the heat sources deposited in one field.
+     */
+    void set_field_sources(int field, const std::vector<HeatSource>& sources);
+
+    /**
+     * @brief Only the Cartesian geometry is available.
+     * @throws std::invalid_argument for a radial geometry
+     */
+    void set_geometry(Geometry geometry, double r_inner = 0.0) override;
+
+    double get_melt_front() const override { return -1.0; }
+
+    /**
+     * @throws std::invalid_argument always: the fields share one block system
+     */
+    LinearStep linear_step() const override;
+    double get_liquid_fraction() const override { return 0.0; }
+    double probe(double x, double y = 0.0) const override;
+
+    /**
+     * @brief Total heat content per unit cross-section, relative to 0 K [J/m²].
+     *
+     * Exchange only moves heat between the fields, so with insulated
+     * edges and no sources this stays constant.
+     */
+    double energy() const;
+};
+
+extern template class CoupledHeatSolver1D<2>;
+extern template class CoupledHeatSolver1D<3>;
+extern template class CoupledHeatSolver1D<4>;
+
+/// Two-temperature model (electrons and lattice, solid and fluid)
+using TwoTemperatureSolver1D = CoupledHeatSolver1D<2>;
+
+} // namespace ensiie
+
+#endif
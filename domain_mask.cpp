@@ -0,0 +1,149 @@
+/**
+ * @file domain_mask.cpp
+ * @brief Domain mask description and rasterisation.
+ */
+
+#include "domain_mask.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace ensiie {
+
+bool MaskShape::contains(double x, double y) const {
+    if (disk) {
+        double ddx = x - x0;
+        double ddy = y - y0;
+        return ddx * ddx + ddy * ddy <= r * r;
+    }
+    return x >= x0 && x <= x1 && y >= y0 && y <= y1;
+}
+
+DomainMask DomainMask::from_bitmap(const std::vector<std::string>& rows,
+                                   double Lx, double Ly,
+                                   const std::string& solid) {
+    if (rows.empty() || rows[0].empty()) {
+        throw std::invalid_argument("domain bitmap is empty");
+    }
+    for (const std::string& row : rows) {
+        if (row.size() != rows[0].size()) {
+            throw std::invalid_argument("domain bitmap rows must have the same width");
+        }
+    }
+
+    DomainMask mask;
+    mask.bitmap_ = rows;
+    mask.solid_chars_ = solid;
+    mask.bitmap_Lx_ = Lx;
+    mask.bitmap_Ly_ = Ly;
+    return mask;
+}
+
+DomainMask DomainMask::l_shape(double Lx, double Ly) {
+    DomainMask mask;
+    // Strict inner bound so the nodes on the re-entrant edges stay solid
+    mask.cut_rect(0.5 * Lx * (1.0 + 1e-9), Lx, 0.5 * Ly * (1.0 + 1e-9), Ly);
+    return mask;
+}
+
+DomainMask& DomainMask::cut_rect(double x0, double x1, double y0, double y1) {
+    MaskShape s;
+    s.x0 = x0;
+    s.x1 = x1;
+    s.y0 = y0;
+    s.y1 = y1;
+    shapes_.push_back(s);
+    return *this;
+}
+
+DomainMask& DomainMask::cut_disk(double cx, double cy, double r) {
+    MaskShape s;
+    s.disk = true;
+    s.x0 = cx;
+    s.y0 = cy;
+    s.r = r;
+    shapes_.push_back(s);
+    return *this;
+}
+
+DomainMask& DomainMask::add_rect(double x0, double x1, double y0, double y1) {
+    cut_rect(x0, x1, y0, y1);
+    shapes_.back().cut = false;
+    return *this;
+}
+
+DomainMask& DomainMask::add_disk(double cx, double cy, double r) {
+    cut_disk(cx, cy, r);
+    shapes_.back().cut = false;
+    return *this;
+}
+
+DomainMask& DomainMask::faces(MaskFace face, double value) {
+    face_ = face;
+    face_value_ = value;
+    return *this;
+}
+
+bool DomainMask::solid(double x, double y) const {
+    bool inside = true;
+
+    if (!bitmap_.empty()) {
+        const int h = static_cast<int>(bitmap_.size());
+        const int w = static_cast<int>(bitmap_[0].size());
+        int col = std::clamp(static_cast<int>(std::floor(x / bitmap_Lx_ * w)), 0, w - 1);
+        int row = std::clamp(static_cast<int>(std::floor((1.0 - y / bitmap_Ly_) * h)), 0, h - 1);
+        inside = solid_chars_.find(bitmap_[row][col]) != std::string::npos;
+    }
+
+    for (const MaskShape& s : shapes_) {
+        if (s.contains(x, y)) inside = !s.cut;
+    }
+    return inside;
+}
+
+void ActiveRuns::build_full(int nx, int ny) {
+    row_ptr_.resize(ny + 1);
+    begin_.assign(ny, 0);
+    end_.assign(ny, nx);
+    for (int j = 0; j <= ny; j++) row_ptr_[j] = j;
+    active_.clear();
+    count_ = nx * ny;
+}
+
+void ActiveRuns::build(const DomainMask& mask, int nx, int ny, double dx, double dy,
+                       const std::vector<double>& x, const std::vector<double>& y) {
+    if (mask.full()) {
+        build_full(nx, ny);
+        return;
+    }
+
+    row_ptr_.assign(ny + 1, 0);
+    begin_.clear();
+    end_.clear();
+    active_.assign(static_cast<size_t>(nx) * ny, 0);
+    count_ = 0;
+
+    auto xi = [&](int i) { return x.empty() ? i * dx : x[i]; };
+
+    for (int j = 0; j < ny; j++) {
+        row_ptr_[j] = static_cast<int>(begin_.size());
+        const double yj = y.empty() ? j * dy : y[j];
+        int i = 0;
+        while (i < nx) {
+            // Skip the hole, then extend the run over solid nodes
+            while (i < nx && !mask.solid(xi(i), yj)) i++;
+            if (i == nx) break;
+            int start = i;
+            while (i < nx && mask.solid(xi(i), yj)) {
+                active_[j * nx + i] = 1;
+                i++;
+            }
+            begin_.push_back(start);
+            end_.push_back(i);
+            count_ += i - start;
+        }
+    }
+    row_ptr_[ny] = static_cast<int>(begin_.size());
+}
+
+} // namespace ensiie
@@ -0,0 +1,174 @@
+/**
+ * @file domain_mask.hpp
+ * @brief Plate geometries other than the full rectangle (holes, L-shapes).
+ *
+ * A DomainMask describes which part of the plate is solid, either as a
+ * bitmap stretched over the plate or as a list of rectangles and disks
+ * added to or cut from it. The solver rasterises the description onto
+ * its grid as an ActiveRuns list: for every row, the [begin, end) runs
+ * of active nodes. Sweeps only visit these runs, so cells inside a hole
+ * cost nothing.
+ *
+ * The faces between active nodes and a hole are either insulated
+ * (mirror ghost node, like a Neumann edge) or held at a fixed
+ * temperature (like a Dirichlet edge).
+ */
+
+#ifndef DOMAIN_MASK_HPP
+#define DOMAIN_MASK_HPP
+
+#include <string>
+#include <vector>
+
+namespace ensiie {
+
+/**
+ * @brief Condition on the faces between the plate and a hole
+ */
+enum class MaskFace {
+    INSULATED,  ///< No heat flux through the hole faces
+    FIXED       ///< Hole held at a fixed temperature
+};
+
+/**
+ * @struct MaskShape
+ * @brief Rectangle or disk added to or cut from the plate.
+ */
+struct MaskShape {
+    bool disk = false;   ///< Disk (cx = x0, cy = y0, radius r) instead of rectangle
+    bool cut = true;     ///< Remove the shape (hole) instead of adding it
+    double x0 = 0.0;     ///< Rectangle x start / disk centre x [m]
+    double x1 = 0.0;     ///< Rectangle x end [m]
+    double y0 = 0.0;     ///< Rectangle y start / disk centre y [m]
+    double y1 = 0.0;     ///< Rectangle y end [m]
+    double r = 0.0;      ///< Disk radius [m]
+
+    /**
+     * @brief Whether (x, y) lies inside the shape (boundary included)
+     */
+    bool contains(double x, double y) const;
+};
+
+/**
+ * @class DomainMask
+ * @brief Description of the solid part of a plate.
+ *
+ * The bitmap (if any) is applied first, then the shapes in order.
+ */
+class DomainMask {
+public:
+    /**
+     * @brief Full plate.
+     */
+    DomainMask() = default;
+
+    /**
+     * @brief Plate given as a bitmap stretched over [0, Lx] × [0, Ly].
+     *
+     * The first string is the top row (y = Ly). Characters in `solid`
+     * mark solid pixels; any other character is a hole.
+     *
+     * @throws std::invalid_argument if the bitmap is empty or ragged
+     */
+    static DomainMask from_bitmap(const std::vector<std::string>& rows,
+                                  double Lx, double Ly,
+                                  const std::string& solid = "#");
+
+    /**
+     * @brief L-shaped plate: the top-right quadrant of [0, Lx] × [0, Ly] is removed.
+     */
+    static DomainMask l_shape(double Lx, double Ly);
+
+    /// Remove the rectangle [x0, x1] × [y0, y1]
+    DomainMask& cut_rect(double x0, double x1, double y0, double y1);
+
+    /// Remove the disk of radius r around (cx, cy)
+    DomainMask& cut_disk(double cx, double cy, double r);
+
+    /// Add back the rectangle [x0, x1] × [y0, y1]
+    DomainMask& add_rect(double x0, double x1, double y0, double y1);
+
+    /// Add back the disk of radius r around (cx, cy)
+    DomainMask& add_disk(double cx, double cy, double r);
+
+    /**
+     * @brief Select the condition on the hole faces.
+     * @param value Hole temperature for MaskFace::FIXED [°C]
+     */
+    DomainMask& faces(MaskFace face, double value = 0.0);
+
+    /**
+     * @brief Whether the point (x, y) is solid.
+     */
+    bool solid(double x, double y) const;
+
+    MaskFace face() const { return face_; }
+    double face_value() const { return face_value_; }
+
+    /**
+     * @brief Whether the mask keeps the full plate.
+     */
+    bool full() const { return bitmap_.empty() && shapes_.empty(); }
+
+private:
+    std::vector<std::string> bitmap_;  ///< Pixel rows, top row first
+    std::string solid_chars_;          ///< Characters marking solid pixels
+    double bitmap_Lx_ = 1.0;           ///< Plate width covered by the bitmap [m]
+    double bitmap_Ly_ = 1.0;           ///< Plate height covered by the bitmap [m]
+    std::vector<MaskShape> shapes_;    ///< Shapes applied after the bitmap
+    MaskFace face_ = MaskFace::INSULATED;  ///< Hole face condition
+    double face_value_ = 0.0;          ///< Hole temperature (FIXED) [°C]
+};
+
+/**
+ * @class ActiveRuns
+ * @brief Compressed list of active nodes: [begin, end) runs per row.
+ *
+ * Node (i, j) has index j·nx + i. Runs of row j are
+ * begin()[r], end()[r] for r in [row_ptr(j), row_ptr(j + 1)).
+ */
+class ActiveRuns {
+public:
+    /**
+     * @brief Every node active (one run per row).
+     */
+    void build_full(int nx, int ny);
+
+    /**
+     * @brief Rasterise a mask on the grid x_i = i·dx, y_j = j·dy.
+     *
+     * @param x, y Node coordinates of a stretched grid (empty: uniform spacing)
+     */
+    void build(const DomainMask& mask, int nx, int ny, double dx, double dy,
+               const std::vector<double>& x = {}, const std::vector<double>& y = {});
+
+    int row_ptr(int j) const { return row_ptr_[j]; }
+    const int* begin() const { return begin_.data(); }
+    const int* end() const { return end_.data(); }
+
+    /**
+     * @brief Whether node k is active.
+     */
+    bool active(int k) const { return active_.empty() || active_[k] != 0; }
+
+    /**
+     * @brief Whether some nodes are inactive.
+     */
+    bool masked() const { return !active_.empty(); }
+
+    /**
+     * @brief Number of active nodes.
+     */
+    int count() const { return count_; }
+
+private:
+    std::vector<int> row_ptr_;            ///< First run of each row (size ny + 1)
+    std::vector<int> begin_;              ///< First node of each run
+    std::vector<int> end_;                ///< One past the last node of each run
+    std::vector<unsigned char> active_;   ///< Per-node flag (empty when every node is active)
+    int count_ = 0;                       ///< Active nodes
+};
+
+} // namespace ensiie
+
+#endif
@@ -0,0 +1,378 @@
+/**
+ * @file ensemble.cpp
+ * @brief Member-minor packing and stepping of ensembles.
+ */
+
+#include "ensemble.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace ensiie {
+
+EnsembleHeatSolver1D::EnsembleHeatSolver1D(const std::vector<std::unique_ptr<HeatSolver1D>>& members)
+    : k_(static_cast<int>(members.size()))
+    , n_(0)
+    , dt_(0.0)
+    , tmax_(0.0)
+    , t_(0.0)
+{
+    if (members.empty()) throw std::invalid_argument("ensemble needs at least one member");
+    n_ = members[0]->get_n();
+    tmax_ = members[0]->get_tmax();
+    x_ = members[0]->get_x();
+
+    const std::size_t size = static_cast<std::size_t>(n_) * k_;
+    a_.assign(size, 0.0);
+    c_prime_.assign(size, 0.0);
+    inv_den_.assign(size, 0.0);
+    keep_.assign(size, 0.0);
+    b_.assign(size, 0.0);
+    init_.assign(size, 0.0);
+
+    for (int m = 0; m < k_; m++) {
+        const HeatSolver1D& member = *members[m];
+        if (member.get_n() != n_ || member.get_tmax() != tmax_ || member.get_x() != x_) {
+            throw std::invalid_argument("ensemble members must share the grid and tmax");
+        }
+        const LinearStep ls = member.linear_step();
+        if (m == 0) dt_ = ls.dt;
+        if (ls.dt != dt_) throw std::invalid_argument("ensemble members must share the time step");
+
+        // Tridiagonal rows; a wrapped corner means a periodic bar
+        std::vector<double> lower(n_, 0.0), diag(n_, 0.0), upper(n_, 0.0);
+        for (int i = 0; i < n_; i++) {
+            for (int p = ls.A.row_ptr[i]; p < ls.A.row_ptr[i + 1]; p++) {
+                const int j = ls.A.col[p];
+                if (j == i) diag[i] = ls.A.val[p];
+                else if (j == i - 1) lower[i] = ls.A.val[p];
+                else if (j == i + 1) upper[i] = ls.A.val[p];
+                else throw std::invalid_argument("ensemble: periodic bars are not supported");
+            }
+        }
+
+        // Thomas factorisation, once per member
+        inv_den_[m] = 1.0 / diag[0];
+        c_prime_[m] = upper[0] * inv_den_[m];
+        for (int i = 1; i < n_; i++) {
+            const std::size_t q = static_cast<std::size_t>(i) * k_ + m;
+            a_[q] = lower[i];
+            inv_den_[q] = 1.0 / (diag[i] - lower[i] * c_prime_[q - k_]);
+            c_prime_[q] = upper[i] * inv_den_[q];
+        }
+
+        const std::vector<double> u0 = member.get_temperature();
+        for (int i = 0; i < n_; i++) {
+            const std::size_t q = static_cast<std::size_t>(i) * k_ + m;
+            keep_[q] = ls.fixed[i] ? 0.0 : 1.0;
+            b_[q] = ls.b[i];
+            init_[q] = u0[i];
+        }
+
+        for (std::size_t j = 0; j < ls.sources.size(); j++) {
+            if (j == sources_.size()) {
+                sources_.emplace_back(size, 0.0);
+                modulations_.emplace_back(k_);
+            }
+            for (int i = 0; i < n_; i++) sources_[j][static_cast<std::size_t>(i) * k_ + m] = ls.sources[j][i];
+            modulations_[j][m] = ls.modulations[j];
+        }
+    }
+    amplitude_.assign(sources_.size() * k_, 0.0);
+    u_ = init_;
+}
+
+bool EnsembleHeatSolver1D::step() {
+    if (t_ >= tmax_) return false;
+    const int K = k_;
+
+    // Source amplitudes at t + dt
+    for (std::size_t j = 0; j < sources_.size(); j++) {
+        for (int m = 0; m < K; m++) {
+            const auto& mod = modulations_[j][m];
+            amplitude_[j * K + m] = mod ? mod(t_ + dt_) : 1.0;
+        }
+    }
+
+    // Right-hand side and forward substitution in one pass, in place
+    for (int i = 0; i < n_; i++) {
+        const std::size_t row = static_cast<std::size_t>(i) * K;
+        double* u = &u_[row];
+        const double* keep = &keep_[row];
+        const double* b = &b_[row];
+        for (int m = 0; m < K; m++) u[m] = keep[m] * u[m] + b[m];
+        for (std::size_t j = 0; j < sources_.size(); j++) {
+            const double* s = &sources_[j][row];
+            const double* amp = &amplitude_[j * K];
+            for (int m = 0; m < K; m++) u[m] += amp[m] * s[m];
+        }
+
+        const double* inv = &inv_den_[row];
+        if (i == 0) {
+            for (int m = 0; m < K; m++) u[m] *= inv[m];
+        } else {
+            const double* a = &a_[row];
+            const double* prev = u - K;
+            for (int m = 0; m < K; m++) u[m] = (u[m] - a[m] * prev[m]) * inv[m];
+        }
+    }
+
+    // Back substitution
+    for (int i = n_ - 2; i >= 0; i--) {
+        const std::size_t row = static_cast<std::size_t>(i) * K;
+        double* u = &u_[row];
+        const double* next = u + K;
+        const double* cp = &c_prime_[row];
+        for (int m = 0; m < K; m++) u[m] -= cp[m] * next[m];
+    }
+
+    t_ += dt_;
+    return true;
+}
+
+void EnsembleHeatSolver1D::reset() {
+    t_ = 0.0;
+    u_ = init_;
+}
+
+std::vector<double> EnsembleHeatSolver1D::get_temperature(int m) const {
+    std::vector<double> u(n_);
+    for (int i = 0; i < n_; i++) u[i] = u_[static_cast<std::size_t>(i) * k_ + m];
+    return u;
+}
+
+double EnsembleHeatSolver1D::probe(int m, double x) const {
+    int i;
+    double s;
+    grid::locate(x_, x, i, s);
+    return (1.0 - s) * get_temperature(m, i) + s * get_temperature(m, i + 1);
+}
+
+EnsembleHeatSolver2D::EnsembleHeatSolver2D(const std::vector<std::unique_ptr<HeatSolver2D>>& members)
+    : k_(static_cast<int>(members.size()))
+    , kp_((k_ + LANES - 1) / LANES * LANES)
+    , nx_(0)
+    , ny_(0)
+    , dt_(0.0)
+    , tmax_(0.0)
+    , t_(0.0)
+    , sweeps_(0)
+{
+    if (members.empty()) throw std::invalid_argument("ensemble needs at least one member");
+    nx_ = members[0]->get_n();
+    ny_ = members[0]->get_ny();
+    tmax_ = members[0]->get_tmax();
+    x_ = members[0]->get_x();
+    y_ = members[0]->get_y();
+    const int nn = nx_ * ny_;
+    const std::size_t size = static_cast<std::size_t>(nn) * kp_;
+    scale_.assign(2 * kp_, 0.0);
+    omega_.assign(kp_, 1.0);
+    tol_.assign(kp_, 0.0);
+    max_sweeps_.assign(kp_, 0);
+
+    for (int m = 0; m < k_; m++) {
+        const HeatSolver2D& member = *members[m];
+        if (member.get_n() != nx_ || member.get_ny() != ny_ || member.get_tmax() != tmax_ ||
+            member.get_x() != x_ || member.get_y() != y_) {
+            throw std::invalid_argument("ensemble members must share the grid and tmax");
+        }
+        const LinearStep ls = member.linear_step();
+        const CsrMatrix& A = ls.A;
+        if (ls.method != StepMethod::SWEEPS) {
+            throw std::invalid_argument("ensemble plates must be solved by double-precision sweeps");
+        }
+        omega_[m] = ls.omega;
+        tol_[m] = ls.tol;
+        max_sweeps_[m] = ls.max_sweeps;
+
+        if (m == 0) {
+            // Shared pattern and weights: off-diagonal entries of the free
+            // rows, those along x first
+            dt_ = ls.dt;
+            row_ptr_.assign(2 * nn + 1, 0);
+            for (int k = 0; k < nn; k++) {
+                for (int axis = 0; axis < 2; axis++) {
+                    for (int p = A.row_ptr[k]; !ls.fixed[k] && p < A.row_ptr[k + 1]; p++) {
+                        if (A.col[p] == k || (A.col[p] / nx_ != k / nx_) != (axis == 1)) continue;
+                        col_.push_back(A.col[p]);
+                        weight_.push_back(A.val[p]);
+                    }
+                    row_ptr_[2 * k + axis + 1] = static_cast<int>(col_.size());
+                }
+                if (!ls.fixed[k]) free_.push_back(k);
+            }
+            inv_diag_.assign(size, 0.0);
+            keep_.assign(size, 0.0);
+            b_.assign(size, 0.0);
+            init_.assign(size, 0.0);
+        }
+        if (ls.dt != dt_) throw std::invalid_argument("ensemble members must share the time step");
+
+        // Scale of each axis from its first coupling, then every coupling
+        // must follow it (to rounding)
+        bool scaled[2] = {false, false};
+        for (int k = 0; k < nn; k++) {
+            const std::size_t q = index(m, k);
+            if (m > 0 && (ls.fixed[k] != 0) != (keep_[index(0, k)] == 0.0)) {
+                throw std::invalid_argument("ensemble members must share the fixed nodes");
+            }
+            keep_[q] = ls.fixed[k] ? 0.0 : 1.0;
+            b_[q] = ls.b[k];
+            if (ls.fixed[k]) continue;
+
+            int found = 0;
+            for (int p = A.row_ptr[k]; p < A.row_ptr[k + 1]; p++) {
+                if (A.col[p] == k) {
+                    inv_diag_[q] = 1.0 / A.val[p];
+                    continue;
+                }
+                const int axis = A.col[p] / nx_ == k / nx_ ? 0 : 1;
+                const auto first = col_.begin() + row_ptr_[2 * k + axis];
+                const auto last = col_.begin() + row_ptr_[2 * k + axis + 1];
+                const auto e = std::find(first, last, A.col[p]);
+                if (e == last) throw std::invalid_argument("ensemble members must share the matrix pattern");
+                const double weight = weight_[e - col_.begin()];
+                double& scale = scale_[axis * kp_ + m];
+                if (!scaled[axis] && weight != 0.0) {
+                    scale = A.val[p] / weight;
+                    scaled[axis] = true;
+                }
+                if (std::abs(A.val[p] - scale * weight) > 1e-6 * std::abs(A.val[p])) {
+                    throw std::invalid_argument("ensemble members must differ only by material, edge values and sources");
+                }
+                found++;
+            }
+            if (found != row_ptr_[2 * k + 2] - row_ptr_[2 * k]) {
+                throw std::invalid_argument("ensemble members must share the matrix pattern");
+            }
+        }
+
+        int k = 0;
+        for (const std::vector<double>& row : member.get_temperature_2d()) {
+            for (double v : row) init_[index(m, k++)] = v;
+        }
+
+        for (std::size_t j = 0; j < ls.sources.size(); j++) {
+            if (j == sources_.size()) {
+                sources_.emplace_back(size, 0.0);
+                modulations_.emplace_back(k_);
+            }
+            for (int k = 0; k < nn; k++) sources_[j][index(m, k)] = ls.sources[j][k];
+            modulations_[j][m] = ls.modulations[j];
+        }
+    }
+    amplitude_.assign(sources_.size() * kp_, 0.0);
+    rhs_.assign(size, 0.0);
+    u_ = init_;
+}
+
+bool EnsembleHeatSolver2D::step() {
+    if (t_ >= tmax_) return false;
+    const std::size_t size = u_.size();
+    const std::size_t nn = static_cast<std::size_t>(nx_) * ny_;
+
+    for (std::size_t j = 0; j < sources_.size(); j++) {
+        for (int m = 0; m < k_; m++) {
+            const auto& mod = modulations_[j][m];
+            amplitude_[j * kp_ + m] = mod ? mod(t_ + dt_) : 1.0;
+        }
+    }
+
+    // Right-hand side D·uⁿ + b + Σ a_j·s_j; fixed nodes take their value now
+    for (std::size_t q = 0; q < size; q++) rhs_[q] = keep_[q] * u_[q] + b_[q];
+    for (std::size_t j = 0; j < sources_.size(); j++) {
+        for (int l = 0; l < kp_; l += LANES) {
+            const double* amp = &amplitude_[j * kp_ + l];
+            const double* s = &sources_[j][index(l, 0)];
+            double* rhs = &rhs_[index(l, 0)];
+            for (std::size_t q = 0; q < nn * LANES; q += LANES) {
+                for (int m = 0; m < LANES; m++) rhs[q + m] += amp[m] * s[q + m];
+            }
+        }
+    }
+    for (std::size_t q = 0; q < size; q++) {
+        if (keep_[q] == 0.0) u_[q] = rhs_[q];
+    }
+
+    sweeps_ = 0;
+    for (int l = 0; l < kp_; l += LANES) sweeps_ = std::max(sweeps_, relax(l));
+
+    t_ += dt_;
+    return true;
+}
+
+int EnsembleHeatSolver2D::relax(int first) {
+    // Padding members have a zero diagonal inverse and stay at zero
+    bool live[LANES];
+    double sx[LANES], sy[LANES], omega[LANES];
+    int most = 0;
+    for (int m = 0; m < LANES; m++) {
+        live[m] = first + m < k_;
+        sx[m] = scale_[first + m];
+        sy[m] = scale_[kp_ + first + m];
+        omega[m] = omega_[first + m];
+        most = std::max(most, max_sweeps_[first + m]);
+    }
+    const double* rhs = &rhs_[index(first, 0)];
+    const double* inv = &inv_diag_[index(first, 0)];
+    double* u = &u_[index(first, 0)];
+
+    int sweep = 1;
+    for (; sweep <= most; sweep++) {
+        double change[LANES] = {};
+        for (int k : free_) {
+            const std::size_t row = static_cast<std::size_t>(k) * LANES;
+            double along_x[LANES] = {}, along_y[LANES] = {};
+            for (int p = row_ptr_[2 * k]; p < row_ptr_[2 * k + 1]; p++) {
+                const double w = weight_[p];
+                const double* v = &u[static_cast<std::size_t>(col_[p]) * LANES];
+                for (int m = 0; m < LANES; m++) along_x[m] += w * v[m];
+            }
+            for (int p = row_ptr_[2 * k + 1]; p < row_ptr_[2 * k + 2]; p++) {
+                const double w = weight_[p];
+                const double* v = &u[static_cast<std::size_t>(col_[p]) * LANES];
+                for (int m = 0; m < LANES; m++) along_y[m] += w * v[m];
+            }
+            const double* r = &rhs[row];
+            const double* d = &inv[row];
+            double* x = &u[row];
+            for (int m = 0; m < LANES; m++) {
+                // Gauss–Seidel target, over-relaxed as the member's stencil does
+                const double target = (r[m] - sx[m] * along_x[m] - sy[m] * along_y[m]) * d[m];
+                const double next = omega[m] == 1.0 ? target : x[m] + omega[m] * (target - x[m]);
+                change[m] = std::max(change[m], std::abs(next - x[m]));
+                x[m] = live[m] ? next : x[m];
+            }
+        }
+        bool running = false;
+        for (int m = 0; m < LANES; m++) {
+            live[m] = live[m] && change[m] >= tol_[first + m] && sweep < max_sweeps_[first + m];
+            running = running || live[m];
+        }
+        if (!running) break;
+    }
+    return std::min(sweep, most);
+}
+
+void EnsembleHeatSolver2D::reset() {
+    t_ = 0.0;
+    u_ = init_;
+}
+
+std::vector<double> EnsembleHeatSolver2D::get_temperature(int m) const {
+    std::vector<double> u(static_cast<std::size_t>(nx_) * ny_);
+    for (std::size_t k = 0; k < u.size(); k++) u[k] = u_[index(m, static_cast<int>(k))];
+    return u;
+}
+
+double EnsembleHeatSolver2D::probe(int m, double x, double y) const {
+    int i, j;
+    double s, r;
+    grid::locate(x_, x, i, s);
+    grid::locate(y_, y, j, r);
+    return (1.0 - r) * ((1.0 - s) * get_temperature(m, i, j) + s * get_temperature(m, i + 1, j))
+         + r * ((1.0 - s) * get_temperature(m, i, j + 1) + s * get_temperature(m, i + 1, j + 1));
+}
+
+} // namespace ensiie
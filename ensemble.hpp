@@ -0,0 +1,238 @@
+/**
+ * @file ensemble.hpp
+ * @brief Batched solvers advancing many parameter sets of one grid together.
+ *
+ * An ensemble holds K members sharing a grid and a time step but not
+ * their material, edge values or sources. Fields are stored member-minor
+ * (cell-major): the K values of node i are contiguous at [i·K, i·K + K),
+ * so every loop over nodes has an inner loop over members with unit
+ * stride, which the compiler vectorises, and the index structure is
+ * walked once per step for all members.
+ *
+ * Members are described by ordinary solvers: their LinearStep gives the
+ * discretisation (edges, stretched grids, radial geometry), so an
+ * ensemble member follows exactly the same step as the solver it was
+ * built from.
+ */
+
+#ifndef ENSEMBLE_HPP
+#define ENSEMBLE_HPP
+
+#include "heat_equation_solver.hpp"
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace ensiie {
+
+/**
+ * @class EnsembleHeatSolver1D
+ * @brief K bars stepped together by a member-minor Thomas algorithm.
+ *
+ * Restricted to linear, non-periodic bars (LinearStep): no phase change,
+ * no radiative or time-dependent edges, no moving sources.
+ */
+class EnsembleHeatSolver1D {
+public:
+    /**
+     * @brief Pack the members' steps and initial fields.
+     *
+     * @param members Solvers on the same grid with the same tmax
+     * @throws std::invalid_argument if there is no member, the grids or
+     *         time steps differ, a bar is periodic or a step is not linear
+     */
+    explicit EnsembleHeatSolver1D(const std::vector<std::unique_ptr<HeatSolver1D>>& members);
+
+    /**
+     * @brief Advance every member by one time step.
+     * @return false once tmax is reached
+     */
+    bool step();
+
+    /**
+     * @brief Return every member to its initial temperature.
+     */
+    void reset();
+
+    double get_time() const { return t_; }
+    double get_tmax() const { return tmax_; }
+
+    /**
+     * @brief Number of members K.
+     */
+    int size() const { return k_; }
+
+    int get_n() const { return n_; }
+    const std::vector<double>& get_x() const { return x_; }
+
+    /**
+     * @brief Temperature of member m at node i [K].
+     */
+    double get_temperature(int m, int i) const { return u_[i * k_ + m]; }
+
+    /**
+     * @brief Temperature field of member m [K].
+     */
+    std::vector<double> get_temperature(int m) const;
+
+    /**
+     * @brief Temperature of member m at x, linearly interpolated [K].
+     */
+    double probe(int m, double x) const;
+
+private:
+    int k_;                 /**< Members */
+    int n_;                 /**< Grid points */
+    double dt_;             /**< Time step */
+    double tmax_;           /**< Final time */
+    double t_;              /**< Current time */
+    std::vector<double> x_; /**< Node coordinates */
+
+    std::vector<double> a_;        /**< Sub-diagonal of each member, member-minor */
+    std::vector<double> c_prime_;  /**< Modified super-diagonal of the Thomas algorithm */
+    std::vector<double> inv_den_;  /**< Inverse pivots of the Thomas algorithm */
+    std::vector<double> keep_;     /**< D: 1 on free nodes, 0 on fixed ones */
+    std::vector<double> b_;        /**< Edge terms and imposed values */
+    std::vector<double> init_;     /**< Initial fields */
+    std::vector<double> u_;        /**< Current fields */
+
+    std::vector<std::vector<double>> sources_;  /**< Footprint j of every member (zero if it has fewer) */
+    std::vector<std::vector<std::function<double(double)>>> modulations_;  /**< a_j(t) per source and member */
+    std::vector<double> amplitude_;  /**< Work: a_j(t) per source and member */
+};
+
+/**
+ * @class EnsembleHeatSolver2D
+ * @brief K plates relaxed together by member-minor Gauss–Seidel sweeps.
+ *
+ * The members share the grid, edge kinds and mask, hence the pattern of
+ * their step matrix. Their couplings are shared geometric weights scaled
+ * by the member's αx·Δt along x and αy·Δt along y, so the pattern and the
+ * weights are stored once; only the diagonal, the fields and the sources
+ * are per member. Members are grouped in lanes of LANES (the last one
+ * padded), each stored node by node with its LANES values contiguous, so
+ * a sweep updates a lane with fixed-width unit-stride loops.
+ *
+ * Members do not interact, so each lane is relaxed on its own. Sweeps
+ * follow the lexicographic order of the plate solvers. Each member takes
+ * the relaxation factor, tolerance and sweep limit of its solver
+ * (LinearStep): it stops updating after the sweep whose largest update
+ * falls below its tolerance or that reaches its limit, so every member
+ * follows the iterations of its solver.
+ *
+ * Restricted to linear plates (LinearStep) solved by double-precision
+ * Gauss–Seidel or SOR sweeps: no phase change, no radiative or
+ * time-dependent edges, no moving sources, no float, mixed-precision or
+ * Krylov solvers.
+ */
+class EnsembleHeatSolver2D {
+public:
+    /// Members updated by one fixed-width inner loop
+    static constexpr int LANES = 8;
+
+    /**
+     * @brief Pack the members' steps and initial fields.
+     *
+     * @param members Solvers on the same grid with the same tmax
+     * @throws std::invalid_argument if there is no member, the grids,
+     *         time steps or matrix patterns differ, the couplings are not
+     *         the same weights scaled per axis, a step is not linear or a
+     *         solver does not relax it in double precision
+     */
+    explicit EnsembleHeatSolver2D(const std::vector<std::unique_ptr<HeatSolver2D>>& members);
+
+    /**
+     * @brief Advance every member by one time step.
+     * @return false once tmax is reached
+     */
+    bool step();
+
+    /**
+     * @brief Return every member to its initial temperature.
+     */
+    void reset();
+
+    double get_time() const { return t_; }
+    double get_tmax() const { return tmax_; }
+
+    /**
+     * @brief Number of members K.
+     */
+    int size() const { return k_; }
+
+    int get_n() const { return nx_; }
+    int get_ny() const { return ny_; }
+    const std::vector<double>& get_x() const { return x_; }
+    const std::vector<double>& get_y() const { return y_; }
+
+    /**
+     * @brief Temperature of member m at node (i, j) [K].
+     */
+    double get_temperature(int m, int i, int j) const {
+        return u_[index(m, j * nx_ + i)];
+    }
+
+    /**
+     * @brief Temperature field of member m, row-major (k = j·nx + i) [K].
+     */
+    std::vector<double> get_temperature(int m) const;
+
+    /**
+     * @brief Temperature of member m at (x, y), bilinearly interpolated [K].
+     */
+    double probe(int m, double x, double y) const;
+
+    /**
+     * @brief Sweeps taken by the last step (by its slowest lane).
+     */
+    int last_sweeps() const { return sweeps_; }
+
+private:
+    int k_;                 /**< Members */
+    int kp_;                /**< Members padded to whole lanes */
+    int nx_;                /**< Grid points along x */
+    int ny_;                /**< Grid points along y */
+    double dt_;             /**< Time step */
+    double tmax_;           /**< Final time */
+    double t_;              /**< Current time */
+    int sweeps_;            /**< Sweeps of the last step */
+    std::vector<double> x_; /**< Node coordinates along x */
+    std::vector<double> y_; /**< Node coordinates along y */
+
+    std::vector<int> free_;     /**< Free nodes, in sweep order */
+    std::vector<int> row_ptr_;  /**< Shared pattern: row k couples along x over [2k, 2k+1), along y over [2k+1, 2k+2) */
+    std::vector<int> col_;      /**< Shared pattern: column of each entry (diagonal excluded) */
+    std::vector<double> weight_;  /**< Shared couplings of member 0 */
+    std::vector<double> scale_;   /**< Coupling of each member relative to member 0: [axis·kp + m] */
+    std::vector<double> omega_;   /**< Relaxation factor of each member's solver (1: Gauss–Seidel) */
+    std::vector<double> tol_;     /**< Largest update at which each member stops [K] */
+    std::vector<int> max_sweeps_; /**< Sweeps per step of each member at most (0: padding) */
+    std::vector<double> inv_diag_;  /**< Inverse diagonal of each member (fields below: index()) */
+    std::vector<double> keep_;  /**< D: 1 on free nodes, 0 on fixed ones */
+    std::vector<double> b_;     /**< Edge terms and imposed values */
+    std::vector<double> init_;  /**< Initial fields */
+    std::vector<double> u_;     /**< Current fields */
+    std::vector<double> rhs_;   /**< Work: right-hand side of the step */
+
+    std::vector<std::vector<double>> sources_;  /**< Footprint j of every member (zero if it has fewer) */
+    std::vector<std::vector<std::function<double(double)>>> modulations_;  /**< a_j(t) per source and member */
+    std::vector<double> amplitude_;  /**< Work: a_j(t) per source and member */
+
+    /**
+     * @brief Position of member m at node k: lane-major, member-minor.
+     */
+    std::size_t index(int m, int k) const {
+        return (static_cast<std::size_t>(m / LANES) * nx_ * ny_ + k) * LANES + m % LANES;
+    }
+
+    /**
+     * @brief Gauss–Seidel or SOR sweeps of the lane of member `first`
+     *        until its members converge or reach their limit.
+     * @return Sweeps taken
+     */
+    int relax(int first);
+};
+
+} // namespace ensiie
+
+#endif
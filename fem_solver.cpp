@@ -0,0 +1,323 @@
+/**
+ * @file fem_solver.cpp
+ * @brief Assembly and time stepping of the triangle mesh solver.
+ */
+
+#include "fem_solver.hpp"
+#include "parallel.hpp"
+#include "profile.hpp"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+namespace ensiie {
+
+namespace {
+
+constexpr double KELVIN_OFFSET = 273.15;
+
+/**
+ * @brief Edge length [m].
+ */
+double edge_length(const TriMesh& mesh, const MeshEdge& e) {
+    return std::hypot(mesh.x[e.b] - mesh.x[e.a], mesh.y[e.b] - mesh.y[e.a]);
+}
+
+} // namespace
+
+FemHeatSolver::FemHeatSolver(
+    const Material& mat,
+    TriMesh mesh,
+    double tmax,
+    double u0,
+    std::vector<BoundaryCondition> bc,
+    bool reorder
+)
+    : mat_(mat)
+    , mesh_(std::move(mesh))
+    , tmax_(tmax)
+    , dt_(tmax / 1000.0)
+    , u0_kelvin_(u0 + KELVIN_OFFSET)
+    , t_(0.0)
+    , bc_(std::move(bc))
+{
+    if (mat_.changes_phase()) {
+        throw std::invalid_argument("phase change is not supported on triangle meshes");
+    }
+    for (const BoundaryCondition& c : bc_) {
+        if (c.kind == BoundaryKind::PERIODIC) {
+            throw std::invalid_argument("periodic conditions are not supported on triangle meshes");
+        }
+        if (c.is_radiative()) {
+            throw std::invalid_argument("radiative conditions are not supported on triangle meshes");
+        }
+    }
+    mesh_.validate();
+    for (const MeshEdge& e : mesh_.edges) {
+        if (e.tag >= static_cast<int>(bc_.size())) {
+            throw std::invalid_argument("mesh edge tag has no boundary condition");
+        }
+    }
+
+    order_.resize(mesh_.nodes());
+    std::iota(order_.begin(), order_.end(), 0);
+    if (reorder) {
+        order_ = mesh_.rcm_order();
+        mesh_.renumber(order_);
+    }
+
+    u_.assign(mesh_.nodes(), u0_kelvin_);
+    rhs_.resize(mesh_.nodes());
+    solver_ = KrylovSolver(assemble(), KrylovOptions());
+}
+
+CsrMatrix FemHeatSolver::assemble() {
+    const int n = mesh_.nodes();
+    const double coef = dt_ / (mat_.rho * mat_.c);
+    const double lx = mat_.lambda;
+    const double ly = mat_.conductivity_y();
+
+    // Triangles around each node
+    std::vector<int> tri_ptr(n + 1, 0);
+    for (const auto& t : mesh_.tri) {
+        for (int v : t) tri_ptr[v + 1]++;
+    }
+    for (int i = 0; i < n; i++) tri_ptr[i + 1] += tri_ptr[i];
+    std::vector<int> tri_list(tri_ptr[n]);
+    {
+        std::vector<int> fill(tri_ptr.begin(), tri_ptr.end() - 1);
+        for (int t = 0; t < mesh_.triangles(); t++) {
+            for (int v : mesh_.tri[t]) tri_list[fill[v]++] = t;
+        }
+    }
+
+    // Neighbours of node i: the vertices of its triangles
+    auto neighbours = [&](int i, std::vector<int>& cols) {
+        cols.clear();
+        for (int k = tri_ptr[i]; k < tri_ptr[i + 1]; k++) {
+            for (int v : mesh_.tri[tri_list[k]]) cols.push_back(v);
+        }
+        std::sort(cols.begin(), cols.end());
+        cols.erase(std::unique(cols.begin(), cols.end()), cols.end());
+    };
+
+    CsrMatrix A;
+    A.n = n;
+    A.row_ptr.assign(n + 1, 0);
+    parallel::for_range(n, [&](int begin, int end) {
+        std::vector<int> cols;
+        for (int i = begin; i < end; i++) {
+            neighbours(i, cols);
+            A.row_ptr[i + 1] = static_cast<int>(cols.size());
+        }
+    });
+    for (int i = 0; i < n; i++) A.row_ptr[i + 1] += A.row_ptr[i];
+    A.col.resize(A.row_ptr[n]);
+    A.val.assign(A.row_ptr[n], 0.0);
+    mass_.assign(n, 0.0);
+
+    // Row i sums the element matrices of the triangles around node i
+    parallel::for_range(n, [&](int begin, int end) {
+        std::vector<int> cols;
+        for (int i = begin; i < end; i++) {
+            neighbours(i, cols);
+            std::copy(cols.begin(), cols.end(), A.col.begin() + A.row_ptr[i]);
+
+            for (int k = tri_ptr[i]; k < tri_ptr[i + 1]; k++) {
+                const int t = tri_list[k];
+                const auto& v = mesh_.tri[t];
+                const double area = mesh_.area(t);
+                double b[3], c[3];
+                for (int a = 0; a < 3; a++) {
+                    const int p = v[(a + 1) % 3], q = v[(a + 2) % 3];
+                    b[a] = mesh_.y[p] - mesh_.y[q];
+                    c[a] = mesh_.x[q] - mesh_.x[p];
+                }
+                const int li = (v[0] == i) ? 0 : (v[1] == i) ? 1 : 2;
+                for (int lj = 0; lj < 3; lj++) {
+                    double kij = (lx * b[li] * b[lj] + ly * c[li] * c[lj]) / (4.0 * area);
+                    A.val[A.find(i, v[lj])] += coef * kij;
+                }
+                mass_[i] += area / 3.0;
+            }
+            A.val[A.find(i, i)] += mass_[i];
+        }
+    });
+
+    // Neumann and Robin edges: half of the edge on each node
+    edge_load_.assign(n, 0.0);
+    std::vector<int> dirichlet_tag(n, -1);
+    for (const MeshEdge& e : mesh_.edges) {
+        const BoundaryCondition& c = bc_[e.tag];
+        const double half = 0.5 * edge_length(mesh_, e);
+        for (int v : {e.a, e.b}) {
+            if (c.kind == BoundaryKind::NEUMANN) {
+                edge_load_[v] += half * c.flux;
+            } else if (c.kind == BoundaryKind::ROBIN) {
+                A.val[A.find(v, v)] += coef * half * c.h;
+                edge_load_[v] += half * c.h * (c.t_inf + KELVIN_OFFSET);
+            } else {
+                dirichlet_tag[v] = e.tag;
+            }
+        }
+    }
+
+    // Dirichlet nodes: identity rows, columns moved to the right-hand side
+    dirichlet_.clear();
+    lift_.clear();
+    for (int i = 0; i < n; i++) {
+        if (dirichlet_tag[i] >= 0) dirichlet_.emplace_back(i, dirichlet_tag[i]);
+    }
+    for (int i = 0; i < n; i++) {
+        for (int k = A.row_ptr[i]; k < A.row_ptr[i + 1]; k++) {
+            const int j = A.col[k];
+            if (dirichlet_tag[i] >= 0) {
+                A.val[k] = (j == i) ? 1.0 : 0.0;
+            } else if (dirichlet_tag[j] >= 0) {
+                lift_.push_back({i, j, A.val[k]});
+                A.val[k] = 0.0;
+            }
+        }
+    }
+    return A;
+}
+
+void FemHeatSolver::set_time_step(double dt) {
+    if (!(dt > 0.0)) throw std::invalid_argument("time step must be positive");
+    dt_ = dt;
+    solver_ = KrylovSolver(assemble(), solver_.options());
+}
+
+void FemHeatSolver::set_krylov(const KrylovOptions& options) {
+    solver_ = KrylovSolver(solver_.matrix(), options);
+}
+
+int FemHeatSolver::locate(double x, double y, double w[3]) const {
+    for (int t = 0; t < mesh_.triangles(); t++) {
+        const auto& v = mesh_.tri[t];
+        const double area = mesh_.area(t);
+        for (int a = 0; a < 3; a++) {
+            const int p = v[(a + 1) % 3], q = v[(a + 2) % 3];
+            w[a] = 0.5 * ((mesh_.x[q] - mesh_.x[p]) * (y - mesh_.y[p])
+                        - (mesh_.y[q] - mesh_.y[p]) * (x - mesh_.x[p])) / area;
+        }
+        const double eps = -1e-12;
+        if (w[0] >= eps && w[1] >= eps && w[2] >= eps) return t;
+    }
+    return -1;
+}
+
+void FemHeatSolver::footprint(const HeatSource& s, double ox, double oy, Load& load) const {
+    load.index.clear();
+    load.weight.clear();
+    load.amplitude = s.amplitude;
+    const double cx = s.x0 + ox;
+    const double cy = s.y0 + oy;
+
+    if (s.shape == SourceShape::POINT) {
+        double w[3];
+        const int t = locate(cx, cy, w);
+        if (t < 0) return;
+        for (int a = 0; a < 3; a++) {
+            load.index.push_back(mesh_.tri[t][a]);
+            load.weight.push_back(s.intensity * w[a]);
+        }
+        return;
+    }
+
+    for (int i = 0; i < mesh_.nodes(); i++) {
+        double q;
+        if (s.shape == SourceShape::BOX) {
+            if (mesh_.x[i] < cx || mesh_.x[i] > s.x1 + ox
+                || mesh_.y[i] < cy || mesh_.y[i] > s.y1 + oy) continue;
+            q = s.intensity;
+        } else {
+            const double rx = (mesh_.x[i] - cx) / s.sigma;
+            const double ry = (mesh_.y[i] - cy) / s.sigma;
+            const double r2 = rx * rx + ry * ry;
+            if (r2 > GAUSSIAN_CUTOFF * GAUSSIAN_CUTOFF) continue;
+            q = s.intensity * std::exp(-0.5 * r2);
+        }
+        load.index.push_back(i);
+        load.weight.push_back(mass_[i] * q);
+    }
+}
+
+void FemHeatSolver::set_sources(const std::vector<HeatSource>& sources) {
+    loads_.clear();
+    for (const HeatSource& s : sources) {
+        if (s.shape == SourceShape::BOX && (s.x1 < s.x0 || s.y1 < s.y0)) {
+            throw std::invalid_argument("heat source box has a negative extent");
+        }
+        if (s.shape == SourceShape::GAUSSIAN && !(s.sigma > 0.0)) {
+            throw std::invalid_argument("gaussian heat source needs sigma > 0");
+        }
+        loads_.emplace_back();
+        footprint(s, 0.0, 0.0, loads_.back());
+    }
+}
+
+void FemHeatSolver::set_moving_sources(const std::vector<MovingSource>& sources) {
+    moving_ = sources;
+}
+
+bool FemHeatSolver::step() {
+    if (t_ >= tmax_) return false;
+    PROFILE_ZONE("step fem");
+
+    const int n = mesh_.nodes();
+    const double tn = t_ + dt_;
+    const double coef = dt_ / (mat_.rho * mat_.c);
+
+    parallel::for_range(n, [&](int begin, int end) {
+        for (int i = begin; i < end; i++) rhs_[i] = mass_[i] * u_[i] + coef * edge_load_[i];
+    });
+
+    auto add = [&](const Load& load) {
+        const double a = coef * (load.amplitude ? load.amplitude(tn) : 1.0);
+        if (a == 0.0) return;
+        for (std::size_t m = 0; m < load.index.size(); m++) {
+            rhs_[load.index[m]] += a * load.weight[m];
+        }
+    };
+    for (const Load& load : loads_) add(load);
+    for (const MovingSource& mov : moving_) {
+        const auto centre = mov.path(tn);
+        footprint(mov.footprint, centre.first, centre.second, scratch_);
+        add(scratch_);
+    }
+
+    // Edge temperatures are imposed at t + dt; they also start the iteration
+    for (const auto& d : dirichlet_) {
+        u_[d.first] = bc_[d.second].value_at(tn) + KELVIN_OFFSET;
+        rhs_[d.first] = u_[d.first];
+    }
+    for (const Lift& l : lift_) rhs_[l.row] -= l.value * u_[l.col];
+
+    stats_ = solver_.solve(rhs_, u_);
+    t_ = tn;
+    return true;
+}
+
+void FemHeatSolver::reset() {
+    t_ = 0.0;
+    std::fill(u_.begin(), u_.end(), u0_kelvin_);
+    stats_ = SolveStats();
+}
+
+std::vector<double> FemHeatSolver::get_temperature() const {
+    std::vector<double> u(u_.size());
+    for (std::size_t k = 0; k < u_.size(); k++) u[order_[k]] = u_[k];
+    return u;
+}
+
+double FemHeatSolver::probe(double x, double y) const {
+    double w[3];
+    const int t = locate(x, y, w);
+    if (t < 0) return -1.0;
+    const auto& v = mesh_.tri[t];
+    return w[0] * u_[v[0]] + w[1] * u_[v[1]] + w[2] * u_[v[2]];
+}
+
+} // namespace ensiie
@@ -0,0 +1,124 @@
+/**
+ * @file grid.cpp
+ * @brief Uniform and stretched node coordinates.
+ */
+
+#include "grid.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace ensiie {
+
+namespace grid {
+
+namespace {
+
+/// Samples of the density per grid interval used to place the nodes
+constexpr int SAMPLES_PER_CELL = 32;
+
+/**
+ * @brief Distance from x to the nearest region (0 inside one).
+ */
+double distance(double x, const std::vector<Region>& regions) {
+    double d = HUGE_VAL;
+    for (const Region& r : regions) {
+        if (x < r.first) d = std::min(d, r.first - x);
+        else if (x > r.second) d = std::min(d, x - r.second);
+        else return 0.0;
+    }
+    return d;
+}
+
+} // namespace
+
+void check(const std::vector<double>& x) {
+    if (x.size() < 3) {
+        throw std::invalid_argument("a grid needs at least 3 coordinates");
+    }
+    if (x.front() != 0.0) {
+        throw std::invalid_argument("grid coordinates must start at 0");
+    }
+    for (std::size_t i = 1; i < x.size(); i++) {
+        if (!(x[i] > x[i - 1])) {
+            throw std::invalid_argument("grid coordinates must be strictly increasing");
+        }
+    }
+}
+
+std::vector<double> uniform(double L, int n) {
+    if (n < 3 || !(L > 0.0)) {
+        throw std::invalid_argument("a grid needs L > 0 and at least 3 nodes");
+    }
+    std::vector<double> x(n);
+    double h = L / (n - 1);
+    for (int i = 0; i < n; i++) x[i] = i * h;
+    x[n - 1] = L;
+    return x;
+}
+
+std::vector<double> refined(double L, int n, const std::vector<Region>& regions,
+                            double ratio, double blend) {
+    if (n < 3 || !(L > 0.0)) {
+        throw std::invalid_argument("a grid needs L > 0 and at least 3 nodes");
+    }
+    if (!(ratio >= 1.0)) {
+        throw std::invalid_argument("grid stretch ratio must be at least 1");
+    }
+    if (regions.empty() || ratio == 1.0) return uniform(L, n);
+    if (!(blend > 0.0)) blend = L / 20.0;
+
+    // Cumulative integral of the density on a fine uniform sampling
+    const int m = SAMPLES_PER_CELL * (n - 1);
+    const double h = L / m;
+    std::vector<double> cumul(m + 1, 0.0);
+    double w_prev = 0.0;
+    for (int k = 0; k <= m; k++) {
+        double d = distance(k * h, regions) / blend;
+        double w = 1.0 + (ratio - 1.0) * std::exp(-d * d);
+        if (k > 0) cumul[k] = cumul[k - 1] + 0.5 * h * (w_prev + w);
+        w_prev = w;
+    }
+
+    // Node i sits where the integral reaches i / (n - 1) of the total
+    std::vector<double> x(n);
+    int k = 0;
+    for (int i = 0; i < n - 1; i++) {
+        double target = cumul[m] * i / (n - 1);
+        while (k < m && cumul[k + 1] < target) k++;
+        double s = (target - cumul[k]) / (cumul[k + 1] - cumul[k]);
+        x[i] = (k + s) * h;
+    }
+    x[0] = 0.0;
+    x[n - 1] = L;
+    return x;
+}
+
+std::vector<Region> source_regions(const std::vector<HeatSource>& sources, bool along_y) {
+    std::vector<Region> regions;
+    regions.reserve(sources.size());
+    for (const HeatSource& s : sources) {
+        double lo = along_y ? s.y0 : s.x0;
+        double hi = along_y ? s.y1 : s.x1;
+        if (s.shape == SourceShape::GAUSSIAN) {
+            double cut = GAUSSIAN_CUTOFF * s.sigma;
+            regions.emplace_back(lo - cut, lo + cut);
+        } else if (s.shape == SourceShape::POINT) {
+            regions.emplace_back(lo, lo);
+        } else {
+            regions.emplace_back(lo, hi);
+        }
+    }
+    return regions;
+}
+
+void locate(const std::vector<double>& x, double p, int& i, double& s) {
+    const int n = static_cast<int>(x.size());
+    i = static_cast<int>(std::upper_bound(x.begin(), x.end(), p) - x.begin()) - 1;
+    i = std::clamp(i, 0, n - 2);
+    s = std::clamp((p - x[i]) / (x[i + 1] - x[i]), 0.0, 1.0);
+}
+
+} // namespace grid
+
+} // namespace ensiie
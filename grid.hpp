@@ -0,0 +1,88 @@
+/**
+ * @file grid.hpp
+ * @brief Node coordinates of uniform and stretched (non-uniform) grids.
+ *
+ * The solvers default to uniform spacing. A stretched grid is given as
+ * the list of node coordinates along each axis (a tensor product in 2D),
+ * either supplied directly or generated by refined(), which clusters the
+ * nodes around regions of steep gradients (heat sources, Dirichlet edges)
+ * and coarsens them elsewhere.
+ *
+ * Conventions:
+ * - Coordinates are strictly increasing and start at 0; the last one is
+ *   the domain length
+ * - On a periodic axis the last coordinate closes the period: it is the
+ *   same point as x[0] and is not an unknown, so n + 1 coordinates give
+ *   n nodes
+ */
+
+#ifndef GRID_HPP
+#define GRID_HPP
+
+#include "source.hpp"
+#include <utility>
+#include <vector>
+
+namespace ensiie {
+
+/**
+ * @namespace grid
+ * @brief Node coordinate generators.
+ */
+namespace grid {
+
+/// Interval [lo, hi] of an axis [m]
+using Region = std::pair<double, double>;
+
+/// Default ratio between the coarsest and the finest spacing of refined()
+constexpr double DEFAULT_STRETCH = 4.0;
+
+/**
+ * @brief Check a list of node coordinates.
+ * @throws std::invalid_argument if there are fewer than 3 coordinates, if
+ *         they do not start at 0 or are not strictly increasing
+ */
+void check(const std::vector<double>& x);
+
+/**
+ * @brief n coordinates with uniform spacing over [0, L].
+ */
+std::vector<double> uniform(double L, int n);
+
+/**
+ * @brief n coordinates over [0, L] clustered around some regions.
+ *
+ * The nodes equidistribute the density
+ * w(x) = 1 + (ratio - 1)·exp(-(d(x) / blend)²), where d(x) is the
+ * distance from x to the nearest region, so the spacing inside the
+ * regions is about `ratio` times finer than far from them and varies
+ * smoothly in between.
+ *
+ * @param regions Intervals to refine (a point region [a, a] is allowed)
+ * @param ratio Coarsest to finest spacing (>= 1)
+ * @param blend Width of the transition [m] (<= 0: L / 20)
+ * @throws std::invalid_argument if n < 3, L <= 0 or ratio < 1
+ */
+std::vector<double> refined(double L, int n, const std::vector<Region>& regions,
+                            double ratio = DEFAULT_STRETCH, double blend = 0.0);
+
+/**
+ * @brief Extent of heat sources along x (or y) as refinement regions.
+ *
+ * Boxes give their interval, Gaussians their 3σ support and points a
+ * single coordinate.
+ */
+std::vector<Region> source_regions(const std::vector<HeatSource>& sources, bool along_y = false);
+
+/**
+ * @brief Interval [x[i], x[i+1]] holding p and the position s of p in it.
+ *
+ * Points outside the nodes are clamped to the first or last node.
+ */
+void locate(const std::vector<double>& x, double p, int& i, double& s);
+
+} // namespace grid
+
+} // namespace ensiie
+
+#endif
@@ -4,25 +4,426 @@
  */
 
 #include "heat_equation_solver.hpp"
+#include "profile.hpp"
 #include <cmath>
 #include <algorithm>
+#include <chrono>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 /// Conversion from Celsius to Kelvin
 constexpr double KELVIN_OFFSET = 273.15;
 
+/// Maximum number of relaxation sweeps per plate step (per refinement pass in mixed precision)
+constexpr int MAX_SWEEPS = 100;
+
+/// Largest sweep update at which the plate sweeps stop [K]
+constexpr double SWEEP_TOL = 1e-6;
+
+/// Maximum number of mixed-precision refinement passes per step
+constexpr int MAX_REFINE = 4;
+
+/// Scaled double residual at which refinement stops [K] (just above float ulp at ~300 K)
+constexpr double REFINE_TOL = 5e-5;
+
+/// Heat transfer coefficient used when a Robin policy gets no parameters [W/(m²K)]
+constexpr double DEFAULT_ROBIN_H = 10.0;
+
+/// Maximum number of Newton iterations of a radiative edge
+constexpr int MAX_NEWTON_ITER = 20;
+
+/// Newton update at which a radiative edge temperature has converged [K]
+constexpr double NEWTON_TOL = 1e-9;
+
+/// Maximum number of phase (mushy set) updates per 1D step
+constexpr int MAX_PHASE_ITER = 50;
+
+/// Melting range that pins a mushy node of a pure substance to its melting point [K]
+constexpr double ISOTHERMAL_WIDTH = 1e-4;
+
 namespace ensiie {
 
+namespace {
+
+/**
+ * @brief Condition used by the short constructors for an edge policy.
+ *
+ * Concrete policies get the historical parameters of their kind; Generic
+ * edges keep the historical condition of that edge.
+ */
+template <typename Policy>
+BoundaryCondition default_condition(const BoundaryCondition& historical, double u0) {
+    if constexpr (Policy::runtime) {
+        return historical;
+    } else if constexpr (Policy::kind == BoundaryKind::DIRICHLET) {
+        return BoundaryCondition::dirichlet(u0);
+    } else if constexpr (Policy::kind == BoundaryKind::NEUMANN) {
+        return BoundaryCondition::neumann(0.0);
+    } else if constexpr (Policy::kind == BoundaryKind::ROBIN) {
+        return BoundaryCondition::robin(DEFAULT_ROBIN_H, u0);
+    } else {
+        return BoundaryCondition::periodic();
+    }
+}
+
+/**
+ * @brief Check that a runtime condition is compatible with its edge policy.
+ */
+template <typename Policy>
+void check_condition(const BoundaryCondition& bc) {
+    if (!Policy::runtime && bc.kind != Policy::kind) {
+        throw std::invalid_argument("boundary condition does not match the solver edge policy");
+    }
+}
+
+/**
+ * @brief Check that periodic edges come in pairs.
+ */
+void check_periodic_pair(const BoundaryCondition& lo, const BoundaryCondition& hi) {
+    if ((lo.kind == BoundaryKind::PERIODIC) != (hi.kind == BoundaryKind::PERIODIC)) {
+        throw std::invalid_argument("periodic boundary conditions must be set on opposite edges");
+    }
+}
+
+/**
+ * @brief Diagonal and RHS contributions of an edge row.
+ *
+ * With a mirror ghost node at distance h, a Neumann/Robin edge row gains
+ * diag += 2·r·h·h_conv/λ and rhs += 2·r·h·(flux + h_conv·T∞)/λ.
+ * For a Dirichlet edge, rhs is the imposed temperature in Kelvin.
+ *
+ * @param r Diffusion number normal to the edge
+ * @param h Grid spacing normal to the edge
+ * @param lambda Thermal conductivity
+ * @param bc Edge condition
+ * @param diag Output diagonal contribution
+ * @param rhs Output RHS contribution
+ */
+void edge_terms(double r, double h, double lambda, const BoundaryCondition& bc,
+                double& diag, double& rhs) {
+    diag = 0.0;
+    rhs = 0.0;
+    if (bc.kind == BoundaryKind::NEUMANN) {
+        rhs = 2.0 * r * h * bc.flux / lambda;
+    } else if (bc.kind == BoundaryKind::ROBIN) {
+        diag = 2.0 * r * h * bc.h / lambda;
+        rhs = diag * (bc.t_inf + KELVIN_OFFSET);
+    } else if (bc.kind == BoundaryKind::DIRICHLET) {
+        rhs = bc.value + KELVIN_OFFSET;
+    }
+}
+
+/**
+ * @brief Radiative exchange of a Robin edge row.
+ *
+ * Same ghost-node scaling as edge_terms(): the row gains
+ * 2·r·h·εσ(T∞⁴ - u⁴)/λ. The constant part is added to rhs; the returned
+ * coefficient multiplies -u⁴ and is linearised by the solvers.
+ *
+ * @param rhs RHS contribution, updated in place
+ * @return Coefficient of -u⁴ in the row (0 if the edge does not radiate)
+ */
+double edge_radiation(double r, double h, double lambda, const BoundaryCondition& bc, double& rhs) {
+    if (!bc.is_radiative()) return 0.0;
+    const double rad = 2.0 * r * h * bc.emissivity * STEFAN_BOLTZMANN / lambda;
+    const double t_inf = bc.t_inf + KELVIN_OFFSET;
+    rhs += rad * t_inf * t_inf * t_inf * t_inf;
+    return rad;
+}
+
+/**
+ * @brief Solve diag·u + rad·u⁴ = rhs for u > 0 by Newton's method.
+ *
+ * The left-hand side is convex and increasing, so the iteration
+ * converges monotonically after its first step.
+ *
+ * @param guess Starting point (current iterate)
+ */
+double radiative_root(double diag, double rad, double rhs, double guess) {
+    double u = (guess > 0.0) ? guess : rhs / diag;
+    for (int iter = 0; iter < MAX_NEWTON_ITER; iter++) {
+        const double u3 = u * u * u;
+        const double step = (diag * u + rad * u3 * u - rhs) / (diag + 4.0 * rad * u3);
+        u -= step;
+        if (std::abs(step) < NEWTON_TOL) break;
+    }
+    return u;
+}
+
+/**
+ * @brief Refresh the RHS of a time-dependent Dirichlet edge.
+ *
+ * @param bc Edge condition
+ * @param t Time at which the edge temperature is imposed
+ * @param rhs RHS contribution, updated in place
+ */
+void refresh_edge(const BoundaryCondition& bc, double t, double& rhs) {
+    if (bc.kind == BoundaryKind::DIRICHLET && bc.is_time_dependent()) {
+        rhs = bc.value_at(t) + KELVIN_OFFSET;
+    }
+}
+
+/**
+ * @brief Grid spacings of one axis.
+ *
+ * h[i] is the distance from node i to node i + 1; on a periodic axis
+ * h[n - 1] closes the period. Uniform axes (no coordinates) get h
+ * everywhere.
+ *
+ * @param x Node coordinates (empty: uniform)
+ * @param h Uniform spacing
+ * @param n Number of nodes
+ */
+std::vector<double> spacings(const std::vector<double>& x, double h, int n) {
+    if (x.empty()) return std::vector<double>(n, h);
+    std::vector<double> s(n);
+    for (int i = 0; i + 1 < static_cast<int>(x.size()) && i < n; i++) {
+        s[i] = x[i + 1] - x[i];
+    }
+    if (static_cast<int>(x.size()) == n) s[n - 1] = s[n - 2];  // unused: no wrap-around
+    return s;
+}
+
+/**
+ * @brief Implicit diffusion couplings of the nodes of one axis.
+ *
+ * Finite-volume form of α·∂²u/∂x²: node i owns the cell between the
+ * midpoints of its two intervals, and lo[i], hi[i] = α·Δt / (|cell|·h)
+ * are its couplings to the lower and upper neighbour. The end nodes of a
+ * non-periodic axis own half a cell and only couple inwards, which is the
+ * mirror ghost node of the uniform scheme. With uniform spacing every
+ * coupling is r = α·Δt / h² (2r inwards at the ends), bit for bit.
+ *
+ * @param alpha_dt α·Δt
+ * @param h Spacings (see spacings())
+ * @param periodic Whether the axis wraps around
+ * @param lo Output couplings to the lower neighbour
+ * @param hi Output couplings to the upper neighbour
+ */
+void axis_couplings(double alpha_dt, const std::vector<double>& h, bool periodic,
+                    std::vector<double>& lo, std::vector<double>& hi) {
+    const int n = static_cast<int>(h.size());
+    lo.assign(n, 0.0);
+    hi.assign(n, 0.0);
+    for (int i = 0; i < n; i++) {
+        double hl = (i > 0) ? h[i - 1] : (periodic ? h[n - 1] : 0.0);
+        double hr = (i < n - 1 || periodic) ? h[i] : 0.0;
+        double cell = 0.5 * (hl + hr);
+        if (hl > 0.0) lo[i] = alpha_dt / (cell * hl);
+        if (hr > 0.0) hi[i] = alpha_dt / (cell * hr);
+    }
+}
+
+/**
+ * @brief Implicit diffusion couplings on a radial axis.
+ *
+ * Same balance as axis_couplings() over cylindrical (m = 1) or spherical
+ * (m = 2) shells: a face at radius ρ has an area ∝ ρ^m and the cell
+ * [ρ₋, ρ₊] a volume ∝ (ρ₊^(m+1) - ρ₋^(m+1)) / (m + 1). The face at r = 0
+ * has no area, which is the symmetry condition.
+ *
+ * @param alpha_dt α·Δt
+ * @param r Node radii, increasing
+ * @param m Metric exponent (1: cylinder, 2: sphere)
+ * @param lo Output couplings to the lower neighbour
+ * @param hi Output couplings to the upper neighbour
+ * @param edge Output scaling of the edge terms at node 0 and n - 1: face
+ *        area over cell volume, relative to the Cartesian half cell
+ */
+void radial_couplings(double alpha_dt, const std::vector<double>& r, int m,
+                      std::vector<double>& lo, std::vector<double>& hi, double edge[2]) {
+    const int n = static_cast<int>(r.size());
+    auto area = [m](double rho) { return std::pow(rho, m); };
+    auto shell = [m](double a, double b) { return (std::pow(b, m + 1) - std::pow(a, m + 1)) / (m + 1); };
+
+    lo.assign(n, 0.0);
+    hi.assign(n, 0.0);
+    for (int i = 0; i < n; i++) {
+        double rl = (i > 0) ? 0.5 * (r[i - 1] + r[i]) : r[i];
+        double rr = (i < n - 1) ? 0.5 * (r[i] + r[i + 1]) : r[i];
+        double vol = shell(rl, rr);
+        if (i > 0) lo[i] = alpha_dt * area(rl) / (vol * (r[i] - r[i - 1]));
+        if (i < n - 1) hi[i] = alpha_dt * area(rr) / (vol * (r[i + 1] - r[i]));
+    }
+    edge[0] = area(r[0]) * 0.5 * (r[1] - r[0]) / shell(r[0], 0.5 * (r[0] + r[1]));
+    edge[1] = area(r[n - 1]) * 0.5 * (r[n - 1] - r[n - 2]) / shell(0.5 * (r[n - 2] + r[n - 1]), r[n - 1]);
+}
+
+/**
+ * @brief Size of the cell owned by each node (see axis_couplings()).
+ *
+ * Length between the midpoints of the node intervals, or shell volume
+ * (up to a constant factor) on a radial axis.
+ *
+ * @param r Node coordinates, increasing
+ * @param period Length of a periodic axis (0: the end nodes own half a cell)
+ * @param m Metric exponent (0: Cartesian, 1: cylinder, 2: sphere)
+ */
+std::vector<double> cell_sizes(const std::vector<double>& r, double period, int m) {
+    const int n = static_cast<int>(r.size());
+    const double wrap = (period > 0.0) ? 0.5 * (r[0] + period - r[n - 1]) : 0.0;
+    std::vector<double> cell(n);
+    for (int i = 0; i < n; i++) {
+        double lo = (i > 0) ? 0.5 * (r[i - 1] + r[i]) : r[0] - wrap;
+        double hi = (i < n - 1) ? 0.5 * (r[i] + r[i + 1]) : r[n - 1] + wrap;
+        cell[i] = (m == 0) ? hi - lo : (std::pow(hi, m + 1) - std::pow(lo, m + 1)) / (m + 1);
+    }
+    return cell;
+}
+
+/**
+ * @brief Enthalpy model of a phase-changing material (temperatures in Kelvin).
+ *
+ * The enthalpy per unit heat capacity is T + lc·f(T), where the liquid
+ * fraction f ramps linearly from 0 at the solidus to 1 at the liquidus
+ * (a single temperature when the mushy zone has no width).
+ */
+struct Phase {
+    double lc;     ///< Latent heat over heat capacity L/c [K]
+    double t_lo;   ///< Solidus [K]
+    double t_hi;   ///< Liquidus [K]
+
+    explicit Phase(const Material& mat)
+        : lc(mat.latent_heat / mat.c)
+        , t_lo(mat.t_melt - mat.mushy + KELVIN_OFFSET)
+        , t_hi(mat.t_melt + mat.mushy + KELVIN_OFFSET)
+    {
+    }
+
+    /// Equilibrium liquid fraction at temperature T
+    double fraction(double T) const {
+        if (T <= t_lo) return 0.0;
+        if (T >= t_hi) return 1.0;
+        return (T - t_lo) / (t_hi - t_lo);
+    }
+
+    /// Temperature at which the equilibrium liquid fraction is f
+    double temperature(double f) const { return t_lo + f * (t_hi - t_lo); }
+
+    /**
+     * @brief Solve diag·T + lc·f(T) = B for T and f exactly.
+     *
+     * The left-hand side is piecewise linear and increasing in T: solid,
+     * mushy (isothermal plateau if the zone has no width) or liquid.
+     */
+    void invert(double diag, double B, double& T, double& f) const {
+        if (B <= diag * t_lo) {
+            T = B / diag;
+            f = 0.0;
+        } else if (B >= diag * t_hi + lc) {
+            T = (B - lc) / diag;
+            f = 1.0;
+        } else if (t_hi > t_lo) {
+            double s = lc / (t_hi - t_lo);
+            T = (B + s * t_lo) / (diag + s);
+            f = (T - t_lo) / (t_hi - t_lo);
+        } else {
+            T = t_lo;
+            f = (B - diag * t_lo) / lc;
+        }
+    }
+};
+
+/**
+ * @brief Number of unknowns on an axis given by its coordinates.
+ *
+ * @throws std::invalid_argument if the coordinates are invalid
+ */
+int node_count(const std::vector<double>& x, const BoundaryCondition& lo) {
+    grid::check(x);
+    const int n = static_cast<int>(x.size());
+    return (lo.kind == BoundaryKind::PERIODIC) ? n - 1 : n;
+}
+
+/**
+ * @brief Length of an axis given by its coordinates.
+ *
+ * @throws std::invalid_argument if the coordinates are invalid
+ */
+double axis_length(const std::vector<double>& x) {
+    grid::check(x);
+    return x.back();
+}
+
+/**
+ * @brief Node coordinates of an axis (uniform ones if none are stored).
+ */
+std::vector<double> node_coordinates(const std::vector<double>& x, double h, int n) {
+    if (!x.empty()) return std::vector<double>(x.begin(), x.begin() + n);
+    std::vector<double> c(n);
+    for (int i = 0; i < n; i++) c[i] = i * h;
+    return c;
+}
+
+} // namespace
+
+std::array<BoundaryCondition, 2> default_boundaries_1d(double u0) {
+    return {BoundaryCondition::neumann(0.0), BoundaryCondition::dirichlet(u0)};
+}
+
+std::array<BoundaryCondition, 4> default_boundaries_2d(double u0) {
+    return {BoundaryCondition::neumann(0.0), BoundaryCondition::dirichlet(u0),
+            BoundaryCondition::neumann(0.0), BoundaryCondition::dirichlet(u0)};
+}
+
 // =============================================================================
 // 1D SOLVER IMPLEMENTATION
 // =============================================================================
 
-HeatEquationSolver1D::HeatEquationSolver1D(
+template <typename Real, typename Boundary>
+BasicHeatEquationSolver1D<Real, Boundary>::BasicHeatEquationSolver1D(
     const Material& mat,
     double L,
     double tmax,
     double u0,
     double f,
     int n
+)
+    : BasicHeatEquationSolver1D(mat, L, tmax, u0, f, n, {
+          default_condition<typename Boundary::left>(default_boundaries_1d(u0)[LEFT], u0),
+          default_condition<typename Boundary::right>(default_boundaries_1d(u0)[RIGHT], u0)})
+{
+}
+
+template <typename Real, typename Boundary>
+BasicHeatEquationSolver1D<Real, Boundary>::BasicHeatEquationSolver1D(
+    const Material& mat,
+    double L,
+    double tmax,
+    double u0,
+    double f,
+    int n,
+    const std::array<BoundaryCondition, 2>& bc
+)
+    : BasicHeatEquationSolver1D(mat, L, tmax, u0, f, n, bc, std::vector<double>())
+{
+}
+
+template <typename Real, typename Boundary>
+BasicHeatEquationSolver1D<Real, Boundary>::BasicHeatEquationSolver1D(
+    const Material& mat,
+    const std::vector<double>& x,
+    double tmax,
+    double u0,
+    double f,
+    const std::array<BoundaryCondition, 2>& bc
+)
+    : BasicHeatEquationSolver1D(mat, axis_length(x), tmax, u0, f, node_count(x, bc[LEFT]), bc, x)
+{
+}
+
+template <typename Real, typename Boundary>
+BasicHeatEquationSolver1D<Real, Boundary>::BasicHeatEquationSolver1D(
+    const Material& mat,
+    double L,
+    double tmax,
+    double u0,
+    double f,
+    int n,
+    const std::array<BoundaryCondition, 2>& bc,
+    std::vector<double> x
 )
     : mat_(mat)
     , L_(L)
@@ -32,13 +433,30 @@ HeatEquationSolver1D::HeatEquationSolver1D(
     , u0_kelvin_(u0 + KELVIN_OFFSET)
     , t_(0.0)
     , n_(n)
-    , u_(n, u0_kelvin_)
-    , F_(n, 0.0)
+    , x_(std::move(x))
+    , geometry_(Geometry::CARTESIAN)
+    , r_inner_(0.0)
+    , bc_(bc)
+    , sm_ratio_(0.0)
+    , sm_den_(1.0)
+    , u_(n, static_cast<Real>(u0_kelvin_))
+    , d_(n)
+    , d_real_(n)
+    , u_new_(n)
 {
+    check_condition<typename Boundary::left>(bc_[LEFT]);
+    check_condition<typename Boundary::right>(bc_[RIGHT]);
+    check_periodic_pair(bc_[LEFT], bc_[RIGHT]);
+
+    if (mat_.changes_phase()) {
+        frac_.assign(n, static_cast<Real>(Phase(mat_).fraction(u0_kelvin_)));
+    }
+    assemble();
     init_source(f);
 }
 
-void HeatEquationSolver1D::init_source(double f) {
+template <typename Real, typename Boundary>
+void BasicHeatEquationSolver1D<Real, Boundary>::init_source(double f) {
     // Source regions: [L/10, 2L/10] and [5L/10, 6L/10]
     // F(x) = tmax * f^2 according to PDF
     double f1 = tmax_ * f * f;
@@ -47,210 +465,1723 @@ void HeatEquationSolver1D::init_source(double f) {
     // Scale factor to make heat propagation visible
     double scale = 100.0;  // Amplification factor for visualization
 
-    for (int i = 0; i < n_; i++) {
-        double x = i * dx_;
-        if (x >= L_ / 10.0 && x <= 2.0 * L_ / 10.0) {
-            F_[i] = f1 * scale;
-        } else if (x >= 5.0 * L_ / 10.0 && x <= 6.0 * L_ / 10.0) {
-            F_[i] = f2 * scale;
-        } else {
-            F_[i] = 0.0;
+    set_sources({
+        HeatSource::box(L_ / 10.0, 2.0 * L_ / 10.0, f1 * scale),
+        HeatSource::box(5.0 * L_ / 10.0, 6.0 * L_ / 10.0, f2 * scale)
+    });
+}
+
+template <typename Real, typename Boundary>
+void BasicHeatEquationSolver1D<Real, Boundary>::set_sources(const std::vector<HeatSource>& sources) {
+    const bool periodic = bc::resolve<typename Boundary::left>(bc_[LEFT].kind) == BoundaryKind::PERIODIC;
+    sources_.rasterise_1d(sources, n_, dx_, x_, periodic);
+}
+
+template <typename Real, typename Boundary>
+void BasicHeatEquationSolver1D<Real, Boundary>::set_moving_sources(const std::vector<MovingSource>& sources) {
+    const bool periodic = bc::resolve<typename Boundary::left>(bc_[LEFT].kind) == BoundaryKind::PERIODIC;
+    sources_.set_moving_1d(sources, n_, dx_, x_, periodic);
+}
+
+template <typename Real, typename Boundary>
+void BasicHeatEquationSolver1D<Real, Boundary>::set_geometry(Geometry geometry, double r_inner) {
+    if (geometry != Geometry::CARTESIAN) {
+        const BoundaryKind kl = bc::resolve<typename Boundary::left>(bc_[LEFT].kind);
+        if (kl == BoundaryKind::PERIODIC) {
+            throw std::invalid_argument("radial solvers cannot have periodic edges");
+        }
+        if (!(r_inner >= 0.0)) {
+            throw std::invalid_argument("inner radius must be non-negative");
+        }
+        if (r_inner == 0.0 && kl == BoundaryKind::DIRICHLET) {
+            throw std::invalid_argument("the axis r = 0 is a symmetry edge, not a Dirichlet edge");
         }
     }
+    geometry_ = geometry;
+    r_inner_ = (geometry == Geometry::CARTESIAN) ? 0.0 : r_inner;
+    assemble();
 }
 
-bool HeatEquationSolver1D::step() {
-    if (t_ >= tmax_) return false;
+template <typename Real, typename Boundary>
+void BasicHeatEquationSolver1D<Real, Boundary>::set_time_step(double dt) {
+    if (!(dt > 0.0)) throw std::invalid_argument("time step must be positive");
+    dt_ = dt;
+    assemble();
+}
 
-    // Implicit scheme coefficients
-    double alpha = mat_.alpha();
-    double r = alpha * dt_ / (dx_ * dx_);
-    double coef = dt_ / (mat_.rho * mat_.c);
+template <typename Real, typename Boundary>
+void BasicHeatEquationSolver1D<Real, Boundary>::assemble() {
+    const BoundaryKind kl = bc::resolve<typename Boundary::left>(bc_[LEFT].kind);
+    const BoundaryKind kr = bc::resolve<typename Boundary::right>(bc_[RIGHT].kind);
+    const bool periodic = (kl == BoundaryKind::PERIODIC);
+
+    // Periodic: n distinct nodes, node n is node 0
+    dx_ = periodic ? L_ / n_ : L_ / (n_ - 1);
 
-    std::vector<double> a(n_, -r);
-    std::vector<double> b(n_, 1.0 + 2.0 * r);
-    std::vector<double> c(n_, -r);
-    std::vector<double> d(n_);
+    // Implicit scheme coefficients (variable on a stretched grid or in radius)
+    const std::vector<double> h = spacings(x_, dx_, n_);
+    std::vector<double> lo, hi;
+    double edge_scale[2] = {1.0, 1.0};
+    if (geometry_ == Geometry::CARTESIAN) {
+        axis_couplings(mat_.alpha() * dt_, h, periodic, lo, hi);
+    } else {
+        std::vector<double> r = get_x();
+        for (double& ri : r) ri += r_inner_;
+        const int m = (geometry_ == Geometry::CYLINDRICAL) ? 1 : 2;
+        radial_couplings(mat_.alpha() * dt_, r, m, lo, hi, edge_scale);
+    }
 
-    // RHS
+    std::vector<double> a(n_);
+    std::vector<double> b(n_);
+    std::vector<double> c(n_);
     for (int i = 0; i < n_; i++) {
-        d[i] = u_[i] + coef * F_[i];
+        a[i] = -lo[i];
+        b[i] = 1.0 + (lo[i] + hi[i]);
+        c[i] = -hi[i];
+    }
+
+    double diag = 0.0;
+
+    // Edge at x = 0 (the end cells already couple inwards only)
+    const double h0 = h[0];
+    edge_terms(mat_.alpha() * dt_ / (h0 * h0), h0, mat_.lambda, bc_[LEFT], diag, edge_rhs_[LEFT]);
+    edge_rad_[LEFT] = edge_radiation(mat_.alpha() * dt_ / (h0 * h0), h0, mat_.lambda, bc_[LEFT], edge_rhs_[LEFT]);
+    if (kl == BoundaryKind::DIRICHLET) {
+        b[0] = 1.0;
+        c[0] = 0.0;
+    } else if (kl != BoundaryKind::PERIODIC) {
+        // Radial: the face area scales the exchange (0 on the axis)
+        b[0] += edge_scale[LEFT] * diag;
+        edge_rhs_[LEFT] *= edge_scale[LEFT];
+        edge_rad_[LEFT] *= edge_scale[LEFT];
+    }
+    if (!periodic) a[0] = 0.0;
+
+    // Edge at x = L
+    const double h1 = h[n_ - 2];
+    edge_terms(mat_.alpha() * dt_ / (h1 * h1), h1, mat_.lambda, bc_[RIGHT], diag, edge_rhs_[RIGHT]);
+    edge_rad_[RIGHT] = edge_radiation(mat_.alpha() * dt_ / (h1 * h1), h1, mat_.lambda, bc_[RIGHT], edge_rhs_[RIGHT]);
+    if (kr == BoundaryKind::DIRICHLET) {
+        b[n_ - 1] = 1.0;
+        a[n_ - 1] = 0.0;
+    } else if (kr != BoundaryKind::PERIODIC) {
+        b[n_ - 1] += edge_scale[RIGHT] * diag;
+        edge_rhs_[RIGHT] *= edge_scale[RIGHT];
+        edge_rad_[RIGHT] *= edge_scale[RIGHT];
+    }
+    if (!periodic) c[n_ - 1] = 0.0;
+
+    // Phase change: latent heat terms are added to the rows of mushy nodes
+    if (mat_.changes_phase()) {
+        diag_ = b;
+        mushy_.assign(n_, 0);
     }
 
-    // Neumann boundary condition at x = 0
-    b[0] = 1.0 + r;
-    c[0] = -r;
+    a_.assign(a.begin(), a.end());
+    b_.assign(b.begin(), b.end());
+    c_.assign(c.begin(), c.end());
+    factor(a, b, c, 0);
+
+    // Radiative edges: response of the field to the edge rows, A⁻¹·e
+    for (int e : {LEFT, RIGHT}) {
+        edge_response_[e].clear();
+        if (edge_rad_[e] == 0.0) continue;
+        std::vector<Real> unit(n_, Real(0));
+        unit[(e == LEFT) ? 0 : n_ - 1] = Real(1);
+        edge_response_[e].resize(n_);
+        solve_tridiagonal(unit, edge_response_[e]);
+    }
+}
+
+template <typename Real, typename Boundary>
+template <typename V>
+void BasicHeatEquationSolver1D<Real, Boundary>::factor(const V& a, const V& b, const V& c, int from) {
+    const bool periodic = bc::resolve<typename Boundary::left>(bc_[LEFT].kind) == BoundaryKind::PERIODIC;
+
+    // Periodic: A = T + u·vᵀ with u = (γ, 0, …, α), v = (1, 0, …, β/γ)
+    double gamma = -static_cast<double>(b[0]);
+    double alpha_c = static_cast<double>(c[n_ - 1]);
+    double beta_c = static_cast<double>(a[0]);
+    auto bt = [&](int i) {
+        double bi = static_cast<double>(b[i]);
+        if (periodic && i == 0) bi -= gamma;
+        if (periodic && i == n_ - 1) bi -= alpha_c * beta_c / gamma;
+        return bi;
+    };
+    if (periodic) from = 0;
+
+    // Thomas factorization of T in double, from row `from` on
+    c_prime_.resize(n_);
+    inv_den_.resize(n_);
+    double cp;
+    if (from == 0) {
+        cp = static_cast<double>(c[0]) / bt(0);
+        inv_den_[0] = static_cast<Real>(1.0 / bt(0));
+        c_prime_[0] = static_cast<Real>(cp);
+        from = 1;
+    } else {
+        cp = static_cast<double>(c_prime_[from - 1]);
+    }
+    for (int i = from; i < n_; i++) {
+        double inv = 1.0 / (bt(i) - static_cast<double>(a[i]) * cp);
+        cp = static_cast<double>(c[i]) * inv;
+        inv_den_[i] = static_cast<Real>(inv);
+        c_prime_[i] = static_cast<Real>(cp);
+    }
+
+    sm_ratio_ = 0.0;
+    if (periodic) {
+        std::vector<Real> uvec(n_, Real(0));
+        uvec[0] = static_cast<Real>(gamma);
+        uvec[n_ - 1] = static_cast<Real>(alpha_c);
+        z_.assign(n_, Real(0));
+        solve_tridiagonal(uvec, z_);  // plain Thomas solve while sm_ratio_ = 0
+        sm_ratio_ = beta_c / gamma;
+        sm_den_ = 1.0 + z_[0] + sm_ratio_ * z_[n_ - 1];
+    }
+}
+
+template <typename Real, typename Boundary>
+bool BasicHeatEquationSolver1D<Real, Boundary>::step() {
+    if (t_ >= tmax_) return false;
+    PROFILE_ZONE("step 1d");
+
+    const BoundaryKind kl = bc::resolve<typename Boundary::left>(bc_[LEFT].kind);
+    const BoundaryKind kr = bc::resolve<typename Boundary::right>(bc_[RIGHT].kind);
+    double coef = dt_ / (mat_.rho * mat_.c);
+
+    // Implicit step: edge temperatures are imposed at t + dt
+    refresh_edge(bc_[LEFT], t_ + dt_, edge_rhs_[LEFT]);
+    refresh_edge(bc_[RIGHT], t_ + dt_, edge_rhs_[RIGHT]);
 
-    // Dirichlet boundary condition at x = L
-    b[n_ - 1] = 1.0;
-    a[n_ - 1] = 0.0;
-    c[n_ - 1] = 0.0;
-    d[n_ - 1] = u0_kelvin_;
+    // RHS (kept in double for the refinement residual), sources evaluated at t + dt
+    {
+        PROFILE_ZONE("rhs");
+        for (int i = 0; i < n_; i++) {
+            d_[i] = static_cast<double>(u_[i]);
+        }
+        sources_.move_to(t_ + dt_);
+        sources_.add_to(d_, t_ + dt_, coef);
+
+        // Edge rows: Dirichlet value replaces the RHS, other kinds add to it
+        if (kl == BoundaryKind::DIRICHLET) d_[0] = edge_rhs_[LEFT];
+        else d_[0] += edge_rhs_[LEFT];
+        if (kr == BoundaryKind::DIRICHLET) d_[n_ - 1] = edge_rhs_[RIGHT];
+        else d_[n_ - 1] += edge_rhs_[RIGHT];
+    }
 
-    std::vector<double> u_new(n_);
-    solve_tridiagonal(a, b, c, d, u_new);
+    if (mat_.changes_phase()) {
+        PROFILE_ZONE("phase change");
+        solve_phase();
+    } else {
+        {
+            PROFILE_ZONE("thomas");
+            std::copy(d_.begin(), d_.end(), d_real_.begin());
+            solve_tridiagonal(d_real_, u_new_);
+        }
+
+        if constexpr (!std::is_same_v<Real, double>) {
+            PROFILE_ZONE("refinement");
+            refine(d_, u_new_);
+        }
+        radiate();
+    }
 
-    u_ = u_new;
+    u_.swap(u_new_);
     t_ += dt_;
     return true;
 }
 
-void HeatEquationSolver1D::solve_tridiagonal(
-    const std::vector<double>& a,
-    const std::vector<double>& b,
-    const std::vector<double>& c,
-    std::vector<double>& d,
-    std::vector<double>& x
-) 
+template <typename Real, typename Boundary>
+void BasicHeatEquationSolver1D<Real, Boundary>::solve_tridiagonal(
+    std::vector<Real>& d,
+    std::vector<Real>& x
+) const
 {
-    // Thomas algorithm (TDMA)
-    int n = static_cast<int>(b.size());
-    std::vector<double> c_prime(n);
-    std::vector<double> d_prime(n);
-
-    // Forward elimination
-    c_prime[0] = c[0] / b[0];
-    d_prime[0] = d[0] / b[0];
+    int n = n_;
 
+    // Forward substitution with the stored pivots
+    d[0] *= inv_den_[0];
     for (int i = 1; i < n; i++) {
-        double denom = b[i] - a[i] * c_prime[i - 1];
-        c_prime[i] = c[i] / denom;
-        d_prime[i] = (d[i] - a[i] * d_prime[i - 1]) / denom;
+        d[i] = (d[i] - a_[i] * d[i - 1]) * inv_den_[i];
     }
 
     // Back substitution
-    x[n - 1] = d_prime[n - 1];
+    x[n - 1] = d[n - 1];
     for (int i = n - 2; i >= 0; --i) {
-        x[i] = d_prime[i] - c_prime[i] * x[i + 1];
+        x[i] = d[i] - c_prime_[i] * x[i + 1];
     }
-}
 
-void HeatEquationSolver1D::reset() {
-    t_ = 0.0;
-    std::fill(u_.begin(), u_.end(), u0_kelvin_);
+    // Sherman–Morrison correction for the cyclic corners
+    if (sm_ratio_ != 0.0) {
+        Real fact = static_cast<Real>((x[0] + sm_ratio_ * x[n - 1]) / sm_den_);
+        for (int i = 0; i < n; i++) x[i] -= fact * z_[i];
+    }
 }
 
-
-// =============================================================================
-// 2D SOLVER IMPLEMENTATION
-// =============================================================================
-
-HeatEquationSolver2D::HeatEquationSolver2D(
-    const Material& mat,
-    double L,
-    double tmax,
-    double u0,
-    double f,
-    int n
+template <typename Real, typename Boundary>
+void BasicHeatEquationSolver1D<Real, Boundary>::refine(
+    const std::vector<double>& d,
+    std::vector<Real>& x
 )
-    : mat_(mat)
-    , L_(L)
-    , tmax_(tmax)
-    , dx_(L / (n - 1))
-    , dt_(tmax / 1000.0)
-    , u0_kelvin_(u0 + KELVIN_OFFSET)
-    , t_(0.0)
-    , n_(n)
-    , u_(n * n, u0_kelvin_)
-    , F_(n * n, 0.0)
 {
-    init_source(f);
-}
+    std::vector<Real> res(n_);
+    std::vector<Real> e(n_);
 
-void HeatEquationSolver2D::init_source(double f) {
-    // Four symmetric sources at corners
-    // F(x,y) = tmax * f^2 according to PDF
-    double f_val = tmax_ * f * f;
+    for (int pass = 0; pass < MAX_REFINE; pass++) {
+        // Residual r = d - A·x in double precision (corner terms are zero
+        // unless the system is cyclic)
+        double max_res = 0.0;
+        for (int i = 0; i < n_; i++) {
+            int im = (i > 0) ? i - 1 : n_ - 1;
+            int ip = (i < n_ - 1) ? i + 1 : 0;
+            double ax = static_cast<double>(a_[i]) * x[im]
+                      + static_cast<double>(b_[i]) * x[i]
+                      + static_cast<double>(c_[i]) * x[ip];
+            double ri = d[i] - ax;
+            res[i] = static_cast<Real>(ri);
+            max_res = std::max(max_res, std::abs(ri / b_[i]));
+        }
+        if (max_res < REFINE_TOL) break;
 
-    // Scale factor to make heat propagation visible
-    double scale = 100.0;  // Amplification factor for visualization
+        // Correction solved in storage precision
+        solve_tridiagonal(res, e);
+        for (int i = 0; i < n_; i++) x[i] += e[i];
+    }
+}
 
-    for (int j = 0; j < n_; j++) {
-        for (int i = 0; i < n_; i++) {
-            double x = i * dx_;
-            double y = j * dx_;
+template <typename Real, typename Boundary>
+void BasicHeatEquationSolver1D<Real, Boundary>::radiate() {
+    if (edge_rad_[LEFT] == 0.0 && edge_rad_[RIGHT] == 0.0) return;
+    const int rows[2] = {0, n_ - 1};
+
+    // Response of the edge temperatures to the edge rows: W[e][f] = (A⁻¹·e_f)[row e]
+    double W[2][2] = {{0.0, 0.0}, {0.0, 0.0}};
+    for (int e : {LEFT, RIGHT}) {
+        for (int f : {LEFT, RIGHT}) {
+            if (edge_rad_[f] != 0.0) W[e][f] = static_cast<double>(edge_response_[f][rows[e]]);
+        }
+    }
 
-            bool in_source = false;
+    // Newton on u_e = y_e - Σ_f W[e][f]·rad_f·u_f⁴, starting from the previous step
+    const double y[2] = {static_cast<double>(u_new_[0]), static_cast<double>(u_new_[n_ - 1])};
+    double u[2] = {static_cast<double>(u_[0]), static_cast<double>(u_[n_ - 1])};
+    double q[2];
+    for (int iter = 0; iter < MAX_NEWTON_ITER; iter++) {
+        double dq[2];
+        for (int e : {LEFT, RIGHT}) {
+            q[e] = -edge_rad_[e] * u[e] * u[e] * u[e] * u[e];
+            dq[e] = 4.0 * q[e] / u[e];
+        }
+        double F[2], J[2][2];
+        for (int e : {LEFT, RIGHT}) {
+            F[e] = u[e] - y[e] - W[e][LEFT] * q[LEFT] - W[e][RIGHT] * q[RIGHT];
+            J[e][LEFT] = -W[e][LEFT] * dq[LEFT];
+            J[e][RIGHT] = -W[e][RIGHT] * dq[RIGHT];
+            J[e][e] += 1.0;
+        }
+        const double det = J[0][0] * J[1][1] - J[0][1] * J[1][0];
+        const double du0 = (F[0] * J[1][1] - F[1] * J[0][1]) / det;
+        const double du1 = (F[1] * J[0][0] - F[0] * J[1][0]) / det;
+        u[0] -= du0;
+        u[1] -= du1;
+        if (std::max(std::abs(du0), std::abs(du1)) < NEWTON_TOL) break;
+    }
 
-            // Bottom-left
-            if (x >= L_/6.0 && x <= 2.0*L_/6.0 && y >= L_/6.0 && y <= 2.0*L_/6.0)
-                in_source = true;
-            // Bottom-right
-            if (x >= 4.0*L_/6.0 && x <= 5.0*L_/6.0 && y >= L_/6.0 && y <= 2.0*L_/6.0)
-                in_source = true;
-            // Top-left
-            if (x >= L_/6.0 && x <= 2.0*L_/6.0 && y >= 4.0*L_/6.0 && y <= 5.0*L_/6.0)
-                in_source = true;
-            // Top-right
-            if (x >= 4.0*L_/6.0 && x <= 5.0*L_/6.0 && y >= 4.0*L_/6.0 && y <= 5.0*L_/6.0)
-                in_source = true;
+    // Only the edge rows changed: add their response to the interior solution
+    for (int e : {LEFT, RIGHT}) {
+        if (edge_rad_[e] == 0.0) continue;
+        q[e] = -edge_rad_[e] * u[e] * u[e] * u[e] * u[e];
+        const Real qe = static_cast<Real>(q[e]);
+        const std::vector<Real>& w = edge_response_[e];
+        for (int i = 0; i < n_; i++) u_new_[i] += qe * w[i];
+    }
 
-            F_[idx(i, j)] = in_source ? (f_val * scale) : 0.0;
+    if constexpr (!std::is_same_v<Real, double>) {
+        std::vector<double> d = d_;
+        for (int e : {LEFT, RIGHT}) {
+            if (edge_rad_[e] != 0.0) d[rows[e]] += q[e];
         }
+        refine(d, u_new_);
     }
 }
 
-bool HeatEquationSolver2D::step() {
-    if (t_ >= tmax_) return false;
+template <typename Real, typename Boundary>
+void BasicHeatEquationSolver1D<Real, Boundary>::solve_phase() {
+    const BoundaryKind kl = bc::resolve<typename Boundary::left>(bc_[LEFT].kind);
+    const BoundaryKind kr = bc::resolve<typename Boundary::right>(bc_[RIGHT].kind);
+    const Phase phase(mat_);
 
-    // Implicit scheme with 5-point stencil
-    double alpha = mat_.alpha();
-    double r = alpha * dt_ / (dx_ * dx_);
-    double src_coef = dt_ / (mat_.rho * mat_.c);
+    // Mushy rows: lc·f = s·(u - t_lo), so s joins the diagonal
+    const double s = phase.lc / std::max(phase.t_hi - phase.t_lo, ISOTHERMAL_WIDTH);
 
-    std::vector<double> u_new = u_;
+    // Temperature resolution of the storage precision: round-off must not
+    // move a node in and out of the mushy set
+    const double resolution = 4.0 * std::numeric_limits<Real>::epsilon() * phase.t_hi;
 
-    // Gauss-Seidel parameters
-    const int max_iter = 100;
-    const double tol = 1e-6;
-
-    for (int iter = 0; iter < max_iter; iter++) {
-        double max_diff = 0.0;
-
-        for (int j = 0; j < n_; ++j) {
-            for (int i = 0; i < n_; ++i) {
-                // Dirichlet BC at right and top edges
-                if (i == n_ - 1 || j == n_ - 1) {
-                    u_new[idx(i, j)] = u0_kelvin_;
-                    continue;
-                }
+    // Dirichlet rows keep their imposed value
+    const int i0 = (kl == BoundaryKind::DIRICHLET) ? 1 : 0;
+    const int i1 = (kr == BoundaryKind::DIRICHLET) ? n_ - 1 : n_;
+
+    std::vector<double> f(frac_.begin(), frac_.end());
+    std::vector<double> d = d_;
+
+    // Radiative edges: -rad·u⁴ linearised at u*, slope on the diagonal
+    // and offset on the RHS (Newton, updated with the mushy set)
+    const int rows[2] = {0, n_ - 1};
+    double u_lin[2] = {static_cast<double>(u_[0]), static_cast<double>(u_[n_ - 1])};
+    double slope[2] = {0.0, 0.0};
+    double offset[2] = {0.0, 0.0};
+    auto linearise = [&](int e) {
+        const double u3 = u_lin[e] * u_lin[e] * u_lin[e];
+        slope[e] = 4.0 * edge_rad_[e] * u3;
+        offset[e] = 3.0 * edge_rad_[e] * u3 * u_lin[e];
+    };
+    auto edge_term = [&](int i, const double (&term)[2]) {
+        return ((i == 0) ? term[LEFT] : 0.0) + ((i == n_ - 1) ? term[RIGHT] : 0.0);
+    };
 
-                double old_val = u_new[idx(i, j)];
+    // Refactor from the first row whose diagonal changed
+    int from = n_;
+    auto refresh = [&](int i) {
+        const Real bi = static_cast<Real>(diag_[i] + (mushy_[i] ? s : 0.0) + edge_term(i, slope));
+        if (bi != b_[i]) {
+            b_[i] = bi;
+            from = std::min(from, i);
+        }
+    };
+
+    // Switch a row between solid/liquid (f fixed) and mushy (u tied to f)
+    auto set_mushy = [&](int i, bool on) {
+        mushy_[i] = on;
+        refresh(i);
+    };
+    for (int e : {LEFT, RIGHT}) {
+        linearise(e);
+        refresh(rows[e]);
+    }
+    for (int i = i0; i < i1; i++) {
+        if (!mushy_[i] && f[i] > 0.0 && f[i] < 1.0) set_mushy(i, true);
+    }
 
-                // Neighbors with Neumann BC (mirror at i=0, j=0)
-                double u_left  = (i > 0) ? u_new[idx(i-1, j)] : u_new[idx(1, j)];
-                double u_right = u_new[idx(i+1, j)];
-                double u_down  = (j > 0) ? u_new[idx(i, j-1)] : u_new[idx(i, 1)];
-                double u_up    = u_new[idx(i, j+1)];
+    // Active-set iteration: solve with the current mushy rows, then move
+    // the nodes whose temperature or fraction left their state
+    for (int iter = 0; iter < MAX_PHASE_ITER; iter++) {
+        if (from < n_) factor(a_, b_, c_, from);
+        from = n_;
 
-                double rhs = u_[idx(i, j)] + src_coef * F_[idx(i, j)];
-                u_new[idx(i, j)] = (rhs + r * (u_left + u_right + u_down + u_up)) / (1.0 + 4.0 * r);
+        for (int i = i0; i < i1; i++) {
+            const double latent = d_[i] + phase.lc * static_cast<double>(frac_[i]) + edge_term(i, offset);
+            d[i] = mushy_[i] ? latent + s * phase.t_lo : latent - phase.lc * f[i];
+        }
+        std::copy(d.begin(), d.end(), d_real_.begin());
+        solve_tridiagonal(d_real_, u_new_);
+        if constexpr (!std::is_same_v<Real, double>) {
+            refine(d, u_new_);
+        }
+
+        for (int i = i0; i < i1; i++) {
+            const double u = static_cast<double>(u_new_[i]);
+            if (mushy_[i]) {
+                // Fraction from the energy balance of the row (conservative)
+                const int im = (i > 0) ? i - 1 : n_ - 1;
+                const int ip = (i < n_ - 1) ? i + 1 : 0;
+                const double au = static_cast<double>(a_[i]) * u_new_[im]
+                                + (diag_[i] + edge_term(i, slope)) * u
+                                + static_cast<double>(c_[i]) * u_new_[ip];
+                f[i] = (d_[i] + phase.lc * static_cast<double>(frac_[i]) + edge_term(i, offset) - au)
+                     / phase.lc;
+                const double margin = diag_[i] * resolution / phase.lc;
+                if (f[i] < -margin || f[i] > 1.0 + margin) {
+                    f[i] = (f[i] < 0.0) ? 0.0 : 1.0;
+                    set_mushy(i, false);
+                }
+            } else if ((f[i] == 0.0 && u > phase.t_lo + resolution) ||
+                       (f[i] == 1.0 && u < phase.t_hi - resolution)) {
+                set_mushy(i, true);
+            }
+        }
 
-                max_diff = std::max(max_diff, std::abs(u_new[idx(i, j)] - old_val));
+        bool moved = false;
+        for (int e : {LEFT, RIGHT}) {
+            const double u = static_cast<double>(u_new_[rows[e]]);
+            if (edge_rad_[e] != 0.0 && std::abs(u - u_lin[e]) > resolution) {
+                u_lin[e] = u;
+                linearise(e);
+                refresh(rows[e]);
+                moved = true;
             }
         }
+        if (from == n_ && !moved) break;
+    }
+
+    if (i0 == 1) f[0] = phase.fraction(u_new_[0]);
+    if (i1 == n_ - 1) f[n_ - 1] = phase.fraction(u_new_[n_ - 1]);
+    std::copy(f.begin(), f.end(), frac_.begin());
+}
+
+template <typename Real, typename Boundary>
+std::vector<double> BasicHeatEquationSolver1D<Real, Boundary>::get_x() const {
+    return node_coordinates(x_, dx_, n_);
+}
+
+template <typename Real, typename Boundary>
+double BasicHeatEquationSolver1D<Real, Boundary>::get_liquid_fraction() const {
+    if (frac_.empty()) return 0.0;
+    const bool periodic = bc::resolve<typename Boundary::left>(bc_[LEFT].kind) == BoundaryKind::PERIODIC;
+    std::vector<double> r = get_x();
+    for (double& ri : r) ri += r_inner_;
+    const int m = (geometry_ == Geometry::CYLINDRICAL) ? 1 : (geometry_ == Geometry::SPHERICAL) ? 2 : 0;
+    const std::vector<double> cell = cell_sizes(r, periodic ? L_ : 0.0, m);
 
-        if (max_diff < tol) break;
+    double liquid = 0.0;
+    double total = 0.0;
+    for (int i = 0; i < n_; i++) {
+        liquid += cell[i] * static_cast<double>(frac_[i]);
+        total += cell[i];
     }
+    return liquid / total;
+}
 
-    u_ = u_new;
-    t_ += dt_;
-    return true;
+template <typename Real, typename Boundary>
+double BasicHeatEquationSolver1D<Real, Boundary>::probe(double x, double) const {
+    int i;
+    double s;
+    grid::locate(get_x(), x, i, s);
+    return (1.0 - s) * static_cast<double>(u_[i]) + s * static_cast<double>(u_[i + 1]);
+}
+
+template <typename Real, typename Boundary>
+double BasicHeatEquationSolver1D<Real, Boundary>::get_melt_front() const {
+    if (frac_.empty()) return -1.0;
+    const std::vector<double> x = get_x();
+    for (int i = 0; i + 1 < n_; i++) {
+        const double f0 = static_cast<double>(frac_[i]) - 0.5;
+        const double f1 = static_cast<double>(frac_[i + 1]) - 0.5;
+        if (f0 == 0.0) return x[i];
+        if ((f0 < 0.0) != (f1 < 0.0)) {
+            return x[i] + f0 / (f0 - f1) * (x[i + 1] - x[i]);
+        }
+    }
+    return -1.0;
 }
 
-std::vector<std::vector<double>> HeatEquationSolver2D::get_temperature_2d() const {
-    std::vector<std::vector<double>> result(n_, std::vector<double>(n_));
-    for (int j = 0; j < n_; j++) {
+template <typename Real, typename Boundary>
+LinearStep BasicHeatEquationSolver1D<Real, Boundary>::linear_step() const {
+    if (mat_.changes_phase()) {
+        throw std::invalid_argument("linear step: phase change is nonlinear");
+    }
+    for (const BoundaryCondition& c : bc_) {
+        if (c.is_radiative()) throw std::invalid_argument("linear step: radiative edges are nonlinear");
+        if (c.is_time_dependent()) throw std::invalid_argument("linear step: edge values must be constant");
+    }
+    if (sources_.has_moving()) {
+        throw std::invalid_argument("linear step: moving sources are not supported");
+    }
+
+    const BoundaryKind kinds[2] = {
+        bc::resolve<typename Boundary::left>(bc_[LEFT].kind),
+        bc::resolve<typename Boundary::right>(bc_[RIGHT].kind)
+    };
+    LinearStep ls;
+    ls.dt = dt_;
+    ls.fixed.assign(n_, 0);
+    ls.b.assign(n_, 0.0);
+
+    // Tridiagonal rows; periodic corners wrap around
+    CsrMatrix& A = ls.A;
+    A.n = n_;
+    A.row_ptr.assign(n_ + 1, 0);
+    std::vector<std::pair<int, double>> row;
+    for (int i = 0; i < n_; i++) {
+        row.clear();
+        const int lo = (i > 0) ? i - 1 : n_ - 1;
+        const int hi = (i < n_ - 1) ? i + 1 : 0;
+        if (a_[i] != Real(0)) row.emplace_back(lo, static_cast<double>(a_[i]));
+        row.emplace_back(i, static_cast<double>(b_[i]));
+        if (c_[i] != Real(0)) row.emplace_back(hi, static_cast<double>(c_[i]));
+        std::sort(row.begin(), row.end());
+        for (const auto& e : row) {
+            A.col.push_back(e.first);
+            A.val.push_back(e.second);
+        }
+        A.row_ptr[i + 1] = static_cast<int>(A.col.size());
+    }
+
+    // Edge rows: Dirichlet value, or flux and convection terms
+    for (int e : {LEFT, RIGHT}) {
+        if (kinds[e] == BoundaryKind::PERIODIC) continue;
+        const int i = (e == LEFT) ? 0 : n_ - 1;
+        ls.b[i] = edge_rhs_[e];
+        ls.fixed[i] = (kinds[e] == BoundaryKind::DIRICHLET);
+    }
+
+    const double coef = dt_ / (mat_.rho * mat_.c);
+    for (std::size_t s = 0; s < sources_.size(); s++) {
+        std::vector<double> f = sources_.footprint(s, n_, coef);
         for (int i = 0; i < n_; i++) {
-            result[j][i] = u_[idx(i, j)];
+            if (ls.fixed[i]) f[i] = 0.0;
         }
+        ls.sources.push_back(std::move(f));
+        ls.modulations.push_back(sources_.modulation(s));
     }
-    return result;
+    return ls;
 }
 
-void HeatEquationSolver2D::reset() {
+template <typename Real, typename Boundary>
+void BasicHeatEquationSolver1D<Real, Boundary>::reset() {
     t_ = 0.0;
-    std::fill(u_.begin(), u_.end(), u0_kelvin_);
+    std::fill(u_.begin(), u_.end(), static_cast<Real>(u0_kelvin_));
+    if (!frac_.empty()) {
+        std::fill(frac_.begin(), frac_.end(), static_cast<Real>(Phase(mat_).fraction(u0_kelvin_)));
+    }
+}
+
+
+// =============================================================================
+// 2D SOLVER IMPLEMENTATION
+// =============================================================================
+
+template <typename Real, typename Boundary, typename Stencil>
+BasicHeatEquationSolver2D<Real, Boundary, Stencil>::BasicHeatEquationSolver2D(
+    const Material& mat,
+    double L,
+    double tmax,
+    double u0,
+    double f,
+    int n
+)
+    : BasicHeatEquationSolver2D(mat, L, tmax, u0, f, n, {
+          default_condition<typename Boundary::west>(default_boundaries_2d(u0)[WEST], u0),
+          default_condition<typename Boundary::east>(default_boundaries_2d(u0)[EAST], u0),
+          default_condition<typename Boundary::south>(default_boundaries_2d(u0)[SOUTH], u0),
+          default_condition<typename Boundary::north>(default_boundaries_2d(u0)[NORTH], u0)})
+{
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+BasicHeatEquationSolver2D<Real, Boundary, Stencil>::BasicHeatEquationSolver2D(
+    const Material& mat,
+    double L,
+    double tmax,
+    double u0,
+    double f,
+    int n,
+    const std::array<BoundaryCondition, 4>& bc
+)
+    : BasicHeatEquationSolver2D(mat, L, L, tmax, u0, f, n, n, bc)
+{
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+BasicHeatEquationSolver2D<Real, Boundary, Stencil>::BasicHeatEquationSolver2D(
+    const Material& mat,
+    double Lx,
+    double Ly,
+    double tmax,
+    double u0,
+    double f,
+    int nx,
+    int ny,
+    const std::array<BoundaryCondition, 4>& bc
+)
+    : BasicHeatEquationSolver2D(mat, Lx, Ly, tmax, u0, f, nx, ny, bc,
+                                std::vector<double>(), std::vector<double>())
+{
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+BasicHeatEquationSolver2D<Real, Boundary, Stencil>::BasicHeatEquationSolver2D(
+    const Material& mat,
+    const std::vector<double>& x,
+    const std::vector<double>& y,
+    double tmax,
+    double u0,
+    double f,
+    const std::array<BoundaryCondition, 4>& bc
+)
+    : BasicHeatEquationSolver2D(mat, axis_length(x), axis_length(y), tmax, u0, f,
+                                node_count(x, bc[WEST]), node_count(y, bc[SOUTH]), bc, x, y)
+{
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+BasicHeatEquationSolver2D<Real, Boundary, Stencil>::BasicHeatEquationSolver2D(
+    const Material& mat,
+    double Lx,
+    double Ly,
+    double tmax,
+    double u0,
+    double f,
+    int nx,
+    int ny,
+    const std::array<BoundaryCondition, 4>& bc,
+    std::vector<double> x,
+    std::vector<double> y
+)
+    : mat_(mat)
+    , Lx_(Lx)
+    , Ly_(Ly)
+    , tmax_(tmax)
+    , dx_(Lx / (nx - 1))
+    , dy_(Ly / (ny - 1))
+    , dt_(tmax / 1000.0)
+    , u0_kelvin_(u0 + KELVIN_OFFSET)
+    , t_(0.0)
+    , iterations_(0)
+    , residual_(0.0)
+    , unconverged_(0)
+    , nx_(nx)
+    , ny_(ny)
+    , x_(std::move(x))
+    , y_(std::move(y))
+    , rx_(0.0)
+    , ry_(0.0)
+    , omega_(1.0)
+    , bc_(bc)
+    , u_(nx * ny, static_cast<Real>(u0_kelvin_))
+    , mask_face_(MaskFace::INSULATED)
+    , mask_kelvin_(0.0)
+    , u_new_(nx * ny)
+    , rhs_(nx * ny)
+{
+    check_condition<typename Boundary::west>(bc_[WEST]);
+    check_condition<typename Boundary::east>(bc_[EAST]);
+    check_condition<typename Boundary::south>(bc_[SOUTH]);
+    check_condition<typename Boundary::north>(bc_[NORTH]);
+    check_periodic_pair(bc_[WEST], bc_[EAST]);
+    check_periodic_pair(bc_[SOUTH], bc_[NORTH]);
+
+    if (mat_.changes_phase()) {
+        frac_.assign(nx * ny, static_cast<Real>(Phase(mat_).fraction(u0_kelvin_)));
+        frac_new_.resize(nx * ny);
+    }
+    assemble();
+    runs_.build_full(nx_, ny_);
+    init_source(f);
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+void BasicHeatEquationSolver2D<Real, Boundary, Stencil>::init_source(double f) {
+    // Four symmetric sources at corners
+    // F(x,y) = tmax * f^2 according to PDF
+    double f_val = tmax_ * f * f;
+
+    // Scale factor to make heat propagation visible
+    double scale = 100.0;  // Amplification factor for visualization
+
+    const double xlo = Lx_ / 6.0, xhi = 2.0 * Lx_ / 6.0;
+    const double xlo2 = 4.0 * Lx_ / 6.0, xhi2 = 5.0 * Lx_ / 6.0;
+    const double ylo = Ly_ / 6.0, yhi = 2.0 * Ly_ / 6.0;
+    const double ylo2 = 4.0 * Ly_ / 6.0, yhi2 = 5.0 * Ly_ / 6.0;
+    set_sources({
+        HeatSource::box(xlo,  xhi,  ylo,  yhi,  f_val * scale),   // Bottom-left
+        HeatSource::box(xlo2, xhi2, ylo,  yhi,  f_val * scale),   // Bottom-right
+        HeatSource::box(xlo,  xhi,  ylo2, yhi2, f_val * scale),   // Top-left
+        HeatSource::box(xlo2, xhi2, ylo2, yhi2, f_val * scale)    // Top-right
+    });
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+void BasicHeatEquationSolver2D<Real, Boundary, Stencil>::set_sources(const std::vector<HeatSource>& sources) {
+    const bool px = bc::resolve<typename Boundary::west>(bc_[WEST].kind) == BoundaryKind::PERIODIC;
+    const bool py = bc::resolve<typename Boundary::south>(bc_[SOUTH].kind) == BoundaryKind::PERIODIC;
+    sources_.rasterise_2d(sources, nx_, ny_, dx_, dy_, x_, y_, px, py);
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+void BasicHeatEquationSolver2D<Real, Boundary, Stencil>::set_moving_sources(const std::vector<MovingSource>& sources) {
+    const bool px = bc::resolve<typename Boundary::west>(bc_[WEST].kind) == BoundaryKind::PERIODIC;
+    const bool py = bc::resolve<typename Boundary::south>(bc_[SOUTH].kind) == BoundaryKind::PERIODIC;
+    sources_.set_moving_2d(sources, nx_, ny_, dx_, dy_, x_, y_, px, py);
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+void BasicHeatEquationSolver2D<Real, Boundary, Stencil>::set_mask(const DomainMask& mask) {
+    const bool pw = bc::resolve<typename Boundary::west>(bc_[WEST].kind) == BoundaryKind::PERIODIC;
+    const bool ps = bc::resolve<typename Boundary::south>(bc_[SOUTH].kind) == BoundaryKind::PERIODIC;
+    const int nx = nx_;
+    const int ny = ny_;
+
+    runs_.build(mask, nx, ny, dx_, dy_, x_, y_);
+    mask_face_ = mask.face();
+    mask_kelvin_ = mask.face_value() + KELVIN_OFFSET;
+
+    hole_.clear();
+    if (runs_.masked()) {
+        // Flag the active nodes whose stencil reaches into a hole
+        hole_.assign(static_cast<size_t>(nx) * ny, 0);
+        for (int j = 0; j < ny; j++) {
+            const int jd = (j > 0) ? j - 1 : (ps ? ny - 1 : 1);
+            const int ju = (j < ny - 1) ? j + 1 : (ps ? 0 : ny - 2);
+            for (int i = 0; i < nx; i++) {
+                if (!runs_.active(idx(i, j))) continue;
+                const int il = (i > 0) ? i - 1 : (pw ? nx - 1 : 1);
+                const int ir = (i < nx - 1) ? i + 1 : (pw ? 0 : nx - 2);
+                hole_[idx(i, j)] = !runs_.active(idx(il, j)) || !runs_.active(idx(ir, j)) ||
+                                   !runs_.active(idx(i, jd)) || !runs_.active(idx(i, ju));
+            }
+        }
+    }
+    fill_holes();
+    if (krylov_) build_krylov();
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+void BasicHeatEquationSolver2D<Real, Boundary, Stencil>::set_time_step(double dt) {
+    if (!(dt > 0.0)) throw std::invalid_argument("time step must be positive");
+    dt_ = dt;
+    assemble();
+    if (krylov_) build_krylov();
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+void BasicHeatEquationSolver2D<Real, Boundary, Stencil>::set_krylov(std::optional<KrylovOptions> options) {
+    if (options) {
+        if (options->method == KrylovMethod::CG) {
+            throw std::invalid_argument("plate matrix is nonsymmetric: use BiCGStab or GMRES");
+        }
+        if (mat_.changes_phase()) {
+            throw std::invalid_argument("Krylov solves do not support phase change");
+        }
+        for (const BoundaryCondition& c : bc_) {
+            if (c.is_radiative()) throw std::invalid_argument("Krylov solves do not support radiative edges");
+        }
+    }
+    krylov_ = options;
+    if (krylov_) {
+        build_krylov();
+    } else {
+        krylov_solver_ = KrylovSolver();
+    }
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+CsrMatrix BasicHeatEquationSolver2D<Real, Boundary, Stencil>::extract_matrix(
+    std::vector<unsigned char>& unknown
+) const
+{
+    const bool pw = bc::resolve<typename Boundary::west>(bc_[WEST].kind) == BoundaryKind::PERIODIC;
+    const bool pe = bc::resolve<typename Boundary::east>(bc_[EAST].kind) == BoundaryKind::PERIODIC;
+    const bool ps = bc::resolve<typename Boundary::south>(bc_[SOUTH].kind) == BoundaryKind::PERIODIC;
+    const bool pn = bc::resolve<typename Boundary::north>(bc_[NORTH].kind) == BoundaryKind::PERIODIC;
+    const int nx = nx_;
+    const int ny = ny_;
+    const int nn = nx * ny;
+
+    // Nodes the stencil of each node can reach (mirror ghosts, wrap-around)
+    constexpr int W = 5;
+    std::vector<int> reach(static_cast<size_t>(nn) * W);
+    for (int j = 0; j < ny; j++) {
+        const int jd = (j > 0) ? j - 1 : (ps ? ny - 1 : 1);
+        const int ju = (j < ny - 1) ? j + 1 : (pn ? 0 : ny - 2);
+        for (int i = 0; i < nx; i++) {
+            int* r = &reach[static_cast<size_t>(idx(i, j)) * W];
+            r[0] = idx(i, j);
+            r[1] = idx((i > 0) ? i - 1 : (pw ? nx - 1 : 1), j);
+            r[2] = idx((i < nx - 1) ? i + 1 : (pe ? 0 : nx - 2), j);
+            r[3] = idx(i, jd);
+            r[4] = idx(i, ju);
+        }
+    }
+
+    // Transpose of reach in CSR form: the nodes whose stencil reaches c are
+    // from[from_ptr[c] .. from_ptr[c + 1])
+    std::vector<int> from_ptr(nn + 1, 0);
+    for (int r : reach) from_ptr[r + 1]++;
+    for (int c = 0; c < nn; c++) from_ptr[c + 1] += from_ptr[c];
+    std::vector<int> from(reach.size());
+    std::vector<int> fill(from_ptr.begin(), from_ptr.end() - 1);
+    for (int k = 0; k < nn; k++) {
+        for (int m = 0; m < W; m++) from[fill[reach[static_cast<size_t>(k) * W + m]]++] = k;
+    }
+
+    // Greedy colouring: nodes reached from a common node get different colours
+    std::vector<int> colour(nn, -1);
+    int colours = 0;
+    std::vector<int> taken;
+    for (int c = 0; c < nn; c++) {
+        taken.assign(colours + 1, 0);
+        for (int f = from_ptr[c]; f < from_ptr[c + 1]; f++) {
+            const int k = from[f];
+            for (int m = 0; m < W; m++) {
+                const int other = colour[reach[static_cast<size_t>(k) * W + m]];
+                if (other >= 0) taken[other] = 1;
+            }
+        }
+        colour[c] = static_cast<int>(std::find(taken.begin(), taken.end(), 0) - taken.begin());
+        colours = std::max(colours, colour[c] + 1);
+    }
+
+    // Unknowns: the nodes the sweeps visit
+    unknown.assign(nn, 0);
+    traverse<double>(u_, 0.0, [&](int k, double, double, double, double, double) { unknown[k] = 1; });
+
+    // Row k of A·v is diag·v_k - neighbours; v = indicator of one colour
+    // isolates one coefficient per row
+    std::vector<double> coef(static_cast<size_t>(nn) * W, 0.0);
+    std::vector<Real> probe(nn);
+    for (int c = 0; c < colours; c++) {
+        for (int k = 0; k < nn; k++) probe[k] = (colour[k] == c) ? Real(1) : Real(0);
+        traverse<double>(probe, 0.0, [&](int k, double nb, double diag, double, double, double) {
+            const double y = diag * static_cast<double>(probe[k]) - nb;
+            for (int m = 0; m < W; m++) {
+                if (colour[reach[static_cast<size_t>(k) * W + m]] == c) {
+                    coef[static_cast<size_t>(k) * W + m] = y;
+                    break;
+                }
+            }
+        });
+    }
+
+    CsrMatrix A;
+    A.n = nn;
+    A.row_ptr.assign(nn + 1, 0);
+    std::vector<std::pair<int, double>> row;
+    for (int k = 0; k < nn; k++) {
+        row.clear();
+        if (!unknown[k]) {
+            row.emplace_back(k, 1.0);
+        } else {
+            for (int m = 0; m < W; m++) {
+                const int j = reach[static_cast<size_t>(k) * W + m];
+                const double a = coef[static_cast<size_t>(k) * W + m];
+                if (!unknown[j] || (a == 0.0 && j != k)) continue;
+                auto it = std::find_if(row.begin(), row.end(), [&](const auto& e) { return e.first == j; });
+                if (it == row.end()) row.emplace_back(j, a);
+            }
+            std::sort(row.begin(), row.end());
+        }
+        for (const auto& e : row) {
+            A.col.push_back(e.first);
+            A.val.push_back(e.second);
+        }
+        A.row_ptr[k + 1] = static_cast<int>(A.col.size());
+    }
+    return A;
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+void BasicHeatEquationSolver2D<Real, Boundary, Stencil>::build_krylov() {
+    std::vector<unsigned char> unknown;
+    krylov_solver_ = KrylovSolver(extract_matrix(unknown), *krylov_);
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+LinearStep BasicHeatEquationSolver2D<Real, Boundary, Stencil>::linear_step() const {
+    if (mat_.changes_phase()) {
+        throw std::invalid_argument("linear step: phase change is nonlinear");
+    }
+    for (const BoundaryCondition& c : bc_) {
+        if (c.is_radiative()) throw std::invalid_argument("linear step: radiative edges are nonlinear");
+        if (c.is_time_dependent()) throw std::invalid_argument("linear step: edge values must be constant");
+    }
+    if (sources_.has_moving()) {
+        throw std::invalid_argument("linear step: moving sources are not supported");
+    }
+
+    const int nn = nx_ * ny_;
+    LinearStep ls;
+    std::vector<unsigned char> unknown;
+    ls.A = extract_matrix(unknown);
+    ls.dt = dt_;
+    ls.method = krylov_ ? StepMethod::KRYLOV
+              : std::is_same_v<Real, double> ? StepMethod::SWEEPS : StepMethod::MIXED_PRECISION;
+    ls.omega = omega_;
+    ls.tol = SWEEP_TOL;
+    ls.max_sweeps = MAX_SWEEPS;
+    ls.fixed.resize(nn);
+    for (int k = 0; k < nn; k++) ls.fixed[k] = !unknown[k];
+
+    // Imposed values, then the edge terms and the pull of the fixed
+    // neighbours on the free rows
+    std::vector<Real> v(nn, Real(0));
+    for (int k = 0; k < nn; k++) {
+        if (!unknown[k]) v[k] = u_[k];
+    }
+    apply_dirichlet(v, Real(1));
+    ls.b.assign(v.begin(), v.end());
+    traverse<double>(v, 1.0, [&](int k, double nb, double, double, double extra, double) {
+        ls.b[k] = extra + nb;
+    });
+
+    const double coef = dt_ / (mat_.rho * mat_.c);
+    for (std::size_t s = 0; s < sources_.size(); s++) {
+        std::vector<double> f = sources_.footprint(s, nn, coef);
+        for (int k = 0; k < nn; k++) {
+            if (!unknown[k]) f[k] = 0.0;
+        }
+        ls.sources.push_back(std::move(f));
+        ls.modulations.push_back(sources_.modulation(s));
+    }
+    return ls;
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+void BasicHeatEquationSolver2D<Real, Boundary, Stencil>::fill_holes() {
+    if (!runs_.masked()) return;
+    const Real value = static_cast<Real>(mask_face_ == MaskFace::FIXED ? mask_kelvin_ : u0_kelvin_);
+    for (int k = 0; k < nx_ * ny_; k++) {
+        if (!runs_.active(k)) u_[k] = value;
+    }
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+void BasicHeatEquationSolver2D<Real, Boundary, Stencil>::assemble() {
+    const bool px = bc::resolve<typename Boundary::west>(bc_[WEST].kind) == BoundaryKind::PERIODIC;
+    const bool py = bc::resolve<typename Boundary::south>(bc_[SOUTH].kind) == BoundaryKind::PERIODIC;
+
+    // Periodic axes: n distinct nodes, node n is node 0
+    dx_ = px ? Lx_ / nx_ : Lx_ / (nx_ - 1);
+    dy_ = py ? Ly_ / ny_ : Ly_ / (ny_ - 1);
+
+    // Anisotropic conduction: λx along x, λy along y
+    const double ax_dt = mat_.alpha() * dt_;
+    const double ay_dt = mat_.alpha_y() * dt_;
+    rx_ = ax_dt / (dx_ * dx_);
+    ry_ = ay_dt / (dy_ * dy_);
+    omega_ = Stencil::omega(rx_, ry_, nx_, ny_);
+
+    // Stretched grid: per-column and per-row couplings
+    const std::vector<double> hx = spacings(x_, dx_, nx_);
+    const std::vector<double> hy = spacings(y_, dy_, ny_);
+    xlo_.clear();
+    xhi_.clear();
+    ylo_.clear();
+    yhi_.clear();
+    if (!x_.empty() || !y_.empty()) {
+        axis_couplings(ax_dt, hx, px, xlo_, xhi_);
+        axis_couplings(ay_dt, hy, py, ylo_, yhi_);
+    }
+
+    // Edge terms use the spacing normal to each edge
+    const double hw = hx[0], he = hx[nx_ - 2];
+    const double hs = hy[0], hn = hy[ny_ - 2];
+    const double lambda_y = mat_.conductivity_y();
+    edge_terms(ax_dt / (hw * hw), hw, mat_.lambda, bc_[WEST],  edge_diag_[WEST],  edge_rhs_[WEST]);
+    edge_terms(ax_dt / (he * he), he, mat_.lambda, bc_[EAST],  edge_diag_[EAST],  edge_rhs_[EAST]);
+    edge_terms(ay_dt / (hs * hs), hs, lambda_y,    bc_[SOUTH], edge_diag_[SOUTH], edge_rhs_[SOUTH]);
+    edge_terms(ay_dt / (hn * hn), hn, lambda_y,    bc_[NORTH], edge_diag_[NORTH], edge_rhs_[NORTH]);
+    edge_rad_[WEST]  = edge_radiation(ax_dt / (hw * hw), hw, mat_.lambda, bc_[WEST],  edge_rhs_[WEST]);
+    edge_rad_[EAST]  = edge_radiation(ax_dt / (he * he), he, mat_.lambda, bc_[EAST],  edge_rhs_[EAST]);
+    edge_rad_[SOUTH] = edge_radiation(ay_dt / (hs * hs), hs, lambda_y,    bc_[SOUTH], edge_rhs_[SOUTH]);
+    edge_rad_[NORTH] = edge_radiation(ay_dt / (hn * hn), hn, lambda_y,    bc_[NORTH], edge_rhs_[NORTH]);
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+template <typename T, typename Op>
+void BasicHeatEquationSolver2D<Real, Boundary, Stencil>::traverse(
+    const std::vector<Real>& v,
+    T bscale,
+    Op&& op
+) const
+{
+    const BoundaryKind kw = bc::resolve<typename Boundary::west>(bc_[WEST].kind);
+    const BoundaryKind ke = bc::resolve<typename Boundary::east>(bc_[EAST].kind);
+    const BoundaryKind ks = bc::resolve<typename Boundary::south>(bc_[SOUTH].kind);
+    const BoundaryKind kn = bc::resolve<typename Boundary::north>(bc_[NORTH].kind);
+
+    const int nx = nx_;
+    const int ny = ny_;
+    const bool pw = (kw == BoundaryKind::PERIODIC);
+    const bool pe = (ke == BoundaryKind::PERIODIC);
+    const bool ps = (ks == BoundaryKind::PERIODIC);
+    const bool pn = (kn == BoundaryKind::PERIODIC);
+
+    // Dirichlet rows/columns are not unknowns
+    const bool do_west = (kw != BoundaryKind::DIRICHLET);
+    const bool do_east = (ke != BoundaryKind::DIRICHLET);
+    const int j0 = (ks == BoundaryKind::DIRICHLET) ? 1 : 0;
+    const int j1 = (kn == BoundaryKind::DIRICHLET) ? ny - 1 : ny;
+
+    const T rx = static_cast<T>(rx_);
+    const T ry = static_cast<T>(ry_);
+    const T base = T(1) + T(2) * rx + T(2) * ry;
+
+    // Robin exchange / flux terms (zero for periodic edges)
+    const T dw = static_cast<T>(edge_diag_[WEST]);
+    const T de = static_cast<T>(edge_diag_[EAST]);
+    const T ds = static_cast<T>(edge_diag_[SOUTH]);
+    const T dn = static_cast<T>(edge_diag_[NORTH]);
+    const T bw = bscale * static_cast<T>(edge_rhs_[WEST]);
+    const T be = bscale * static_cast<T>(edge_rhs_[EAST]);
+    const T bs = bscale * static_cast<T>(edge_rhs_[SOUTH]);
+    const T bn = bscale * static_cast<T>(edge_rhs_[NORTH]);
+
+    // Radiative edges: coefficient of -u⁴
+    const T qw = static_cast<T>(edge_rad_[WEST]);
+    const T qe = static_cast<T>(edge_rad_[EAST]);
+    const T qs = static_cast<T>(edge_rad_[SOUTH]);
+    const T qn = static_cast<T>(edge_rad_[NORTH]);
+
+    const Real* u = v.data();
+    const bool masked = runs_.masked();
+    const int* run_begin = runs_.begin();
+    const int* run_end = runs_.end();
+
+    // Hole faces: fixed temperature enters the RHS, insulated faces mirror
+    const bool fixed_faces = (mask_face_ == MaskFace::FIXED);
+    const T hole_value = bscale * static_cast<T>(mask_kelvin_);
+
+    // Stretched grid: couplings vary from node to node
+    const bool stretched = !xlo_.empty();
+
+    // Column neighbours: interior, mirror ghost column, or wrap-around
+    auto west_of = [&](int i) { return (i > 0) ? i - 1 : (pw ? nx - 1 : 1); };
+    auto east_of = [&](int i) { return (i < nx - 1) ? i + 1 : (pe ? 0 : nx - 2); };
+
+    // One axis of a node next to a hole: lo/hi are the neighbour indices
+    // and rlo/rhi their couplings
+    auto axis = [&](int lo, int hi, T rlo, T rhi, T& nb, T& diag, T& extra) {
+        const bool lo_hole = !runs_.active(lo);
+        const bool hi_hole = !runs_.active(hi);
+        if (!lo_hole && !hi_hole) {
+            nb += rlo * T(u[lo]) + rhi * T(u[hi]);
+        } else if (fixed_faces) {
+            if (lo_hole) extra += rlo * hole_value; else nb += rlo * T(u[lo]);
+            if (hi_hole) extra += rhi * hole_value; else nb += rhi * T(u[hi]);
+        } else if (lo_hole && hi_hole) {
+            diag -= rlo + rhi;  // no flux along this axis
+        } else {
+            nb += (rlo + rhi) * T(u[lo_hole ? hi : lo]);
+        }
+    };
+
+    for (int j = j0; j < j1; ++j) {
+        // Row neighbours: interior, mirror ghost row, or wrap-around
+        const int jd = (j > 0) ? j - 1 : (ps ? ny - 1 : 1);
+        const int ju = (j < ny - 1) ? j + 1 : (pn ? 0 : ny - 2);
+
+        T ydiag = T(0);
+        T yrhs = T(0);
+        T yrad = T(0);
+        if (j == 0)     { ydiag += ds; yrhs += bs; yrad += qs; }
+        if (j == ny - 1) { ydiag += dn; yrhs += bn; yrad += qn; }
+
+        const Real* row  = u + j * nx;
+        const Real* down = u + jd * nx;
+        const Real* up   = u + ju * nx;
+        const int k0 = j * nx;
+
+        const T diag = base + ydiag;
+        const T inv_diag = T(1) / diag;
+
+        // Couplings to the rows below and above
+        const T yl = stretched ? static_cast<T>(ylo_[j]) : ry;
+        const T yh = stretched ? static_cast<T>(yhi_[j]) : ry;
+
+        // Node bordering a hole: neighbours resolved one by one
+        auto near_hole = [&](int i, T d, T extra, T rad) {
+            const T xl = stretched ? static_cast<T>(xlo_[i]) : rx;
+            const T xh = stretched ? static_cast<T>(xhi_[i]) : rx;
+            T nb = T(0);
+            axis(k0 + west_of(i), k0 + east_of(i), xl, xh, nb, d, extra);
+            axis(jd * nx + i, ju * nx + i, yl, yh, nb, d, extra);
+            op(k0 + i, nb, d, T(1) / d, extra, rad);
+        };
+
+        // Stretched grid: node with its own couplings, edge terms in ddiag
+        auto variable = [&](int i, T ddiag, T extra, T rad) {
+            const T xl = static_cast<T>(xlo_[i]);
+            const T xh = static_cast<T>(xhi_[i]);
+            const T d = T(1) + (xl + xh) + (yl + yh) + ddiag;
+            if (masked && hole_[k0 + i]) {
+                near_hole(i, d, extra, rad);
+                return;
+            }
+            op(k0 + i, xl * T(row[west_of(i)]) + xh * T(row[east_of(i)])
+                     + yl * T(down[i]) + yh * T(up[i]),
+               d, T(1) / d, extra, rad);
+        };
+
+        for (int r = runs_.row_ptr(j); r < runs_.row_ptr(j + 1); ++r) {
+            int i0 = run_begin[r];
+            int i1 = run_end[r];
+
+            if (stretched) {
+                if (i0 == 0) {
+                    if (do_west) variable(0, ydiag + dw, yrhs + bw, yrad + qw);
+                    i0 = 1;
+                }
+                const bool east = (i1 == nx);
+                if (east) i1 = nx - 1;
+                for (int i = i0; i < i1; ++i) variable(i, ydiag, yrhs, yrad);
+                if (east && do_east) variable(nx - 1, ydiag + de, yrhs + be, yrad + qe);
+                continue;
+            }
+
+            if (i0 == 0) {
+                if (do_west) {
+                    T diag_w = diag + dw;
+                    if (masked && hole_[k0]) {
+                        near_hole(0, diag_w, yrhs + bw, yrad + qw);
+                    } else {
+                        T left = pw ? T(row[nx - 1]) : T(row[1]);
+                        op(k0, rx * (left + T(row[1])) + ry * (T(down[0]) + T(up[0])),
+                           diag_w, T(1) / diag_w, yrhs + bw, yrad + qw);
+                    }
+                }
+                i0 = 1;
+            }
+            const bool east = (i1 == nx);
+            if (east) i1 = nx - 1;
+
+            // Interior of the run: identical for every boundary configuration
+            if (!masked) {
+                for (int i = i0; i < i1; ++i) {
+                    op(k0 + i, rx * (T(row[i - 1]) + T(row[i + 1])) + ry * (T(down[i]) + T(up[i])),
+                       diag, inv_diag, yrhs, yrad);
+                }
+            } else {
+                for (int i = i0; i < i1; ++i) {
+                    if (hole_[k0 + i]) {
+                        near_hole(i, diag, yrhs, yrad);
+                        continue;
+                    }
+                    op(k0 + i, rx * (T(row[i - 1]) + T(row[i + 1])) + ry * (T(down[i]) + T(up[i])),
+                       diag, inv_diag, yrhs, yrad);
+                }
+            }
+
+            if (east && do_east) {
+                T diag_e = diag + de;
+                if (masked && hole_[k0 + nx - 1]) {
+                    near_hole(nx - 1, diag_e, yrhs + be, yrad + qe);
+                } else {
+                    T right = pe ? T(row[0]) : T(row[nx - 2]);
+                    op(k0 + nx - 1, rx * (T(row[nx - 2]) + right) + ry * (T(down[nx - 1]) + T(up[nx - 1])),
+                       diag_e, T(1) / diag_e, yrhs + be, yrad + qe);
+                }
+            }
+        }
+    }
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+void BasicHeatEquationSolver2D<Real, Boundary, Stencil>::apply_dirichlet(
+    std::vector<Real>& v,
+    Real bscale
+) const
+{
+    const BoundaryKind kinds[4] = {
+        bc::resolve<typename Boundary::west>(bc_[WEST].kind),
+        bc::resolve<typename Boundary::east>(bc_[EAST].kind),
+        bc::resolve<typename Boundary::south>(bc_[SOUTH].kind),
+        bc::resolve<typename Boundary::north>(bc_[NORTH].kind)
+    };
+
+    // Columns first, rows last: rows own the corners
+    for (int e : {WEST, EAST}) {
+        if (kinds[e] != BoundaryKind::DIRICHLET) continue;
+        Real value = bscale * static_cast<Real>(edge_rhs_[e]);
+        int i = (e == WEST) ? 0 : nx_ - 1;
+        for (int j = 0; j < ny_; j++) v[idx(i, j)] = value;
+    }
+    for (int e : {SOUTH, NORTH}) {
+        if (kinds[e] != BoundaryKind::DIRICHLET) continue;
+        Real value = bscale * static_cast<Real>(edge_rhs_[e]);
+        int j = (e == SOUTH) ? 0 : ny_ - 1;
+        std::fill(v.begin() + idx(0, j), v.begin() + idx(0, j) + nx_, value);
+    }
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+Real BasicHeatEquationSolver2D<Real, Boundary, Stencil>::sweep(
+    std::vector<Real>& v,
+    const std::vector<Real>& rhs,
+    Real bscale
+) const
+{
+    Real* w = v.data();
+    const Real* b = rhs.data();
+    const Real omega = static_cast<Real>(omega_);
+    Real max_diff = Real(0);
+
+    traverse<Real>(v, bscale, [&](int k, Real nb, Real diag, Real inv_diag, Real extra, Real rad) {
+        Real target;
+        if (rad == Real(0)) {
+            target = (b[k] + extra + nb) * inv_diag;
+        } else if (bscale != Real(0)) {
+            // Radiative edge node: solve diag·u + rad·u⁴ = rhs exactly
+            target = static_cast<Real>(radiative_root(diag, rad, b[k] + extra + nb, w[k]));
+        } else {
+            // Correction equation: Jacobian of the radiative row at u_new_
+            const Real u = u_new_[k];
+            target = (b[k] + extra + nb) / (diag + Real(4) * rad * u * u * u);
+        }
+        Real next = Stencil::relax(w[k], target, omega);
+        max_diff = std::max(max_diff, std::abs(next - w[k]));
+        w[k] = next;
+    });
+    return max_diff;
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+Real BasicHeatEquationSolver2D<Real, Boundary, Stencil>::sweep_phase(const std::vector<Real>& rhs) {
+    const Phase phase(mat_);
+    Real* w = u_new_.data();
+    Real* f = frac_new_.data();
+    const Real* f_old = frac_.data();
+    const Real* b = rhs.data();
+    const Real omega = static_cast<Real>(omega_);
+    Real max_diff = Real(0);
+
+    traverse<Real>(u_new_, Real(1), [&](int k, Real nb, Real diag, Real, Real extra, Real rad) {
+        // Radiative edge node: -rad·u⁴ linearised at the current iterate
+        const double u = static_cast<double>(w[k]);
+        const double u3 = u * u * u;
+        double T, fk;
+        phase.invert(diag + 4.0 * rad * u3,
+                     static_cast<double>(b[k] + extra + nb) + phase.lc * f_old[k] + 3.0 * rad * u3 * u,
+                     T, fk);
+        Real next = Stencil::relax(w[k], static_cast<Real>(T), omega);
+        f[k] = std::clamp(Stencil::relax(f[k], static_cast<Real>(fk), omega), Real(0), Real(1));
+        max_diff = std::max(max_diff, std::abs(next - w[k]));
+        w[k] = next;
+    });
+    return max_diff;
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+template <typename R>
+double BasicHeatEquationSolver2D<Real, Boundary, Stencil>::residual(
+    const std::vector<Real>& v,
+    const std::vector<double>& rhs,
+    std::vector<R>& res
+) const
+{
+    PROFILE_ZONE("residual");
+    double max_res = 0.0;
+    std::fill(res.begin(), res.end(), R(0));
+
+    traverse<double>(v, 1.0, [&](int k, double nb, double diag, double, double extra, double rad) {
+        const double u = static_cast<double>(v[k]);
+        double ri = rhs[k] + extra + nb - diag * u - rad * u * u * u * u;
+        res[k] = static_cast<R>(ri);
+        max_res = std::max(max_res, std::abs(ri) / diag);
+    });
+    return max_res;
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+bool BasicHeatEquationSolver2D<Real, Boundary, Stencil>::step() {
+    if (t_ >= tmax_) return false;
+    PROFILE_ZONE("step 2d");
+    const auto start = std::chrono::steady_clock::now();
+
+    double src_coef = dt_ / (mat_.rho * mat_.c);
+    const int nn = nx_ * ny_;
+
+    // Implicit step: edge temperatures are imposed at t + dt
+    for (int e : {WEST, EAST, SOUTH, NORTH}) {
+        refresh_edge(bc_[e], t_ + dt_, edge_rhs_[e]);
+    }
+
+    {
+        PROFILE_ZONE("copy");
+        u_new_ = u_;
+        rhs_ = u_;
+    }
+    {
+        PROFILE_ZONE("rhs");
+        sources_.move_to(t_ + dt_);
+        sources_.add_to(rhs_, t_ + dt_, src_coef);
+        apply_dirichlet(u_new_, Real(1));
+    }
+
+    // Gauss-Seidel parameters
+    const int max_iter = MAX_SWEEPS;
+    const double tol = SWEEP_TOL;
+    iterations_ = 0;
+    residual_ = 0.0;
+
+    // First and last convergence measures of the step and the iteration
+    // counts at which they were taken, for its statistics
+    StepStats stats;
+    int first_at = -1;
+    int last_at = 0;
+    auto measure = [&](double r) {
+        if (first_at < 0) {
+            stats.initial_residual = r;
+            first_at = iterations_;
+        }
+        last_at = iterations_;
+        residual_ = r;
+        return r;
+    };
+
+    if (mat_.changes_phase()) {
+        // Nonlinear sweeps in storage precision
+        const Real ptol = static_cast<Real>(std::is_same_v<Real, double> ? tol : tol * u0_kelvin_);
+        PROFILE_ZONE("sweeps");
+        frac_new_ = frac_;
+        while (iterations_ < max_iter) {
+            iterations_++;
+            if (measure(sweep_phase(rhs_)) < ptol) {
+                stats.converged = true;
+                break;
+            }
+        }
+
+        // Dirichlet edges are not swept: their fraction follows the imposed value
+        const Phase phase(mat_);
+        const BoundaryKind kinds[4] = {
+            bc::resolve<typename Boundary::west>(bc_[WEST].kind),
+            bc::resolve<typename Boundary::east>(bc_[EAST].kind),
+            bc::resolve<typename Boundary::south>(bc_[SOUTH].kind),
+            bc::resolve<typename Boundary::north>(bc_[NORTH].kind)
+        };
+        for (int e : {WEST, EAST, SOUTH, NORTH}) {
+            if (kinds[e] != BoundaryKind::DIRICHLET) continue;
+            const bool column = (e == WEST || e == EAST);
+            const int line = (e == WEST || e == SOUTH) ? 0 : (column ? nx_ - 1 : ny_ - 1);
+            for (int m = 0; m < (column ? ny_ : nx_); m++) {
+                const int k = column ? idx(line, m) : idx(m, line);
+                frac_new_[k] = static_cast<Real>(phase.fraction(u_new_[k]));
+            }
+        }
+        frac_.swap(frac_new_);
+    } else if (krylov_) {
+        // Krylov solve of the correction A·e = rhs - A·u, in double
+        PROFILE_ZONE("krylov");
+        std::vector<double> rhs_d(u_.begin(), u_.end());
+        sources_.add_to(rhs_d, t_ + dt_, src_coef);
+        const double ktol = std::is_same_v<Real, double> ? tol : REFINE_TOL;
+        std::vector<double> res(nn);
+        std::vector<double> e(nn);
+        for (int pass = 0; ; pass++) {
+            if (measure(residual(u_new_, rhs_d, res)) < ktol) {
+                stats.converged = true;
+                break;
+            }
+            if (pass == MAX_REFINE) break;
+            std::fill(e.begin(), e.end(), 0.0);
+            iterations_ += krylov_solver_.solve(res, e).iterations;
+            for (int k = 0; k < nn; k++) u_new_[k] += static_cast<Real>(e[k]);
+        }
+    } else if constexpr (std::is_same_v<Real, double>) {
+        PROFILE_ZONE("sweeps");
+        while (iterations_ < max_iter) {
+            iterations_++;
+            if (measure(sweep(u_new_, rhs_, 1.0)) < tol) {
+                stats.converged = true;
+                break;
+            }
+        }
+    } else {
+        // Mixed precision: smooth in float, measure residuals in double
+        std::vector<double> rhs_d(u_.begin(), u_.end());
+        sources_.add_to(rhs_d, t_ + dt_, src_coef);
+
+        // Float smoothing down to single-precision resolution
+        const Real ftol = static_cast<Real>(tol * u0_kelvin_);
+        {
+            PROFILE_ZONE("sweeps");
+            while (iterations_ < max_iter) {
+                iterations_++;
+                if (sweep(u_new_, rhs_, Real(1)) < ftol) break;
+            }
+        }
+
+        // Iterative refinement: A·e = rhs - A·u, smoothed in float
+        PROFILE_ZONE("refinement");
+        std::vector<Real> res(nn);
+        std::vector<Real> e(nn);
+        for (int pass = 0; ; pass++) {
+            if (measure(residual(u_new_, rhs_d, res)) < REFINE_TOL) {
+                stats.converged = true;
+                break;
+            }
+            if (pass == MAX_REFINE) break;
+
+            std::fill(e.begin(), e.end(), Real(0));
+            for (int iter = 0; iter < max_iter; iter++) {
+                iterations_++;
+                if (sweep(e, res, Real(0)) < static_cast<Real>(tol)) break;
+            }
+            for (int k = 0; k < nn; k++) u_new_[k] += e[k];
+        }
+    }
+
+    u_.swap(u_new_);
+    t_ += dt_;
+
+    stats.time = t_;
+    stats.iterations = iterations_;
+    stats.final_residual = residual_;
+    if (last_at > first_at && stats.initial_residual > 0.0 && stats.final_residual > 0.0) {
+        stats.rate = std::pow(stats.final_residual / stats.initial_residual, 1.0 / (last_at - first_at));
+    }
+    stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    stats_.push(stats);
+    if (!stats.converged) unconverged_++;
+    return true;
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+std::vector<std::vector<double>> BasicHeatEquationSolver2D<Real, Boundary, Stencil>::get_temperature_2d() const {
+    PROFILE_ZONE("field copy");
+    std::vector<std::vector<double>> result(ny_, std::vector<double>(nx_));
+    for (int j = 0; j < ny_; j++) {
+        for (int i = 0; i < nx_; i++) {
+            result[j][i] = static_cast<double>(u_[idx(i, j)]);
+        }
+    }
+    return result;
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+std::vector<double> BasicHeatEquationSolver2D<Real, Boundary, Stencil>::get_x() const {
+    return node_coordinates(x_, dx_, nx_);
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+std::vector<double> BasicHeatEquationSolver2D<Real, Boundary, Stencil>::get_y() const {
+    return node_coordinates(y_, dy_, ny_);
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+double BasicHeatEquationSolver2D<Real, Boundary, Stencil>::get_liquid_fraction() const {
+    if (frac_.empty()) return 0.0;
+    const bool px = bc::resolve<typename Boundary::west>(bc_[WEST].kind) == BoundaryKind::PERIODIC;
+    const bool py = bc::resolve<typename Boundary::south>(bc_[SOUTH].kind) == BoundaryKind::PERIODIC;
+    const std::vector<double> cx = cell_sizes(get_x(), px ? Lx_ : 0.0, 0);
+    const std::vector<double> cy = cell_sizes(get_y(), py ? Ly_ : 0.0, 0);
+
+    double liquid = 0.0;
+    double total = 0.0;
+    for (int j = 0; j < ny_; j++) {
+        for (int i = 0; i < nx_; i++) {
+            if (!runs_.active(idx(i, j))) continue;
+            liquid += cx[i] * cy[j] * static_cast<double>(frac_[idx(i, j)]);
+            total += cx[i] * cy[j];
+        }
+    }
+    return (total > 0.0) ? liquid / total : 0.0;
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+double BasicHeatEquationSolver2D<Real, Boundary, Stencil>::probe(double x, double y) const {
+    int i, j;
+    double s, r;
+    grid::locate(get_x(), x, i, s);
+    grid::locate(get_y(), y, j, r);
+    auto u = [&](int a, int b) { return static_cast<double>(u_[idx(a, b)]); };
+    return (1.0 - r) * ((1.0 - s) * u(i, j) + s * u(i + 1, j))
+         + r * ((1.0 - s) * u(i, j + 1) + s * u(i + 1, j + 1));
+}
+
+template <typename Real, typename Boundary, typename Stencil>
+void BasicHeatEquationSolver2D<Real, Boundary, Stencil>::reset() {
+    t_ = 0.0;
+    iterations_ = 0;
+    residual_ = 0.0;
+    stats_.clear();
+    unconverged_ = 0;
+    std::fill(u_.begin(), u_.end(), static_cast<Real>(u0_kelvin_));
+    if (!frac_.empty()) {
+        std::fill(frac_.begin(), frac_.end(), static_cast<Real>(Phase(mat_).fraction(u0_kelvin_)));
+    }
+    fill_holes();
+}
+
+// Both precisions of the default and generic configurations are always
+// compiled; the factory instantiates the remaining ones
+template class BasicHeatEquationSolver1D<double>;
+template class BasicHeatEquationSolver1D<float>;
+template class BasicHeatEquationSolver2D<double>;
+template class BasicHeatEquationSolver2D<float>;
+template class BasicHeatEquationSolver2D<double, DefaultBoundary2D, stencil::FivePointSOR>;
+template class BasicHeatEquationSolver2D<float, DefaultBoundary2D, stencil::FivePointSOR>;
+template class BasicHeatEquationSolver2D<double, GenericBoundary2D>;
+template class BasicHeatEquationSolver2D<float, GenericBoundary2D>;
+template class BasicHeatEquationSolver2D<double, GenericBoundary2D, stencil::FivePointSOR>;
+template class BasicHeatEquationSolver2D<float, GenericBoundary2D, stencil::FivePointSOR>;
+
+
+// =============================================================================
+// RUNTIME FACTORY
+// =============================================================================
+
+namespace {
+
+/**
+ * @brief Call f with the edge policy matching a runtime kind.
+ */
+template <typename F>
+auto with_policy(BoundaryKind kind, F&& f) {
+    switch (kind) {
+        case BoundaryKind::DIRICHLET: return f(bc::Dirichlet{});
+        case BoundaryKind::NEUMANN:   return f(bc::Neumann{});
+        case BoundaryKind::ROBIN:     return f(bc::Robin{});
+        default:                      return f(bc::Periodic{});
+    }
+}
+
+/**
+ * @brief Build the 1D instantiation matching bc.
+ *
+ * @param args Constructor arguments preceding the edge conditions
+ */
+template <typename Real, typename... Args>
+std::unique_ptr<HeatSolver1D> build_1d(
+    const std::array<BoundaryCondition, 2>& bc, const Args&... args)
+{
+    return with_policy(bc[LEFT].kind, [&](auto left) {
+        return with_policy(bc[RIGHT].kind, [&](auto right) -> std::unique_ptr<HeatSolver1D> {
+            using Left = std::decay_t<decltype(left)>;
+            using Right = std::decay_t<decltype(right)>;
+            constexpr bool lp = (Left::kind == BoundaryKind::PERIODIC);
+            constexpr bool rp = (Right::kind == BoundaryKind::PERIODIC);
+            if constexpr (lp != rp) {
+                throw std::invalid_argument("periodic boundary conditions must be set on opposite edges");
+            } else {
+                return std::make_unique<BasicHeatEquationSolver1D<Real, Boundary1D<Left, Right>>>(
+                    args..., bc);
+            }
+        });
+    });
+}
+
+/**
+ * @brief Build the 2D instantiation matching bc.
+ *
+ * @param args Constructor arguments preceding the edge conditions
+ */
+template <typename Real, typename Stencil, typename... Args>
+std::unique_ptr<HeatSolver2D> build_2d(
+    const std::array<BoundaryCondition, 4>& bc, const Args&... args)
+{
+    using K = BoundaryKind;
+    auto is = [&](K w, K e, K s, K nn) {
+        return bc[WEST].kind == w && bc[EAST].kind == e && bc[SOUTH].kind == s && bc[NORTH].kind == nn;
+    };
+    auto build = [&](auto boundary) -> std::unique_ptr<HeatSolver2D> {
+        using B = std::decay_t<decltype(boundary)>;
+        return std::make_unique<BasicHeatEquationSolver2D<Real, B, Stencil>>(args..., bc);
+    };
+
+    if (is(K::NEUMANN, K::DIRICHLET, K::NEUMANN, K::DIRICHLET))
+        return build(DefaultBoundary2D{});
+    if (is(K::DIRICHLET, K::DIRICHLET, K::DIRICHLET, K::DIRICHLET))
+        return build(Boundary2D<bc::Dirichlet, bc::Dirichlet, bc::Dirichlet, bc::Dirichlet>{});
+    if (is(K::NEUMANN, K::NEUMANN, K::NEUMANN, K::NEUMANN))
+        return build(Boundary2D<bc::Neumann, bc::Neumann, bc::Neumann, bc::Neumann>{});
+    if (is(K::ROBIN, K::ROBIN, K::ROBIN, K::ROBIN))
+        return build(Boundary2D<bc::Robin, bc::Robin, bc::Robin, bc::Robin>{});
+    if (is(K::PERIODIC, K::PERIODIC, K::PERIODIC, K::PERIODIC))
+        return build(Boundary2D<bc::Periodic, bc::Periodic, bc::Periodic, bc::Periodic>{});
+    if (is(K::DIRICHLET, K::ROBIN, K::ROBIN, K::ROBIN))
+        return build(FinBoundary2D{});
+    if (is(K::PERIODIC, K::PERIODIC, K::NEUMANN, K::NEUMANN))
+        return build(RingBoundary2D{});
+    return build(GenericBoundary2D{});
+}
+
+/**
+ * @brief Build the 2D instantiation matching bc and the stencil kind.
+ */
+template <typename... Args>
+std::unique_ptr<HeatSolver2D> build_2d(
+    Precision precision, StencilKind stencil,
+    const std::array<BoundaryCondition, 4>& bc, const Args&... args)
+{
+    check_periodic_pair(bc[WEST], bc[EAST]);
+    check_periodic_pair(bc[SOUTH], bc[NORTH]);
+    if (precision == Precision::MIXED) {
+        if (stencil == StencilKind::SOR) {
+            return build_2d<float, stencil::FivePointSOR>(bc, args...);
+        }
+        return build_2d<float, stencil::FivePoint>(bc, args...);
+    }
+    if (stencil == StencilKind::SOR) {
+        return build_2d<double, stencil::FivePointSOR>(bc, args...);
+    }
+    return build_2d<double, stencil::FivePoint>(bc, args...);
+}
+
+} // namespace
+
+std::unique_ptr<HeatSolver1D> make_solver_1d(
+    const Material& mat,
+    double L,
+    double tmax,
+    double u0,
+    double f,
+    int n,
+    const std::array<BoundaryCondition, 2>& bc,
+    Precision precision
+)
+{
+    check_periodic_pair(bc[LEFT], bc[RIGHT]);
+    if (precision == Precision::MIXED) {
+        return build_1d<float>(bc, mat, L, tmax, u0, f, n);
+    }
+    return build_1d<double>(bc, mat, L, tmax, u0, f, n);
+}
+
+std::unique_ptr<HeatSolver1D> make_solver_1d(
+    const Material& mat,
+    const std::vector<double>& x,
+    double tmax,
+    double u0,
+    double f,
+    const std::array<BoundaryCondition, 2>& bc,
+    Precision precision
+)
+{
+    check_periodic_pair(bc[LEFT], bc[RIGHT]);
+    if (precision == Precision::MIXED) {
+        return build_1d<float>(bc, mat, x, tmax, u0, f);
+    }
+    return build_1d<double>(bc, mat, x, tmax, u0, f);
+}
+
+std::unique_ptr<HeatSolver2D> make_solver_2d(
+    const Material& mat,
+    double L,
+    double tmax,
+    double u0,
+    double f,
+    int n,
+    const std::array<BoundaryCondition, 4>& bc,
+    Precision precision,
+    StencilKind stencil
+)
+{
+    return make_solver_2d(mat, L, L, tmax, u0, f, n, n, bc, precision, stencil);
+}
+
+std::unique_ptr<HeatSolver2D> make_solver_2d(
+    const Material& mat,
+    double Lx,
+    double Ly,
+    double tmax,
+    double u0,
+    double f,
+    int nx,
+    int ny,
+    const std::array<BoundaryCondition, 4>& bc,
+    Precision precision,
+    StencilKind stencil
+)
+{
+    return build_2d(precision, stencil, bc, mat, Lx, Ly, tmax, u0, f, nx, ny);
+}
+
+std::unique_ptr<HeatSolver2D> make_solver_2d(
+    const Material& mat,
+    const std::vector<double>& x,
+    const std::vector<double>& y,
+    double tmax,
+    double u0,
+    double f,
+    const std::array<BoundaryCondition, 4>& bc,
+    Precision precision,
+    StencilKind stencil
+)
+{
+    return build_2d(precision, stencil, bc, mat, x, y, tmax, u0, f);
 }
 
 } // namespace ensiie
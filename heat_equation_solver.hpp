@@ -17,36 +17,441 @@
  *
  * Numerical methods:
  * - 1D: Backward Euler implicit scheme solved with Thomas algorithm
- * - 2D: Backward Euler implicit scheme solved with Gauss–Seidel iterations
+ * - 2D: Backward Euler implicit scheme solved with Gauss–Seidel iterations,
+ *   or with a preconditioned Krylov method (krylov.hpp) on request
+ * - Uniform grids, or stretched tensor-product grids given by their node
+ *   coordinates (grid.hpp), discretised in finite-volume form
+ * - Materials with a latent heat (Material::latent_heat) melt and
+ *   solidify: the energy balance is written for the enthalpy and the
+ *   liquid fraction is iterated within each implicit step
  *
- * Boundary conditions:
- * - Neumann (zero flux) on left/bottom boundaries
- * - Dirichlet (fixed temperature) on right/top boundaries
+ * Boundary conditions (see boundary.hpp):
+ * - Default: Neumann (zero flux) on left/bottom boundaries,
+ *   Dirichlet (fixed temperature) on right/top boundaries
+ * - Any edge may be Dirichlet (constant or time series), Neumann,
+ *   Robin or periodic
+ *
+ * Templates:
+ * The solvers are templates over
+ * - Real:     storage/smoothing precision
+ *             (double: reference; float: mixed precision, fields stored
+ *             and smoothed in float while residuals are evaluated in
+ *             double and fed back through iterative refinement. Results
+ *             stay within MIXED_PRECISION_TOL of the double solver.)
+ * - Boundary: edge policies (Boundary1D / Boundary2D)
+ * - Stencil:  point-update policy of the 2D sweeps (stencil.hpp)
+ *
+ * so that every configuration compiles into its own branch-free kernel.
+ * make_solver_1d() / make_solver_2d() select an instantiation at runtime
+ * and return it through the HeatSolver1D / HeatSolver2D interfaces.
  */
 
 #ifndef HEAT_EQUATION_SOLVER_HPP
 #define HEAT_EQUATION_SOLVER_HPP
 
 #include "material.hpp"
+#include "boundary.hpp"
+#include "stencil.hpp"
+#include "source.hpp"
+#include "domain_mask.hpp"
+#include "grid.hpp"
+#include "krylov.hpp"
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
+#include <optional>
 #include <vector>
 
 namespace ensiie {
 
+/// Max deviation of the float solvers from the double ones over a run [K]
+constexpr double MIXED_PRECISION_TOL = 5e-2;
+
+/**
+ * @brief Runtime selector for the solver precision
+ */
+enum class Precision {
+    DOUBLE,  ///< double storage and arithmetic
+    MIXED    ///< float storage/smoothing, double residuals
+};
+
+/**
+ * @brief Coordinate system of the 1D solvers
+ */
+enum class Geometry {
+    CARTESIAN,    ///< Bar along x
+    CYLINDRICAL,  ///< Radius of a long cylinder (rod, tube wall)
+    SPHERICAL     ///< Radius of a sphere (pellet, shell)
+};
+
+/**
+ * @class HeatSolver
+ * @brief Interface shared by every solver (1D, 2D grids, triangle meshes).
+ *
+ * Covers what does not depend on how the domain is discretised: time
+ * stepping, heat sources and point probes.
+ */
+class HeatSolver {
+public:
+    virtual ~HeatSolver() = default;
+
+    /**
+     * @brief Advance the solution by one time step.
+     * @return false if the final time is reached
+     */
+    virtual bool step() = 0;
+
+    /**
+     * @brief Get the current simulation time.
+     */
+    virtual double get_time() const = 0;
+
+    /**
+     * @brief Get the final simulation time.
+     */
+    virtual double get_tmax() const = 0;
+
+    /**
+     * @brief Get the time step (tmax / 1000 unless set_time_step() was called).
+     */
+    virtual double get_time_step() const = 0;
+
+    /**
+     * @brief Change the time step; the implicit system is assembled again.
+     *
+     * The current time and temperature are kept, so the step may change
+     * between two calls to step() (see multirate.hpp).
+     *
+     * @throws std::invalid_argument if dt is not positive
+     */
+    virtual void set_time_step(double dt) = 0;
+
+    /**
+     * @brief Reset the solver to the initial state (t=0, u=u0)
+     */
+    virtual void reset() = 0;
+
+    /**
+     * @brief Replace the heat sources (see source.hpp).
+     *
+     * The sources are rasterised once; their amplitudes are evaluated
+     * at every step, so pulsed or ramped heaters need no rebuild.
+     */
+    virtual void set_sources(const std::vector<HeatSource>& sources) = 0;
+
+    /**
+     * @brief Replace the moving heat sources (laser, weld track).
+     *
+     * Footprints follow their trajectory; at each step only the nodes
+     * entering or leaving a footprint change in the source lists.
+     */
+    virtual void set_moving_sources(const std::vector<MovingSource>& sources) = 0;
+
+    /**
+     * @brief Get the liquid fraction of the whole domain (0 without phase change).
+     */
+    virtual double get_liquid_fraction() const = 0;
+
+    /**
+     * @brief Temperature at a point, interpolated between nodes [K].
+     *
+     * 1D solvers ignore y. Points outside the domain take the value of
+     * the nearest node (grids) or -1 (meshes).
+     */
+    virtual double probe(double x, double y = 0.0) const = 0;
+};
+
+/**
+ * @brief How a solver solves the system of its step
+ */
+enum class StepMethod {
+    DIRECT,           ///< Thomas algorithm (bars)
+    SWEEPS,           ///< Gauss–Seidel or SOR sweeps in double precision
+    MIXED_PRECISION,  ///< Float sweeps inside a double iterative refinement
+    KRYLOV            ///< Preconditioned Krylov solve (set_krylov())
+};
+
+/**
+ * @struct LinearStep
+ * @brief Affine form of the backward Euler step of a linear bar or plate.
+ *
+ * With D the identity restricted to the free nodes, one step reads
+ * @f[
+ *   A\,u^{n+1} = D\,u^n + b + \sum_j a_j(t^{n+1})\,s_j
+ * @f]
+ * Fixed nodes (Dirichlet edges, holes) have identity rows in A and their
+ * imposed value in b. Used by the reduced-order models (rom.hpp), the
+ * adjoint gradients (adjoint.hpp) and the ensembles (ensemble.hpp), which
+ * also read how the solver solves it.
+ */
+struct LinearStep {
+    CsrMatrix A;                        ///< Step matrix, identity rows on fixed nodes
+    std::vector<unsigned char> fixed;   ///< Nodes whose value is imposed
+    std::vector<double> b;              ///< Edge terms on free nodes, imposed values on fixed ones
+    std::vector<std::vector<double>> sources;  ///< Δt/ρc · F_j of each source (zero on fixed nodes)
+    std::vector<std::function<double(double)>> modulations;  ///< a_j(t) (empty: constant)
+    double dt = 0.0;                    ///< Time step
+    StepMethod method = StepMethod::DIRECT;  ///< Solution of A·u = rhs by the solver
+    double omega = 1.0;                 ///< SWEEPS: relaxation factor (1: Gauss–Seidel)
+    double tol = 0.0;                   ///< SWEEPS: largest update of the last sweep [K]
+    int max_sweeps = 0;                 ///< SWEEPS: sweeps per step at most
+};
+
+/// Steps whose convergence statistics a solver keeps (the most recent ones)
+constexpr int STEP_STATS_CAPACITY = 1024;
+
 /**
- * @class HeatEquationSolver1D
+ * @struct StepStats
+ * @brief Convergence of one implicit step of an iterative solver.
+ *
+ * The convergence measure is one quantity per solution path [K]:
+ * - relaxation sweeps: the largest update of a sweep, after each sweep;
+ * - Krylov: the largest scaled residual, before and after each pass;
+ * - mixed precision: the largest scaled double residual, after the float
+ *   smoothing and after each refinement pass (the float sweeps are not
+ *   measured).
+ */
+struct StepStats {
+    double time = 0.0;              ///< Time reached by the step [s]
+    int iterations = 0;             ///< Sweeps or Krylov iterations
+    double initial_residual = 0.0;  ///< First convergence measure of the step [K]
+    double final_residual = 0.0;    ///< Last convergence measure of the step [K]
+    double rate = 0.0;              ///< Mean reduction of the measure per iteration between the first and last measures (0: none in between)
+    double seconds = 0.0;           ///< Wall time of the step [s]
+    bool converged = false;         ///< Tolerance reached before the iteration limit
+};
+
+/**
+ * @class StepStatsRing
+ * @brief Statistics of the most recent steps; the oldest are overwritten.
+ */
+class StepStatsRing {
+public:
+    explicit StepStatsRing(int capacity = STEP_STATS_CAPACITY) : slots_(capacity), count_(0) {}
+
+    void push(const StepStats& stats) {
+        slots_[count_ % slots_.size()] = stats;
+        count_++;
+    }
+
+    /**
+     * @brief Retained steps, oldest first.
+     */
+    std::vector<StepStats> recent() const {
+        const long size = static_cast<long>(slots_.size());
+        std::vector<StepStats> out;
+        for (long c = std::max(0L, count_ - size); c < count_; c++) out.push_back(slots_[c % size]);
+        return out;
+    }
+
+    void clear() { count_ = 0; }
+
+private:
+    std::vector<StepStats> slots_;  ///< Step c is in slots_[c % capacity]
+    long count_;                    ///< Steps pushed since the last clear()
+};
+
+/**
+ * @class HeatSolver1D
+ * @brief Common interface of the 1D solver instantiations.
+ */
+class HeatSolver1D : public HeatSolver {
+public:
+    /**
+     * @brief Get the current temperature field (widened to double).
+     */
+    virtual std::vector<double> get_temperature() const = 0;
+
+    /**
+     * @brief Get the number of grid points.
+     */
+    virtual int get_n() const = 0;
+
+    /**
+     * @brief Get the node coordinates [m].
+     */
+    virtual std::vector<double> get_x() const = 0;
+
+    /**
+     * @brief Solve in radius instead of along a bar.
+     *
+     * Node x sits at radius r = r_inner + x. With r_inner = 0 the LEFT
+     * edge is the axis (cylinder) or centre (sphere): its face has no
+     * area, which imposes the symmetry condition ∂u/∂r = 0, so LEFT must
+     * then be Neumann or Robin. The system stays tridiagonal and is
+     * factored again once.
+     *
+     * @param geometry Coordinate system
+     * @param r_inner Inner radius [m] (tube, hollow shell)
+     * @throws std::invalid_argument for periodic edges, r_inner < 0, or a
+     *         Dirichlet condition on the axis
+     */
+    virtual void set_geometry(Geometry geometry, double r_inner = 0.0) = 0;
+
+    /**
+     * @brief Get the position of the melting front [m].
+     *
+     * First point from x = 0 where the liquid fraction crosses 1/2,
+     * interpolated between nodes, or -1 if there is none.
+     */
+    virtual double get_melt_front() const = 0;
+
+    /**
+     * @brief Matrix and right-hand side terms of the implicit step.
+     *
+     * @throws std::invalid_argument for phase change, radiative or
+     *         time-dependent edges, or moving sources
+     */
+    virtual LinearStep linear_step() const = 0;
+};
+
+/**
+ * @class HeatSolver2D
+ * @brief Common interface of the 2D solver instantiations.
+ */
+class HeatSolver2D : public HeatSolver {
+public:
+    /**
+     * @brief Get temperature at grid point (i,j).
+     */
+    virtual double get_temperature(int i, int j) const = 0;
+
+    /**
+     * @brief Get the full temperature field as a 2D array.
+     */
+    virtual std::vector<std::vector<double>> get_temperature_2d() const = 0;
+
+    /**
+     * @brief Get the number of grid points along x.
+     */
+    virtual int get_n() const = 0;
+
+    /**
+     * @brief Get the number of grid points along y.
+     */
+    virtual int get_ny() const = 0;
+
+    /**
+     * @brief Get the plate width (x) [m].
+     */
+    virtual double get_lx() const = 0;
+
+    /**
+     * @brief Get the plate height (y) [m].
+     */
+    virtual double get_ly() const = 0;
+
+    /**
+     * @brief Get the node coordinates along x [m].
+     */
+    virtual std::vector<double> get_x() const = 0;
+
+    /**
+     * @brief Get the node coordinates along y [m].
+     */
+    virtual std::vector<double> get_y() const = 0;
+
+    /**
+     * @brief Restrict the plate to the solid part of a mask (holes, L-shapes).
+     *
+     * Sweeps then only visit the active runs of each row.
+     */
+    virtual void set_mask(const DomainMask& mask) = 0;
+
+    /**
+     * @brief Solve each step with a Krylov method instead of relaxation sweeps.
+     *
+     * The matrix is extracted from the stencil once (and again after
+     * set_mask()); each step then solves for the correction to the
+     * previous temperature. The mirrored edges make the matrix
+     * nonsymmetric, so the method must be BiCGStab or GMRES.
+     *
+     * @param options Method, preconditioner and format (std::nullopt: sweeps)
+     * @throws std::invalid_argument for conjugate gradients, phase change
+     *         or radiative edges
+     */
+    virtual void set_krylov(std::optional<KrylovOptions> options) = 0;
+
+    /**
+     * @brief Whether grid point (i,j) belongs to the plate.
+     */
+    virtual bool is_active(int i, int j) const = 0;
+
+    /**
+     * @brief Iterations of the last step: relaxation sweeps (all passes
+     *        of the mixed-precision refinement) or Krylov iterations.
+     */
+    virtual int get_last_iterations() const = 0;
+
+    /**
+     * @brief Last convergence measure of the last step [K]: the largest
+     *        update of the final sweep, or the largest scaled residual
+     *        of the final refinement or Krylov pass.
+     */
+    virtual double get_last_residual() const = 0;
+
+    /**
+     * @brief Convergence of the most recent steps since the last reset,
+     *        oldest first (at most STEP_STATS_CAPACITY).
+     */
+    virtual std::vector<StepStats> get_step_stats() const = 0;
+
+    /**
+     * @brief Steps since the last reset that hit their iteration limit
+     *        without reaching their tolerance.
+     *
+     * Such a step is kept, so its result may be silently inaccurate.
+     */
+    virtual long get_unconverged_steps() const = 0;
+
+    /**
+     * @brief Matrix and right-hand side terms of the implicit step.
+     *
+     * @throws std::invalid_argument for phase change, radiative or
+     *         time-dependent edges, or moving sources
+     */
+    virtual LinearStep linear_step() const = 0;
+};
+
+/**
+ * @class BasicHeatEquationSolver1D
  * @brief Implicit finite difference solver for the 1D heat equation.
  *
  * Solves the heat equation on the domain x ∈ [0, L] using a backward
  * Euler time discretization and centered finite differences in space.
+ * On a stretched grid the rows become the finite-volume balance of each
+ * node cell, a tridiagonal with variable coefficients. The same balance
+ * over cylindrical or spherical shells gives the radial solvers
+ * (set_geometry()).
+ *
+ * The system matrix does not change between steps, so its Thomas (LU)
+ * factorization is computed once at construction; each step is then a
+ * forward and a backward substitution in O(n). Periodic boundaries give
+ * a cyclic tridiagonal system, solved with the Sherman–Morrison formula
+ * on top of the same factorization.
+ *
+ * When Real is float, the solve runs in single precision and is
+ * followed by iterative refinement: the residual d - A·u is computed in
+ * double and the correction solved again in float.
+ *
+ * Radiative edges (BoundaryCondition::radiative()) make the edge rows
+ * nonlinear. The edge temperatures are found by Newton's method through
+ * the precomputed responses A⁻¹·e of the two edge rows, so the interior
+ * factorization is reused as is and a step costs one substitution plus
+ * two vector updates.
  *
- * The resulting tridiagonal linear system is solved using the Thomas
- * algorithm with O(n) complexity.
+ * Phase change is solved with an active-set enthalpy iteration: solid and
+ * liquid nodes keep their row, mushy nodes get the latent heat term on
+ * the diagonal. Only the rows from the first node that changed state are
+ * factored again, and the mushy set carries over from step to step, so
+ * most steps cost a single substitution plus a short refactorization.
  *
- * Boundary conditions:
- * - Neumann condition (∂u/∂x = 0) at x = 0
- * - Dirichlet condition (u = u₀) at x = L
+ * @tparam Real Storage and solve precision (float or double)
+ * @tparam Boundary Edge policies (Boundary1D)
  */
-class HeatEquationSolver1D {
+template <typename Real, typename Boundary = DefaultBoundary1D>
+class BasicHeatEquationSolver1D : public HeatSolver1D {
 private:
     Material mat_;        /**< Material properties (λ, ρ, c) */
     double L_;            /**< Length of the 1D domain */
@@ -56,31 +461,105 @@ private:
     double u0_kelvin_;    /**< Initial temperature (Kelvin) */
     double t_;            /**< Current simulation time */
     int n_;               /**< Number of grid points */
+    std::vector<double> x_; /**< Node coordinates of a stretched grid (empty: uniform) */
+    Geometry geometry_;   /**< Cartesian bar or radial coordinate */
+    double r_inner_;      /**< Radius of node 0 (radial geometries) */
 
-    std::vector<double> u_; /**< Temperature field */
-    std::vector<double> F_; /**< Heat source term */
+    std::array<BoundaryCondition, 2> bc_; /**< Edge conditions (LEFT, RIGHT) */
+    double edge_rhs_[2];  /**< Constant RHS contribution of each edge */
+    double edge_rad_[2];  /**< Coefficient of -u⁴ in each edge row (radiation) */
+    std::vector<Real> edge_response_[2]; /**< Radiative edges: A⁻¹·e of the edge row */
+
+    std::vector<Real> a_; /**< Sub-diagonal */
+    std::vector<Real> b_; /**< Main diagonal */
+    std::vector<Real> c_; /**< Super-diagonal */
+    std::vector<Real> c_prime_;  /**< Factored super-diagonal c'ᵢ */
+    std::vector<Real> inv_den_;  /**< Factored pivots 1 / (bᵢ - aᵢc'ᵢ₋₁) */
+    std::vector<Real> z_;        /**< Sherman–Morrison correction vector (periodic) */
+    double sm_ratio_;     /**< Sherman–Morrison: corner ratio β/γ (periodic) */
+    double sm_den_;       /**< Sherman–Morrison: denominator 1 + v·z (periodic) */
+
+    std::vector<Real> u_; /**< Temperature field */
+    std::vector<Real> frac_; /**< Liquid fraction (phase-changing materials only) */
+    std::vector<double> diag_; /**< Main diagonal without latent heat terms (phase change) */
+    std::vector<unsigned char> mushy_; /**< Rows carrying the latent heat term of a mushy node */
+    SparseSource sources_; /**< Rasterised heat sources */
+
+    std::vector<double> d_;    /**< Work: right-hand side in double */
+    std::vector<Real> d_real_; /**< Work: right-hand side in Real */
+    std::vector<Real> u_new_;  /**< Work: next temperature field */
 
     /**
-     * @brief Initialize the spatial heat source.
+     * @brief Install the historical heat sources.
      * @param f Source amplitude.
      */
     void init_source(double f);
 
     /**
-     * @brief Solve a tridiagonal linear system using the Thomas algorithm.
+     * @brief Build the tridiagonal rows from the edge policies and factor them.
+     */
+    void assemble();
+
+    /**
+     * @brief Thomas (LU) factorization of rows [from, n) of a tridiagonal.
+     *
+     * Rows before `from` keep their stored pivots; periodic systems are
+     * always factored in full, with the Sherman–Morrison terms.
+     *
+     * @tparam V Coefficient vector (double at assembly, Real when refactoring)
+     */
+    template <typename V>
+    void factor(const V& a, const V& b, const V& c, int from);
+
+    /**
+     * @brief Solve A·x = d with the pre-computed factorization.
      *
-     * @param a Sub-diagonal coefficients
-     * @param b Main diagonal coefficients
-     * @param c Super-diagonal coefficients
-     * @param d Right-hand side vector
+     * @param d Right-hand side vector (overwritten)
      * @param x Solution vector
      */
-    void solve_tridiagonal(
-        const std::vector<double>& a,
-        const std::vector<double>& b,
-        const std::vector<double>& c,
-        std::vector<double>& d,
-        std::vector<double>& x
+    void solve_tridiagonal(std::vector<Real>& d, std::vector<Real>& x) const;
+
+    /**
+     * @brief Refine a single-precision solution using double residuals.
+     *
+     * Computes r = d - A·x in double, solves A·e = r in Real and
+     * updates x += e until the residual drops below the tolerance.
+     */
+    void refine(const std::vector<double>& d, std::vector<Real>& x);
+
+    /**
+     * @brief Add the radiative exchange of the edges to a linear solve.
+     *
+     * On entry u_new_ solves the system without radiation. The edge
+     * temperatures are found by Newton's method on a 2×2 system through
+     * the stored edge responses A⁻¹·e, then the response is added to the
+     * whole field: the interior factorization is never touched.
+     */
+    void radiate();
+
+    /**
+     * @brief Implicit step of a phase-changing material.
+     *
+     * Solves A·u + L/c·f = d + L/c·fⁿ together with f = f(u) and stores
+     * the new liquid fraction. Radiative edges are linearised with the
+     * mushy rows and refined until their temperature settles.
+     */
+    void solve_phase();
+
+    /**
+     * @brief Common constructor of the uniform and stretched grids.
+     *
+     * @param x Node coordinates (empty: n uniform nodes over [0, L])
+     */
+    BasicHeatEquationSolver1D(
+        const Material& mat,
+        double L,
+        double tmax,
+        double u0,
+        double f,
+        int n,
+        const std::array<BoundaryCondition, 2>& bc,
+        std::vector<double> x
     );
 
 public:
@@ -94,7 +573,7 @@ public:
      * @param f Heat source amplitude
      * @param n Number of spatial grid points
      */
-    HeatEquationSolver1D(
+    BasicHeatEquationSolver1D(
         const Material& mat,
         double L,
         double tmax,
@@ -104,75 +583,280 @@ public:
     );
 
     /**
-     * @brief Advance the solution by one time step.
-     * @return false if the final time is reached
+     * @brief Construct a 1D heat equation solver with explicit edge conditions.
+     *
+     * @param mat Material properties
+     * @param L Length of the domain
+     * @param tmax Maximum simulation time
+     * @param u0 Initial temperature (°C)
+     * @param f Heat source amplitude
+     * @param n Number of spatial grid points
+     * @param bc Conditions at LEFT and RIGHT; kinds must match the policies
+     * @throws std::invalid_argument if a kind contradicts its policy
      */
-    bool step();
+    BasicHeatEquationSolver1D(
+        const Material& mat,
+        double L,
+        double tmax,
+        double u0,
+        double f,
+        int n,
+        const std::array<BoundaryCondition, 2>& bc
+    );
 
     /**
-     * @brief Get the current temperature field.
+     * @brief Construct a 1D solver on a stretched grid.
+     *
+     * @param mat Material properties
+     * @param x Node coordinates (see grid.hpp; periodic: last one closes the period)
+     * @param tmax Maximum simulation time
+     * @param u0 Initial temperature (°C)
+     * @param f Heat source amplitude
+     * @param bc Conditions at LEFT and RIGHT; kinds must match the policies
+     * @throws std::invalid_argument if the coordinates are invalid or a
+     *         kind contradicts its policy
      */
-    const std::vector<double>& get_temperature() const { return u_; }
+    BasicHeatEquationSolver1D(
+        const Material& mat,
+        const std::vector<double>& x,
+        double tmax,
+        double u0,
+        double f,
+        const std::array<BoundaryCondition, 2>& bc
+    );
 
-    /**
-     * @brief Get the current simulation time.
-     */
-    double get_time() const { return t_; }
+    bool step() override;
 
-    /**
-     * @brief Get the number of grid points.
-     */
-    int get_n() const { return n_; }
+    std::vector<double> get_temperature() const override {
+        return std::vector<double>(u_.begin(), u_.end());
+    }
 
-    /**
-     * @brief Reset the solver to the initial state (t=0, u=u0)
-     */
-    void reset();
+    double get_time() const override { return t_; }
+    double get_tmax() const override { return tmax_; }
+    double get_time_step() const override { return dt_; }
+    void set_time_step(double dt) override;
+    int get_n() const override { return n_; }
+    std::vector<double> get_x() const override;
+
+    void reset() override;
+    void set_sources(const std::vector<HeatSource>& sources) override;
+    void set_moving_sources(const std::vector<MovingSource>& sources) override;
+    void set_geometry(Geometry geometry, double r_inner = 0.0) override;
+    double get_liquid_fraction() const override;
+    double probe(double x, double y = 0.0) const override;
+    double get_melt_front() const override;
+    LinearStep linear_step() const override;
 };
 
 
 /**
- * @class HeatEquationSolver2D
+ * @class BasicHeatEquationSolver2D
  * @brief Implicit finite difference solver for the 2D heat equation.
  *
- * Solves the heat equation on a square domain [0, L]² using a five-point
- * stencil and a backward Euler time discretization.
+ * Solves the heat equation on a rectangle [0, Lx] × [0, Ly] with nx × ny
+ * nodes using a five-point stencil and a backward Euler time
+ * discretization. The conductivity may differ along x and y
+ * (Material::lambda_y). On a stretched grid every node has its own
+ * couplings to its four neighbours (finite-volume balance of the node
+ * cell); the uniform grid keeps the constant-coefficient kernel.
+ *
+ * The implicit system is solved using Gauss–Seidel iterations (or SOR,
+ * depending on the stencil policy). Edge handling is resolved once per
+ * row from the boundary policies; the inner loop over a row is the same
+ * branch-free update for every configuration.
  *
- * The implicit system is solved using Gauss–Seidel iterations.
+ * When Real is float, the sweeps run in single precision inside a
+ * mixed-precision iterative refinement loop: the residual is evaluated
+ * in double every outer iteration and the correction equation is
+ * smoothed in float.
  *
- * Boundary conditions:
- * - Neumann condition on left and bottom boundaries
- * - Dirichlet condition on right and top boundaries
+ * set_krylov() replaces the sweeps by a preconditioned BiCGStab or GMRES
+ * solve on the matrix of the same stencil, extracted in double
+ * precision by applying the point update to a few probe fields.
+ *
+ * On radiative edges (BoundaryCondition::radiative()) the point update
+ * solves its quartic row by Newton's method; every other row keeps the
+ * linear update. The mixed-precision refinement linearises these rows
+ * at the current iterate.
+ *
+ * Phase change is solved by nonlinear Gauss–Seidel: each point update
+ * inverts the piecewise linear enthalpy–temperature relation exactly.
+ * In mixed precision these sweeps run in float without refinement (the
+ * enthalpy residual is not linear in the correction).
+ *
+ * @tparam Real Storage and smoothing precision (float or double)
+ * @tparam Boundary Edge policies (Boundary2D)
+ * @tparam Stencil Point-update policy (stencil::FivePoint, stencil::FivePointSOR)
  */
-class HeatEquationSolver2D {
+template <typename Real,
+          typename Boundary = DefaultBoundary2D,
+          typename Stencil = stencil::FivePoint>
+class BasicHeatEquationSolver2D : public HeatSolver2D {
 private:
     Material mat_;        /**< Material properties */
-    double L_;            /**< Domain size */
+    double Lx_;           /**< Domain width (x) */
+    double Ly_;           /**< Domain height (y) */
     double tmax_;         /**< Maximum simulation time */
-    double dx_;           /**< Spatial step */
+    double dx_;           /**< Spatial step along x */
+    double dy_;           /**< Spatial step along y */
     double dt_;           /**< Time step */
     double u0_kelvin_;    /**< Initial temperature in Kelvin */
     double t_;            /**< Current time */
-    int n_;               /**< Grid points per dimension */
+    int iterations_;      /**< Sweeps or Krylov iterations of the last step */
+    double residual_;     /**< Last convergence measure of the last step [K] */
+    StepStatsRing stats_; /**< Convergence of the recent steps */
+    long unconverged_;    /**< Steps that hit their iteration limit since the last reset */
+    int nx_;              /**< Grid points along x */
+    int ny_;              /**< Grid points along y */
+    std::vector<double> x_; /**< Node coordinates along x of a stretched grid (empty: uniform) */
+    std::vector<double> y_; /**< Node coordinates along y of a stretched grid (empty: uniform) */
+
+    double rx_;           /**< Diffusion number along x (mean spacing if stretched) */
+    double ry_;           /**< Diffusion number along y (mean spacing if stretched) */
+    double omega_;        /**< Relaxation factor of the stencil policy */
+    std::vector<double> xlo_; /**< Stretched grid: coupling of column i to column i-1 */
+    std::vector<double> xhi_; /**< Stretched grid: coupling of column i to column i+1 */
+    std::vector<double> ylo_; /**< Stretched grid: coupling of row j to row j-1 */
+    std::vector<double> yhi_; /**< Stretched grid: coupling of row j to row j+1 */
+
+    std::array<BoundaryCondition, 4> bc_; /**< Edge conditions (WEST, EAST, SOUTH, NORTH) */
+    double edge_diag_[4]; /**< Diagonal contribution of each edge (Robin) */
+    double edge_rhs_[4];  /**< RHS contribution of each edge (flux, Robin) */
+    double edge_rad_[4];  /**< Coefficient of -u⁴ in each edge row (radiation) */
 
-    std::vector<double> u_; /**< Temperature field (row-major) */
-    std::vector<double> F_; /**< Heat source */
+    std::vector<Real> u_; /**< Temperature field (row-major) */
+    std::vector<Real> frac_; /**< Liquid fraction (phase-changing materials only) */
+    SparseSource sources_; /**< Rasterised heat sources */
+
+    ActiveRuns runs_;     /**< Active nodes of each row */
+    std::vector<unsigned char> hole_; /**< Nodes with a neighbour in a hole (masked plates only) */
+    MaskFace mask_face_;  /**< Condition on the hole faces */
+    double mask_kelvin_;  /**< Hole temperature for fixed faces (Kelvin) */
+
+    std::optional<KrylovOptions> krylov_; /**< Krylov solve of each step (empty: sweeps) */
+    KrylovSolver krylov_solver_; /**< Stencil matrix and preconditioner of the Krylov solves */
+
+    std::vector<Real> u_new_; /**< Work: next temperature field */
+    std::vector<Real> rhs_;   /**< Work: right-hand side */
+    std::vector<Real> frac_new_; /**< Work: next liquid fraction */
 
     /**
      * @brief Convert 2D indices to 1D index.
      */
-    int idx(int i, int j) const { return j * n_ + i; }
+    int idx(int i, int j) const { return j * nx_ + i; }
 
     /**
-     * @brief Initialize the 2D heat source.
+     * @brief Install the historical 2D heat sources.
      */
     void init_source(double f);
 
+    /**
+     * @brief Pre-compute spacings, diffusion numbers and edge terms.
+     */
+    void assemble();
+
+    /**
+     * @brief Visit every non-Dirichlet point with its stencil data.
+     *
+     * Encodes the boundary policies in one place: mirror ghost nodes for
+     * Neumann/Robin edges, wrap-around for periodic edges, Dirichlet
+     * rows/columns skipped. Only the active runs of each row are visited;
+     * nodes next to a hole resolve their neighbours one by one. For each
+     * point, calls
+     * op(k, neighbours, diag, inv_diag, extra, rad) where neighbours is the
+     * weighted neighbour sum r_x(u_W + u_E) + r_y(u_S + u_N) (per-node
+     * couplings on a stretched grid), extra the edge RHS contribution
+     * scaled by bscale and rad the coefficient of -u⁴ of radiative edges
+     * (0 elsewhere).
+     *
+     * @tparam T Accumulation type
+     */
+    template <typename T, typename Op>
+    void traverse(const std::vector<Real>& v, T bscale, Op&& op) const;
+
+    /**
+     * @brief Give the nodes inside holes a displayable temperature.
+     */
+    void fill_holes();
+
+    /**
+     * @brief Impose the Dirichlet edge values, scaled by bscale.
+     */
+    void apply_dirichlet(std::vector<Real>& v, Real bscale) const;
+
+    /**
+     * @brief One relaxation sweep of A·v = rhs.
+     *
+     * @param v Iterate, updated in place
+     * @param rhs Right-hand side
+     * @param bscale 1 for the temperature equation, 0 for a correction
+     *        equation with homogeneous boundary data
+     * @return Maximum absolute update over the sweep
+     */
+    Real sweep(std::vector<Real>& v, const std::vector<Real>& rhs, Real bscale) const;
+
+    /**
+     * @brief One nonlinear relaxation sweep of the enthalpy equation.
+     *
+     * Solves diag·u + L/c·f(u) = rhs + neighbours + L/c·fⁿ point by point
+     * for u_new_ and frac_new_.
+     *
+     * @param rhs Right-hand side of the linear equation
+     * @return Maximum absolute temperature update over the sweep
+     */
+    Real sweep_phase(const std::vector<Real>& rhs);
+
+    /**
+     * @brief Residual rhs - A·v evaluated in double precision.
+     *
+     * @param v Current iterate
+     * @param rhs Right-hand side (double)
+     * @param res Output residual (zero on Dirichlet nodes)
+     * @return Maximum absolute residual scaled by the diagonal
+     * @tparam R Storage of the residual
+     */
+    template <typename R>
+    double residual(const std::vector<Real>& v, const std::vector<double>& rhs,
+                    std::vector<R>& res) const;
+
+    /**
+     * @brief Extract the stencil matrix by applying the point update to probe fields.
+     *
+     * Rows of Dirichlet and hole nodes are identity rows.
+     *
+     * @param unknown Output: nodes visited by the sweeps
+     */
+    CsrMatrix extract_matrix(std::vector<unsigned char>& unknown) const;
+
+    /**
+     * @brief Extract the stencil matrix and build the Krylov solver.
+     */
+    void build_krylov();
+
+    /**
+     * @brief Common constructor of the uniform and stretched grids.
+     *
+     * @param x, y Node coordinates (empty: uniform nodes)
+     */
+    BasicHeatEquationSolver2D(
+        const Material& mat,
+        double Lx,
+        double Ly,
+        double tmax,
+        double u0,
+        double f,
+        int nx,
+        int ny,
+        const std::array<BoundaryCondition, 4>& bc,
+        std::vector<double> x,
+        std::vector<double> y
+    );
+
 public:
     /**
      * @brief Construct a 2D heat equation solver.
      */
-    HeatEquationSolver2D(
+    BasicHeatEquationSolver2D(
         const Material& mat,
         double L,
         double tmax,
@@ -182,29 +866,236 @@ public:
     );
 
     /**
-     * @brief Advance one step using Gauss-Seidel iteration
+     * @brief Construct a 2D heat equation solver with explicit edge conditions.
+     *
+     * @param bc Conditions at WEST, EAST, SOUTH, NORTH; kinds must match the policies
+     * @throws std::invalid_argument if a kind contradicts its policy
      */
-    bool step();
+    BasicHeatEquationSolver2D(
+        const Material& mat,
+        double L,
+        double tmax,
+        double u0,
+        double f,
+        int n,
+        const std::array<BoundaryCondition, 4>& bc
+    );
 
     /**
-     * @brief Get temperature at grid point (i,j).
+     * @brief Construct a solver on a rectangular plate.
+     *
+     * @param mat Material properties (lambda_y > 0 for anisotropic conduction)
+     * @param Lx Plate width [m]
+     * @param Ly Plate height [m]
+     * @param tmax Maximum simulation time
+     * @param u0 Initial temperature (°C)
+     * @param f Heat source amplitude
+     * @param nx Grid points along x
+     * @param ny Grid points along y
+     * @param bc Conditions at WEST, EAST, SOUTH, NORTH; kinds must match the policies
+     * @throws std::invalid_argument if a kind contradicts its policy
      */
-    double get_temperature(int i, int j) const { return u_[idx(i, j)]; }
+    BasicHeatEquationSolver2D(
+        const Material& mat,
+        double Lx,
+        double Ly,
+        double tmax,
+        double u0,
+        double f,
+        int nx,
+        int ny,
+        const std::array<BoundaryCondition, 4>& bc
+    );
 
     /**
-     * @brief Get the full temperature field as a 2D array.
+     * @brief Construct a solver on a stretched tensor-product grid.
+     *
+     * @param mat Material properties
+     * @param x Node coordinates along x (see grid.hpp)
+     * @param y Node coordinates along y
+     * @param tmax Maximum simulation time
+     * @param u0 Initial temperature (°C)
+     * @param f Heat source amplitude
+     * @param bc Conditions at WEST, EAST, SOUTH, NORTH; kinds must match the policies
+     * @throws std::invalid_argument if the coordinates are invalid or a
+     *         kind contradicts its policy
      */
-    std::vector<std::vector<double>> get_temperature_2d() const;
-    double get_time() const { return t_; }
-    double get_tmax() const { return tmax_; }
-    int get_n() const { return n_; }
+    BasicHeatEquationSolver2D(
+        const Material& mat,
+        const std::vector<double>& x,
+        const std::vector<double>& y,
+        double tmax,
+        double u0,
+        double f,
+        const std::array<BoundaryCondition, 4>& bc
+    );
 
     /**
-     * @brief Reset the solver to the initial state.
+     * @brief Advance one step using Gauss-Seidel iteration
      */
-    void reset();
+    bool step() override;
+
+    double get_temperature(int i, int j) const override {
+        return static_cast<double>(u_[idx(i, j)]);
+    }
+
+    std::vector<std::vector<double>> get_temperature_2d() const override;
+    double get_time() const override { return t_; }
+    double get_tmax() const override { return tmax_; }
+    double get_time_step() const override { return dt_; }
+    void set_time_step(double dt) override;
+    int get_n() const override { return nx_; }
+    int get_ny() const override { return ny_; }
+    double get_lx() const override { return Lx_; }
+    double get_ly() const override { return Ly_; }
+    std::vector<double> get_x() const override;
+    std::vector<double> get_y() const override;
+
+    void reset() override;
+    void set_sources(const std::vector<HeatSource>& sources) override;
+    void set_moving_sources(const std::vector<MovingSource>& sources) override;
+    void set_mask(const DomainMask& mask) override;
+    void set_krylov(std::optional<KrylovOptions> options) override;
+    bool is_active(int i, int j) const override { return runs_.active(idx(i, j)); }
+    int get_last_iterations() const override { return iterations_; }
+    double get_last_residual() const override { return residual_; }
+    std::vector<StepStats> get_step_stats() const override { return stats_.recent(); }
+    long get_unconverged_steps() const override { return unconverged_; }
+    LinearStep linear_step() const override;
+    double get_liquid_fraction() const override;
+    double probe(double x, double y) const override;
 };
 
+extern template class BasicHeatEquationSolver1D<double>;
+extern template class BasicHeatEquationSolver1D<float>;
+extern template class BasicHeatEquationSolver2D<double>;
+extern template class BasicHeatEquationSolver2D<float>;
+extern template class BasicHeatEquationSolver2D<double, DefaultBoundary2D, stencil::FivePointSOR>;
+extern template class BasicHeatEquationSolver2D<float, DefaultBoundary2D, stencil::FivePointSOR>;
+extern template class BasicHeatEquationSolver2D<double, GenericBoundary2D>;
+extern template class BasicHeatEquationSolver2D<float, GenericBoundary2D>;
+extern template class BasicHeatEquationSolver2D<double, GenericBoundary2D, stencil::FivePointSOR>;
+extern template class BasicHeatEquationSolver2D<float, GenericBoundary2D, stencil::FivePointSOR>;
+
+/// Reference double-precision 1D solver
+using HeatEquationSolver1D = BasicHeatEquationSolver1D<double>;
+/// Mixed-precision 1D solver (float storage, double residuals)
+using MixedHeatEquationSolver1D = BasicHeatEquationSolver1D<float>;
+/// Reference double-precision 2D solver
+using HeatEquationSolver2D = BasicHeatEquationSolver2D<double>;
+/// Mixed-precision 2D solver (float storage, double residuals)
+using MixedHeatEquationSolver2D = BasicHeatEquationSolver2D<float>;
+
+/**
+ * @brief Historical 1D edge conditions: insulated at x = 0, u = u0 at x = L.
+ */
+std::array<BoundaryCondition, 2> default_boundaries_1d(double u0);
+
+/**
+ * @brief Historical 2D edge conditions: insulated west/south, u = u0 east/north.
+ */
+std::array<BoundaryCondition, 4> default_boundaries_2d(double u0);
+
+/**
+ * @brief Create the 1D solver instantiation matching a runtime configuration.
+ *
+ * Every combination of edge kinds has a dedicated instantiation.
+ *
+ * @throws std::invalid_argument if periodic edges are not paired
+ */
+std::unique_ptr<HeatSolver1D> make_solver_1d(
+    const Material& mat,
+    double L,
+    double tmax,
+    double u0,
+    double f,
+    int n,
+    const std::array<BoundaryCondition, 2>& bc,
+    Precision precision = Precision::DOUBLE
+);
+
+/**
+ * @brief Create the 1D solver instantiation for a stretched grid.
+ *
+ * @param x Node coordinates (see grid.hpp)
+ * @throws std::invalid_argument if periodic edges are not paired or the
+ *         coordinates are invalid
+ */
+std::unique_ptr<HeatSolver1D> make_solver_1d(
+    const Material& mat,
+    const std::vector<double>& x,
+    double tmax,
+    double u0,
+    double f,
+    const std::array<BoundaryCondition, 2>& bc,
+    Precision precision = Precision::DOUBLE
+);
+
+/**
+ * @brief Create the 2D solver instantiation matching a runtime configuration.
+ *
+ * Common edge combinations (the default one, all-Dirichlet, all-Neumann,
+ * all-Robin, fully periodic, cooled fin, ring) map to dedicated
+ * instantiations; any other
+ * combination falls back to runtime-dispatched edges, whose cost is
+ * O(n) per sweep instead of O(n²).
+ *
+ * @throws std::invalid_argument if periodic edges are not paired
+ */
+std::unique_ptr<HeatSolver2D> make_solver_2d(
+    const Material& mat,
+    double L,
+    double tmax,
+    double u0,
+    double f,
+    int n,
+    const std::array<BoundaryCondition, 4>& bc,
+    Precision precision = Precision::DOUBLE,
+    StencilKind stencil = StencilKind::GAUSS_SEIDEL
+);
+
+/**
+ * @brief Create the 2D solver instantiation for a rectangular plate.
+ *
+ * Same dispatch as the square overload, on an nx × ny grid over
+ * [0, Lx] × [0, Ly].
+ *
+ * @throws std::invalid_argument if periodic edges are not paired
+ */
+std::unique_ptr<HeatSolver2D> make_solver_2d(
+    const Material& mat,
+    double Lx,
+    double Ly,
+    double tmax,
+    double u0,
+    double f,
+    int nx,
+    int ny,
+    const std::array<BoundaryCondition, 4>& bc,
+    Precision precision = Precision::DOUBLE,
+    StencilKind stencil = StencilKind::GAUSS_SEIDEL
+);
+
+/**
+ * @brief Create the 2D solver instantiation for a stretched tensor-product grid.
+ *
+ * @param x Node coordinates along x (see grid.hpp)
+ * @param y Node coordinates along y
+ * @throws std::invalid_argument if periodic edges are not paired or the
+ *         coordinates are invalid
+ */
+std::unique_ptr<HeatSolver2D> make_solver_2d(
+    const Material& mat,
+    const std::vector<double>& x,
+    const std::vector<double>& y,
+    double tmax,
+    double u0,
+    double f,
+    const std::array<BoundaryCondition, 4>& bc,
+    Precision precision = Precision::DOUBLE,
+    StencilKind stencil = StencilKind::GAUSS_SEIDEL
+);
+
 } // namespace ensiie
 
 #endif
@@ -0,0 +1,422 @@
+/**
+ * @file inverse.cpp
+ * @brief Levenberg–Marquardt and L-BFGS fits with concurrent forward runs.
+ */
+
+#include "inverse.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <deque>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+namespace ensiie {
+
+namespace {
+
+/// Parameter θₖ fitted as xₖ = ln θₖ
+enum class Unknown { LAMBDA, LAMBDA_Y, RHOC, POWER };
+
+double max_abs(const std::vector<double>& a) {
+    double m = 0.0;
+    for (double v : a) m = std::max(m, std::abs(v));
+    return m;
+}
+
+/**
+ * @brief task(0), ..., task(count - 1) on up to `threads` threads, the caller included.
+ *
+ * The first exception thrown by a task is rethrown once all have finished.
+ */
+template <typename T, typename Task>
+std::vector<T> concurrently(int count, int threads, const Task& task) {
+    std::vector<T> out(count);
+    std::vector<std::exception_ptr> errors(count);
+    std::atomic<int> next{0};
+    auto work = [&] {
+        for (int k = next++; k < count; k = next++) {
+            try {
+                out[k] = task(k);
+            } catch (...) {
+                errors[k] = std::current_exception();
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int w = 1; w < std::min(threads, count); w++) pool.emplace_back(work);
+    work();
+    for (std::thread& t : pool) t.join();
+    for (const std::exception_ptr& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+    return out;
+}
+
+/**
+ * @brief Solve the small symmetric positive definite system M·x = r (Cholesky).
+ */
+std::vector<double> cholesky_solve(std::vector<double> M, std::vector<double> r) {
+    const int p = static_cast<int>(r.size());
+    for (int j = 0; j < p; j++) {
+        double d = M[j * p + j];
+        for (int k = 0; k < j; k++) d -= M[j * p + k] * M[j * p + k];
+        if (!(d > 0.0)) throw std::invalid_argument("inverse fit: singular normal equations");
+        d = std::sqrt(d);
+        M[j * p + j] = d;
+        for (int i = j + 1; i < p; i++) {
+            double s = M[i * p + j];
+            for (int k = 0; k < j; k++) s -= M[i * p + k] * M[j * p + k];
+            M[i * p + j] = s / d;
+        }
+    }
+    for (int i = 0; i < p; i++) {
+        for (int k = 0; k < i; k++) r[i] -= M[i * p + k] * r[k];
+        r[i] /= M[i * p + i];
+    }
+    for (int i = p - 1; i >= 0; i--) {
+        for (int k = i + 1; k < p; k++) r[i] -= M[k * p + i] * r[k];
+        r[i] /= M[i * p + i];
+    }
+    return r;
+}
+
+/**
+ * @brief Residuals T - y of a run over its measured samples.
+ */
+std::vector<double> residuals(HeatSolver& solver, const std::vector<ProbeData>& data) {
+    std::vector<double> r;
+    for (std::size_t n = 0; solver.step(); n++) {
+        for (const ProbeData& d : data) {
+            if (n >= d.values.size() || std::isnan(d.values[n])) continue;
+            r.push_back(solver.probe(d.x, d.y) - d.values[n]);
+        }
+    }
+    return r;
+}
+
+/**
+ * @class Fit
+ * @brief Parameter mapping and optimisers shared by bars and plates.
+ */
+class Fit {
+public:
+    /// Residual vector of a run at (material, power)
+    using Run = std::function<std::vector<double>(const Material&, double)>;
+    /// Adjoint gradient at (material, power)
+    using Differentiate = std::function<Gradient(const Material&, double)>;
+
+    Fit(const Material& guess, bool plate, const InverseOptions& options,
+        Run run, Differentiate differentiate)
+        : guess_(guess)
+        , options_(options)
+        , run_(std::move(run))
+        , differentiate_(std::move(differentiate))
+        , threads_(options.threads > 0 ? options.threads
+                                       : std::max(1, static_cast<int>(std::thread::hardware_concurrency())))
+        , runs_(0)
+        , samples_(0)
+    {
+        if (!(guess.lambda > 0.0) || !(guess.rho * guess.c > 0.0)) {
+            throw std::invalid_argument("inverse fit needs a positive starting λ and ρc");
+        }
+        if (options.fit_lambda) {
+            unknowns_.push_back(Unknown::LAMBDA);
+            if (plate && guess.lambda_y > 0.0) unknowns_.push_back(Unknown::LAMBDA_Y);
+        }
+        if (options.fit_rhoc) unknowns_.push_back(Unknown::RHOC);
+        if (options.fit_power) unknowns_.push_back(Unknown::POWER);
+        if (unknowns_.empty()) throw std::invalid_argument("inverse fit has no unknown");
+        if (options.max_iterations < 0 || options.trials < 1 || options.memory < 1 ||
+            !(options.difference_step > 0.0) || !(options.damping > 0.0)) {
+            throw std::invalid_argument("inverse fit options out of range");
+        }
+    }
+
+    InverseResult solve() {
+        std::vector<double> x;
+        for (Unknown u : unknowns_) {
+            switch (u) {
+                case Unknown::LAMBDA:   x.push_back(std::log(guess_.lambda)); break;
+                case Unknown::LAMBDA_Y: x.push_back(std::log(guess_.lambda_y)); break;
+                case Unknown::RHOC:     x.push_back(std::log(guess_.rho * guess_.c)); break;
+                case Unknown::POWER:    x.push_back(0.0); break;
+            }
+        }
+        return options_.method == InverseMethod::LBFGS ? lbfgs(x) : levenberg_marquardt(x);
+    }
+
+private:
+    Material guess_;
+    InverseOptions options_;
+    Run run_;
+    Differentiate differentiate_;
+    std::vector<Unknown> unknowns_;
+    int threads_;
+    int runs_;       ///< Forward runs so far
+    int samples_;    ///< Measured samples in the residual vector
+
+    Material material(const std::vector<double>& x) const {
+        Material m = guess_;
+        for (std::size_t k = 0; k < unknowns_.size(); k++) {
+            if (unknowns_[k] == Unknown::LAMBDA) m.lambda = std::exp(x[k]);
+            if (unknowns_[k] == Unknown::LAMBDA_Y) m.lambda_y = std::exp(x[k]);
+            if (unknowns_[k] == Unknown::RHOC) m.rho = std::exp(x[k]) / guess_.c;
+        }
+        return m;
+    }
+
+    double power(const std::vector<double>& x) const {
+        for (std::size_t k = 0; k < unknowns_.size(); k++) {
+            if (unknowns_[k] == Unknown::POWER) return std::exp(x[k]);
+        }
+        return 1.0;
+    }
+
+    /// Residuals at x, for each of several points run concurrently
+    std::vector<std::vector<double>> run(const std::vector<std::vector<double>>& points) {
+        runs_ += static_cast<int>(points.size());
+        return concurrently<std::vector<double>>(static_cast<int>(points.size()), threads_, [&](int k) {
+            return run_(material(points[k]), power(points[k]));
+        });
+    }
+
+    /// Misfit and gradient ∂J/∂xₖ = θₖ·∂J/∂θₖ, for each of several points run concurrently
+    std::vector<std::pair<double, std::vector<double>>> gradient(const std::vector<std::vector<double>>& points) {
+        runs_ += static_cast<int>(points.size());
+        using Value = std::pair<double, std::vector<double>>;
+        return concurrently<Value>(static_cast<int>(points.size()), threads_, [&](int k) {
+            const Material m = material(points[k]);
+            const Gradient g = differentiate_(m, power(points[k]));
+            std::vector<double> d;
+            for (Unknown u : unknowns_) {
+                switch (u) {
+                    case Unknown::LAMBDA:   d.push_back(m.lambda * g.lambda); break;
+                    case Unknown::LAMBDA_Y: d.push_back(m.lambda_y * g.lambda_y); break;
+                    case Unknown::RHOC:     d.push_back(m.rho * g.rho); break;  // ρc·∂J/∂(ρc) = ρ·∂J/∂ρ
+                    case Unknown::POWER: {
+                        double s = 0.0;
+                        for (double v : g.source) s += v;
+                        d.push_back(s);
+                        break;
+                    }
+                }
+            }
+            return Value(g.objective, d);
+        });
+    }
+
+    /// Residuals at the starting point (sets the sample count)
+    std::vector<double> first_run(const std::vector<double>& x) {
+        std::vector<double> r = run({x})[0];
+        if (r.empty()) throw std::invalid_argument("inverse fit: no measured sample within the run");
+        samples_ = static_cast<int>(r.size());
+        return r;
+    }
+
+    InverseResult result(const std::vector<double>& x, double f, int iterations, bool converged,
+                         std::vector<double> history) const {
+        InverseResult res;
+        res.material = material(x);
+        res.power = power(x);
+        res.objective = f;
+        res.rms = std::sqrt(2.0 * f / samples_);
+        res.iterations = iterations;
+        res.runs = runs_;
+        res.converged = converged;
+        res.history = std::move(history);
+        return res;
+    }
+
+    /**
+     * @brief Damped Gauss–Newton with a forward-difference Jacobian.
+     *
+     * Each iteration runs the p Jacobian columns concurrently, then the
+     * steps of `trials` damping values μ·10^(t-1) concurrently, and keeps
+     * the best one; its damping is the centre of the next batch.
+     */
+    InverseResult levenberg_marquardt(std::vector<double> x) {
+        const int p = static_cast<int>(x.size());
+        const double h = options_.difference_step;
+        std::vector<double> r = first_run(x);
+        double f = 0.5 * dot(r, r);
+        double mu = options_.damping;
+        std::vector<double> history;
+
+        for (int it = 1; it <= options_.max_iterations; it++) {
+            std::vector<std::vector<double>> shifted(p, x);
+            for (int k = 0; k < p; k++) shifted[k][k] += h;
+            const std::vector<std::vector<double>> cols = run(shifted);
+
+            // Normal equations JᵀJ·δ = -Jᵀr
+            std::vector<std::vector<double>> J(p, std::vector<double>(r.size()));
+            for (int k = 0; k < p; k++) {
+                if (cols[k].size() != r.size()) throw std::invalid_argument("inverse fit: runs differ in length");
+                for (std::size_t i = 0; i < r.size(); i++) J[k][i] = (cols[k][i] - r[i]) / h;
+            }
+            std::vector<double> JtJ(p * p), Jtr(p);
+            double trace = 0.0;
+            for (int a = 0; a < p; a++) {
+                for (int b = 0; b <= a; b++) JtJ[a * p + b] = JtJ[b * p + a] = dot(J[a], J[b]);
+                Jtr[a] = -dot(J[a], r);
+                trace += JtJ[a * p + a];
+            }
+            if (!(trace > 0.0)) break;  // the probes do not depend on the unknowns
+
+            std::vector<double> damping(options_.trials);
+            std::vector<std::vector<double>> steps(options_.trials), points(options_.trials, x);
+            for (int t = 0; t < options_.trials; t++) {
+                damping[t] = mu * std::pow(10.0, t - 1);
+                std::vector<double> M(JtJ);
+                for (int k = 0; k < p; k++) M[k * p + k] += damping[t] * std::max(JtJ[k * p + k], 1e-12 * trace);
+                steps[t] = cholesky_solve(M, Jtr);
+                for (int k = 0; k < p; k++) points[t][k] += steps[t][k];
+            }
+            const std::vector<std::vector<double>> trial = run(points);
+
+            int best = 0;
+            double fbest = 0.5 * dot(trial[0], trial[0]);
+            for (int t = 1; t < options_.trials; t++) {
+                const double ft = 0.5 * dot(trial[t], trial[t]);
+                if (ft < fbest) {
+                    best = t;
+                    fbest = ft;
+                }
+            }
+            const bool small = max_abs(steps[best]) < options_.tolerance;
+            if (fbest < f) {
+                x = points[best];
+                r = trial[best];
+                f = fbest;
+                mu = damping[best];
+            } else {
+                mu = damping.back() * 10.0;
+            }
+            history.push_back(f);
+            if (small) return result(x, f, it, true, std::move(history));
+        }
+        return result(x, f, static_cast<int>(history.size()), false, std::move(history));
+    }
+
+    /**
+     * @brief Limited-memory BFGS on adjoint gradients.
+     *
+     * Each iteration tries the step lengths 1, 1/2, ..., 2^(1-trials)
+     * concurrently (then shorter ones if none decreases enough) and keeps
+     * the longest one satisfying the Armijo condition.
+     */
+    InverseResult lbfgs(std::vector<double> x) {
+        constexpr double ARMIJO = 1e-4;
+        constexpr int BATCHES = 3;  // Step length batches before giving up
+        const int p = static_cast<int>(x.size());
+        first_run(x);
+        auto [f, g] = gradient({x})[0];
+        std::deque<std::vector<double>> S, Y;
+        std::vector<double> history;
+
+        for (int it = 1; it <= options_.max_iterations; it++) {
+            // Two-loop recursion: d = -H·g
+            std::vector<double> d(g);
+            std::vector<double> alpha(S.size());
+            for (int m = static_cast<int>(S.size()) - 1; m >= 0; m--) {
+                alpha[m] = dot(S[m], d) / dot(S[m], Y[m]);
+                for (int k = 0; k < p; k++) d[k] -= alpha[m] * Y[m][k];
+            }
+            const double gamma = S.empty() ? 0.5 / std::max(max_abs(g), 1e-300)
+                                           : dot(S.back(), Y.back()) / dot(Y.back(), Y.back());
+            for (double& v : d) v *= gamma;
+            for (std::size_t m = 0; m < S.size(); m++) {
+                const double beta = dot(Y[m], d) / dot(S[m], Y[m]);
+                for (int k = 0; k < p; k++) d[k] += (alpha[m] - beta) * S[m][k];
+            }
+            for (double& v : d) v = -v;
+            double slope = dot(g, d);
+            if (!(slope < 0.0)) {
+                // Not a descent direction: restart from steepest descent
+                S.clear();
+                Y.clear();
+                for (int k = 0; k < p; k++) d[k] = -0.5 * g[k] / std::max(max_abs(g), 1e-300);
+                slope = dot(g, d);
+            }
+            if (max_abs(d) < options_.tolerance) return result(x, f, it - 1, true, std::move(history));
+
+            int accepted = -1;
+            double step = 1.0;
+            std::pair<double, std::vector<double>> next;
+            for (int batch = 0; batch < BATCHES && accepted < 0; batch++) {
+                std::vector<std::vector<double>> points(options_.trials, x);
+                std::vector<double> lengths(options_.trials);
+                for (int t = 0; t < options_.trials; t++) {
+                    lengths[t] = step;
+                    for (int k = 0; k < p; k++) points[t][k] += step * d[k];
+                    step *= 0.5;
+                }
+                const auto trial = gradient(points);
+                for (int t = 0; t < options_.trials; t++) {
+                    if (trial[t].first <= f + ARMIJO * lengths[t] * slope) {
+                        accepted = t;
+                        next = trial[t];
+                        step = lengths[t];
+                        break;
+                    }
+                }
+            }
+            if (accepted < 0) return result(x, f, it, false, std::move(history));
+
+            std::vector<double> s(p), y(p);
+            for (int k = 0; k < p; k++) {
+                s[k] = step * d[k];
+                y[k] = next.second[k] - g[k];
+                x[k] += s[k];
+            }
+            if (dot(s, y) > 1e-12 * std::sqrt(dot(s, s) * dot(y, y))) {
+                S.push_back(s);
+                Y.push_back(y);
+                if (static_cast<int>(S.size()) > options_.memory) {
+                    S.pop_front();
+                    Y.pop_front();
+                }
+            }
+            f = next.first;
+            g = next.second;
+            history.push_back(f);
+            if (max_abs(s) < options_.tolerance) return result(x, f, it, true, std::move(history));
+        }
+        return result(x, f, static_cast<int>(history.size()), false, std::move(history));
+    }
+};
+
+} // namespace
+
+InverseResult fit_material_1d(const InverseFactory1D& make, const Material& guess,
+                              const std::vector<ProbeData>& data, const InverseOptions& options) {
+    Fit fit(guess, false, options,
+            [&](const Material& m, double power) {
+                std::unique_ptr<HeatSolver1D> solver = make(m, power);
+                return residuals(*solver, data);
+            },
+            [&](const Material& m, double power) {
+                return adjoint_gradient_1d([&](const Material& mm) { return make(mm, power); },
+                                           m, data, options.adjoint);
+            });
+    return fit.solve();
+}
+
+InverseResult fit_material_2d(const InverseFactory2D& make, const Material& guess,
+                              const std::vector<ProbeData>& data, const InverseOptions& options) {
+    Fit fit(guess, true, options,
+            [&](const Material& m, double power) {
+                std::unique_ptr<HeatSolver2D> solver = make(m, power);
+                return residuals(*solver, data);
+            },
+            [&](const Material& m, double power) {
+                return adjoint_gradient_2d([&](const Material& mm) { return make(mm, power); },
+                                           m, data, options.adjoint);
+            });
+    return fit.solve();
+}
+
+} // namespace ensiie
@@ -0,0 +1,112 @@
+/**
+ * @file inverse.hpp
+ * @brief Material and source power estimation from probe series.
+ *
+ * The unknowns θ (conductivity, volumetric heat capacity ρc, a power
+ * scale of the heat sources) are fitted so that the simulated probe
+ * temperatures match measured series in the least-squares sense
+ * (the objective of adjoint.hpp). They are optimised in logarithmic
+ * coordinates xₖ = ln θₖ: they stay positive and the steps are relative.
+ *
+ * Two methods:
+ * - Levenberg–Marquardt works on the residual vector of any solver,
+ *   phase change included. Its Jacobian is taken by forward differences,
+ *   one forward run per unknown, all run concurrently; the damped
+ *   Gauss–Newton step is then tried for several damping values at once.
+ * - L-BFGS takes its gradients from the adjoint sweep (linear problems
+ *   only) and tries several step lengths concurrently, keeping the
+ *   longest one satisfying the Armijo condition.
+ *
+ * Concurrent runs are independent solvers on separate threads: wall time
+ * per iteration is about one run when enough cores are available.
+ */
+
+#ifndef INVERSE_HPP
+#define INVERSE_HPP
+
+#include "adjoint.hpp"
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace ensiie {
+
+/**
+ * @brief Optimisation method of an inverse fit
+ */
+enum class InverseMethod {
+    LEVENBERG_MARQUARDT,  ///< Finite-difference Jacobian, any solver
+    LBFGS                 ///< Adjoint gradients, linear problems only
+};
+
+/**
+ * @struct InverseOptions
+ * @brief Unknowns, method and stopping criteria of an inverse fit.
+ */
+struct InverseOptions {
+    InverseMethod method = InverseMethod::LEVENBERG_MARQUARDT;  ///< Optimiser
+    bool fit_lambda = true;     ///< Fit λ (and λ_y of anisotropic materials)
+    bool fit_rhoc = true;       ///< Fit ρc (ρ is rescaled, c is kept)
+    bool fit_power = false;     ///< Fit one power scale of all heat sources
+    int max_iterations = 50;    ///< Iteration limit
+    double tolerance = 1e-6;    ///< Relative parameter change at which the fit stops
+    int trials = 4;             ///< Damping values or step lengths tried per iteration
+    int threads = 0;            ///< Concurrent forward runs (<= 0: one per hardware thread)
+    double damping = 1e-3;      ///< Initial Levenberg–Marquardt damping
+    double difference_step = 1e-4;  ///< Relative step of the Jacobian differences
+    int memory = 8;             ///< L-BFGS correction pairs
+    AdjointOptions adjoint;     ///< Gradient solves of L-BFGS
+};
+
+/**
+ * @struct InverseResult
+ * @brief Fitted parameters and convergence record.
+ */
+struct InverseResult {
+    Material material;            ///< Fitted material
+    double power = 1.0;           ///< Fitted source power scale
+    double objective = 0.0;       ///< Final misfit J [K²]
+    double rms = 0.0;             ///< Final RMS residual [K]
+    int iterations = 0;           ///< Iterations performed
+    int runs = 0;                 ///< Forward runs (an adjoint gradient counts as one)
+    bool converged = false;       ///< Whether the tolerance was reached
+    std::vector<double> history;  ///< Misfit after each iteration
+};
+
+/// Builds a bar solver for a material and a source power scale (called concurrently)
+using InverseFactory1D = std::function<std::unique_ptr<HeatSolver1D>(const Material&, double power)>;
+
+/// Builds a plate solver for a material and a source power scale (called concurrently)
+using InverseFactory2D = std::function<std::unique_ptr<HeatSolver2D>(const Material&, double power)>;
+
+/**
+ * @brief Fit the material of a bar to probe series.
+ *
+ * @param make Solver factory; must be callable from several threads
+ * @param guess Starting material (its c and the fixed fields are kept)
+ * @param data Measured probe series (ProbeData::y is ignored)
+ * @param options Unknowns, method and stopping criteria
+ * @throws std::invalid_argument if nothing is fitted, the guess is not
+ *         positive or no sample is measured; L-BFGS throws on non-linear
+ *         problems (LinearStep)
+ */
+InverseResult fit_material_1d(const InverseFactory1D& make, const Material& guess,
+                              const std::vector<ProbeData>& data,
+                              const InverseOptions& options = {});
+
+/**
+ * @brief Fit the material of a plate to probe series.
+ *
+ * @param make Solver factory; must be callable from several threads
+ * @param guess Starting material (λ_y is fitted when set)
+ * @param data Measured probe series
+ * @param options Unknowns, method and stopping criteria
+ * @throws std::invalid_argument as fit_material_1d()
+ */
+InverseResult fit_material_2d(const InverseFactory2D& make, const Material& guess,
+                              const std::vector<ProbeData>& data,
+                              const InverseOptions& options = {});
+
+} // namespace ensiie
+
+#endif
@@ -0,0 +1,638 @@
+/**
+ * @file krylov.cpp
+ * @brief Preconditioners and Krylov iterations.
+ */
+
+#include "krylov.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace ensiie {
+
+namespace {
+
+/// Residuals below this fraction of ||b|| are round-off
+constexpr double RESIDUAL_FLOOR = 1e-14;
+
+/// Strength threshold of the AMG aggregation: |a_ij| >= θ·sqrt(|a_ii·a_jj|)
+constexpr double AMG_THETA = 0.08;
+
+/// Rows at which AMG coarsening stops and the level is solved directly
+constexpr int AMG_COARSE_SIZE = 256;
+
+/// Largest coarsest level factored densely (larger ones are smoothed only)
+constexpr int AMG_DENSE_MAX = 512;
+
+/// Deepest AMG hierarchy
+constexpr int AMG_MAX_LEVELS = 20;
+
+/// Damped Jacobi sweeps before and after each coarse correction
+constexpr int AMG_SWEEPS = 2;
+
+/// Damping of the Jacobi smoother
+constexpr double AMG_OMEGA = 2.0 / 3.0;
+
+/// Scaling of the coarse correction (piecewise constant prolongation
+/// underestimates smooth errors)
+constexpr double AMG_OVERCORRECT = 1.5;
+
+double norm(const std::vector<double>& a) {
+    return std::sqrt(dot(a, a));
+}
+
+/**
+ * @brief z = M⁻¹·r, or z = r without preconditioner.
+ */
+void precondition(const Preconditioner* M, const std::vector<double>& r, std::vector<double>& z) {
+    if (M) {
+        M->apply(r, z);
+    } else {
+        z = r;
+    }
+}
+
+/**
+ * @brief Inverse diagonal of A.
+ * @throws std::invalid_argument if a diagonal entry is zero
+ */
+std::vector<double> inverse_diagonal(const CsrMatrix& A) {
+    std::vector<double> d = A.diagonal();
+    for (double& v : d) {
+        if (v == 0.0) throw std::invalid_argument("preconditioner needs a nonzero diagonal");
+        v = 1.0 / v;
+    }
+    return d;
+}
+
+// ============================================================================
+// Preconditioners
+// ============================================================================
+
+class JacobiPreconditioner : public Preconditioner {
+public:
+    explicit JacobiPreconditioner(const CsrMatrix& A) : inv_diag_(inverse_diagonal(A)) {}
+
+    void apply(const std::vector<double>& r, std::vector<double>& z) const override {
+        const int n = static_cast<int>(inv_diag_.size());
+        z.resize(n);
+        parallel::for_range(n, [&](int begin, int end) {
+            for (int i = begin; i < end; i++) z[i] = inv_diag_[i] * r[i];
+        });
+    }
+
+private:
+    std::vector<double> inv_diag_;  ///< 1 / a_ii
+};
+
+class Ilu0Preconditioner : public Preconditioner {
+public:
+    explicit Ilu0Preconditioner(const CsrMatrix& A) : lu_(A), diag_(A.n) {
+        const int n = A.n;
+        for (int i = 0; i < n; i++) {
+            diag_[i] = lu_.find(i, i);
+            if (diag_[i] < 0 || lu_.val[diag_[i]] == 0.0) {
+                throw std::invalid_argument("preconditioner needs a nonzero diagonal");
+            }
+        }
+
+        // IKJ elimination restricted to the pattern of A
+        std::vector<int> position(n, -1);
+        for (int i = 0; i < n; i++) {
+            for (int k = lu_.row_ptr[i]; k < lu_.row_ptr[i + 1]; k++) position[lu_.col[k]] = k;
+            for (int k = lu_.row_ptr[i]; k < diag_[i]; k++) {
+                const int p = lu_.col[k];
+                lu_.val[k] /= lu_.val[diag_[p]];
+                for (int m = diag_[p] + 1; m < lu_.row_ptr[p + 1]; m++) {
+                    const int pos = position[lu_.col[m]];
+                    if (pos >= 0) lu_.val[pos] -= lu_.val[k] * lu_.val[m];
+                }
+            }
+            for (int k = lu_.row_ptr[i]; k < lu_.row_ptr[i + 1]; k++) position[lu_.col[k]] = -1;
+            if (lu_.val[diag_[i]] == 0.0) {
+                throw std::invalid_argument("incomplete LU factorisation broke down");
+            }
+        }
+    }
+
+    void apply(const std::vector<double>& r, std::vector<double>& z) const override {
+        const int n = lu_.n;
+        z.resize(n);
+        // L·y = r (unit lower triangle), then U·z = y
+        for (int i = 0; i < n; i++) {
+            double s = r[i];
+            for (int k = lu_.row_ptr[i]; k < diag_[i]; k++) s -= lu_.val[k] * z[lu_.col[k]];
+            z[i] = s;
+        }
+        for (int i = n - 1; i >= 0; i--) {
+            double s = z[i];
+            for (int k = diag_[i] + 1; k < lu_.row_ptr[i + 1]; k++) s -= lu_.val[k] * z[lu_.col[k]];
+            z[i] = s / lu_.val[diag_[i]];
+        }
+    }
+
+private:
+    CsrMatrix lu_;           ///< L (strictly lower, unit diagonal) and U in the pattern of A
+    std::vector<int> diag_;  ///< Position of the diagonal entry of each row
+};
+
+class AmgPreconditioner : public Preconditioner {
+public:
+    explicit AmgPreconditioner(const CsrMatrix& A) {
+        levels_.emplace_back();
+        levels_.back().A = A;
+        while (true) {
+            Level& fine = levels_.back();
+            fine.inv_diag = inverse_diagonal(fine.A);
+            if (fine.A.n <= AMG_COARSE_SIZE || static_cast<int>(levels_.size()) >= AMG_MAX_LEVELS) break;
+
+            const int nc = aggregate(fine.A, fine.aggregate);
+            if (nc == 0 || nc > 0.8 * fine.A.n) {
+                fine.aggregate.clear();
+                break;
+            }
+            CsrMatrix coarse = galerkin(fine.A, fine.aggregate, nc);
+            levels_.emplace_back();
+            levels_.back().A = std::move(coarse);
+        }
+        factor_coarsest();
+    }
+
+    void apply(const std::vector<double>& r, std::vector<double>& z) const override {
+        z.assign(r.size(), 0.0);
+        cycle(0, r, z);
+    }
+
+private:
+    struct Level {
+        CsrMatrix A;                   ///< Operator of the level
+        std::vector<double> inv_diag;  ///< 1 / a_ii for the smoother
+        std::vector<int> aggregate;    ///< Coarse node of each node (-1: not coarsened)
+    };
+
+    std::vector<Level> levels_;   ///< Finest first
+    std::vector<double> lu_;      ///< Dense LU of the coarsest level (row-major), empty if too large
+    std::vector<int> pivot_;      ///< Row pivots of lu_
+
+    /**
+     * @brief Group strongly coupled nodes; returns the number of aggregates.
+     *
+     * Nodes without strong neighbours (Dirichlet rows) are left to the
+     * smoother.
+     */
+    static int aggregate(const CsrMatrix& A, std::vector<int>& agg) {
+        const int n = A.n;
+        const std::vector<double> d = A.diagonal();
+        auto strong = [&](int i, int k) {
+            const int j = A.col[k];
+            return j != i && std::abs(A.val[k]) >= AMG_THETA * std::sqrt(std::abs(d[i] * d[j]));
+        };
+
+        agg.assign(n, -2);  // -2: not visited
+        int nc = 0;
+
+        // Pass 1: a node whose strong neighbours are all free seeds an aggregate
+        for (int i = 0; i < n; i++) {
+            if (agg[i] != -2) continue;
+            bool free = true, any = false;
+            for (int k = A.row_ptr[i]; k < A.row_ptr[i + 1]; k++) {
+                if (!strong(i, k)) continue;
+                any = true;
+                if (agg[A.col[k]] != -2) free = false;
+            }
+            if (!any) {
+                agg[i] = -1;
+                continue;
+            }
+            if (!free) continue;
+            agg[i] = nc;
+            for (int k = A.row_ptr[i]; k < A.row_ptr[i + 1]; k++) {
+                if (strong(i, k)) agg[A.col[k]] = nc;
+            }
+            nc++;
+        }
+
+        // Pass 2: remaining nodes join the aggregate of their strongest neighbour
+        std::vector<int> pass1 = agg;
+        for (int i = 0; i < n; i++) {
+            if (agg[i] != -2) continue;
+            double best = 0.0;
+            for (int k = A.row_ptr[i]; k < A.row_ptr[i + 1]; k++) {
+                if (strong(i, k) && pass1[A.col[k]] >= 0 && std::abs(A.val[k]) > best) {
+                    best = std::abs(A.val[k]);
+                    agg[i] = pass1[A.col[k]];
+                }
+            }
+        }
+
+        // Pass 3: leftovers form aggregates with their free strong neighbours
+        for (int i = 0; i < n; i++) {
+            if (agg[i] != -2) continue;
+            agg[i] = nc;
+            for (int k = A.row_ptr[i]; k < A.row_ptr[i + 1]; k++) {
+                if (strong(i, k) && agg[A.col[k]] == -2) agg[A.col[k]] = nc;
+            }
+            nc++;
+        }
+        return nc;
+    }
+
+    /**
+     * @brief Pᵀ·A·P for the piecewise constant prolongation of the aggregates.
+     */
+    static CsrMatrix galerkin(const CsrMatrix& A, const std::vector<int>& agg, int nc) {
+        std::vector<std::vector<int>> members(nc);
+        for (int i = 0; i < A.n; i++) {
+            if (agg[i] >= 0) members[agg[i]].push_back(i);
+        }
+
+        CsrMatrix C;
+        C.n = nc;
+        C.row_ptr.assign(nc + 1, 0);
+        std::vector<double> row(nc, 0.0);
+        std::vector<int> cols;
+        std::vector<bool> used(nc, false);
+        for (int I = 0; I < nc; I++) {
+            cols.clear();
+            for (int i : members[I]) {
+                for (int k = A.row_ptr[i]; k < A.row_ptr[i + 1]; k++) {
+                    const int J = agg[A.col[k]];
+                    if (J < 0) continue;
+                    if (!used[J]) {
+                        used[J] = true;
+                        cols.push_back(J);
+                    }
+                    row[J] += A.val[k];
+                }
+            }
+            std::sort(cols.begin(), cols.end());
+            for (int J : cols) {
+                C.col.push_back(J);
+                C.val.push_back(row[J]);
+                row[J] = 0.0;
+                used[J] = false;
+            }
+            C.row_ptr[I + 1] = static_cast<int>(C.col.size());
+        }
+        return C;
+    }
+
+    /**
+     * @brief LU factorisation with partial pivoting of the coarsest level.
+     */
+    void factor_coarsest() {
+        const CsrMatrix& A = levels_.back().A;
+        const int n = A.n;
+        if (n > AMG_DENSE_MAX) return;
+        lu_.assign(static_cast<std::size_t>(n) * n, 0.0);
+        pivot_.resize(n);
+        for (int i = 0; i < n; i++) {
+            for (int k = A.row_ptr[i]; k < A.row_ptr[i + 1]; k++) lu_[i * n + A.col[k]] = A.val[k];
+        }
+        for (int c = 0; c < n; c++) {
+            int p = c;
+            for (int i = c + 1; i < n; i++) {
+                if (std::abs(lu_[i * n + c]) > std::abs(lu_[p * n + c])) p = i;
+            }
+            pivot_[c] = p;
+            if (p != c) {
+                for (int j = 0; j < n; j++) std::swap(lu_[c * n + j], lu_[p * n + j]);
+            }
+            const double piv = lu_[c * n + c];
+            if (piv == 0.0) {
+                // Singular coarse operator: fall back to smoothing
+                lu_.clear();
+                return;
+            }
+            for (int i = c + 1; i < n; i++) {
+                const double f = lu_[i * n + c] / piv;
+                lu_[i * n + c] = f;
+                for (int j = c + 1; j < n; j++) lu_[i * n + j] -= f * lu_[c * n + j];
+            }
+        }
+    }
+
+    /**
+     * @brief x += ω·D⁻¹·(b - A·x), repeated.
+     */
+    static void smooth(const Level& L, const std::vector<double>& b, std::vector<double>& x,
+                       std::vector<double>& ax, int sweeps) {
+        for (int s = 0; s < sweeps; s++) {
+            L.A.apply(x, ax);
+            parallel::for_range(L.A.n, [&](int begin, int end) {
+                for (int i = begin; i < end; i++) x[i] += AMG_OMEGA * L.inv_diag[i] * (b[i] - ax[i]);
+            });
+        }
+    }
+
+    /**
+     * @brief V-cycle on level l from x = 0.
+     */
+    void cycle(std::size_t l, const std::vector<double>& b, std::vector<double>& x) const {
+        const Level& L = levels_[l];
+        const int n = L.A.n;
+        std::vector<double> ax(n);
+
+        if (l + 1 == levels_.size()) {
+            if (lu_.empty()) {
+                smooth(L, b, x, ax, 2 * AMG_SWEEPS);
+                return;
+            }
+            x = b;
+            for (int c = 0; c < n; c++) std::swap(x[c], x[pivot_[c]]);
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < i; j++) x[i] -= lu_[i * n + j] * x[j];
+            }
+            for (int i = n - 1; i >= 0; i--) {
+                for (int j = i + 1; j < n; j++) x[i] -= lu_[i * n + j] * x[j];
+                x[i] /= lu_[i * n + i];
+            }
+            return;
+        }
+
+        smooth(L, b, x, ax, AMG_SWEEPS);
+
+        // Restrict the residual (sum over each aggregate), correct, prolong
+        const int nc = levels_[l + 1].A.n;
+        L.A.apply(x, ax);
+        std::vector<double> bc(nc, 0.0), xc(nc, 0.0);
+        for (int i = 0; i < n; i++) {
+            if (L.aggregate[i] >= 0) bc[L.aggregate[i]] += b[i] - ax[i];
+        }
+        cycle(l + 1, bc, xc);
+        for (int i = 0; i < n; i++) {
+            if (L.aggregate[i] >= 0) x[i] += AMG_OVERCORRECT * xc[L.aggregate[i]];
+        }
+
+        smooth(L, b, x, ax, AMG_SWEEPS);
+    }
+};
+
+// ============================================================================
+// Iterations
+// ============================================================================
+
+SolveStats conjugate_gradient(const LinearOperator& A, const Preconditioner* M,
+                              const std::vector<double>& b, std::vector<double>& x,
+                              const KrylovOptions& opt) {
+    const int n = A.size();
+    SolveStats stats;
+    std::vector<double> r(n), z(n), p(n), q(n);
+
+    A.apply(x, q);
+    parallel::for_range(n, [&](int begin, int end) {
+        for (int i = begin; i < end; i++) r[i] = b[i] - q[i];
+    });
+    precondition(M, r, z);
+    p = z;
+    double rz = dot(r, z);
+    double rr = dot(r, r);
+
+    // Reduce the residual of the initial guess, down to round-off of b
+    const double r0 = std::sqrt(rr);
+    const double target = std::max(opt.tol * r0, RESIDUAL_FLOOR * norm(b));
+    stats.residual = (r0 > 0.0) ? 1.0 : 0.0;
+    while (std::sqrt(rr) > target && stats.iterations < opt.max_iter) {
+        A.apply(p, q);
+        const double pq = dot(p, q);
+        if (!(pq > 0.0)) break;
+        const double alpha = rz / pq;
+
+        // x += α·p, r -= α·q, fused with the residual norm
+        rr = parallel::sum(n, [&](int begin, int end) {
+            double s = 0.0;
+            for (int i = begin; i < end; i++) {
+                x[i] += alpha * p[i];
+                r[i] -= alpha * q[i];
+                s += r[i] * r[i];
+            }
+            return s;
+        });
+        precondition(M, r, z);
+        const double rz_new = dot(r, z);
+        const double beta = rz_new / rz;
+        rz = rz_new;
+        parallel::for_range(n, [&](int begin, int end) {
+            for (int i = begin; i < end; i++) p[i] = z[i] + beta * p[i];
+        });
+
+        stats.iterations++;
+        stats.residual = std::sqrt(rr) / r0;
+    }
+    stats.converged = std::sqrt(rr) <= target;
+    return stats;
+}
+
+SolveStats bicgstab(const LinearOperator& A, const Preconditioner* M,
+                    const std::vector<double>& b, std::vector<double>& x,
+                    const KrylovOptions& opt) {
+    const int n = A.size();
+    SolveStats stats;
+    std::vector<double> r(n), r_hat, p(n, 0.0), v(n, 0.0), s(n), t(n), p_hat(n), s_hat(n);
+
+    A.apply(x, t);
+    parallel::for_range(n, [&](int begin, int end) {
+        for (int i = begin; i < end; i++) r[i] = b[i] - t[i];
+    });
+    r_hat = r;
+
+    const double r0 = norm(r);
+    const double target = std::max(opt.tol * r0, RESIDUAL_FLOOR * norm(b));
+    double res = r0;
+    stats.residual = (r0 > 0.0) ? 1.0 : 0.0;
+    double rho = 1.0, alpha = 1.0, omega = 1.0;
+    while (res > target && stats.iterations < opt.max_iter) {
+        const double rho_new = dot(r_hat, r);
+        if (rho_new == 0.0) break;
+        const double beta = (rho_new / rho) * (alpha / omega);
+        rho = rho_new;
+        parallel::for_range(n, [&](int begin, int end) {
+            for (int i = begin; i < end; i++) p[i] = r[i] + beta * (p[i] - omega * v[i]);
+        });
+
+        precondition(M, p, p_hat);
+        A.apply(p_hat, v);
+        const double rv = dot(r_hat, v);
+        if (rv == 0.0) break;
+        alpha = rho / rv;
+        parallel::for_range(n, [&](int begin, int end) {
+            for (int i = begin; i < end; i++) s[i] = r[i] - alpha * v[i];
+        });
+
+        stats.iterations++;
+        const double ss = norm(s);
+        if (ss <= target) {
+            parallel::for_range(n, [&](int begin, int end) {
+                for (int i = begin; i < end; i++) x[i] += alpha * p_hat[i];
+            });
+            res = ss;
+            break;
+        }
+
+        precondition(M, s, s_hat);
+        A.apply(s_hat, t);
+        const double tt = dot(t, t);
+        omega = (tt > 0.0) ? dot(t, s) / tt : 0.0;
+        res = std::sqrt(parallel::sum(n, [&](int begin, int end) {
+            double sum = 0.0;
+            for (int i = begin; i < end; i++) {
+                x[i] += alpha * p_hat[i] + omega * s_hat[i];
+                r[i] = s[i] - omega * t[i];
+                sum += r[i] * r[i];
+            }
+            return sum;
+        }));
+        stats.residual = res / r0;
+        if (omega == 0.0) break;
+    }
+    stats.residual = (r0 > 0.0) ? res / r0 : 0.0;
+    stats.converged = res <= target;
+    return stats;
+}
+
+SolveStats gmres(const LinearOperator& A, const Preconditioner* M,
+                 const std::vector<double>& b, std::vector<double>& x,
+                 const KrylovOptions& opt) {
+    const int n = A.size();
+    const int m = std::max(1, opt.restart);
+    SolveStats stats;
+
+    // Krylov basis V, preconditioned directions Z = M⁻¹·V (right preconditioning)
+    std::vector<std::vector<double>> V(m + 1, std::vector<double>(n)), Z(m, std::vector<double>(n));
+    std::vector<double> H((m + 1) * m), cs(m), sn(m), g(m + 1), y(m), w(n);
+
+    A.apply(x, w);
+    parallel::for_range(n, [&](int begin, int end) {
+        for (int i = begin; i < end; i++) V[0][i] = b[i] - w[i];
+    });
+    const double r0 = norm(V[0]);
+    const double target = std::max(opt.tol * r0, RESIDUAL_FLOOR * norm(b));
+    double res = r0;
+
+    while (res > target && stats.iterations < opt.max_iter) {
+        // V[0] holds the residual on entry of each cycle
+        const double g_start = res;
+        std::fill(g.begin(), g.end(), 0.0);
+        g[0] = res;
+        parallel::for_range(n, [&](int begin, int end) {
+            for (int i = begin; i < end; i++) V[0][i] /= res;
+        });
+
+        int j = 0;
+        for (; j < m && res > target && stats.iterations < opt.max_iter; j++) {
+            precondition(M, V[j], Z[j]);
+            A.apply(Z[j], w);
+
+            // Modified Gram–Schmidt
+            for (int i = 0; i <= j; i++) {
+                const double h = dot(w, V[i]);
+                H[i * m + j] = h;
+                parallel::for_range(n, [&](int begin, int end) {
+                    for (int k = begin; k < end; k++) w[k] -= h * V[i][k];
+                });
+            }
+            const double h = norm(w);
+            H[(j + 1) * m + j] = h;
+            if (h > 0.0) {
+                parallel::for_range(n, [&](int begin, int end) {
+                    for (int k = begin; k < end; k++) V[j + 1][k] = w[k] / h;
+                });
+            }
+
+            // Givens rotations keep H upper triangular
+            for (int i = 0; i < j; i++) {
+                const double a = H[i * m + j], c = H[(i + 1) * m + j];
+                H[i * m + j] = cs[i] * a + sn[i] * c;
+                H[(i + 1) * m + j] = -sn[i] * a + cs[i] * c;
+            }
+            const double a = H[j * m + j], c = H[(j + 1) * m + j];
+            const double r = std::hypot(a, c);
+            cs[j] = (r > 0.0) ? a / r : 1.0;
+            sn[j] = (r > 0.0) ? c / r : 0.0;
+            H[j * m + j] = r;
+            H[(j + 1) * m + j] = 0.0;
+            g[j + 1] = -sn[j] * g[j];
+            g[j] = cs[j] * g[j];
+
+            res = std::abs(g[j + 1]);
+            stats.iterations++;
+            if (h == 0.0) {
+                j++;
+                break;
+            }
+        }
+
+        // x += Z·y with H·y = g
+        for (int i = j - 1; i >= 0; i--) {
+            double s = g[i];
+            for (int k = i + 1; k < j; k++) s -= H[i * m + k] * y[k];
+            y[i] = (H[i * m + i] != 0.0) ? s / H[i * m + i] : 0.0;
+        }
+        parallel::for_range(n, [&](int begin, int end) {
+            for (int i = 0; i < j; i++) {
+                for (int k = begin; k < end; k++) x[k] += y[i] * Z[i][k];
+            }
+        });
+
+        // True residual for the next cycle
+        A.apply(x, w);
+        parallel::for_range(n, [&](int begin, int end) {
+            for (int i = begin; i < end; i++) V[0][i] = b[i] - w[i];
+        });
+        res = norm(V[0]);
+        if (!(res < g_start)) break;  // stagnation
+    }
+    stats.residual = (r0 > 0.0) ? res / r0 : 0.0;
+    stats.converged = res <= target;
+    return stats;
+}
+
+} // namespace
+
+double dot(const std::vector<double>& a, const std::vector<double>& b) {
+    return parallel::sum(static_cast<int>(a.size()), [&](int begin, int end) {
+        double s = 0.0;
+        for (int i = begin; i < end; i++) s += a[i] * b[i];
+        return s;
+    });
+}
+
+std::unique_ptr<Preconditioner> make_preconditioner(const CsrMatrix& A, PreconditionerKind kind) {
+    switch (kind) {
+        case PreconditionerKind::JACOBI: return std::make_unique<JacobiPreconditioner>(A);
+        case PreconditionerKind::ILU0: return std::make_unique<Ilu0Preconditioner>(A);
+        case PreconditionerKind::AMG: return std::make_unique<AmgPreconditioner>(A);
+        case PreconditionerKind::NONE: break;
+    }
+    return nullptr;
+}
+
+SolveStats krylov_solve(const LinearOperator& A, const Preconditioner* M,
+                        const std::vector<double>& b, std::vector<double>& x,
+                        const KrylovOptions& options) {
+    switch (options.method) {
+        case KrylovMethod::BICGSTAB: return bicgstab(A, M, b, x, options);
+        case KrylovMethod::GMRES: return gmres(A, M, b, x, options);
+        case KrylovMethod::CG: break;
+    }
+    return conjugate_gradient(A, M, b, x, options);
+}
+
+KrylovSolver::KrylovSolver(CsrMatrix A, const KrylovOptions& options)
+    : options_(options)
+    , csr_(std::move(A))
+{
+    if (options_.format == MatrixFormat::SELL) sell_ = SellMatrix(csr_);
+    precond_ = make_preconditioner(csr_, options_.preconditioner);
+}
+
+SolveStats KrylovSolver::solve(const std::vector<double>& b, std::vector<double>& x) const {
+    const LinearOperator& A = (options_.format == MatrixFormat::SELL)
+        ? static_cast<const LinearOperator&>(sell_)
+        : static_cast<const LinearOperator&>(csr_);
+    return krylov_solve(A, precond_.get(), b, x, options_);
+}
+
+} // namespace ensiie
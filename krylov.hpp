@@ -0,0 +1,159 @@
+/**
+ * @file krylov.hpp
+ * @brief Krylov methods and preconditioners for sparse systems A·x = b.
+ *
+ * Methods:
+ * - Conjugate gradients: symmetric positive definite systems (triangle
+ *   meshes)
+ * - BiCGStab: nonsymmetric systems, short recurrences (finite difference
+ *   plates, whose mirrored edges make the matrix nonsymmetric)
+ * - GMRES(m): nonsymmetric systems, restarted every m iterations,
+ *   monotone residual
+ *
+ * Preconditioners (built from a CSR matrix):
+ * - Jacobi: inverse diagonal, fully parallel
+ * - ILU(0): incomplete LU on the matrix pattern; the triangular solves
+ *   are sequential
+ * - AMG: aggregation multigrid V-cycle. Strongly coupled nodes are
+ *   grouped into aggregates, the coarse matrix is the Galerkin product
+ *   with piecewise constant prolongation, damped Jacobi smooths every
+ *   level and the coarsest one is solved directly. Iteration counts stay
+ *   nearly flat as the grid is refined.
+ *
+ * The vector operations and products run on the worker pool
+ * (parallel.hpp).
+ */
+
+#ifndef KRYLOV_HPP
+#define KRYLOV_HPP
+
+#include "sparse.hpp"
+#include <memory>
+#include <vector>
+
+namespace ensiie {
+
+/**
+ * @brief Krylov iteration
+ */
+enum class KrylovMethod {
+    CG,        ///< Conjugate gradients (symmetric positive definite A)
+    BICGSTAB,  ///< Biconjugate gradient stabilised
+    GMRES      ///< Restarted generalised minimal residual
+};
+
+/**
+ * @brief Preconditioner of a Krylov solve
+ */
+enum class PreconditionerKind {
+    NONE,    ///< Identity
+    JACOBI,  ///< Inverse diagonal
+    ILU0,    ///< Incomplete LU without fill-in
+    AMG      ///< Aggregation algebraic multigrid V-cycle
+};
+
+/**
+ * @struct KrylovOptions
+ * @brief Method, preconditioner, storage format and stopping criterion.
+ */
+struct KrylovOptions {
+    KrylovMethod method = KrylovMethod::CG;                     ///< Iteration
+    PreconditionerKind preconditioner = PreconditionerKind::JACOBI;  ///< Preconditioner
+    MatrixFormat format = MatrixFormat::CSR;                    ///< Storage of A for the products
+    double tol = 1e-8;      ///< Residual reduction to reach
+    int max_iter = 10000;   ///< Iteration limit
+    int restart = 30;       ///< GMRES restart length
+};
+
+/**
+ * @struct SolveStats
+ * @brief Outcome of an iterative solve.
+ */
+struct SolveStats {
+    int iterations = 0;      ///< Iterations performed
+    double residual = 0.0;   ///< Final residual relative to the initial one
+    bool converged = false;  ///< Whether the tolerance was reached
+};
+
+/**
+ * @class Preconditioner
+ * @brief Approximate inverse z = M⁻¹·r.
+ */
+class Preconditioner {
+public:
+    virtual ~Preconditioner() = default;
+
+    /**
+     * @brief z = M⁻¹·r (z is resized if needed).
+     */
+    virtual void apply(const std::vector<double>& r, std::vector<double>& z) const = 0;
+};
+
+/**
+ * @brief Dot product a·b, on the worker pool for long vectors.
+ *
+ * The partial sums are added in a fixed order, so the result does not
+ * depend on the scheduling.
+ */
+double dot(const std::vector<double>& a, const std::vector<double>& b);
+
+/**
+ * @brief Build a preconditioner of A (nullptr for PreconditionerKind::NONE).
+ *
+ * Preconditioners are immutable once built: apply() may be called from
+ * several threads at once.
+ *
+ * @throws std::invalid_argument if A has a zero diagonal entry
+ */
+std::unique_ptr<Preconditioner> make_preconditioner(const CsrMatrix& A, PreconditionerKind kind);
+
+/**
+ * @brief Solve A·x = b.
+ *
+ * x holds the initial guess on entry (the previous time step is a good
+ * one). The iteration stops when ||b - A·x|| has dropped by options.tol
+ * from the initial guess, or to the round-off level of b.
+ *
+ * @param M Preconditioner (nullptr: none)
+ */
+SolveStats krylov_solve(const LinearOperator& A, const Preconditioner* M,
+                        const std::vector<double>& b, std::vector<double>& x,
+                        const KrylovOptions& options);
+
+/**
+ * @class KrylovSolver
+ * @brief Matrix in its product format, preconditioner and options, built once.
+ */
+class KrylovSolver {
+public:
+    KrylovSolver() = default;
+
+    /**
+     * @brief Prepare the solves of A·x = b.
+     * @throws std::invalid_argument if the preconditioner cannot be built
+     */
+    KrylovSolver(CsrMatrix A, const KrylovOptions& options);
+
+    /**
+     * @brief Solve A·x = b from the initial guess in x.
+     */
+    SolveStats solve(const std::vector<double>& b, std::vector<double>& x) const;
+
+    /**
+     * @brief Whether a matrix has been installed.
+     */
+    bool ready() const { return csr_.n > 0; }
+
+    const CsrMatrix& matrix() const { return csr_; }
+    const KrylovOptions& options() const { return options_; }
+
+private:
+    KrylovOptions options_;                    ///< Method and stopping criterion
+    CsrMatrix csr_;                            ///< Assembled matrix
+    SellMatrix sell_;                          ///< SELL copy (MatrixFormat::SELL)
+    std::shared_ptr<const Preconditioner> precond_;  ///< Preconditioner (null: none), shared by copies
+};
+
+} // namespace ensiie
+
+#endif
@@ -7,6 +7,7 @@
 #include "sdl_app.hpp"
 #include "material.hpp"
 
+#include <array>
 #include <iostream>
 #include <string>
 #include <limits>
@@ -41,7 +42,7 @@ int select_simulation_type() {
     return choice;
 }
 
-bool get_parameters(double& L, double& tmax, double& u0, double& f) {
+bool get_parameters(bool plate, double& L, double& Ly, double& tmax, double& u0, double& f) {
     std::cout << "\nPARAMETERS (Enter for default, 'b' to go back)\n";
     std::cout << "----------------------------------------------\n";
 
@@ -54,6 +55,16 @@ bool get_parameters(double& L, double& tmax, double& u0, double& f) {
     if (!input.empty()) {
         try { L = std::stod(input); } catch (...) { L = 1.0; }
     }
+    Ly = L;
+
+    if (plate) {
+        std::cout << "Plate height Ly [" << L << "] m: ";
+        std::getline(std::cin, input);
+        if (input == "b" || input == "B") return false;
+        if (!input.empty()) {
+            try { Ly = std::stod(input); } catch (...) { Ly = L; }
+        }
+    }
 
     std::cout << "Max time tmax [16.0] s: ";
     std::getline(std::cin, input);
@@ -79,16 +90,97 @@ bool get_parameters(double& L, double& tmax, double& u0, double& f) {
     return true;
 }
 
-bool confirm_and_start_grid(int sim_type, double L, double tmax, double u0, double f) {
+const char* const BOUNDARY_PRESETS[] = {
+    "Default (insulated x=0/y=0, u0 at x=L/y=L)",
+    "Cooled fin (hot base at x=0, convection elsewhere)",
+    "Ring (periodic in x, insulated in y)",
+    "Ambient cooling (convection on all edges)",
+    "Heated base ramp (x=0 ramps from u0 to u0+f)",
+    "Radiating fin (hot base at x=0, radiation + convection elsewhere)"
+};
+
+bool select_boundaries(int& preset, std::array<ensiie::BoundaryCondition, 4>& bc,
+                       double tmax, double u0, double f) {
+    using ensiie::BoundaryCondition;
+
+    std::cout << "\nBOUNDARY CONDITIONS (Enter for default, 'b' to go back)\n";
+    std::cout << "--------------------------------------------------------\n";
+    for (int i = 0; i < 6; i++) {
+        std::cout << "  " << (i + 1) << ". " << BOUNDARY_PRESETS[i] << "\n";
+    }
+    std::cout << "Choice [1]: ";
+
+    std::string input;
+    std::getline(std::cin, input);
+    if (input == "b" || input == "B") return false;
+    preset = 1;
+    if (!input.empty()) {
+        try { preset = std::stoi(input); } catch (...) { preset = 1; }
+        if (preset < 1 || preset > 6) preset = 1;
+    }
+
+    // Convective coefficient of still air around a fin [W/(m²K)]
+    const double h_air = 25.0;
+
+    // Emissivity of an oxidised steel surface
+    const double emissivity = 0.8;
+
+    switch (preset) {
+        case 2:
+            bc = {BoundaryCondition::dirichlet(u0 + f),
+                  BoundaryCondition::robin(h_air, u0),
+                  BoundaryCondition::robin(h_air, u0),
+                  BoundaryCondition::robin(h_air, u0)};
+            break;
+        case 3:
+            bc = {BoundaryCondition::periodic(),
+                  BoundaryCondition::periodic(),
+                  BoundaryCondition::neumann(),
+                  BoundaryCondition::neumann()};
+            break;
+        case 4:
+            bc = {BoundaryCondition::robin(h_air, u0),
+                  BoundaryCondition::robin(h_air, u0),
+                  BoundaryCondition::robin(h_air, u0),
+                  BoundaryCondition::robin(h_air, u0)};
+            break;
+        case 5:
+            bc = {BoundaryCondition::dirichlet_series({{0.0, u0}, {0.5 * tmax, u0 + f}}),
+                  BoundaryCondition::dirichlet(u0),
+                  BoundaryCondition::neumann(),
+                  BoundaryCondition::neumann()};
+            break;
+        case 6:
+            bc = {BoundaryCondition::dirichlet(u0 + f),
+                  BoundaryCondition::radiative(emissivity, u0, h_air),
+                  BoundaryCondition::radiative(emissivity, u0, h_air),
+                  BoundaryCondition::radiative(emissivity, u0, h_air)};
+            break;
+        default:
+            bc = {BoundaryCondition::neumann(),
+                  BoundaryCondition::dirichlet(u0),
+                  BoundaryCondition::neumann(),
+                  BoundaryCondition::dirichlet(u0)};
+            break;
+    }
+    return true;
+}
+
+bool confirm_and_start_grid(int sim_type, double L, double Ly, double tmax, double u0, double f, int preset) {
     const char* sim_names[] = {"1D Bar", "2D Plate"};
 
     std::cout << "\nCONFIGURATION (2x2 Grid - All Materials)\n";
     std::cout << "----------------------------------------\n";
     std::cout << "  Type:      " << sim_names[sim_type - 1] << "\n";
     std::cout << "  Materials: Copper, Iron, Glass, Polystyrene\n";
-    std::cout << "  L=" << L << " m, tmax=" << tmax << " s\n";
-    std::cout << "  u0=" << u0 << " C, f=" << f << " C\n\n";
-    std::cout << "Controls: SPACE=pause, R=reset, UP/DOWN=speed, ESC=quit\n\n";
+    if (sim_type == 2 && Ly != L) {
+        std::cout << "  Lx=" << L << " m, Ly=" << Ly << " m, tmax=" << tmax << " s\n";
+    } else {
+        std::cout << "  L=" << L << " m, tmax=" << tmax << " s\n";
+    }
+    std::cout << "  u0=" << u0 << " C, f=" << f << " C\n";
+    std::cout << "  Edges:     " << BOUNDARY_PRESETS[preset - 1] << "\n\n";
+    std::cout << "Controls: SPACE=pause, R=reset, UP/DOWN=speed, H=HUD, P=profile trace, ESC=quit\n\n";
     std::cout << "[S]tart  [B]ack  [Q]uit: ";
 
     char choice;
@@ -112,11 +204,14 @@ int main() {
             continue;
         }
 
-        double L = 1.0, tmax = 16.0, u0 = 13.0, f = 80.0;
+        double L = 1.0, Ly = 1.0, tmax = 16.0, u0 = 13.0, f = 80.0;
+        int preset = 1;
+        std::array<ensiie::BoundaryCondition, 4> bc;
 
         // Grid mode (all 4 materials)
-        if (!get_parameters(L, tmax, u0, f)) continue;
-        if (!confirm_and_start_grid(sim_type, L, tmax, u0, f)) continue;
+        if (!get_parameters(sim_type == 2, L, Ly, tmax, u0, f)) continue;
+        if (!select_boundaries(preset, bc, tmax, u0, f)) continue;
+        if (!confirm_and_start_grid(sim_type, L, Ly, tmax, u0, f, preset)) continue;
 
         std::cout << "\nStarting grid simulation...\n";
 
@@ -127,7 +222,7 @@ int main() {
                 ? sdl::SDLApp::SimType::BAR_1D
                 : sdl::SDLApp::SimType::PLATE_2D;
 
-            sdl::SDLApp app(type, L, tmax, u0, f);  // Grid mode constructor
+            sdl::SDLApp app(type, L, Ly, tmax, u0, f, bc);  // Grid mode constructor
             app.run();
 
             sdl::SDLCore::quit();
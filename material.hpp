@@ -18,12 +18,32 @@ struct Material {
     double lambda;       ///< Thermal conductivity W/(mK)
     double rho;          ///< Density kg/m^{3}
     double c;            ///< Specific heat J/(kgK)
+    double lambda_y = 0.0;  ///< Conductivity along y W/(mK), 0 = isotropic (2D only)
+    double latent_heat = 0.0;  ///< Latent heat of fusion J/kg, 0 = no phase change
+    double t_melt = 0.0;       ///< Melting temperature °C
+    double mushy = 0.0;        ///< Half-width of the melting range K, 0 = isothermal
 
     /**
      * @brief Compute thermal diffusivity.
      * @return Thermal diffusivity α = λ / (ρc) in m²/s
      */
     double alpha() const { return lambda / (rho * c); }
+
+    /**
+     * @brief Conductivity along y (λ unless the material is anisotropic).
+     */
+    double conductivity_y() const { return lambda_y > 0.0 ? lambda_y : lambda; }
+
+    /**
+     * @brief Thermal diffusivity along y.
+     * @return αy = λy / (ρc) in m²/s
+     */
+    double alpha_y() const { return conductivity_y() / (rho * c); }
+
+    /**
+     * @brief Whether the material melts/solidifies in the simulation.
+     */
+    bool changes_phase() const { return latent_heat > 0.0; }
 };
 
 /**
@@ -35,6 +55,7 @@ namespace Materials {
     const Material IRON        = {"Fer",          80.2, 7874.0,  440.0};
     const Material GLASS       = {"Verre",         1.2, 2530.0,  840.0};
     const Material POLYSTYRENE = {"Polystyrène",   0.1, 1040.0, 1200.0};
+    const Material PARAFFIN    = {"Paraffine",     0.2,  800.0, 2000.0, 0.0, 200e3, 55.0, 1.0};
 }
 
 } // namespace ensiie
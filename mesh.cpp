@@ -0,0 +1,428 @@
+/**
+ * @file mesh.cpp
+ * @brief Triangle mesh input/output, generators and node reordering.
+ */
+
+#include "mesh.hpp"
+#include "boundary.hpp"
+#include "profile.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace ensiie {
+
+namespace {
+
+/// First bytes of the binary format
+constexpr char BINARY_MAGIC[8] = {'T', 'R', 'I', 'M', 'E', 'S', 'H', '1'};
+
+/**
+ * @brief Node adjacency of a mesh in compressed row form.
+ */
+struct Adjacency {
+    std::vector<int> ptr;   ///< First neighbour of each node (size n + 1)
+    std::vector<int> list;  ///< Neighbours, sorted per node
+
+    int degree(int i) const { return ptr[i + 1] - ptr[i]; }
+};
+
+Adjacency adjacency(const TriMesh& mesh) {
+    const int n = mesh.nodes();
+    std::vector<std::pair<int, int>> pairs;
+    pairs.reserve(6 * mesh.tri.size());
+    for (const auto& t : mesh.tri) {
+        for (int a = 0; a < 3; a++) {
+            pairs.emplace_back(t[a], t[(a + 1) % 3]);
+            pairs.emplace_back(t[(a + 1) % 3], t[a]);
+        }
+    }
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+
+    Adjacency adj;
+    adj.ptr.assign(n + 1, 0);
+    adj.list.reserve(pairs.size());
+    for (const auto& p : pairs) {
+        adj.ptr[p.first + 1]++;
+        adj.list.push_back(p.second);
+    }
+    for (int i = 0; i < n; i++) adj.ptr[i + 1] += adj.ptr[i];
+    return adj;
+}
+
+/**
+ * @brief Breadth-first levels from root; returns the depth and the last level.
+ *
+ * @param level Scratch array, -1 on entry for the component, restored on exit
+ */
+int last_level(const Adjacency& adj, int root, std::vector<int>& level, std::vector<int>& last) {
+    std::vector<int> queue{root};
+    level[root] = 0;
+    for (std::size_t q = 0; q < queue.size(); q++) {
+        int i = queue[q];
+        for (int k = adj.ptr[i]; k < adj.ptr[i + 1]; k++) {
+            int j = adj.list[k];
+            if (level[j] < 0) {
+                level[j] = level[i] + 1;
+                queue.push_back(j);
+            }
+        }
+    }
+    const int depth = level[queue.back()];
+    last.clear();
+    for (int i : queue) {
+        if (level[i] == depth) last.push_back(i);
+        level[i] = -1;
+    }
+    return depth;
+}
+
+/**
+ * @brief Node of the component of start far from the rest (George–Liu search).
+ */
+int pseudo_peripheral(const Adjacency& adj, int start, std::vector<int>& level) {
+    std::vector<int> last, next;
+    int root = start;
+    int depth = last_level(adj, root, level, last);
+    for (;;) {
+        int cand = *std::min_element(last.begin(), last.end(), [&](int a, int b) {
+            return adj.degree(a) < adj.degree(b);
+        });
+        int d = last_level(adj, cand, level, next);
+        if (d <= depth) return root;
+        root = cand;
+        depth = d;
+        last.swap(next);
+    }
+}
+
+/**
+ * @brief Boundary edges (owned by one triangle) of a structured submesh.
+ *
+ * @param grid Index of each node on the nx × ny grid it was cut from
+ */
+std::vector<MeshEdge> structured_edges(const TriMesh& mesh, const std::vector<int>& grid,
+                                       int nx, int ny) {
+    std::vector<std::pair<std::pair<int, int>, int>> half;
+    half.reserve(3 * mesh.tri.size());
+    for (const auto& t : mesh.tri) {
+        for (int a = 0; a < 3; a++) {
+            int p = t[a], q = t[(a + 1) % 3];
+            half.push_back({{std::min(p, q), std::max(p, q)}, p});
+        }
+    }
+    std::sort(half.begin(), half.end());
+
+    std::vector<MeshEdge> edges;
+    for (std::size_t k = 0; k < half.size(); k++) {
+        if (k + 1 < half.size() && half[k + 1].first == half[k].first) {
+            k++;
+            continue;
+        }
+        MeshEdge e;
+        e.a = half[k].second;
+        e.b = (e.a == half[k].first.first) ? half[k].first.second : half[k].first.first;
+        const int ia = grid[e.a] % nx, ja = grid[e.a] / nx;
+        const int ib = grid[e.b] % nx, jb = grid[e.b] / nx;
+        if (ia == 0 && ib == 0) e.tag = WEST;
+        else if (ia == nx - 1 && ib == nx - 1) e.tag = EAST;
+        else if (ja == 0 && jb == 0) e.tag = SOUTH;
+        else if (ja == ny - 1 && jb == ny - 1) e.tag = NORTH;
+        else e.tag = HOLE_TAG;
+        edges.push_back(e);
+    }
+    return edges;
+}
+
+template <typename T>
+void read_binary(std::istream& in, T* data, std::size_t count) {
+    in.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+    if (!in) throw std::invalid_argument("mesh file is truncated");
+}
+
+template <typename T>
+void write_binary(std::ostream& out, const T* data, std::size_t count) {
+    out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(count * sizeof(T)));
+}
+
+TriMesh load_binary(std::istream& in) {
+    std::int32_t count[3];
+    read_binary(in, count, 3);
+    if (count[0] < 0 || count[1] < 0 || count[2] < 0) {
+        throw std::invalid_argument("mesh file has negative counts");
+    }
+
+    TriMesh mesh;
+    std::vector<double> xy(2 * static_cast<std::size_t>(count[0]));
+    std::vector<std::int32_t> tri(3 * static_cast<std::size_t>(count[1]));
+    std::vector<std::int32_t> edges(3 * static_cast<std::size_t>(count[2]));
+    read_binary(in, xy.data(), xy.size());
+    read_binary(in, tri.data(), tri.size());
+    read_binary(in, edges.data(), edges.size());
+
+    for (int i = 0; i < count[0]; i++) {
+        mesh.x.push_back(xy[2 * i]);
+        mesh.y.push_back(xy[2 * i + 1]);
+    }
+    for (int t = 0; t < count[1]; t++) {
+        mesh.tri.push_back({tri[3 * t], tri[3 * t + 1], tri[3 * t + 2]});
+    }
+    for (int e = 0; e < count[2]; e++) {
+        mesh.edges.push_back({edges[3 * e], edges[3 * e + 1], edges[3 * e + 2]});
+    }
+    return mesh;
+}
+
+TriMesh load_text(std::istream& in) {
+    // Strip comments, then read whitespace-separated tokens
+    std::stringstream tokens;
+    std::string line;
+    while (std::getline(in, line)) {
+        tokens << line.substr(0, line.find('#')) << '\n';
+    }
+
+    TriMesh mesh;
+    std::string section;
+    while (tokens >> section) {
+        long long count;
+        if (!(tokens >> count) || count < 0) {
+            throw std::invalid_argument("mesh section '" + section + "' has no valid count");
+        }
+        for (long long m = 0; m < count; m++) {
+            bool ok;
+            if (section == "nodes") {
+                double x, y;
+                ok = static_cast<bool>(tokens >> x >> y);
+                mesh.x.push_back(x);
+                mesh.y.push_back(y);
+            } else if (section == "triangles") {
+                std::array<int, 3> t;
+                ok = static_cast<bool>(tokens >> t[0] >> t[1] >> t[2]);
+                mesh.tri.push_back(t);
+            } else if (section == "edges") {
+                MeshEdge e;
+                ok = static_cast<bool>(tokens >> e.a >> e.b >> e.tag);
+                mesh.edges.push_back(e);
+            } else {
+                throw std::invalid_argument("unknown mesh section '" + section + "'");
+            }
+            if (!ok) throw std::invalid_argument("mesh section '" + section + "' is truncated");
+        }
+    }
+    return mesh;
+}
+
+} // namespace
+
+double TriMesh::area(int t) const {
+    const auto& v = tri[t];
+    return 0.5 * ((x[v[1]] - x[v[0]]) * (y[v[2]] - y[v[0]])
+                - (x[v[2]] - x[v[0]]) * (y[v[1]] - y[v[0]]));
+}
+
+TriMesh TriMesh::load(const std::string& path) {
+    PROFILE_ZONE("mesh load");
+    std::ifstream in(path, std::ios::binary);
+    if (!in) throw std::invalid_argument("cannot open mesh file " + path);
+
+    char magic[sizeof(BINARY_MAGIC)] = {};
+    in.read(magic, sizeof(magic));
+    const bool binary = in.gcount() == static_cast<std::streamsize>(sizeof(magic))
+                     && std::memcmp(magic, BINARY_MAGIC, sizeof(magic)) == 0;
+    if (!binary) {
+        in.clear();
+        in.seekg(0);
+    }
+
+    TriMesh mesh = binary ? load_binary(in) : load_text(in);
+    mesh.validate();
+    return mesh;
+}
+
+void TriMesh::save(const std::string& path, bool binary) const {
+    PROFILE_ZONE("mesh save");
+    std::ofstream out(path, binary ? std::ios::binary : std::ios::out);
+    if (!out) throw std::invalid_argument("cannot write mesh file " + path);
+
+    if (binary) {
+        out.write(BINARY_MAGIC, sizeof(BINARY_MAGIC));
+        const std::int32_t count[3] = {nodes(), triangles(), static_cast<std::int32_t>(edges.size())};
+        write_binary(out, count, 3);
+        for (int i = 0; i < nodes(); i++) {
+            const double xy[2] = {x[i], y[i]};
+            write_binary(out, xy, 2);
+        }
+        for (const auto& t : tri) {
+            const std::int32_t v[3] = {t[0], t[1], t[2]};
+            write_binary(out, v, 3);
+        }
+        for (const MeshEdge& e : edges) {
+            const std::int32_t v[3] = {e.a, e.b, e.tag};
+            write_binary(out, v, 3);
+        }
+        return;
+    }
+
+    out << std::setprecision(17);
+    out << "nodes " << nodes() << '\n';
+    for (int i = 0; i < nodes(); i++) out << x[i] << ' ' << y[i] << '\n';
+    out << "triangles " << triangles() << '\n';
+    for (const auto& t : tri) out << t[0] << ' ' << t[1] << ' ' << t[2] << '\n';
+    out << "edges " << edges.size() << '\n';
+    for (const MeshEdge& e : edges) out << e.a << ' ' << e.b << ' ' << e.tag << '\n';
+}
+
+TriMesh TriMesh::rectangle(double Lx, double Ly, int nx, int ny) {
+    return from_mask(DomainMask(), Lx, Ly, nx, ny);
+}
+
+TriMesh TriMesh::from_mask(const DomainMask& mask, double Lx, double Ly, int nx, int ny) {
+    if (nx < 2 || ny < 2 || !(Lx > 0.0) || !(Ly > 0.0)) {
+        throw std::invalid_argument("a structured mesh needs Lx, Ly > 0 and at least 2 nodes per axis");
+    }
+    const double dx = Lx / (nx - 1);
+    const double dy = Ly / (ny - 1);
+    auto coord = [&](int k) { return std::make_pair((k % nx) * dx, (k / nx) * dy); };
+
+    // Two triangles per cell, split along the rising diagonal
+    std::vector<std::array<int, 3>> kept;
+    for (int j = 0; j + 1 < ny; j++) {
+        for (int i = 0; i + 1 < nx; i++) {
+            const int k = j * nx + i;
+            const std::array<int, 3> cell[2] = {{k, k + 1, k + nx + 1}, {k, k + nx + 1, k + nx}};
+            for (const auto& t : cell) {
+                double cx = 0.0, cy = 0.0;
+                for (int v : t) {
+                    cx += coord(v).first / 3.0;
+                    cy += coord(v).second / 3.0;
+                }
+                if (mask.solid(cx, cy)) kept.push_back(t);
+            }
+        }
+    }
+    if (kept.empty()) throw std::invalid_argument("mask leaves no solid triangle");
+
+    // Keep the nodes of the kept triangles, in grid order
+    std::vector<int> index(nx * ny, -1);
+    for (const auto& t : kept) {
+        for (int v : t) index[v] = 0;
+    }
+    TriMesh mesh;
+    std::vector<int> grid;
+    for (int k = 0; k < nx * ny; k++) {
+        if (index[k] < 0) continue;
+        index[k] = mesh.nodes();
+        grid.push_back(k);
+        mesh.x.push_back(coord(k).first);
+        mesh.y.push_back(coord(k).second);
+    }
+    for (const auto& t : kept) mesh.tri.push_back({index[t[0]], index[t[1]], index[t[2]]});
+    mesh.edges = structured_edges(mesh, grid, nx, ny);
+    return mesh;
+}
+
+void TriMesh::validate() {
+    const int n = nodes();
+    if (y.size() != x.size()) throw std::invalid_argument("mesh coordinate arrays differ in size");
+    if (n < 3 || tri.empty()) throw std::invalid_argument("mesh needs at least one triangle");
+
+    for (int t = 0; t < triangles(); t++) {
+        for (int v : tri[t]) {
+            if (v < 0 || v >= n) throw std::invalid_argument("mesh triangle refers to a missing node");
+        }
+        double a = area(t);
+        if (!(std::abs(a) > 0.0)) throw std::invalid_argument("mesh has a degenerate triangle");
+        if (a < 0.0) std::swap(tri[t][1], tri[t][2]);
+    }
+    for (const MeshEdge& e : edges) {
+        if (e.a < 0 || e.a >= n || e.b < 0 || e.b >= n || e.a == e.b) {
+            throw std::invalid_argument("mesh edge refers to a missing node");
+        }
+        if (e.tag < 0) throw std::invalid_argument("mesh edge tags must be non-negative");
+    }
+}
+
+std::vector<int> TriMesh::rcm_order() const {
+    const int n = nodes();
+    const Adjacency adj = adjacency(*this);
+    std::vector<int> level(n, -1);
+    std::vector<char> visited(n, 0);
+    std::vector<int> order;
+    order.reserve(n);
+
+    std::vector<int> next;
+    for (int s = 0; s < n; s++) {
+        if (visited[s]) continue;
+        int root = pseudo_peripheral(adj, s, level);
+        visited[root] = 1;
+        order.push_back(root);
+
+        // Cuthill–McKee: breadth first, lowest degree first
+        for (std::size_t q = order.size() - 1; q < order.size(); q++) {
+            int i = order[q];
+            next.clear();
+            for (int k = adj.ptr[i]; k < adj.ptr[i + 1]; k++) {
+                int j = adj.list[k];
+                if (!visited[j]) {
+                    visited[j] = 1;
+                    next.push_back(j);
+                }
+            }
+            std::stable_sort(next.begin(), next.end(), [&](int a, int b) {
+                return adj.degree(a) < adj.degree(b);
+            });
+            order.insert(order.end(), next.begin(), next.end());
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+void TriMesh::renumber(const std::vector<int>& order) {
+    const int n = nodes();
+    if (static_cast<int>(order.size()) != n) {
+        throw std::invalid_argument("node order must list every node once");
+    }
+    std::vector<int> inv(n, -1);
+    for (int k = 0; k < n; k++) {
+        if (order[k] < 0 || order[k] >= n || inv[order[k]] >= 0) {
+            throw std::invalid_argument("node order must list every node once");
+        }
+        inv[order[k]] = k;
+    }
+
+    std::vector<double> nx(n), ny(n);
+    for (int k = 0; k < n; k++) {
+        nx[k] = x[order[k]];
+        ny[k] = y[order[k]];
+    }
+    x.swap(nx);
+    y.swap(ny);
+    for (auto& t : tri) {
+        for (int& v : t) v = inv[v];
+    }
+    for (MeshEdge& e : edges) {
+        e.a = inv[e.a];
+        e.b = inv[e.b];
+    }
+    std::stable_sort(tri.begin(), tri.end(), [](const std::array<int, 3>& a, const std::array<int, 3>& b) {
+        return std::min({a[0], a[1], a[2]}) < std::min({b[0], b[1], b[2]});
+    });
+}
+
+int TriMesh::bandwidth() const {
+    int band = 0;
+    for (const auto& t : tri) {
+        band = std::max({band, std::abs(t[0] - t[1]), std::abs(t[1] - t[2]), std::abs(t[2] - t[0])});
+    }
+    return band;
+}
+
+} // namespace ensiie
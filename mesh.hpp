@@ -0,0 +1,138 @@
+/**
+ * @file mesh.hpp
+ * @brief Triangle meshes of 2D parts: file formats, generators, reordering.
+ *
+ * A TriMesh lists node coordinates, triangles (three node indices,
+ * counter-clockwise) and tagged boundary edges. The tag of an edge
+ * selects its boundary condition in the mesh solver (fem_solver.hpp);
+ * boundary edges without a tag are insulated.
+ *
+ * Text format (indices start at 0, '#' starts a comment):
+ * @code
+ * nodes 4
+ * 0.0 0.0
+ * 1.0 0.0
+ * 1.0 1.0
+ * 0.0 1.0
+ * triangles 2
+ * 0 1 2
+ * 0 2 3
+ * edges 1          # optional section
+ * 1 2 0            # node a, node b, tag
+ * @endcode
+ *
+ * Binary format: the 8 bytes "TRIMESH1", then the node, triangle and edge
+ * counts (int32), the node coordinates (x, y as double), the triangles
+ * (3 × int32) and the edges (a, b, tag as int32), in native byte order.
+ */
+
+#ifndef MESH_HPP
+#define MESH_HPP
+
+#include "domain_mask.hpp"
+#include <array>
+#include <string>
+#include <vector>
+
+namespace ensiie {
+
+/// Tag of the edges around holes in meshes built from a DomainMask
+constexpr int HOLE_TAG = 4;
+
+/**
+ * @struct MeshEdge
+ * @brief Boundary edge between two nodes, with its condition tag.
+ */
+struct MeshEdge {
+    int a = 0;    ///< First node
+    int b = 0;    ///< Second node
+    int tag = 0;  ///< Index of the boundary condition (>= 0)
+};
+
+/**
+ * @class TriMesh
+ * @brief Linear triangle mesh of a 2D part.
+ */
+class TriMesh {
+public:
+    std::vector<double> x;                   ///< Node x coordinates [m]
+    std::vector<double> y;                   ///< Node y coordinates [m]
+    std::vector<std::array<int, 3>> tri;     ///< Triangles, counter-clockwise
+    std::vector<MeshEdge> edges;             ///< Tagged boundary edges
+
+    int nodes() const { return static_cast<int>(x.size()); }
+    int triangles() const { return static_cast<int>(tri.size()); }
+
+    /**
+     * @brief Signed area of triangle t (positive when counter-clockwise) [m²].
+     */
+    double area(int t) const;
+
+    /**
+     * @brief Read a mesh in the text or binary format (detected from the first bytes).
+     * @throws std::invalid_argument if the file cannot be read or is invalid
+     */
+    static TriMesh load(const std::string& path);
+
+    /**
+     * @brief Write the mesh in the text or binary format.
+     * @throws std::invalid_argument if the file cannot be written
+     */
+    void save(const std::string& path, bool binary = false) const;
+
+    /**
+     * @brief Structured mesh of [0, Lx] × [0, Ly].
+     *
+     * Node (i, j) has index j·nx + i, as on the finite difference grid.
+     * Each cell is split along its rising diagonal. Edges are tagged
+     * WEST, EAST, SOUTH, NORTH (boundary.hpp).
+     *
+     * @throws std::invalid_argument if nx or ny < 2 or a length is not positive
+     */
+    static TriMesh rectangle(double Lx, double Ly, int nx, int ny);
+
+    /**
+     * @brief Structured mesh of the solid part of a mask.
+     *
+     * Triangles of rectangle() whose centroid is solid are kept. Edges on
+     * the plate border keep their WEST..NORTH tags; edges around holes get
+     * HOLE_TAG.
+     *
+     * @throws std::invalid_argument if nothing is solid
+     */
+    static TriMesh from_mask(const DomainMask& mask, double Lx, double Ly, int nx, int ny);
+
+    /**
+     * @brief Check indices, orient every triangle counter-clockwise.
+     * @throws std::invalid_argument on out-of-range indices, negative tags
+     *         or degenerate triangles
+     */
+    void validate();
+
+    /**
+     * @brief Reverse Cuthill–McKee ordering of the nodes.
+     *
+     * Breadth-first numbering from a pseudo-peripheral node, visiting
+     * neighbours by increasing degree, reversed. Neighbouring nodes get
+     * close indices, which narrows the matrix band and keeps the rows
+     * touched by a matrix–vector product in cache.
+     *
+     * @return order[new] = old node index
+     */
+    std::vector<int> rcm_order() const;
+
+    /**
+     * @brief Renumber the nodes, then sort the triangles by their first node.
+     * @param order order[new] = old node index (a permutation)
+     */
+    void renumber(const std::vector<int>& order);
+
+    /**
+     * @brief Largest index difference between two nodes of a triangle.
+     */
+    int bandwidth() const;
+};
+
+} // namespace ensiie
+
+#endif
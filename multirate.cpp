@@ -0,0 +1,122 @@
+/**
+ * @file multirate.cpp
+ * @brief Step selection and synchronised stepping of multi-rate groups.
+ */
+
+#include "multirate.hpp"
+#include "profile.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <stdexcept>
+
+namespace ensiie {
+
+namespace {
+
+/**
+ * @brief Smallest spacing between consecutive nodes.
+ */
+double finest_spacing(const std::vector<double>& x) {
+    double h = x.size() > 1 ? x[1] - x[0] : 1.0;
+    for (std::size_t i = 2; i < x.size(); i++) h = std::min(h, x[i] - x[i - 1]);
+    return h;
+}
+
+} // namespace
+
+MultiRateGroup::MultiRateGroup(const MultiRateOptions& options)
+    : options_(options)
+    , tmax_(0.0)
+    , time_(0.0)
+{
+    if (!(options_.diffusion_number > 0.0) || options_.intervals < 1 || options_.max_steps < options_.intervals) {
+        throw std::invalid_argument("multi-rate options out of range");
+    }
+}
+
+int MultiRateGroup::add(HeatSolver1D& solver, const Material& mat) {
+    const double h = finest_spacing(solver.get_x());
+    return add_member(solver, mat.alpha() / (h * h), [&solver] { return solver.get_temperature(); });
+}
+
+int MultiRateGroup::add(HeatSolver2D& solver, const Material& mat) {
+    const double hx = finest_spacing(solver.get_x());
+    const double hy = finest_spacing(solver.get_y());
+    const double stiffness = std::max(mat.alpha() / (hx * hx), mat.alpha_y() / (hy * hy));
+    return add_member(solver, stiffness, [&solver] {
+        std::vector<double> u;
+        for (const std::vector<double>& row : solver.get_temperature_2d()) u.insert(u.end(), row.begin(), row.end());
+        return u;
+    });
+}
+
+int MultiRateGroup::add_member(HeatSolver& solver, double stiffness, std::function<std::vector<double>()> field) {
+    if (solver.get_time() != 0.0) throw std::invalid_argument("multi-rate members must start at t = 0");
+    if (members_.empty()) {
+        tmax_ = solver.get_tmax();
+    } else if (solver.get_tmax() != tmax_) {
+        throw std::invalid_argument("multi-rate members must share tmax");
+    }
+
+    // Step of the member's own dynamics, bounded by the step budget, then
+    // shortened to a whole number of steps per synchronisation interval
+    const double interval = tmax_ / options_.intervals;
+    double dt = stiffness > 0.0 ? options_.diffusion_number / stiffness : interval;
+    dt = std::max(dt, tmax_ / options_.max_steps);
+    const double per_interval = std::max(1.0, std::ceil(interval / dt - 1e-9));
+    solver.set_time_step(interval / per_interval);
+
+    Member member{&solver, std::move(field), interval / per_interval, 0, {}, 0, 0.0};
+    member.before = member.field();
+    members_.push_back(std::move(member));
+    return size() - 1;
+}
+
+bool MultiRateGroup::advance_to(double t) {
+    if (t < time_) throw std::invalid_argument("multi-rate groups only advance; reset() first");
+    PROFILE_ZONE("multirate advance");
+    time_ = std::min(t, tmax_);
+
+    // Steps are counted rather than compared in time, so rounding in the
+    // solvers' clocks cannot add a step at a synchronisation time
+    for (Member& m : members_) {
+        const long target = static_cast<long>(std::ceil(time_ / m.dt - 1e-6));
+        const long first = m.steps;
+        const auto start = std::chrono::steady_clock::now();
+        while (m.steps < target) {
+            // Keep the field at the start of the step that spans the display time
+            if (m.steps == target - 1) m.before = m.field();
+            if (!m.solver->step()) break;
+            m.steps++;
+        }
+        m.last_steps = m.steps - first;
+        m.last_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+    return time_ < tmax_;
+}
+
+void MultiRateGroup::reset() {
+    time_ = 0.0;
+    for (Member& m : members_) {
+        m.solver->reset();
+        m.before = m.field();
+        m.steps = 0;
+        m.last_steps = 0;
+        m.last_seconds = 0.0;
+    }
+}
+
+std::vector<double> MultiRateGroup::get_temperature(int m) const {
+    const Member& member = members_[m];
+    std::vector<double> u = member.field();
+    const double t = member.steps * member.dt;
+    if (member.steps == 0 || t - time_ <= 1e-6 * member.dt) return u;
+
+    // Linear in time across the last step [t - dt, t]
+    const double w = 1.0 - (t - time_) / member.dt;
+    for (std::size_t i = 0; i < u.size(); i++) u[i] = member.before[i] + w * (u[i] - member.before[i]);
+    return u;
+}
+
+} // namespace ensiie
@@ -0,0 +1,150 @@
+/**
+ * @file multirate.hpp
+ * @brief Solvers of different materials stepped at their own rates.
+ *
+ * A comparison set (one solver per material, on the same domain) spans
+ * diffusivities several orders of magnitude apart: copper diffuses
+ * about 1400 times faster than polystyrene. A shared step wastes steps
+ * on the slow members and under-resolves the fast ones, so each member
+ * of a multi-rate group takes the step of its own dynamics, the
+ * diffusion number
+ * @f[
+ *   \Delta t = \nu\,\min(h_x^2/\alpha_x,\; h_y^2/\alpha_y)
+ * @f]
+ * on its finest spacing, shortened so that a whole number of steps
+ * fills each synchronisation interval. Every member therefore lands on
+ * the synchronisation times exactly; at display times in between, the
+ * field of each member is interpolated linearly across its current
+ * step.
+ */
+
+#ifndef MULTIRATE_HPP
+#define MULTIRATE_HPP
+
+#include "heat_equation_solver.hpp"
+#include "material.hpp"
+#include <functional>
+#include <vector>
+
+namespace ensiie {
+
+/**
+ * @struct MultiRateOptions
+ * @brief Step selection of a multi-rate group.
+ */
+struct MultiRateOptions {
+    double diffusion_number = 2.0;  ///< Target α·Δt/h² of each member (backward Euler is stable for any value)
+    int intervals = 100;            ///< Synchronisation intervals over [0, tmax] (at least one step each)
+    int max_steps = 100000;         ///< Steps of one member over [0, tmax] at most
+};
+
+/**
+ * @class MultiRateGroup
+ * @brief Solvers sharing tmax, each advanced with its own time step.
+ *
+ * The group does not own its members. They are added at t = 0, their
+ * time step is set once (set_time_step()) and they are only stepped by
+ * advance_to().
+ */
+class MultiRateGroup {
+public:
+    /**
+     * @throws std::invalid_argument if an option is out of range
+     */
+    explicit MultiRateGroup(const MultiRateOptions& options = {});
+
+    /**
+     * @brief Add a bar; its step follows from mat and its node spacing.
+     * @return Index of the member
+     * @throws std::invalid_argument if the solver is not at t = 0 or its
+     *         tmax differs from the other members'
+     */
+    int add(HeatSolver1D& solver, const Material& mat);
+
+    /**
+     * @brief Add a plate; its step follows from mat (αx, αy) and its spacings.
+     * @return Index of the member
+     * @throws std::invalid_argument as add(HeatSolver1D&, const Material&)
+     */
+    int add(HeatSolver2D& solver, const Material& mat);
+
+    /**
+     * @brief Step every member until it reaches the display time t.
+     *
+     * @param t Display time, clamped to tmax
+     * @return false once the display time is tmax
+     * @throws std::invalid_argument if t is before the current display time
+     */
+    bool advance_to(double t);
+
+    /**
+     * @brief Return every member to t = 0.
+     */
+    void reset();
+
+    /**
+     * @brief Current display time.
+     */
+    double get_time() const { return time_; }
+
+    double get_tmax() const { return tmax_; }
+
+    /**
+     * @brief Number of members.
+     */
+    int size() const { return static_cast<int>(members_.size()); }
+
+    /**
+     * @brief Time step chosen for member m.
+     */
+    double get_time_step(int m) const { return members_[m].dt; }
+
+    /**
+     * @brief Steps taken by member m since the last reset.
+     */
+    long get_steps(int m) const { return members_[m].steps; }
+
+    /**
+     * @brief Steps taken by member m during the last advance_to().
+     */
+    long get_last_steps(int m) const { return members_[m].last_steps; }
+
+    /**
+     * @brief Wall time member m spent stepping during the last advance_to() [s].
+     */
+    double get_last_seconds(int m) const { return members_[m].last_seconds; }
+
+    /**
+     * @brief Temperature field of member m at the display time [K].
+     *
+     * Plates are row-major (k = j·nx + i). Exact at the synchronisation
+     * times, linearly interpolated across the member's step in between.
+     */
+    std::vector<double> get_temperature(int m) const;
+
+private:
+    /// One solver of the group
+    struct Member {
+        HeatSolver* solver;                          ///< Stepped solver (not owned)
+        std::function<std::vector<double>()> field;  ///< Current field, row-major
+        double dt;                                   ///< Time step
+        long steps;                                  ///< Steps since the last reset: the member is at steps·dt
+        std::vector<double> before;                  ///< Field at the start of the last step
+        long last_steps;                             ///< Steps of the last advance_to()
+        double last_seconds;                         ///< Wall time of the last advance_to() [s]
+    };
+
+    MultiRateOptions options_;     ///< Step selection
+    double tmax_;                  ///< Final time shared by the members
+    double time_;                  ///< Display time
+    std::vector<Member> members_;  ///< Members, in order of addition
+
+    /**
+     * @brief Choose the step of a new member from its stiffness max(α/h²).
+     */
+    int add_member(HeatSolver& solver, double stiffness, std::function<std::vector<double>()> field);
+};
+
+} // namespace ensiie
+
+#endif
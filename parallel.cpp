@@ -0,0 +1,194 @@
+/**
+ * @file parallel.cpp
+ * @brief Worker pool behind the parallel loops.
+ */
+
+#include "parallel.hpp"
+#include "profile.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ensiie {
+
+namespace parallel {
+
+namespace {
+
+/// Chunks per thread, to even out uneven rows
+constexpr int CHUNKS_PER_THREAD = 4;
+
+/// Set on the pool's own threads: loops they start run serially
+thread_local bool in_worker = false;
+
+/**
+ * @class Pool
+ * @brief Sleeping worker threads that drain the chunks of one loop at a time.
+ */
+class Pool {
+public:
+    static Pool& instance() {
+        static Pool pool;
+        return pool;
+    }
+
+    ~Pool() { stop(); }
+
+    int size() const { return size_; }
+
+    void resize(int n) {
+        std::lock_guard<std::mutex> own(owner_);
+        stop();
+        start(n);
+    }
+
+    /**
+     * @brief Run task(c) for every chunk c in [0, chunks).
+     */
+    void run(int chunks, const std::function<void(int)>& task) {
+        if (chunks <= 1 || workers_.empty() || in_worker || !owner_.try_lock()) {
+            for (int c = 0; c < chunks; c++) task(c);
+            return;
+        }
+        std::lock_guard<std::mutex> own(owner_, std::adopt_lock);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            chunks_ = chunks;
+            next_ = 0;
+            busy_ = static_cast<int>(workers_.size());
+            generation_++;
+        }
+        wake_.notify_all();
+        drain(task, chunks);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return busy_ == 0; });
+        task_ = nullptr;
+    }
+
+private:
+    Pool() {
+        int n = static_cast<int>(std::thread::hardware_concurrency());
+        start(n);
+    }
+
+    void start(int n) {
+        if (n <= 0) n = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        size_ = n;
+        // New workers wait for the next loop, not for the loops run before a resize
+        unsigned long generation;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = false;
+            busy_ = 0;
+            generation = generation_;
+        }
+        for (int w = 1; w < n; w++) {
+            workers_.emplace_back([this, generation] { work(generation); });
+        }
+    }
+
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        wake_.notify_all();
+        for (std::thread& w : workers_) w.join();
+        workers_.clear();
+        size_ = 1;
+    }
+
+    /// Take chunks of the loop until none is left
+    void drain(const std::function<void(int)>& task, int chunks) {
+        for (int c = next_.fetch_add(1); c < chunks; c = next_.fetch_add(1)) {
+            task(c);
+        }
+    }
+
+    /**
+     * @brief Worker loop.
+     * @param seen Loops started before this worker: it joins the next one
+     */
+    void work(unsigned long seen) {
+        in_worker = true;
+        for (;;) {
+            const std::function<void(int)>* task;
+            int chunks;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wake_.wait(lock, [&] { return stopping_ || generation_ != seen; });
+                if (stopping_) return;
+                seen = generation_;
+                task = task_;
+                chunks = chunks_;
+            }
+            drain(*task, chunks);
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--busy_ == 0) done_.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers_;       ///< Threads besides the caller
+    std::mutex owner_;                       ///< Held by the thread running a loop
+    std::mutex mutex_;                       ///< Guards the loop state below
+    std::condition_variable wake_;           ///< Signals a new loop or shutdown
+    std::condition_variable done_;           ///< Signals the last worker finishing
+    const std::function<void(int)>* task_ = nullptr;  ///< Current chunk body
+    int chunks_ = 0;                         ///< Chunks of the current loop
+    std::atomic<int> next_{0};               ///< Next chunk to take
+    int busy_ = 0;                           ///< Workers not done with the current loop
+    unsigned long generation_ = 0;           ///< Loops started so far
+    bool stopping_ = false;                  ///< Workers must exit
+    int size_ = 1;                           ///< Threads per loop
+};
+
+/**
+ * @brief Number of chunks of a loop over n indices.
+ */
+int chunk_count(int n) {
+    int by_size = (n + MIN_CHUNK - 1) / MIN_CHUNK;
+    return std::max(1, std::min(by_size, CHUNKS_PER_THREAD * Pool::instance().size()));
+}
+
+} // namespace
+
+int threads() {
+    return Pool::instance().size();
+}
+
+void set_threads(int n) {
+    Pool::instance().resize(n);
+}
+
+void for_range(int n, const std::function<void(int, int)>& body) {
+    if (n <= 0) return;
+    const int chunks = chunk_count(n);
+    Pool::instance().run(chunks, [&](int c) {
+        PROFILE_ZONE("parallel chunk");
+        body(static_cast<int>(static_cast<long long>(n) * c / chunks),
+             static_cast<int>(static_cast<long long>(n) * (c + 1) / chunks));
+    });
+}
+
+double sum(int n, const std::function<double(int, int)>& body) {
+    if (n <= 0) return 0.0;
+    const int chunks = chunk_count(n);
+    std::vector<double> partial(chunks, 0.0);
+    Pool::instance().run(chunks, [&](int c) {
+        PROFILE_ZONE("parallel chunk");
+        partial[c] = body(static_cast<int>(static_cast<long long>(n) * c / chunks),
+                          static_cast<int>(static_cast<long long>(n) * (c + 1) / chunks));
+    });
+    double total = 0.0;
+    for (double p : partial) total += p;
+    return total;
+}
+
+} // namespace parallel
+
+} // namespace ensiie
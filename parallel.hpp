@@ -0,0 +1,60 @@
+/**
+ * @file parallel.hpp
+ * @brief Persistent worker pool for data-parallel loops.
+ *
+ * Sparse kernels (assembly, matrix–vector products, dot products) split
+ * their index range into contiguous chunks shared between a fixed set of
+ * worker threads and the calling thread. The workers are started on
+ * first use and sleep between loops, so a parallel loop costs a wake-up
+ * rather than a thread creation.
+ *
+ * A loop runs serially on the calling thread when its range is short,
+ * when it is started from inside another loop, or while another thread
+ * is using the pool. The chunks only depend on the range length and the
+ * thread count, so reductions are reproducible from run to run.
+ */
+
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <functional>
+
+namespace ensiie {
+
+/**
+ * @namespace parallel
+ * @brief Chunked loops over [0, n) on the worker pool.
+ */
+namespace parallel {
+
+/// Fewest indices given to one chunk
+constexpr int MIN_CHUNK = 2048;
+
+/**
+ * @brief Number of threads taking part in a loop (workers + caller).
+ */
+int threads();
+
+/**
+ * @brief Resize the pool.
+ * @param n Threads per loop (<= 0: one per hardware thread, 1: serial)
+ */
+void set_threads(int n);
+
+/**
+ * @brief Call body(begin, end) on disjoint chunks covering [0, n).
+ */
+void for_range(int n, const std::function<void(int, int)>& body);
+
+/**
+ * @brief Sum of body(begin, end) over disjoint chunks covering [0, n).
+ *
+ * The partial sums are added in chunk order.
+ */
+double sum(int n, const std::function<double(int, int)>& body);
+
+} // namespace parallel
+
+} // namespace ensiie
+
+#endif
@@ -0,0 +1,177 @@
+/**
+ * @file profile.cpp
+ * @brief Per-thread event rings and the Chrome trace writer.
+ */
+
+#include "profile.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
+namespace ensiie {
+
+namespace profile {
+
+namespace {
+
+/**
+ * @struct Ring
+ * @brief Most recent events of one thread; written by that thread only.
+ */
+struct Ring {
+    int thread;                          ///< Thread number
+    std::atomic<std::uint64_t> count{0}; ///< Events recorded since the ring was created
+    std::vector<Event> slots;            ///< Event c is in slots[c % RING_CAPACITY]
+    bool owned = true;                   ///< A live thread records into it (guarded by the registry)
+
+    explicit Ring(int t) : thread(t), slots(RING_CAPACITY) {}
+};
+
+/**
+ * @brief Rings of all threads that recorded a zone.
+ *
+ * Rings are never freed, so events outlive their thread. The ring of a
+ * thread that exits goes back to the registry and the next new thread
+ * continues it: short-lived threads (fit batches, UQ workers) share the
+ * rings and there are no more rings than threads alive at once.
+ */
+struct Registry {
+    std::mutex mutex;                          ///< Guards rings and their owned flags
+    std::vector<std::unique_ptr<Ring>> rings;  ///< In order of first zone
+    std::atomic<std::int64_t> since{0};        ///< Events starting earlier were cleared
+
+    static Registry& instance() {
+        static Registry registry;
+        return registry;
+    }
+};
+
+/**
+ * @brief Hold of a thread on its ring, given back when the thread exits.
+ */
+struct Owner {
+    Ring* ring = nullptr;
+
+    ~Owner() {
+        if (!ring) return;
+        Registry& reg = Registry::instance();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        ring->owned = false;
+    }
+};
+
+/// Ring of the calling thread: a ring left by an exited thread, or a new one
+Ring& own_ring() {
+    thread_local Owner owner;
+    if (!owner.ring) {
+        Registry& reg = Registry::instance();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (const auto& r : reg.rings) {
+            if (!r->owned) {
+                r->owned = true;
+                owner.ring = r.get();
+                break;
+            }
+        }
+        if (!owner.ring) {
+            reg.rings.push_back(std::make_unique<Ring>(static_cast<int>(reg.rings.size())));
+            owner.ring = reg.rings.back().get();
+        }
+    }
+    return *owner.ring;
+}
+
+/// Clock origin: the first call
+const std::chrono::steady_clock::time_point& origin() {
+    static const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    return start;
+}
+
+} // namespace
+
+std::int64_t now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - origin()).count();
+}
+
+void record(const char* name, std::int64_t begin_ns, std::int64_t end_ns, int depth) {
+    Ring& ring = own_ring();
+    const std::uint64_t c = ring.count.load(std::memory_order_relaxed);
+    ring.slots[c % RING_CAPACITY] = {name, begin_ns, end_ns, ring.thread, depth};
+    ring.count.store(c + 1, std::memory_order_release);
+}
+
+std::vector<Event> events() {
+    Registry& reg = Registry::instance();
+    const std::int64_t since = reg.since.load(std::memory_order_acquire);
+    std::vector<Event> out;
+
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& ring : reg.rings) {
+        const std::uint64_t end = ring->count.load(std::memory_order_acquire);
+        const std::uint64_t first = end > RING_CAPACITY ? end - RING_CAPACITY : 0;
+        std::vector<Event> copy;
+        copy.reserve(end - first);
+        for (std::uint64_t c = first; c < end; c++) copy.push_back(ring->slots[c % RING_CAPACITY]);
+
+        // Slots the owner reused while we copied hold newer events: drop them.
+        // The owner may also be writing slot `now` (count not yet published),
+        // which overwrites event now + 1 - RING_CAPACITY.
+        const std::uint64_t now = ring->count.load(std::memory_order_acquire);
+        const std::uint64_t valid = now + 1 > RING_CAPACITY ? now + 1 - RING_CAPACITY : 0;
+        const std::size_t skip = valid > first ? static_cast<std::size_t>(std::min(valid, end) - first) : 0;
+
+        const std::size_t start = out.size();
+        for (std::size_t i = skip; i < copy.size(); i++) {
+            if (copy[i].begin_ns >= since) out.push_back(copy[i]);
+        }
+        // Zones close inner first: order each thread by start for the viewers
+        std::sort(out.begin() + start, out.end(), [](const Event& a, const Event& b) {
+            return a.begin_ns < b.begin_ns || (a.begin_ns == b.begin_ns && a.depth < b.depth);
+        });
+    }
+    return out;
+}
+
+void clear() {
+    Registry::instance().since.store(now_ns(), std::memory_order_release);
+}
+
+void write_chrome_trace(const std::string& path) {
+    const std::vector<Event> all = events();
+    std::ofstream out(path);
+    if (!out) throw std::invalid_argument("cannot write trace file " + path);
+    out.precision(15);
+
+    // Complete events ("X") in microseconds, one track per thread
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    int last_thread = -1;
+    bool first = true;
+    for (const Event& e : all) {
+        if (e.thread != last_thread) {
+            last_thread = e.thread;
+            out << (first ? "\n" : ",\n")
+                << "{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << e.thread
+                << ", \"args\": {\"name\": \"thread " << e.thread << "\"}}";
+            first = false;
+        }
+        out << ",\n{\"name\": \"" << e.name << "\", \"ph\": \"X\", \"pid\": 1, \"tid\": " << e.thread
+            << ", \"ts\": " << e.begin_ns * 1e-3
+            << ", \"dur\": " << (e.end_ns - e.begin_ns) * 1e-3 << "}";
+    }
+    out << "\n]}\n";
+}
+
+int& Zone::depth() {
+    thread_local int open = 0;
+    return open;
+}
+
+} // namespace profile
+
+} // namespace ensiie
@@ -0,0 +1,130 @@
+/**
+ * @file profile.hpp
+ * @brief Scoped timing zones in per-thread rings, exported as a Chrome trace.
+ *
+ * PROFILE_ZONE("name") times the rest of the enclosing scope. Zones are
+ * compiled in only with -DHEAT_PROFILE; otherwise the macro expands to
+ * nothing and the timed code is unchanged.
+ *
+ * Each thread records into its own ring of RING_CAPACITY events. The
+ * owner is the only writer and publishes an event with a release store
+ * of its count, so recording takes no lock; once the ring is full the
+ * oldest events are overwritten. Readers copy the rings and drop the
+ * events overwritten while they copied. The ring of an exited thread is
+ * continued by the next thread that records, so memory is bounded by
+ * the threads alive at once, not by the threads ever started.
+ *
+ * Zones of a thread nest, and a trace viewer (chrome://tracing, Perfetto)
+ * shows them as a flame chart per thread.
+ */
+
+#ifndef PROFILE_HPP
+#define PROFILE_HPP
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ensiie {
+
+/**
+ * @namespace profile
+ * @brief Timing zones and their export.
+ */
+namespace profile {
+
+/// Events kept per thread (the most recent ones)
+constexpr int RING_CAPACITY = 1 << 17;
+
+/**
+ * @struct Event
+ * @brief One closed zone.
+ */
+struct Event {
+    const char* name;        ///< Zone name (a string literal)
+    std::int64_t begin_ns;   ///< Start [ns since the first zone of the process]
+    std::int64_t end_ns;     ///< End [ns]
+    int thread;              ///< Ring of the recording thread, numbered by first zone
+    int depth;               ///< Zones of the same thread open around it
+};
+
+/**
+ * @brief Whether the zones are compiled in (-DHEAT_PROFILE).
+ */
+constexpr bool enabled() {
+#ifdef HEAT_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Monotonic clock of the events [ns].
+ */
+std::int64_t now_ns();
+
+/**
+ * @brief Append a closed zone to the calling thread's ring.
+ */
+void record(const char* name, std::int64_t begin_ns, std::int64_t end_ns, int depth);
+
+/**
+ * @brief Events of every thread still in the rings, by thread then start.
+ */
+std::vector<Event> events();
+
+/**
+ * @brief Forget the events recorded so far.
+ *
+ * The rings are not touched: events that started earlier are no longer
+ * returned, so clear() may be called while other threads record.
+ */
+void clear();
+
+/**
+ * @brief Write the events in the Chrome trace-event format (JSON).
+ * @throws std::invalid_argument if the file cannot be written
+ */
+void write_chrome_trace(const std::string& path);
+
+/**
+ * @class Zone
+ * @brief Records its lifetime under a name (use PROFILE_ZONE).
+ */
+class Zone {
+public:
+    explicit Zone(const char* name) : name_(name), depth_(depth()++), begin_(now_ns()) {}
+
+    ~Zone() {
+        record(name_, begin_, now_ns(), depth_);
+        depth()--;
+    }
+
+    Zone(const Zone&) = delete;
+    Zone& operator=(const Zone&) = delete;
+
+private:
+    const char* name_;    ///< Zone name
+    int depth_;           ///< Zones open around this one
+    std::int64_t begin_;  ///< Start [ns]
+
+    /// Zones open on the calling thread
+    static int& depth();
+};
+
+} // namespace profile
+
+} // namespace ensiie
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+#ifdef HEAT_PROFILE
+/// Time the rest of the enclosing scope under a string literal name
+#define PROFILE_ZONE(name) ::ensiie::profile::Zone PROFILE_CONCAT(profile_zone_, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,507 @@
+/**
+ * @file rom.cpp
+ * @brief Snapshot compression, Galerkin projection and reduced stepping.
+ */
+
+#include "rom.hpp"
+#include "profile.hpp"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+namespace ensiie {
+
+namespace {
+
+/// Vectors shrunk below this fraction of their norm by orthogonalisation are dependent
+constexpr double DEPENDENT_TOL = 1e-10;
+
+/// Singular values below this fraction of the largest one are round-off
+constexpr double SIGMA_FLOOR = 1e-12;
+
+/// Sweeps of the Jacobi eigenvalue iteration
+constexpr int JACOBI_SWEEPS = 50;
+
+/// Full solves of the offline error responses
+const KrylovOptions RESPONSE_SOLVE = {KrylovMethod::BICGSTAB, PreconditionerKind::ILU0,
+                                      MatrixFormat::CSR, 1e-10, 10000, 30};
+
+/**
+ * @brief Orthonormalise vectors by modified Gram–Schmidt, twice.
+ *
+ * Vectors that are (numerically) combinations of the previous ones are
+ * dropped.
+ */
+void orthonormalise(std::vector<std::vector<double>>& q) {
+    std::vector<std::vector<double>> out;
+    for (std::vector<double>& v : q) {
+        const double before = std::sqrt(dot(v, v));
+        if (before == 0.0) continue;
+        for (int pass = 0; pass < 2; pass++) {
+            for (const std::vector<double>& u : out) {
+                const double c = dot(u, v);
+                for (std::size_t i = 0; i < v.size(); i++) v[i] -= c * u[i];
+            }
+        }
+        const double after = std::sqrt(dot(v, v));
+        if (after <= DEPENDENT_TOL * before) continue;
+        for (double& x : v) x /= after;
+        out.push_back(std::move(v));
+    }
+    q.swap(out);
+}
+
+/**
+ * @brief Eigen-decomposition of a symmetric k × k matrix by cyclic Jacobi rotations.
+ *
+ * @param a Matrix, row-major (destroyed)
+ * @param values Output: eigenvalues, decreasing
+ * @param vectors Output: eigenvectors, column c of row-major k × k for values[c]
+ */
+void symmetric_eigen(std::vector<double> a, int k, std::vector<double>& values,
+                     std::vector<double>& vectors) {
+    std::vector<double> v(static_cast<std::size_t>(k) * k, 0.0);
+    for (int i = 0; i < k; i++) v[i * k + i] = 1.0;
+
+    for (int sweep = 0; sweep < JACOBI_SWEEPS; sweep++) {
+        double off = 0.0, diag = 0.0;
+        for (int i = 0; i < k; i++) {
+            diag += a[i * k + i] * a[i * k + i];
+            for (int j = i + 1; j < k; j++) off += a[i * k + j] * a[i * k + j];
+        }
+        if (off <= 1e-30 * diag) break;
+
+        for (int p = 0; p < k; p++) {
+            for (int q = p + 1; q < k; q++) {
+                const double apq = a[p * k + q];
+                if (apq == 0.0) continue;
+                // Rotation annihilating a_pq
+                const double theta = (a[q * k + q] - a[p * k + p]) / (2.0 * apq);
+                const double t = std::copysign(1.0, theta) / (std::abs(theta) + std::sqrt(theta * theta + 1.0));
+                const double c = 1.0 / std::sqrt(t * t + 1.0);
+                const double s = t * c;
+                for (int m = 0; m < k; m++) {
+                    const double amp = a[m * k + p], amq = a[m * k + q];
+                    a[m * k + p] = c * amp - s * amq;
+                    a[m * k + q] = s * amp + c * amq;
+                }
+                for (int m = 0; m < k; m++) {
+                    const double apm = a[p * k + m], aqm = a[q * k + m];
+                    a[p * k + m] = c * apm - s * aqm;
+                    a[q * k + m] = s * apm + c * aqm;
+                }
+                for (int m = 0; m < k; m++) {
+                    const double vmp = v[m * k + p], vmq = v[m * k + q];
+                    v[m * k + p] = c * vmp - s * vmq;
+                    v[m * k + q] = s * vmp + c * vmq;
+                }
+            }
+        }
+    }
+
+    // Sort by decreasing eigenvalue
+    std::vector<int> order(k);
+    for (int i = 0; i < k; i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](int x, int y) { return a[x * k + x] > a[y * k + y]; });
+    values.resize(k);
+    vectors.resize(static_cast<std::size_t>(k) * k);
+    for (int c = 0; c < k; c++) {
+        values[c] = a[order[c] * k + order[c]];
+        for (int m = 0; m < k; m++) vectors[m * k + c] = v[m * k + order[c]];
+    }
+}
+
+/**
+ * @brief Inverse of a dense r × r matrix by Gauss–Jordan elimination with partial pivoting.
+ *
+ * @throws std::invalid_argument if the matrix is singular
+ */
+std::vector<double> invert(std::vector<double> m, int r) {
+    std::vector<double> inv(static_cast<std::size_t>(r) * r, 0.0);
+    for (int i = 0; i < r; i++) inv[i * r + i] = 1.0;
+    for (int c = 0; c < r; c++) {
+        int p = c;
+        for (int i = c + 1; i < r; i++) {
+            if (std::abs(m[i * r + c]) > std::abs(m[p * r + c])) p = i;
+        }
+        if (m[p * r + c] == 0.0) throw std::invalid_argument("singular reduced matrix");
+        if (p != c) {
+            for (int k = 0; k < r; k++) {
+                std::swap(m[c * r + k], m[p * r + k]);
+                std::swap(inv[c * r + k], inv[p * r + k]);
+            }
+        }
+        const double scale = 1.0 / m[c * r + c];
+        for (int k = 0; k < r; k++) {
+            m[c * r + k] *= scale;
+            inv[c * r + k] *= scale;
+        }
+        for (int i = 0; i < r; i++) {
+            if (i == c) continue;
+            const double f = m[i * r + c];
+            if (f == 0.0) continue;
+            for (int k = 0; k < r; k++) {
+                m[i * r + k] -= f * m[c * r + k];
+                inv[i * r + k] -= f * inv[c * r + k];
+            }
+        }
+    }
+    return inv;
+}
+
+} // namespace
+
+ReducedHeatSolver2D::ReducedHeatSolver2D(
+    std::unique_ptr<HeatSolver2D> full,
+    const std::vector<std::vector<HeatSource>>& training,
+    const RomOptions& options
+)
+    : full_(std::move(full))
+    , options_(options)
+    , nx_(full_->get_n())
+    , ny_(full_->get_ny())
+    , x_(full_->get_x())
+    , y_(full_->get_y())
+    , t_(0.0)
+    , steps_(0)
+    , rms_scale_(0.0)
+    , error_(0.0)
+    , fallen_back_(false)
+{
+    if (options_.rank < 1 || options_.oversampling < 0 || options_.power_iterations < 0 ||
+        options_.stride < 1 || !(options_.energy >= 0.0) || !(options_.tolerance > 0.0)) {
+        throw std::invalid_argument("invalid reduced model options");
+    }
+
+    // Offset: the initial field, with the imposed values on the fixed nodes
+    const int nn = nx_ * ny_;
+    full_->reset();
+    system_ = full_->linear_step();
+    dt_ = system_.dt;
+    init_.resize(nn);
+    for (int j = 0; j < ny_; j++) {
+        for (int i = 0; i < nx_; i++) init_[j * nx_ + i] = full_->get_temperature(i, j);
+    }
+    ubar_ = init_;
+    int free = 0;
+    for (int k = 0; k < nn; k++) {
+        if (system_.fixed[k]) ubar_[k] = system_.b[k];
+        else free++;
+    }
+    rms_scale_ = (free > 0) ? 1.0 / std::sqrt(static_cast<double>(free)) : 0.0;
+
+    compress(collect(training));
+    if (!training.empty()) system_ = full_->linear_step();
+    project();
+    project_sources();
+    reset();
+}
+
+std::vector<std::vector<double>> ReducedHeatSolver2D::collect(
+    const std::vector<std::vector<HeatSource>>& training
+)
+{
+    std::vector<std::vector<double>> snapshots;
+    auto record = [&]() {
+        std::vector<double> s(ubar_.size());
+        for (int j = 0; j < ny_; j++) {
+            for (int i = 0; i < nx_; i++) {
+                const int k = j * nx_ + i;
+                s[k] = system_.fixed[k] ? 0.0 : full_->get_temperature(i, j) - ubar_[k];
+            }
+        }
+        snapshots.push_back(std::move(s));
+    };
+    auto run = [&]() {
+        full_->reset();
+        int n = 0;
+        while (full_->step()) {
+            // Steps 1, 2, 4, 8... resolve the initial transient
+            ++n;
+            if (n % options_.stride == 0 || (n & (n - 1)) == 0) record();
+        }
+        if (n % options_.stride != 0) record();
+    };
+
+    if (training.empty()) {
+        run();
+    } else {
+        for (const std::vector<HeatSource>& sources : training) {
+            full_->set_sources(sources);
+            run();
+        }
+    }
+    return snapshots;
+}
+
+void ReducedHeatSolver2D::compress(const std::vector<std::vector<double>>& snapshots) {
+    const int m = static_cast<int>(snapshots.size());
+    const std::size_t nn = ubar_.size();
+    const int k = std::min(options_.rank + options_.oversampling, m);
+
+    double total = 0.0;
+    for (const std::vector<double>& s : snapshots) total += dot(s, s);
+    phi_.clear();
+    sigma_.clear();
+    if (k == 0 || total == 0.0) return;
+
+    // Y = X·Ω: random combinations of the snapshots span their dominant directions
+    std::mt19937 rng(options_.seed);
+    std::normal_distribution<double> gauss(0.0, 1.0);
+    std::vector<std::vector<double>> y(k, std::vector<double>(nn, 0.0));
+    auto times_x = [&](const std::vector<double>& omega, int cols, int c) {
+        // y[c] = X·omega[:, c], omega stored row-major m × cols
+        for (int i = 0; i < m; i++) {
+            const double w = omega[static_cast<std::size_t>(i) * cols + c];
+            if (w == 0.0) continue;
+            for (std::size_t n = 0; n < nn; n++) y[c][n] += w * snapshots[i][n];
+        }
+    };
+    std::vector<double> omega(static_cast<std::size_t>(m) * k);
+    for (double& w : omega) w = gauss(rng);
+    for (int c = 0; c < k; c++) times_x(omega, k, c);
+    orthonormalise(y);
+
+    // Power iterations: Y = X·Xᵀ·Y damps the directions of small singular values
+    for (int it = 0; it < options_.power_iterations; it++) {
+        const int kk = static_cast<int>(y.size());
+        std::vector<double> z(static_cast<std::size_t>(m) * kk);
+        for (int i = 0; i < m; i++) {
+            for (int c = 0; c < kk; c++) z[static_cast<std::size_t>(i) * kk + c] = dot(snapshots[i], y[c]);
+        }
+        for (int c = 0; c < kk; c++) std::fill(y[c].begin(), y[c].end(), 0.0);
+        for (int c = 0; c < kk; c++) times_x(z, kk, c);
+        orthonormalise(y);
+    }
+
+    // B = Qᵀ·X is small: eigen-decompose B·Bᵀ = U·Σ²·Uᵀ
+    const int kk = static_cast<int>(y.size());
+    std::vector<double> b(static_cast<std::size_t>(kk) * m);
+    for (int c = 0; c < kk; c++) {
+        for (int i = 0; i < m; i++) b[static_cast<std::size_t>(c) * m + i] = dot(y[c], snapshots[i]);
+    }
+    std::vector<double> bbt(static_cast<std::size_t>(kk) * kk, 0.0);
+    for (int p = 0; p < kk; p++) {
+        for (int q = p; q < kk; q++) {
+            double s = 0.0;
+            for (int i = 0; i < m; i++) s += b[static_cast<std::size_t>(p) * m + i] * b[static_cast<std::size_t>(q) * m + i];
+            bbt[p * kk + q] = bbt[q * kk + p] = s;
+        }
+    }
+    std::vector<double> lambda, u;
+    symmetric_eigen(bbt, kk, lambda, u);
+
+    // Smallest rank leaving out at most the allowed energy
+    int r = 0;
+    double kept = 0.0;
+    for (int c = 0; c < kk; c++) {
+        const double s = std::sqrt(std::max(lambda[c], 0.0));
+        sigma_.push_back(s);
+        if (r >= options_.rank || s <= SIGMA_FLOOR * sigma_[0]) continue;
+        if (total - kept <= options_.energy * total) continue;
+        kept += s * s;
+        r++;
+    }
+
+    // Φ = Q·U[:, :r]
+    phi_.assign(r, std::vector<double>(nn, 0.0));
+    for (int c = 0; c < r; c++) {
+        for (int p = 0; p < kk; p++) {
+            const double w = u[p * kk + c];
+            for (std::size_t n = 0; n < nn; n++) phi_[c][n] += w * y[p][n];
+        }
+    }
+    orthonormalise(phi_);
+}
+
+void ReducedHeatSolver2D::project() {
+    const int r = rank();
+    const std::size_t nn = ubar_.size();
+
+    std::vector<std::vector<double>> aphi(r);
+    for (int c = 0; c < r; c++) system_.A.apply(phi_[c], aphi[c]);
+
+    // e0 = D·ū + b - A·ū (zero on the fixed rows, where ū = b)
+    std::vector<double> au;
+    system_.A.apply(ubar_, au);
+    std::vector<double> e0(nn);
+    for (std::size_t k = 0; k < nn; k++) {
+        e0[k] = (system_.fixed[k] ? 0.0 : ubar_[k]) + system_.b[k] - au[k];
+    }
+
+    std::vector<double> ar(static_cast<std::size_t>(r) * r);
+    for (int p = 0; p < r; p++) {
+        for (int q = 0; q < r; q++) ar[p * r + q] = dot(phi_[p], aphi[q]);
+    }
+    m_ = invert(std::move(ar), r);
+
+    h_.assign(r, 0.0);
+    std::vector<double> g(r);
+    for (int p = 0; p < r; p++) g[p] = dot(phi_[p], e0);
+    for (int p = 0; p < r; p++) {
+        for (int q = 0; q < r; q++) h_[p] += m_[p * r + q] * g[q];
+    }
+
+    // Responses of one full step to the offset and to the modes
+    inverse_ = KrylovSolver(system_.A, RESPONSE_SOLVE);
+    ie0_.assign(nn, 0.0);
+    inverse_.solve(e0, ie0_);
+    iphi_.assign(r, std::vector<double>(nn, 0.0));
+    for (int c = 0; c < r; c++) inverse_.solve(phi_[c], iphi_[c]);
+}
+
+void ReducedHeatSolver2D::project_sources() {
+    const int r = rank();
+    const int ns = static_cast<int>(system_.sources.size());
+    const std::size_t nn = ubar_.size();
+
+    tau_.assign(ns, std::vector<double>(r, 0.0));
+    isrc_.assign(ns, std::vector<double>(nn, 0.0));
+    std::vector<double> sigma(r);
+    for (int j = 0; j < ns; j++) {
+        for (int p = 0; p < r; p++) sigma[p] = dot(phi_[p], system_.sources[j]);
+        for (int p = 0; p < r; p++) {
+            for (int q = 0; q < r; q++) tau_[j][p] += m_[p * r + q] * sigma[q];
+        }
+        inverse_.solve(system_.sources[j], isrc_[j]);
+    }
+
+    // Error of one step A⁻¹·R = A⁻¹e0 + A⁻¹Φ·aⁿ - Φ·aⁿ⁺¹ + Σ a_j·A⁻¹s_j:
+    // Gram matrix of its terms
+    std::vector<const std::vector<double>*> terms;
+    std::vector<double> sign;
+    terms.push_back(&ie0_);
+    sign.push_back(1.0);
+    for (int c = 0; c < r; c++) {
+        terms.push_back(&iphi_[c]);
+        sign.push_back(1.0);
+    }
+    for (int c = 0; c < r; c++) {
+        terms.push_back(&phi_[c]);
+        sign.push_back(-1.0);
+    }
+    for (int j = 0; j < ns; j++) {
+        terms.push_back(&isrc_[j]);
+        sign.push_back(1.0);
+    }
+    const int nt = static_cast<int>(terms.size());
+    gram_.assign(static_cast<std::size_t>(nt) * nt, 0.0);
+    for (int p = 0; p < nt; p++) {
+        for (int q = p; q < nt; q++) {
+            gram_[p * nt + q] = gram_[q * nt + p] = sign[p] * sign[q] * dot(*terms[p], *terms[q]);
+        }
+    }
+    w_.assign(nt, 0.0);
+}
+
+bool ReducedHeatSolver2D::step() {
+    if (fallen_back_) return full_->step();
+    if (t_ >= full_->get_tmax()) return false;
+    PROFILE_ZONE("step reduced");
+
+    const double tn = t_ + dt_;
+    const int r = rank();
+    const int ns = static_cast<int>(tau_.size());
+    const int nt = static_cast<int>(w_.size());
+
+    // aⁿ⁺¹ = M·aⁿ + h + Σ a_j(tⁿ⁺¹)·τ_j
+    w_[0] = 1.0;
+    for (int j = 0; j < ns; j++) {
+        const auto& mod = system_.modulations[j];
+        w_[1 + 2 * r + j] = mod ? mod(tn) : 1.0;
+    }
+    for (int p = 0; p < r; p++) {
+        double s = h_[p];
+        for (int q = 0; q < r; q++) s += m_[p * r + q] * a_[q];
+        for (int j = 0; j < ns; j++) s += w_[1 + 2 * r + j] * tau_[j][p];
+        next_[p] = s;
+    }
+
+    // ||A⁻¹R||² = wᵀ·G·w with w = (1, aⁿ, aⁿ⁺¹, a_j)
+    for (int p = 0; p < r; p++) {
+        w_[1 + p] = a_[p];
+        w_[1 + r + p] = next_[p];
+    }
+    double q = 0.0;
+    for (int p = 0; p < nt; p++) {
+        double s = 0.0;
+        for (int c = 0; c < nt; c++) s += gram_[p * nt + c] * w_[c];
+        q += w_[p] * s;
+    }
+    error_ += std::sqrt(std::max(q, 0.0)) * rms_scale_;
+
+    a_.swap(next_);
+    t_ = tn;
+    steps_++;
+    if (error_ > options_.tolerance) fall_back();
+    return true;
+}
+
+void ReducedHeatSolver2D::fall_back() {
+    fallen_back_ = true;
+    full_->reset();
+    for (int s = 0; s < steps_; s++) full_->step();
+}
+
+double ReducedHeatSolver2D::value(int k) const {
+    if (steps_ == 0) return init_[k];
+    double u = ubar_[k];
+    for (std::size_t c = 0; c < phi_.size(); c++) u += phi_[c][k] * a_[c];
+    return u;
+}
+
+double ReducedHeatSolver2D::get_temperature(int i, int j) const {
+    if (fallen_back_) return full_->get_temperature(i, j);
+    return value(j * nx_ + i);
+}
+
+std::vector<std::vector<double>> ReducedHeatSolver2D::get_temperature_2d() const {
+    if (fallen_back_) return full_->get_temperature_2d();
+    std::vector<std::vector<double>> result(ny_, std::vector<double>(nx_));
+    for (int j = 0; j < ny_; j++) {
+        for (int i = 0; i < nx_; i++) result[j][i] = value(j * nx_ + i);
+    }
+    return result;
+}
+
+double ReducedHeatSolver2D::probe(double x, double y) const {
+    if (fallen_back_) return full_->probe(x, y);
+    int i, j;
+    double s, r;
+    grid::locate(x_, x, i, s);
+    grid::locate(y_, y, j, r);
+    auto u = [&](int a, int b) { return value(b * nx_ + a); };
+    return (1.0 - r) * ((1.0 - s) * u(i, j) + s * u(i + 1, j))
+         + r * ((1.0 - s) * u(i, j + 1) + s * u(i + 1, j + 1));
+}
+
+void ReducedHeatSolver2D::reset() {
+    t_ = 0.0;
+    steps_ = 0;
+    a_.assign(rank(), 0.0);
+    next_.assign(rank(), 0.0);
+    error_ = 0.0;
+    fallen_back_ = false;
+}
+
+void ReducedHeatSolver2D::set_sources(const std::vector<HeatSource>& sources) {
+    full_->set_sources(sources);
+    system_ = full_->linear_step();
+    project_sources();
+}
+
+void ReducedHeatSolver2D::set_moving_sources(const std::vector<MovingSource>&) {
+    throw std::invalid_argument("reduced model: moving sources are not supported");
+}
+
+void ReducedHeatSolver2D::set_time_step(double) {
+    throw std::invalid_argument("reduced model: the step is projected at the trained time step");
+}
+
+void ReducedHeatSolver2D::set_mask(const DomainMask&) {
+    throw std::invalid_argument("reduced model: the basis is tied to the trained plate");
+}
+
+} // namespace ensiie
@@ -0,0 +1,240 @@
+/**
+ * @file rom.hpp
+ * @brief Reduced-order model of the 2D plate (proper orthogonal decomposition).
+ *
+ * Offline, the full solver is run on a few training configurations and
+ * its temperature fields are collected as snapshots. Their dominant
+ * directions form an orthonormal basis Φ (N × r, r ≪ N), computed by a
+ * randomised singular value decomposition: a Gaussian sketch of the
+ * snapshot matrix X, a few power iterations, then the exact SVD of the
+ * small projected matrix.
+ *
+ * The temperature is then sought as u = ū + Φ·a and the implicit step
+ * (LinearStep) is projected onto the basis (Galerkin):
+ * @f[
+ *   \Phi^T A \Phi\, a^{n+1} = a^n + \Phi^T (D\bar u + b - A\bar u)
+ *     + \sum_j a_j(t^{n+1})\, \Phi^T s_j
+ * @f]
+ * The r × r matrix is inverted once, so each online step is a dense
+ * product in O(r² + r·J) for J sources: microseconds, whatever the grid.
+ *
+ * Error estimator: the residual R of the full step at the reduced
+ * solution is a linear combination of fixed vectors with coefficients
+ * (1, aⁿ, aⁿ⁺¹, a_j), and so is the error it adds to the step, A⁻¹·R.
+ * Solving A once per vector offline (one full solve per mode and per
+ * source) turns ||A⁻¹·R||² into a quadratic form evaluated from a Gram
+ * matrix in O((2r + J)²). The backward Euler step does not amplify
+ * earlier errors, so the sum of these norms, divided by √N, estimates
+ * the RMS temperature error; when it exceeds the tolerance, the full
+ * solver replays the run and takes over.
+ */
+
+#ifndef ROM_HPP
+#define ROM_HPP
+
+#include "heat_equation_solver.hpp"
+#include <memory>
+#include <vector>
+
+namespace ensiie {
+
+/**
+ * @struct RomOptions
+ * @brief Snapshot sampling, basis size and error tolerance of a reduced model.
+ */
+struct RomOptions {
+    int rank = 20;             ///< Maximum number of modes
+    double energy = 1e-8;      ///< Fraction of the snapshot energy the modes may leave out
+    int oversampling = 10;     ///< Extra directions of the random sketch
+    int power_iterations = 2;  ///< Power iterations sharpening the sketch
+    int stride = 5;            ///< Time steps between two snapshots (steps 1, 2, 4... are added)
+    double tolerance = 0.5;    ///< Estimated RMS error [K] above which the full solver takes over
+    unsigned seed = 5489;      ///< Seed of the random sketch
+};
+
+/**
+ * @class ReducedHeatSolver2D
+ * @brief Plate solver stepping in the span of a POD basis.
+ *
+ * Wraps a full 2D solver, which it trains on and falls back to. The
+ * plate, material, edges and time step are those of the full solver;
+ * queries may change the heat sources (set_sources()) as long as their
+ * response stays close to the span of the training runs, which the
+ * error estimator checks at every step.
+ *
+ * Restricted to linear problems (LinearStep): no phase change, no
+ * radiative or time-dependent edges, no moving sources.
+ */
+class ReducedHeatSolver2D : public HeatSolver2D {
+public:
+    /**
+     * @brief Train a reduced model on runs of the full solver.
+     *
+     * Each training set of sources is run from the initial temperature to
+     * tmax, recording a snapshot every options.stride steps. The model
+     * then starts with the sources of the last set.
+     *
+     * @param full Full solver (its mask and Krylov options are kept)
+     * @param training Source configurations (empty: the solver's current sources)
+     * @param options Sampling, rank and tolerance
+     * @throws std::invalid_argument if the problem is not linear or the
+     *         options are out of range
+     */
+    ReducedHeatSolver2D(std::unique_ptr<HeatSolver2D> full,
+                        const std::vector<std::vector<HeatSource>>& training = {},
+                        const RomOptions& options = {});
+
+    /**
+     * @brief Advance one reduced step, or one full step after a fallback.
+     */
+    bool step() override;
+
+    double get_temperature(int i, int j) const override;
+    std::vector<std::vector<double>> get_temperature_2d() const override;
+    double get_time() const override { return fallen_back_ ? full_->get_time() : t_; }
+    double get_tmax() const override { return full_->get_tmax(); }
+    double get_time_step() const override { return dt_; }
+
+    /**
+     * @throws std::invalid_argument always: the reduced step is projected at the trained time step
+     */
+    void set_time_step(double dt) override;
+    int get_n() const override { return nx_; }
+    int get_ny() const override { return ny_; }
+    double get_lx() const override { return full_->get_lx(); }
+    double get_ly() const override { return full_->get_ly(); }
+    std::vector<double> get_x() const override { return x_; }
+    std::vector<double> get_y() const override { return y_; }
+
+    /**
+     * @brief Return to the initial temperature in reduced mode.
+     */
+    void reset() override;
+
+    /**
+     * @brief Replace the heat sources and project them on the basis.
+     *
+     * Costs one matrix extraction and one full solve per source.
+     */
+    void set_sources(const std::vector<HeatSource>& sources) override;
+
+    /**
+     * @throws std::invalid_argument always: moving sources have no fixed projection
+     */
+    void set_moving_sources(const std::vector<MovingSource>& sources) override;
+
+    /**
+     * @throws std::invalid_argument always: the basis is tied to the trained plate
+     */
+    void set_mask(const DomainMask& mask) override;
+
+    /**
+     * @brief Select the Krylov solve of the full solver (used after a fallback).
+     */
+    void set_krylov(std::optional<KrylovOptions> options) override { full_->set_krylov(options); }
+
+    bool is_active(int i, int j) const override { return full_->is_active(i, j); }
+
+    /**
+     * @brief 0: a reduced step is a direct solve (sweeps of the full solver after a fallback).
+     */
+    int get_last_iterations() const override { return fallen_back_ ? full_->get_last_iterations() : 0; }
+    double get_last_residual() const override { return fallen_back_ ? full_->get_last_residual() : 0.0; }
+    std::vector<StepStats> get_step_stats() const override { return fallen_back_ ? full_->get_step_stats() : std::vector<StepStats>{}; }
+    long get_unconverged_steps() const override { return fallen_back_ ? full_->get_unconverged_steps() : 0; }
+    LinearStep linear_step() const override { return full_->linear_step(); }
+    double get_liquid_fraction() const override { return 0.0; }
+    double probe(double x, double y) const override;
+
+    /**
+     * @brief Number of modes r.
+     */
+    int rank() const { return static_cast<int>(phi_.size()); }
+
+    /**
+     * @brief Singular values of the snapshot matrix captured by the sketch.
+     */
+    const std::vector<double>& singular_values() const { return sigma_; }
+
+    /**
+     * @brief Accumulated estimate of the RMS temperature error [K].
+     */
+    double error_estimate() const { return error_; }
+
+    /**
+     * @brief Whether the estimate exceeded the tolerance and the full solver took over.
+     */
+    bool fallen_back() const { return fallen_back_; }
+
+    /**
+     * @brief The wrapped full solver.
+     */
+    const HeatSolver2D& full() const { return *full_; }
+
+private:
+    std::unique_ptr<HeatSolver2D> full_;  /**< Full solver: training and fallback */
+    RomOptions options_;    /**< Sampling and tolerance */
+    int nx_;                /**< Grid points along x */
+    int ny_;                /**< Grid points along y */
+    std::vector<double> x_; /**< Node coordinates along x */
+    std::vector<double> y_; /**< Node coordinates along y */
+    double dt_;             /**< Time step of the full solver */
+    double t_;              /**< Current time in reduced mode */
+    int steps_;             /**< Steps taken since reset() */
+
+    LinearStep system_;     /**< Full step operator (matrix, fixed nodes, edge terms) */
+    std::vector<double> init_;  /**< Initial field of the full solver */
+    std::vector<double> ubar_;  /**< Offset ū: initial field, imposed values on fixed nodes */
+    std::vector<std::vector<double>> phi_;  /**< Basis Φ, one vector per mode */
+    std::vector<double> sigma_; /**< Singular values of the snapshots */
+
+    std::vector<double> m_;     /**< (ΦᵀAΦ)⁻¹, r × r row-major */
+    std::vector<double> h_;     /**< (ΦᵀAΦ)⁻¹·Φᵀe0 */
+    std::vector<std::vector<double>> tau_;  /**< (ΦᵀAΦ)⁻¹·Φᵀs_j of each source */
+    KrylovSolver inverse_;      /**< Full step matrix, for the responses A⁻¹·v */
+    std::vector<double> ie0_;   /**< A⁻¹·(D·ū + b - A·ū): residual of the offset */
+    std::vector<std::vector<double>> iphi_;  /**< A⁻¹·Φ */
+    std::vector<std::vector<double>> isrc_;  /**< A⁻¹·s_j */
+    std::vector<double> gram_;  /**< Gram matrix of (A⁻¹e0, A⁻¹Φ, -Φ, A⁻¹s_j), row-major */
+
+    std::vector<double> a_;     /**< Reduced coordinates */
+    std::vector<double> next_;  /**< Work: next reduced coordinates */
+    std::vector<double> w_;     /**< Work: coefficients (1, aⁿ, aⁿ⁺¹, a_j) of the residual */
+    double rms_scale_;          /**< 1 / √(free nodes): 2-norm to RMS */
+    double error_;              /**< Accumulated error estimate [K] */
+    bool fallen_back_;          /**< Full solver in charge */
+
+    /**
+     * @brief Run the training configurations and return the snapshot deviations from ū.
+     */
+    std::vector<std::vector<double>> collect(const std::vector<std::vector<HeatSource>>& training);
+
+    /**
+     * @brief Randomised SVD of the snapshots: fills phi_ and sigma_.
+     */
+    void compress(const std::vector<std::vector<double>>& snapshots);
+
+    /**
+     * @brief Project the step operator on the basis: fills m_, h_, ie0_, iphi_.
+     */
+    void project();
+
+    /**
+     * @brief Project the sources of system_, solve their responses and rebuild the Gram matrix.
+     */
+    void project_sources();
+
+    /**
+     * @brief Temperature at node k from the reduced coordinates.
+     */
+    double value(int k) const;
+
+    /**
+     * @brief Replay the run with the full solver up to the current step.
+     */
+    void fall_back();
+};
+
+} // namespace ensiie
+
+#endif
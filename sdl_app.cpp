@@ -5,34 +5,131 @@
 
 #include "sdl_app.hpp"
 #include "sdl_core.hpp"
+#include "sdl_draw.hpp"
+#include "profile.hpp"
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#ifdef __linux__
+#include <unistd.h>
+#endif
 
 namespace sdl {
 
+namespace {
+
+/// Frames of the frame time histogram
+constexpr int HUD_FRAMES = 120;
+
+/// Period of the HUD's throughput, phase and memory figures [s]
+constexpr double HUD_REFRESH = 0.5;
+
+/// Weight of the latest frame in the smoothed HUD figures
+constexpr double HUD_SMOOTHING = 0.1;
+
+/**
+ * @brief Resident memory of the process [MB] (-1 where unknown).
+ */
+double resident_mb() {
+#ifdef __linux__
+    std::ifstream statm("/proc/self/statm");
+    long size = 0;
+    long resident = 0;
+    if (statm >> size >> resident) {
+        return static_cast<double>(resident) * sysconf(_SC_PAGESIZE) / (1024.0 * 1024.0);
+    }
+#endif
+    return -1.0;
+}
+
+/// Solver steps are the zones named "step ..."
+bool is_step(const char* zone) {
+    return std::strncmp(zone, "step ", 5) == 0;
+}
+
+/**
+ * @brief Time of the zones directly inside a solver step, slowest first.
+ *
+ * @param since_ns Zones that started earlier are ignored
+ * @param step_ms Output: mean step time [ms]
+ * @return Zone names and their time per step [ms]
+ */
+std::vector<std::pair<std::string, double>> step_phases(std::int64_t since_ns, double& step_ms) {
+    std::vector<std::pair<std::string, double>> phases;
+    std::vector<const ensiie::profile::Event*> open;  // Zones around the current one
+    long steps = 0;
+    double step_ns = 0.0;
+    int thread = -1;
+
+    const std::vector<ensiie::profile::Event> events = ensiie::profile::events();
+    for (const ensiie::profile::Event& e : events) {
+        if (e.thread != thread) {
+            thread = e.thread;
+            open.clear();
+        }
+        while (!open.empty() && open.back()->depth >= e.depth) open.pop_back();
+
+        if (e.begin_ns >= since_ns) {
+            const double ns = static_cast<double>(e.end_ns - e.begin_ns);
+            if (is_step(e.name)) {
+                steps++;
+                step_ns += ns;
+            } else if (!open.empty() && is_step(open.back()->name)) {
+                auto it = std::find_if(phases.begin(), phases.end(),
+                                       [&](const auto& p) { return p.first == e.name; });
+                if (it == phases.end()) it = phases.insert(phases.end(), {e.name, 0.0});
+                it->second += ns;
+            }
+        }
+        open.push_back(&e);
+    }
+
+    step_ms = steps ? 1e-6 * step_ns / steps : 0.0;
+    for (auto& phase : phases) phase.second = steps ? 1e-6 * phase.second / steps : 0.0;
+    std::sort(phases.begin(), phases.end(), [](const auto& a, const auto& b) { return a.second > b.second; });
+    return phases;
+}
+
+} // namespace
+
 // Single material constructor
 SDLApp::SDLApp(
     SimType type,
     const ensiie::Material& mat,
     double L,
+    double Ly,
     double tmax,
     double u0,
-    double f
+    double f,
+    const std::array<ensiie::BoundaryCondition, 4>& bc,
+    std::optional<Offscreen> offscreen
 )
-    : window_(std::make_unique<SDLWindow>("Heat Equation", 800, 600, false))
+    : window_(offscreen ? std::make_unique<SDLWindow>(*offscreen)
+                        : std::make_unique<SDLWindow>("Heat Equation", 800, 600, false))
     , heatmap_(std::make_unique<SDLHeatmap>(*window_, 280.0, 380.0))
     , solver_1d_(nullptr)
     , solver_2d_(nullptr)
     , sim_type_(type)
     , material_(mat)
     , L_(L)
+    , Ly_(Ly)
     , tmax_(tmax)
     , u0_(u0)
     , f_(f)
+    , bc_(bc)
     , n_(1001)
+    , ny_(1001)
     , paused_(false)
     , speed_(10)
     , running_(true)
     , grid_mode_(false)
+    , hud_(false)
+    , frame_times_(HUD_FRAMES, 0.0)
+    , frames_(0)
+    , window_start_(std::chrono::steady_clock::now())
+    , window_start_ns_(ensiie::profile::now_ns())
 {
     start_simulation();
 }
@@ -41,9 +138,12 @@ SDLApp::SDLApp(
 SDLApp::SDLApp(
     SimType type,
     double L,
+    double Ly,
     double tmax,
     double u0,
-    double f
+    double f,
+    const std::array<ensiie::BoundaryCondition, 4>& bc,
+    std::optional<Offscreen> offscreen
 )
     : window_(nullptr)
     , heatmap_(nullptr)
@@ -52,17 +152,29 @@ SDLApp::SDLApp(
     , sim_type_(type)
     , material_(ensiie::Materials::COPPER)
     , L_(L)
+    , Ly_(Ly)
     , tmax_(tmax)
     , u0_(u0)
     , f_(f)
+    , bc_(bc)
     , n_(1001)
+    , ny_(1001)
     , paused_(false)
     , speed_(10)
     , running_(true)
     , grid_mode_(true)
+    , hud_(false)
+    , frame_times_(HUD_FRAMES, 0.0)
+    , frames_(0)
+    , window_start_(std::chrono::steady_clock::now())
+    , window_start_ns_(ensiie::profile::now_ns())
 {
     // Use 0,0 to trigger maximized window mode
-    window_ = std::make_unique<SDLWindow>("Heat Equation - All Materials", 0, 0, false);
+    if (offscreen) {
+        window_ = std::make_unique<SDLWindow>(*offscreen);
+    } else {
+        window_ = std::make_unique<SDLWindow>("Heat Equation - All Materials", 0, 0, false);
+    }
     heatmap_ = std::make_unique<SDLHeatmap>(*window_, 280.0, 380.0);
 
     // Initialize 4 materials
@@ -74,21 +186,37 @@ SDLApp::SDLApp(
     start_grid_simulation();
 }
 
+std::array<ensiie::BoundaryCondition, 2> SDLApp::boundaries_1d() const {
+    return {bc_[ensiie::WEST], bc_[ensiie::EAST]};
+}
+
+// 101 nodes along the longer side of the plate, same spacing on the other
+void SDLApp::plate_resolution() {
+    const int n_long = 101;
+    if (L_ >= Ly_) {
+        n_ = n_long;
+        ny_ = std::max(3, static_cast<int>(std::lround((n_long - 1) * Ly_ / L_)) + 1);
+    } else {
+        ny_ = n_long;
+        n_ = std::max(3, static_cast<int>(std::lround((n_long - 1) * L_ / Ly_)) + 1);
+    }
+}
+
 void SDLApp::start_simulation() {
     paused_ = false;
 
     if (sim_type_ == SimType::BAR_1D) {
         n_ = 1001;
         speed_ = 1;  
-        solver_1d_ = std::make_unique<ensiie::HeatEquationSolver1D>(
-            material_, L_, tmax_, u0_, f_, n_
+        solver_1d_ = ensiie::make_solver_1d(
+            material_, L_, tmax_, u0_, f_, n_, boundaries_1d()
         );
         solver_2d_.reset();
     } else {
-        n_ = 101;
+        plate_resolution();
         speed_ = 1;  
-        solver_2d_ = std::make_unique<ensiie::HeatEquationSolver2D>(
-            material_, L_, tmax_, u0_, f_, n_
+        solver_2d_ = ensiie::make_solver_2d(
+            material_, L_, Ly_, tmax_, u0_, f_, n_, ny_, bc_
         );
         solver_1d_.reset();
     }
@@ -96,35 +224,40 @@ void SDLApp::start_simulation() {
 
 void SDLApp::start_grid_simulation() {
     paused_ = false;
+    group_ = std::make_unique<ensiie::MultiRateGroup>();
 
     if (sim_type_ == SimType::BAR_1D) {
         n_ = 1001;
         speed_ = 1;  
         for (int i = 0; i < 4; i++) {
-            solvers_1d_[i] = std::make_unique<ensiie::HeatEquationSolver1D>(
-                materials_[i], L_, tmax_, u0_, f_, n_
+            solvers_1d_[i] = ensiie::make_solver_1d(
+                materials_[i], L_, tmax_, u0_, f_, n_, boundaries_1d()
             );
             solvers_2d_[i].reset();
+            group_->add(*solvers_1d_[i], materials_[i]);
         }
     } else {
-        n_ = 101;
+        plate_resolution();
         speed_ = 1;  
         for (int i = 0; i < 4; i++) {
-            solvers_2d_[i] = std::make_unique<ensiie::HeatEquationSolver2D>(
-                materials_[i], L_, tmax_, u0_, f_, n_
+            solvers_2d_[i] = ensiie::make_solver_2d(
+                materials_[i], L_, Ly_, tmax_, u0_, f_, n_, ny_, bc_
             );
             solvers_1d_[i].reset();
+            group_->add(*solvers_2d_[i], materials_[i]);
         }
     }
 }
 
 void SDLApp::render() {
+    PROFILE_ZONE("render");
     window_->clear(0, 0, 0);
 
     SimInfo info;
     info.material_name = material_.name;
     info.alpha = material_.alpha();
     info.L = L_;
+    info.Ly = Ly_;
     info.tmax = tmax_;
     info.u0 = u0_ + 273.15;
     info.speed = speed_;
@@ -146,10 +279,12 @@ void SDLApp::render() {
         }
     }
 
+    if (hud_) heatmap_->draw_hud(perf_);
     window_->present();
 }
 
 void SDLApp::render_grid() {
+    PROFILE_ZONE("render");
     window_->clear(0, 0, 0);
 
     int win_w = window_->get_width();
@@ -164,31 +299,23 @@ void SDLApp::render_grid() {
     // Reference temperature for ΔT calculation
     double u0_kelvin = u0_ + 273.15;
 
+    // Fields of the 4 solvers at the common display time (plates row-major)
+    std::vector<double> fields[4];
+    {
+        PROFILE_ZONE("fields");
+        for (int i = 0; i < group_->size(); i++) {
+            fields[i] = group_->get_temperature(i);
+        }
+    }
+
     // Find global min/max ΔT (temperature increase from u0)
     double global_min = 0.0;  // ΔT minimum is 0 (no heating)
     double global_max = 0.0;
 
-    if (sim_type_ == SimType::BAR_1D) {
-        for (int i = 0; i < 4; i++) {
-            if (solvers_1d_[i]) {
-                auto temps = solvers_1d_[i]->get_temperature();
-                for (double t : temps) {
-                    double delta_t = t - u0_kelvin;
-                    global_max = std::max(global_max, delta_t);
-                }
-            }
-        }
-    } else {
-        for (int i = 0; i < 4; i++) {
-            if (solvers_2d_[i]) {
-                auto temps = solvers_2d_[i]->get_temperature_2d();
-                for (const auto& row : temps) {
-                    for (double t : row) {
-                        double delta_t = t - u0_kelvin;
-                        global_max = std::max(global_max, delta_t);
-                    }
-                }
-            }
+    for (int i = 0; i < 4; i++) {
+        for (double t : fields[i]) {
+            double delta_t = t - u0_kelvin;
+            global_max = std::max(global_max, delta_t);
         }
     }
 
@@ -203,36 +330,31 @@ void SDLApp::render_grid() {
         info.material_name = materials_[i].name;
         info.alpha = materials_[i].alpha();
         info.L = L_;
+        info.Ly = Ly_;
         info.tmax = tmax_;
         info.u0 = u0_kelvin;
         info.speed = speed_;
         info.paused = paused_;
 
-        if (sim_type_ == SimType::BAR_1D && solvers_1d_[i]) {
-            info.time = solvers_1d_[i]->get_time();
-            auto temps = solvers_1d_[i]->get_temperature();
-            if (!temps.empty()) {
-                // Convert to ΔT
-                std::vector<double> delta_temps(temps.size());
-                for (size_t j = 0; j < temps.size(); j++) {
-                    delta_temps[j] = temps[j] - u0_kelvin;
-                }
-                heatmap_->draw_1d_cell(delta_temps, info, cell_x[i], cell_y[i], cell_w, cell_h);
+        info.time = group_->get_time();
+        const std::vector<double>& temps = fields[i];
+
+        if (sim_type_ == SimType::BAR_1D && !temps.empty()) {
+            // Convert to ΔT
+            std::vector<double> delta_temps(temps.size());
+            for (size_t j = 0; j < temps.size(); j++) {
+                delta_temps[j] = temps[j] - u0_kelvin;
             }
-        } else if (sim_type_ == SimType::PLATE_2D && solvers_2d_[i]) {
-            info.time = solvers_2d_[i]->get_time();
-            auto temps = solvers_2d_[i]->get_temperature_2d();
-            if (!temps.empty() && !temps[0].empty()) {
-                // Convert to ΔT
-                std::vector<std::vector<double>> delta_temps(temps.size());
-                for (size_t j = 0; j < temps.size(); j++) {
-                    delta_temps[j].resize(temps[j].size());
-                    for (size_t k = 0; k < temps[j].size(); k++) {
-                        delta_temps[j][k] = temps[j][k] - u0_kelvin;
-                    }
+            heatmap_->draw_1d_cell(delta_temps, info, cell_x[i], cell_y[i], cell_w, cell_h);
+        } else if (sim_type_ == SimType::PLATE_2D && !temps.empty()) {
+            // Convert to ΔT, one row per y
+            std::vector<std::vector<double>> delta_temps(ny_, std::vector<double>(n_));
+            for (int j = 0; j < ny_; j++) {
+                for (int k = 0; k < n_; k++) {
+                    delta_temps[j][k] = temps[static_cast<size_t>(j) * n_ + k] - u0_kelvin;
                 }
-                heatmap_->draw_2d_cell(delta_temps, info, cell_x[i], cell_y[i], cell_w, cell_h);
             }
+            heatmap_->draw_2d_cell(delta_temps, info, cell_x[i], cell_y[i], cell_w, cell_h);
         }
     }
 
@@ -241,11 +363,11 @@ void SDLApp::render_grid() {
     SDL_SetRenderDrawColor(rend, 255, 255, 255, 255);
     // Vertical separator (3 pixels wide)
     for (int dx = -1; dx <= 1; dx++) {
-        SDL_RenderDrawLine(rend, cell_w + dx, 0, cell_w + dx, win_h);
+        draw::line(rend, cell_w + dx, 0, cell_w + dx, win_h);
     }
     // Horizontal separator (3 pixels wide)
     for (int dy = -1; dy <= 1; dy++) {
-        SDL_RenderDrawLine(rend, 0, cell_h + dy, win_w, cell_h + dy);
+        draw::line(rend, 0, cell_h + dy, win_w, cell_h + dy);
     }
 
     // Add corner markers
@@ -253,9 +375,10 @@ void SDLApp::render_grid() {
     int corner_size = 10;
     
     // Center cross highlight
-    SDL_RenderDrawLine(rend, cell_w - corner_size, cell_h, cell_w + corner_size, cell_h);
-    SDL_RenderDrawLine(rend, cell_w, cell_h - corner_size, cell_w, cell_h + corner_size);
+    draw::line(rend, cell_w - corner_size, cell_h, cell_w + corner_size, cell_h);
+    draw::line(rend, cell_w, cell_h - corner_size, cell_w, cell_h + corner_size);
 
+    if (hud_) heatmap_->draw_hud(perf_);
     window_->present();
 }
 
@@ -270,10 +393,7 @@ void SDLApp::process_events(SDL_Event& event) {
                 break;
             case SDLK_r:
                 if (grid_mode_) {
-                    for (int i = 0; i < 4; i++) {
-                        if (solvers_1d_[i]) solvers_1d_[i]->reset();
-                        if (solvers_2d_[i]) solvers_2d_[i]->reset();
-                    }
+                    group_->reset();
                 } else {
                     if (solver_1d_) solver_1d_->reset();
                     if (solver_2d_) solver_2d_->reset();
@@ -286,6 +406,17 @@ void SDLApp::process_events(SDL_Event& event) {
             case SDLK_DOWN:
                 speed_ = std::max(1, speed_ - 5);
                 break;
+            case SDLK_h:
+                hud_ = !hud_;
+                break;
+            case SDLK_p:
+                if (ensiie::profile::enabled()) {
+                    ensiie::profile::write_chrome_trace("heat_trace.json");
+                    std::cout << "Profile written to heat_trace.json\n";
+                } else {
+                    std::cout << "Profiling zones are compiled in with -DHEAT_PROFILE\n";
+                }
+                break;
         }
     }
 }
@@ -304,41 +435,12 @@ void SDLApp::run() {
 
         if (!running_) break;
 
-        if (!paused_) {
-            for (int s = 0; s < speed_; s++) {
-                if (grid_mode_) {
-                    bool all_done = true;
-                    for (int i = 0; i < 4; i++) {
-                        if (sim_type_ == SimType::BAR_1D && solvers_1d_[i]) {
-                            if (solvers_1d_[i]->step()) all_done = false;
-                        } else if (sim_type_ == SimType::PLATE_2D && solvers_2d_[i]) {
-                            if (solvers_2d_[i]->step()) all_done = false;
-                        }
-                    }
-                    if (all_done) {
-                        paused_ = true;
-                        break;
-                    }
-                } else {
-                    if (sim_type_ == SimType::BAR_1D && solver_1d_) {
-                        if (!solver_1d_->step()) {
-                            paused_ = true;
-                            break;
-                        }
-                    } else if (sim_type_ == SimType::PLATE_2D && solver_2d_) {
-                        if (!solver_2d_->step()) {
-                            paused_ = true;
-                            break;
-                        }
-                    }
-                }
-            }
-        }
-
-        if (grid_mode_) {
-            render_grid();
-        } else {
-            render();
+        {
+            PROFILE_ZONE("frame");
+            const auto start = std::chrono::steady_clock::now();
+            if (!paused_) advance();
+            render_frame();
+            update_perf(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
         }
         SDLCore::delay(16);
     }
@@ -347,4 +449,109 @@ void SDLApp::run() {
     window_.reset();
 }
 
+void SDLApp::advance() {
+    PROFILE_ZONE("advance");
+    if (grid_mode_) {
+        // Display time advances by speed × tmax/1000 per frame; each
+        // solver takes as many steps of its own size as it needs
+        if (!group_->advance_to(group_->get_time() + speed_ * tmax_ / 1000.0)) {
+            paused_ = true;
+        }
+        for (int i = 0; i < group_->size(); i++) {
+            clocks_[i].frame_seconds = group_->get_last_seconds(i);
+            clocks_[i].window_seconds += group_->get_last_seconds(i);
+            clocks_[i].window_steps += group_->get_last_steps(i);
+        }
+        return;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    int steps = 0;
+    for (int s = 0; s < speed_; s++) {
+        if (sim_type_ == SimType::BAR_1D && solver_1d_) {
+            if (!solver_1d_->step()) {
+                paused_ = true;
+                break;
+            }
+        } else if (sim_type_ == SimType::PLATE_2D && solver_2d_) {
+            if (!solver_2d_->step()) {
+                paused_ = true;
+                break;
+            }
+        }
+        steps++;
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    clocks_[0].frame_seconds = seconds;
+    clocks_[0].window_seconds += seconds;
+    clocks_[0].window_steps += steps;
+}
+
+void SDLApp::render_frame() {
+    draw::reset_calls();
+    if (grid_mode_) {
+        render_grid();
+    } else {
+        render();
+    }
+    perf_.draw_calls = draw::calls();
+}
+
+int SDLApp::solver_count() const {
+    return grid_mode_ ? group_->size() : 1;
+}
+
+const ensiie::HeatSolver2D* SDLApp::plate(int i) const {
+    return grid_mode_ ? solvers_2d_[i].get() : solver_2d_.get();
+}
+
+// Smoothed per-frame figures every frame, windowed ones every HUD_REFRESH
+void SDLApp::update_perf(double frame_seconds) {
+    const double weight = frames_ == 0 ? 1.0 : HUD_SMOOTHING;
+    frame_times_[frames_ % HUD_FRAMES] = 1e3 * frame_seconds;
+    frames_++;
+    perf_.frame_ms += weight * (1e3 * frame_seconds - perf_.frame_ms);
+
+    const int n = solver_count();
+    perf_.solvers.resize(n);
+    for (int i = 0; i < n; i++) {
+        SolverLoad& load = perf_.solvers[i];
+        load.material_name = grid_mode_ ? materials_[i].name : material_.name;
+        load.ms_per_frame += weight * (1e3 * clocks_[i].frame_seconds - load.ms_per_frame);
+        clocks_[i].frame_seconds = 0.0;
+        const ensiie::HeatSolver2D* p = plate(i);
+        load.iterations = p ? p->get_last_iterations() : -1;
+        load.residual = p ? p->get_last_residual() : 0.0;
+        load.unconverged = p ? p->get_unconverged_steps() : 0;
+    }
+
+    const auto now = std::chrono::steady_clock::now();
+    const double window = std::chrono::duration<double>(now - window_start_).count();
+    if (window < HUD_REFRESH) return;
+
+    long steps = 0;
+    for (int i = 0; i < n; i++) {
+        SolverClock& clock = clocks_[i];
+        perf_.solvers[i].steps_per_second = clock.window_seconds > 0.0 ? clock.window_steps / clock.window_seconds : 0.0;
+        steps += clock.window_steps;
+        clock.window_seconds = 0.0;
+        clock.window_steps = 0;
+    }
+    perf_.steps_per_second = steps / window;
+
+    perf_.frame_histogram.fill(0);
+    for (long f = 0; f < std::min<long>(frames_, HUD_FRAMES); f++) {
+        perf_.frame_histogram[std::min(HUD_BINS - 1, static_cast<int>(frame_times_[f] / 4.0))]++;
+    }
+
+    // Reading the rings and /proc costs more than a frame's figures: only when shown
+    if (hud_) {
+        perf_.memory_mb = resident_mb();
+        perf_.profiled = ensiie::profile::enabled();
+        if (perf_.profiled) perf_.phases = step_phases(window_start_ns_, perf_.step_ms);
+    }
+    window_start_ = now;
+    window_start_ns_ = ensiie::profile::now_ns();
+}
+
 }
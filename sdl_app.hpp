@@ -11,7 +11,12 @@
 #include "sdl_heatmap.hpp"
 #include "material.hpp"
 #include "heat_equation_solver.hpp"
+#include "multirate.hpp"
+#include <array>
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <optional>
 
 namespace sdl {
 
@@ -19,7 +24,8 @@ namespace sdl {
  * @class SDLApp
  * @brief Heat simulation with fullscreen visualization
  *
- * Controls: SPACE=pause, R=reset, UP/DOWN=speed, ESC=quit
+ * Controls: SPACE=pause, R=reset, UP/DOWN=speed, H=performance HUD,
+ * P=write profile, ESC=quit
  */
 class SDLApp {
 public:
@@ -33,62 +39,120 @@ public:
 private:
     std::unique_ptr<SDLWindow> window_;
     std::unique_ptr<SDLHeatmap> heatmap_;
-    std::unique_ptr<ensiie::HeatEquationSolver1D> solver_1d_;
-    std::unique_ptr<ensiie::HeatEquationSolver2D> solver_2d_;
+    std::unique_ptr<ensiie::HeatSolver1D> solver_1d_;
+    std::unique_ptr<ensiie::HeatSolver2D> solver_2d_;
 
     SimType sim_type_;           ///< Simulation type
     ensiie::Material material_;  ///< Selected material
 
-    double L_;       ///< Domain size
+    double L_;       ///< Domain size (plate width)
+    double Ly_;      ///< Plate height
     double tmax_;    ///< Maximum simulation time
     double u0_;      ///< Initial temperature
     double f_;       ///< Source intensity
-    int n_;          ///< Grid resolution
+    std::array<ensiie::BoundaryCondition, 4> bc_;  ///< Edge conditions (W, E, S, N)
+    int n_;          ///< Grid resolution (along x)
+    int ny_;         ///< Grid resolution along y (2D)
 
     bool paused_;    ///< Pause state
     int speed_;      ///< Simulation speed
     bool running_;   ///< Application state
     bool grid_mode_; ///< Multi-material grid mode
 
-    // For grid mode: 4 solvers (one per material)
-    std::unique_ptr<ensiie::HeatEquationSolver1D> solvers_1d_[4];
-    std::unique_ptr<ensiie::HeatEquationSolver2D> solvers_2d_[4];
+    // For grid mode: 4 solvers (one per material), each at its own time step
+    std::unique_ptr<ensiie::HeatSolver1D> solvers_1d_[4];
+    std::unique_ptr<ensiie::HeatSolver2D> solvers_2d_[4];
     ensiie::Material materials_[4];
+    std::unique_ptr<ensiie::MultiRateGroup> group_;  ///< Steps the 4 solvers to common display times
+
+    /// Stepping time and steps of one solver
+    struct SolverClock {
+        double frame_seconds = 0.0;   ///< Stepping time of the last advance() [s]
+        double window_seconds = 0.0;  ///< Stepping time since the last HUD refresh [s]
+        long window_steps = 0;        ///< Steps since the last HUD refresh
+    };
+
+    // Performance HUD (H)
+    bool hud_;                           ///< Overlay shown
+    PerfInfo perf_;                      ///< Figures drawn by the overlay
+    SolverClock clocks_[4];              ///< Per solver (single mode: [0])
+    std::vector<double> frame_times_;    ///< Recent frame times [ms], circular
+    long frames_;                        ///< Frames timed since the start
+    std::chrono::steady_clock::time_point window_start_;  ///< Last HUD refresh
+    std::int64_t window_start_ns_;       ///< Last HUD refresh on the zone clock [ns]
 
     void render();
     void render_grid();
     void process_events(SDL_Event& event);
     void start_simulation();
     void start_grid_simulation();
+    std::array<ensiie::BoundaryCondition, 2> boundaries_1d() const;
+    void plate_resolution();
+    void update_perf(double frame_seconds);
+    int solver_count() const;
+    const ensiie::HeatSolver2D* plate(int i) const;
 
 public:
     /**
      * @brief Create application for single material simulation
+     *
+     * @param L Bar length / plate width
+     * @param Ly Plate height (ignored for the bar)
+     * @param bc Edge conditions (W, E, S, N); the bar uses W and E
+     * @param offscreen Render into a surface of this size instead of an
+     *        800×600 window (headless runs)
      */
     SDLApp(
         SimType type,
         const ensiie::Material& mat,
         double L,
+        double Ly,
         double tmax,
         double u0,
-        double f
+        double f,
+        const std::array<ensiie::BoundaryCondition, 4>& bc,
+        std::optional<Offscreen> offscreen = std::nullopt
     );
 
     /**
      * @brief Create application in grid mode (all materials)
+     *
+     * @param L Bar length / plate width
+     * @param Ly Plate height (ignored for the bar)
+     * @param bc Edge conditions (W, E, S, N); the bar uses W and E
+     * @param offscreen Render into a surface of this size instead of a
+     *        maximized window (headless runs)
      */
     SDLApp(
         SimType type,
         double L,
+        double Ly,
         double tmax,
         double u0,
-        double f
+        double f,
+        const std::array<ensiie::BoundaryCondition, 4>& bc,
+        std::optional<Offscreen> offscreen = std::nullopt
     );
 
     /**
      * @brief Run the application main loop
      */
     void run();
+
+    /**
+     * @brief Advance the simulation by one frame (pauses at tmax).
+     */
+    void advance();
+
+    /**
+     * @brief Draw and present one frame of the current state.
+     */
+    void render_frame();
+
+    /**
+     * @brief Window (or offscreen surface) the frames are drawn to.
+     */
+    const SDLWindow& get_window() const { return *window_; }
 };
 
 }
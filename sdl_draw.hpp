@@ -0,0 +1,66 @@
+/**
+ * @file sdl_draw.hpp
+ * @brief Counted SDL draw calls.
+ *
+ * The heatmap and the application draw through these wrappers instead of
+ * the SDL_Render* functions, so the draw calls of a frame can be read
+ * back (bench/render_bench.cpp). Colour changes are state, not draws,
+ * and are not counted.
+ */
+
+#ifndef SDL_DRAW_HPP
+#define SDL_DRAW_HPP
+
+#include "SDL.h"
+
+namespace sdl {
+
+/**
+ * @namespace draw
+ * @brief Draw calls on a renderer, counted over all renderers.
+ */
+namespace draw {
+
+/// Draw calls since the last reset_calls() (rendering is single-threaded)
+inline long call_count = 0;
+
+/**
+ * @brief Draw calls issued since the last reset_calls().
+ */
+inline long calls() { return call_count; }
+
+/**
+ * @brief Restart the count, e.g. at the start of a frame.
+ */
+inline void reset_calls() { call_count = 0; }
+
+inline int clear(SDL_Renderer* rend) {
+    call_count++;
+    return SDL_RenderClear(rend);
+}
+
+inline int line(SDL_Renderer* rend, int x1, int y1, int x2, int y2) {
+    call_count++;
+    return SDL_RenderDrawLine(rend, x1, y1, x2, y2);
+}
+
+inline int point(SDL_Renderer* rend, int x, int y) {
+    call_count++;
+    return SDL_RenderDrawPoint(rend, x, y);
+}
+
+inline int rect(SDL_Renderer* rend, const SDL_Rect* r) {
+    call_count++;
+    return SDL_RenderDrawRect(rend, r);
+}
+
+inline int fill_rect(SDL_Renderer* rend, const SDL_Rect* r) {
+    call_count++;
+    return SDL_RenderFillRect(rend, r);
+}
+
+} // namespace draw
+
+}
+
+#endif
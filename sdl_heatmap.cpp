@@ -4,11 +4,24 @@
  */
 
 #include "sdl_heatmap.hpp"
+#include "sdl_draw.hpp"
+#include "profile.hpp"
 #include <algorithm>
 #include <cmath>
 
 namespace sdl {
 
+// Helper: shrink a w × h plot area to the Lx:Ly plate aspect (no-op if Ly is unset)
+static void fit_aspect(double Lx, double Ly, int& w, int& h) {
+    if (Ly <= 0.0 || Lx <= 0.0 || w <= 0 || h <= 0) return;
+    double aspect = Lx / Ly;
+    if (w > h * aspect) {
+        w = static_cast<int>(h * aspect);
+    } else {
+        h = static_cast<int>(w / aspect);
+    }
+}
+
 // Helper: 7-segment digit rendering
 static void draw_digit(SDL_Renderer* rend, int x, int y, int digit) {
     static const bool segments[10][7] = {
@@ -27,13 +40,13 @@ static void draw_digit(SDL_Renderer* rend, int x, int y, int digit) {
     const int w = 4;
     const int h = 5;
 
-    if (segments[digit][0]) SDL_RenderDrawLine(rend, x, y, x+w, y);
-    if (segments[digit][1]) SDL_RenderDrawLine(rend, x+w, y, x+w, y+h);
-    if (segments[digit][2]) SDL_RenderDrawLine(rend, x+w, y+h, x+w, y+2*h);
-    if (segments[digit][3]) SDL_RenderDrawLine(rend, x, y+2*h, x+w, y+2*h);
-    if (segments[digit][4]) SDL_RenderDrawLine(rend, x, y+h, x, y+2*h);
-    if (segments[digit][5]) SDL_RenderDrawLine(rend, x, y, x, y+h);
-    if (segments[digit][6]) SDL_RenderDrawLine(rend, x, y+h, x+w, y+h);
+    if (segments[digit][0]) draw::line(rend, x, y, x+w, y);
+    if (segments[digit][1]) draw::line(rend, x+w, y, x+w, y+h);
+    if (segments[digit][2]) draw::line(rend, x+w, y+h, x+w, y+2*h);
+    if (segments[digit][3]) draw::line(rend, x, y+2*h, x+w, y+2*h);
+    if (segments[digit][4]) draw::line(rend, x, y+h, x, y+2*h);
+    if (segments[digit][5]) draw::line(rend, x, y, x, y+h);
+    if (segments[digit][6]) draw::line(rend, x, y+h, x+w, y+h);
 }
 
 // Helper: Letter rendering upper case
@@ -42,116 +55,135 @@ static void draw_letter(SDL_Renderer* rend, int x, int y, char c) {
     const int h = 10;
     switch (c) {
         case 'A':
-            SDL_RenderDrawLine(rend, x, y+h, x+w/2, y);
-            SDL_RenderDrawLine(rend, x+w/2, y, x+w, y+h);
-            SDL_RenderDrawLine(rend, x+1, y+h/2, x+w-1, y+h/2);
+            draw::line(rend, x, y+h, x+w/2, y);
+            draw::line(rend, x+w/2, y, x+w, y+h);
+            draw::line(rend, x+1, y+h/2, x+w-1, y+h/2);
+            break;
+        case 'B':
+            draw::line(rend, x, y, x, y+h);
+            draw::line(rend, x, y, x+w-1, y);
+            draw::line(rend, x+w-1, y, x+w-1, y+h/2);
+            draw::line(rend, x, y+h/2, x+w, y+h/2);
+            draw::line(rend, x+w, y+h/2, x+w, y+h);
+            draw::line(rend, x+w, y+h, x, y+h);
             break;
         case 'C':
-            SDL_RenderDrawLine(rend, x+w, y, x, y);
-            SDL_RenderDrawLine(rend, x, y, x, y+h);
-            SDL_RenderDrawLine(rend, x, y+h, x+w, y+h);
+            draw::line(rend, x+w, y, x, y);
+            draw::line(rend, x, y, x, y+h);
+            draw::line(rend, x, y+h, x+w, y+h);
             break;
         case 'D':
-            SDL_RenderDrawLine(rend, x, y, x, y+h);
-            SDL_RenderDrawLine(rend, x, y, x+w-1, y+2);
-            SDL_RenderDrawLine(rend, x+w-1, y+2, x+w-1, y+h-2);
-            SDL_RenderDrawLine(rend, x+w-1, y+h-2, x, y+h);
+            draw::line(rend, x, y, x, y+h);
+            draw::line(rend, x, y, x+w-1, y+2);
+            draw::line(rend, x+w-1, y+2, x+w-1, y+h-2);
+            draw::line(rend, x+w-1, y+h-2, x, y+h);
             break;
         case 'E':
-            SDL_RenderDrawLine(rend, x, y, x, y+h);
-            SDL_RenderDrawLine(rend, x, y, x+w, y);
-            SDL_RenderDrawLine(rend, x, y+h/2, x+w-1, y+h/2);
-            SDL_RenderDrawLine(rend, x, y+h, x+w, y+h);
+            draw::line(rend, x, y, x, y+h);
+            draw::line(rend, x, y, x+w, y);
+            draw::line(rend, x, y+h/2, x+w-1, y+h/2);
+            draw::line(rend, x, y+h, x+w, y+h);
             break;
         case 'F':
-            SDL_RenderDrawLine(rend, x, y, x, y+h);
-            SDL_RenderDrawLine(rend, x, y, x+w, y);
-            SDL_RenderDrawLine(rend, x, y+h/2, x+w-1, y+h/2);
+            draw::line(rend, x, y, x, y+h);
+            draw::line(rend, x, y, x+w, y);
+            draw::line(rend, x, y+h/2, x+w-1, y+h/2);
             break;
         case 'G':
-            SDL_RenderDrawLine(rend, x+w, y+1, x+1, y);
-            SDL_RenderDrawLine(rend, x, y, x, y+h);
-            SDL_RenderDrawLine(rend, x, y+h, x+w, y+h);
-            SDL_RenderDrawLine(rend, x+w, y+h, x+w, y+h/2);
-            SDL_RenderDrawLine(rend, x+w, y+h/2, x+w/2, y+h/2);
+            draw::line(rend, x+w, y+1, x+1, y);
+            draw::line(rend, x, y, x, y+h);
+            draw::line(rend, x, y+h, x+w, y+h);
+            draw::line(rend, x+w, y+h, x+w, y+h/2);
+            draw::line(rend, x+w, y+h/2, x+w/2, y+h/2);
+            break;
+        case 'H':
+            draw::line(rend, x, y, x, y+h);
+            draw::line(rend, x+w, y, x+w, y+h);
+            draw::line(rend, x, y+h/2, x+w, y+h/2);
             break;
         case 'I':
-            SDL_RenderDrawLine(rend, x+w/2, y, x+w/2, y+h);
-            SDL_RenderDrawLine(rend, x, y, x+w, y);
-            SDL_RenderDrawLine(rend, x, y+h, x+w, y+h);
+            draw::line(rend, x+w/2, y, x+w/2, y+h);
+            draw::line(rend, x, y, x+w, y);
+            draw::line(rend, x, y+h, x+w, y+h);
             break;
         case 'K':
-            SDL_RenderDrawLine(rend, x, y, x, y+h);
-            SDL_RenderDrawLine(rend, x+w, y, x, y+h/2);
-            SDL_RenderDrawLine(rend, x, y+h/2, x+w, y+h);
+            draw::line(rend, x, y, x, y+h);
+            draw::line(rend, x+w, y, x, y+h/2);
+            draw::line(rend, x, y+h/2, x+w, y+h);
             break;
         case 'L':
-            SDL_RenderDrawLine(rend, x, y, x, y+h);
-            SDL_RenderDrawLine(rend, x, y+h, x+w, y+h);
+            draw::line(rend, x, y, x, y+h);
+            draw::line(rend, x, y+h, x+w, y+h);
             break;
         case 'M':
-            SDL_RenderDrawLine(rend, x, y+h, x, y);
-            SDL_RenderDrawLine(rend, x, y, x+w/2, y+h/3);
-            SDL_RenderDrawLine(rend, x+w/2, y+h/3, x+w, y);
-            SDL_RenderDrawLine(rend, x+w, y, x+w, y+h);
+            draw::line(rend, x, y+h, x, y);
+            draw::line(rend, x, y, x+w/2, y+h/3);
+            draw::line(rend, x+w/2, y+h/3, x+w, y);
+            draw::line(rend, x+w, y, x+w, y+h);
             break;
         case 'N':
-            SDL_RenderDrawLine(rend, x, y+h, x, y);
-            SDL_RenderDrawLine(rend, x, y, x+w, y+h);
-            SDL_RenderDrawLine(rend, x+w, y+h, x+w, y);
+            draw::line(rend, x, y+h, x, y);
+            draw::line(rend, x, y, x+w, y+h);
+            draw::line(rend, x+w, y+h, x+w, y);
             break;
         case 'O':
-            SDL_RenderDrawLine(rend, x, y, x+w, y);
-            SDL_RenderDrawLine(rend, x+w, y, x+w, y+h);
-            SDL_RenderDrawLine(rend, x+w, y+h, x, y+h);
-            SDL_RenderDrawLine(rend, x, y+h, x, y);
+            draw::line(rend, x, y, x+w, y);
+            draw::line(rend, x+w, y, x+w, y+h);
+            draw::line(rend, x+w, y+h, x, y+h);
+            draw::line(rend, x, y+h, x, y);
             break;
         case 'P':
-            SDL_RenderDrawLine(rend, x, y, x, y+h);
-            SDL_RenderDrawLine(rend, x, y, x+w, y);
-            SDL_RenderDrawLine(rend, x+w, y, x+w, y+h/2);
-            SDL_RenderDrawLine(rend, x+w, y+h/2, x, y+h/2);
+            draw::line(rend, x, y, x, y+h);
+            draw::line(rend, x, y, x+w, y);
+            draw::line(rend, x+w, y, x+w, y+h/2);
+            draw::line(rend, x+w, y+h/2, x, y+h/2);
             break;
         case 'R':
-            SDL_RenderDrawLine(rend, x, y, x, y+h);
-            SDL_RenderDrawLine(rend, x, y, x+w, y);
-            SDL_RenderDrawLine(rend, x+w, y, x+w, y+h/2);
-            SDL_RenderDrawLine(rend, x+w, y+h/2, x, y+h/2);
-            SDL_RenderDrawLine(rend, x+w/2, y+h/2, x+w, y+h);
+            draw::line(rend, x, y, x, y+h);
+            draw::line(rend, x, y, x+w, y);
+            draw::line(rend, x+w, y, x+w, y+h/2);
+            draw::line(rend, x+w, y+h/2, x, y+h/2);
+            draw::line(rend, x+w/2, y+h/2, x+w, y+h);
             break;
         case 'S':
-            SDL_RenderDrawLine(rend, x+w, y, x, y);
-            SDL_RenderDrawLine(rend, x, y, x, y+h/2);
-            SDL_RenderDrawLine(rend, x, y+h/2, x+w, y+h/2);
-            SDL_RenderDrawLine(rend, x+w, y+h/2, x+w, y+h);
-            SDL_RenderDrawLine(rend, x+w, y+h, x, y+h);
+            draw::line(rend, x+w, y, x, y);
+            draw::line(rend, x, y, x, y+h/2);
+            draw::line(rend, x, y+h/2, x+w, y+h/2);
+            draw::line(rend, x+w, y+h/2, x+w, y+h);
+            draw::line(rend, x+w, y+h, x, y+h);
             break;
         case 'T':
-            SDL_RenderDrawLine(rend, x, y, x+w, y);
-            SDL_RenderDrawLine(rend, x+w/2, y, x+w/2, y+h);
+            draw::line(rend, x, y, x+w, y);
+            draw::line(rend, x+w/2, y, x+w/2, y+h);
             break;
         case 'U':
-            SDL_RenderDrawLine(rend, x, y, x, y+h);
-            SDL_RenderDrawLine(rend, x, y+h, x+w, y+h);
-            SDL_RenderDrawLine(rend, x+w, y+h, x+w, y);
+            draw::line(rend, x, y, x, y+h);
+            draw::line(rend, x, y+h, x+w, y+h);
+            draw::line(rend, x+w, y+h, x+w, y);
             break;
         case 'V':
-            SDL_RenderDrawLine(rend, x, y, x+w/2, y+h);
-            SDL_RenderDrawLine(rend, x+w/2, y+h, x+w, y);
+            draw::line(rend, x, y, x+w/2, y+h);
+            draw::line(rend, x+w/2, y+h, x+w, y);
+            break;
+        case 'W':
+            draw::line(rend, x, y, x+1, y+h);
+            draw::line(rend, x+1, y+h, x+w/2, y+h/2);
+            draw::line(rend, x+w/2, y+h/2, x+w-1, y+h);
+            draw::line(rend, x+w-1, y+h, x+w, y);
             break;
         case 'X':
-            SDL_RenderDrawLine(rend, x, y, x+w, y+h);
-            SDL_RenderDrawLine(rend, x+w, y, x, y+h);
+            draw::line(rend, x, y, x+w, y+h);
+            draw::line(rend, x+w, y, x, y+h);
             break;
         case 'Y':
-            SDL_RenderDrawLine(rend, x, y, x+w/2, y+h/2);
-            SDL_RenderDrawLine(rend, x+w, y, x+w/2, y+h/2);
-            SDL_RenderDrawLine(rend, x+w/2, y+h/2, x+w/2, y+h);
+            draw::line(rend, x, y, x+w/2, y+h/2);
+            draw::line(rend, x+w, y, x+w/2, y+h/2);
+            draw::line(rend, x+w/2, y+h/2, x+w/2, y+h);
             break;
         default:
             // Unknown letter - draw rectangle
             SDL_Rect r = {x, y, w, h};
-            SDL_RenderDrawRect(rend, &r);
+            draw::rect(rend, &r);
             break;
     }
 }
@@ -248,6 +280,7 @@ void SDLHeatmap::temp_to_rgb(double t, Uint8& r, Uint8& g, Uint8& b) const {
 
 // Number rendering display
 void SDLHeatmap::draw_number(SDL_Renderer* rend, int x, int y, double value) const {
+    PROFILE_ZONE("text");
     char buffer[32];
     snprintf(buffer, sizeof(buffer), "%.1f", value);
 
@@ -256,14 +289,14 @@ void SDLHeatmap::draw_number(SDL_Renderer* rend, int x, int y, double value) con
         char c = buffer[i];
         if (c == '.') {
             SDL_Rect dot = {x + offset, y + 8, 2, 2};
-            SDL_RenderFillRect(rend, &dot);
+            draw::fill_rect(rend, &dot);
             offset += 3;
         } else if (c >= '0' && c <= '9') {
             int digit = c - '0';
             draw_digit(rend, x + offset, y, digit);
             offset += 7;
         } else if (c == '-') {
-            SDL_RenderDrawLine(rend, x + offset, y + 5, x + offset + 4, y + 5);
+            draw::line(rend, x + offset, y + 5, x + offset + 4, y + 5);
             offset += 6;
         }
     }
@@ -271,6 +304,7 @@ void SDLHeatmap::draw_number(SDL_Renderer* rend, int x, int y, double value) con
 
 // Text rendering using 7-segment digits
 void SDLHeatmap::draw_text(SDL_Renderer* rend, int x, int y, const char* text) const {
+    PROFILE_ZONE("text");
     int offset = 0;
     for (int i = 0; text[i] != '\0'; ++i) {
         char c = text[i];
@@ -278,30 +312,37 @@ void SDLHeatmap::draw_text(SDL_Renderer* rend, int x, int y, const char* text) c
             offset += 5;
         } else if (c == '.') {
             SDL_Rect dot = {x + offset, y + 8, 2, 2};
-            SDL_RenderFillRect(rend, &dot);
+            draw::fill_rect(rend, &dot);
             offset += 3;
         } else if (c == ':') {
             SDL_Rect dot1 = {x + offset + 1, y + 3, 2, 2};
             SDL_Rect dot2 = {x + offset + 1, y + 7, 2, 2};
-            SDL_RenderFillRect(rend, &dot1);
-            SDL_RenderFillRect(rend, &dot2);
+            draw::fill_rect(rend, &dot1);
+            draw::fill_rect(rend, &dot2);
             offset += 5;
         } else if (c == '=') {
-            SDL_RenderDrawLine(rend, x + offset, y + 3, x + offset + 4, y + 3);
-            SDL_RenderDrawLine(rend, x + offset, y + 7, x + offset + 4, y + 7);
+            draw::line(rend, x + offset, y + 3, x + offset + 4, y + 3);
+            draw::line(rend, x + offset, y + 7, x + offset + 4, y + 7);
             offset += 6;
         } else if (c == '/') {
-            SDL_RenderDrawLine(rend, x + offset + 4, y, x + offset, y + 10);
+            draw::line(rend, x + offset + 4, y, x + offset, y + 10);
+            offset += 6;
+        } else if (c == '-') {
+            draw::line(rend, x + offset, y + 5, x + offset + 4, y + 5);
+            offset += 6;
+        } else if (c == '+') {
+            draw::line(rend, x + offset, y + 5, x + offset + 4, y + 5);
+            draw::line(rend, x + offset + 2, y + 3, x + offset + 2, y + 7);
             offset += 6;
         } else if (c == '[') {
-            SDL_RenderDrawLine(rend, x + offset, y, x + offset, y + 10);
-            SDL_RenderDrawLine(rend, x + offset, y, x + offset + 2, y);
-            SDL_RenderDrawLine(rend, x + offset, y + 10, x + offset + 2, y + 10);
+            draw::line(rend, x + offset, y, x + offset, y + 10);
+            draw::line(rend, x + offset, y, x + offset + 2, y);
+            draw::line(rend, x + offset, y + 10, x + offset + 2, y + 10);
             offset += 4;
         } else if (c == ']') {
-            SDL_RenderDrawLine(rend, x + offset + 2, y, x + offset + 2, y + 10);
-            SDL_RenderDrawLine(rend, x + offset, y, x + offset + 2, y);
-            SDL_RenderDrawLine(rend, x + offset, y + 10, x + offset + 2, y + 10);
+            draw::line(rend, x + offset + 2, y, x + offset + 2, y + 10);
+            draw::line(rend, x + offset, y, x + offset + 2, y);
+            draw::line(rend, x + offset, y + 10, x + offset + 2, y + 10);
             offset += 4;
         } else if (c >= '0' && c <= '9') {
             draw_digit(rend, x + offset, y, c - '0');
@@ -324,20 +365,20 @@ void SDLHeatmap::draw_colorbar(SDL_Renderer* rend, int x, int y, int w, int h) c
         Uint8 r, g, b;
         temp_to_rgb(t, r, g, b);
         SDL_SetRenderDrawColor(rend, r, g, b, 255);
-        SDL_RenderDrawLine(rend, x, y + i, x + w, y + i);
+        draw::line(rend, x, y + i, x + w, y + i);
     }
 
     // Border
     SDL_SetRenderDrawColor(rend, 255, 255, 255, 255);
     SDL_Rect border = {x - 1, y - 1, w + 2, h + 2};
-    SDL_RenderDrawRect(rend, &border);
+    draw::rect(rend, &border);
 
     // ΔT labels
     int num_labels = 5;
     for (int i = 0; i <= num_labels; ++i) {
         int ly = y + (i * h) / num_labels;
         double temp = t_max_ - (i * (t_max_ - t_min_)) / num_labels;
-        SDL_RenderDrawLine(rend, x + w, ly, x + w + 3, ly);
+        draw::line(rend, x + w, ly, x + w + 3, ly);
         draw_number(rend, x + w + 5, ly - 5, temp);
     }
 
@@ -374,12 +415,12 @@ void SDLHeatmap::draw_info_panel(SDL_Renderer* rend, const SimInfo& info) const
 
     SDL_SetRenderDrawColor(rend, 80, 80, 80, 255);
     SDL_Rect bar_bg = {bar_x, y + 2, bar_w, bar_h};
-    SDL_RenderFillRect(rend, &bar_bg);
+    draw::fill_rect(rend, &bar_bg);
     SDL_SetRenderDrawColor(rend, 100, 200, 100, 255);
     SDL_Rect bar_fg = {bar_x, y + 2, static_cast<int>(bar_w * progress), bar_h};
-    SDL_RenderFillRect(rend, &bar_fg);
+    draw::fill_rect(rend, &bar_fg);
     SDL_SetRenderDrawColor(rend, 255, 255, 255, 255);
-    SDL_RenderDrawRect(rend, &bar_bg);
+    draw::rect(rend, &bar_bg);
 
     // Speed indicator
     char speed_buf[16];
@@ -394,6 +435,140 @@ void SDLHeatmap::draw_info_panel(SDL_Renderer* rend, const SimInfo& info) const
     }
 }
 
+// Performance overlay: throughput, solver loads, phases, frame times
+void SDLHeatmap::draw_hud(const PerfInfo& perf) const {
+    SDL_Renderer* rend = win_.get_renderer();
+    const int line_h = 14;
+    const int hist_h = 40;
+    const int phase_rows = perf.profiled ? 1 + static_cast<int>(perf.phases.size()) : 1;
+    const int rows = 6 + static_cast<int>(perf.solvers.size()) + phase_rows + 1;
+    const int w = 330;
+    const int h = rows * line_h + hist_h + 24;
+    const int x0 = win_.get_width() - w - 10;
+    const int y0 = 25;
+    const int x = x0 + 8;
+    int y = y0 + 6;
+    char buf[64];
+
+    SDL_SetRenderDrawColor(rend, 20, 20, 28, 255);
+    SDL_Rect panel = {x0, y0, w, h};
+    draw::fill_rect(rend, &panel);
+    SDL_SetRenderDrawColor(rend, 120, 120, 140, 255);
+    draw::rect(rend, &panel);
+
+    SDL_SetRenderDrawColor(rend, 255, 255, 255, 255);
+    draw_text(rend, x, y, "PERFORMANCE");
+    draw_text(rend, x0 + w - 30, y, "[H]");
+    y += line_h + 4;
+
+    SDL_SetRenderDrawColor(rend, 200, 200, 200, 255);
+    snprintf(buf, sizeof(buf), "STEPS/S %.0f", perf.steps_per_second);
+    draw_text(rend, x, y, buf);
+    snprintf(buf, sizeof(buf), "FRAME %.1f MS", perf.frame_ms);
+    draw_text(rend, x + 160, y, buf);
+    y += line_h;
+    snprintf(buf, sizeof(buf), "DRAW CALLS %ld", perf.draw_calls);
+    draw_text(rend, x, y, buf);
+    if (perf.memory_mb >= 0.0) {
+        snprintf(buf, sizeof(buf), "MEM %.1f MB", perf.memory_mb);
+    } else {
+        snprintf(buf, sizeof(buf), "MEM -");
+    }
+    draw_text(rend, x + 160, y, buf);
+    y += line_h + 4;
+
+    // Solver loads; the most expensive one is the bottleneck
+    int slowest = -1;
+    for (size_t i = 0; i < perf.solvers.size(); ++i) {
+        if (slowest < 0 || perf.solvers[i].ms_per_frame > perf.solvers[slowest].ms_per_frame) {
+            slowest = static_cast<int>(i);
+        }
+    }
+    SDL_SetRenderDrawColor(rend, 150, 200, 255, 255);
+    draw_text(rend, x, y, "MATERIAL");
+    draw_text(rend, x + 100, y, "MS/FR");
+    draw_text(rend, x + 150, y, "STEPS/S");
+    draw_text(rend, x + 210, y, "IT");
+    draw_text(rend, x + 245, y, "RES");
+    y += line_h;
+    for (size_t i = 0; i < perf.solvers.size(); ++i) {
+        const SolverLoad& load = perf.solvers[i];
+        if (perf.solvers.size() > 1 && static_cast<int>(i) == slowest) {
+            SDL_SetRenderDrawColor(rend, 255, 140, 60, 255);
+        } else {
+            SDL_SetRenderDrawColor(rend, 200, 200, 200, 255);
+        }
+        draw_text(rend, x, y, load.material_name.c_str());
+        snprintf(buf, sizeof(buf), "%.2f", load.ms_per_frame);
+        draw_text(rend, x + 100, y, buf);
+        snprintf(buf, sizeof(buf), "%.0f", load.steps_per_second);
+        draw_text(rend, x + 150, y, buf);
+        if (load.iterations >= 0) {
+            snprintf(buf, sizeof(buf), "%d", load.iterations);
+            draw_text(rend, x + 210, y, buf);
+            snprintf(buf, sizeof(buf), "%.1e", load.residual);
+            draw_text(rend, x + 245, y, buf);
+        } else {
+            draw_text(rend, x + 210, y, "-");
+            draw_text(rend, x + 245, y, "-");
+        }
+        y += line_h;
+    }
+
+    // Steps kept although they hit their iteration limit
+    long unconverged = 0;
+    for (const SolverLoad& load : perf.solvers) unconverged += load.unconverged;
+    if (unconverged > 0) {
+        SDL_SetRenderDrawColor(rend, 220, 90, 60, 255);
+    } else {
+        SDL_SetRenderDrawColor(rend, 200, 200, 200, 255);
+    }
+    snprintf(buf, sizeof(buf), "UNCONVERGED STEPS %ld", unconverged);
+    draw_text(rend, x, y, buf);
+    y += line_h + 4;
+
+    // Solver phases from the profiling zones
+    SDL_SetRenderDrawColor(rend, 150, 200, 255, 255);
+    if (!perf.profiled) {
+        draw_text(rend, x, y, "PHASES: PROFILE BUILD ONLY");
+        y += line_h;
+    } else {
+        snprintf(buf, sizeof(buf), "PHASES MS/STEP   STEP %.3f", perf.step_ms);
+        draw_text(rend, x, y, buf);
+        y += line_h;
+        SDL_SetRenderDrawColor(rend, 200, 200, 200, 255);
+        for (const auto& [name, ms] : perf.phases) {
+            draw_text(rend, x, y, name.c_str());
+            snprintf(buf, sizeof(buf), "%.3f", ms);
+            draw_text(rend, x + 100, y, buf);
+            y += line_h;
+        }
+    }
+    y += 4;
+
+    // Frame time histogram, 4 ms bins
+    SDL_SetRenderDrawColor(rend, 150, 200, 255, 255);
+    draw_text(rend, x, y, "FRAME TIME [MS]");
+    y += line_h;
+    int peak = 1;
+    for (int count : perf.frame_histogram) peak = std::max(peak, count);
+    const int bin_w = (w - 16) / HUD_BINS;
+    for (int b = 0; b < HUD_BINS; ++b) {
+        const int bar_h = (perf.frame_histogram[b] * hist_h) / peak;
+        // Bins past 16 ms miss a 60 Hz display
+        if (b < 4) {
+            SDL_SetRenderDrawColor(rend, 100, 200, 100, 255);
+        } else {
+            SDL_SetRenderDrawColor(rend, 220, 90, 60, 255);
+        }
+        SDL_Rect bar = {x + b * bin_w, y + hist_h - bar_h, bin_w - 2, bar_h};
+        draw::fill_rect(rend, &bar);
+        SDL_SetRenderDrawColor(rend, 200, 200, 200, 255);
+        snprintf(buf, sizeof(buf), b + 1 < HUD_BINS ? "%d" : "%d+", 4 * b);
+        draw_text(rend, x + b * bin_w, y + hist_h + 2, buf);
+    }
+}
+
 // Grid lines
 void SDLHeatmap::draw_grid(SDL_Renderer* rend, int x0, int y0, int w, int h, int nx, int ny) const {
     SDL_SetRenderDrawColor(rend, 100, 100, 100, 128);
@@ -402,7 +577,7 @@ void SDLHeatmap::draw_grid(SDL_Renderer* rend, int x0, int y0, int w, int h, int
     for (int i = 1; i < nx; ++i) {
         int x = x0 + (i * w) / nx;
         for (int y = y0; y < y0 + h; y += 4) {
-            SDL_RenderDrawPoint(rend, x, y);
+            draw::point(rend, x, y);
         }
     }
 
@@ -410,7 +585,7 @@ void SDLHeatmap::draw_grid(SDL_Renderer* rend, int x0, int y0, int w, int h, int
     for (int j = 1; j < ny; ++j) {
         int y = y0 + (j * h) / ny;
         for (int x = x0; x < x0 + w; x += 4) {
-            SDL_RenderDrawPoint(rend, x, y);
+            draw::point(rend, x, y);
         }
     }
 }
@@ -436,16 +611,19 @@ void SDLHeatmap::draw_1d_fullscreen(const std::vector<double>& temps, const SimI
     draw_info_panel(rend, info);
 
     // Draw heatmap
-    for (int i = 0; i < n; i++) {
-        Uint8 r, g, b;
-        temp_to_rgb(temps[i], r, g, b);
+    {
+        PROFILE_ZONE("field raster");
+        for (int i = 0; i < n; i++) {
+            Uint8 r, g, b;
+            temp_to_rgb(temps[i], r, g, b);
 
-        int x1 = margin_left + (i * plot_w) / n;
-        int x2 = margin_left + ((i + 1) * plot_w) / n;
+            int x1 = margin_left + (i * plot_w) / n;
+            int x2 = margin_left + ((i + 1) * plot_w) / n;
 
-        SDL_SetRenderDrawColor(rend, r, g, b, 255);
-        SDL_Rect rect = {x1, margin_top, x2 - x1 + 1, plot_h};
-        SDL_RenderFillRect(rend, &rect);
+            SDL_SetRenderDrawColor(rend, r, g, b, 255);
+            SDL_Rect rect = {x1, margin_top, x2 - x1 + 1, plot_h};
+            draw::fill_rect(rend, &rect);
+        }
     }
 
     // Draw grid lines
@@ -464,7 +642,7 @@ void SDLHeatmap::draw_1d_fullscreen(const std::vector<double>& temps, const SimI
         int y1 = margin_top + plot_h - static_cast<int>(norm1 * plot_h);
         int y2 = margin_top + plot_h - static_cast<int>(norm2 * plot_h);
 
-        SDL_RenderDrawLine(rend, x1, y1, x2, y2);
+        draw::line(rend, x1, y1, x2, y2);
     }
 
     // Find min and max temperature positions
@@ -482,7 +660,7 @@ void SDLHeatmap::draw_1d_fullscreen(const std::vector<double>& temps, const SimI
     SDL_SetRenderDrawColor(rend, 100, 150, 255, 255);
     for (int dx = -4; dx <= 4; dx++) {
         for (int dy = -4; dy <= 4; dy++) {
-            if (dx*dx + dy*dy <= 16) SDL_RenderDrawPoint(rend, min_x + dx, min_y + dy);
+            if (dx*dx + dy*dy <= 16) draw::point(rend, min_x + dx, min_y + dy);
         }
     }
 
@@ -493,7 +671,7 @@ void SDLHeatmap::draw_1d_fullscreen(const std::vector<double>& temps, const SimI
     SDL_SetRenderDrawColor(rend, 255, 100, 100, 255);
     for (int dx = -4; dx <= 4; dx++) {
         for (int dy = -4; dy <= 4; dy++) {
-            if (dx*dx + dy*dy <= 16) SDL_RenderDrawPoint(rend, max_x + dx, max_y + dy);
+            if (dx*dx + dy*dy <= 16) draw::point(rend, max_x + dx, max_y + dy);
         }
     }
 
@@ -504,19 +682,19 @@ void SDLHeatmap::draw_1d_fullscreen(const std::vector<double>& temps, const SimI
     SDL_SetRenderDrawColor(rend, 255, 255, 255, 255);
 
     // X-axis
-    SDL_RenderDrawLine(rend, margin_left, win_h - margin_bottom,
-                       margin_left + plot_w, win_h - margin_bottom);
+    draw::line(rend, margin_left, win_h - margin_bottom,
+               margin_left + plot_w, win_h - margin_bottom);
 
     // Y-axis (temperature)
-    SDL_RenderDrawLine(rend, margin_left, margin_top,
-                       margin_left, win_h - margin_bottom);
+    draw::line(rend, margin_left, margin_top,
+               margin_left, win_h - margin_bottom);
 
     // X-axis ticks and labels unit meters
     int num_x_ticks = 5;
     for (int i = 0; i <= num_x_ticks; i++) {
         int x = margin_left + (i * plot_w) / num_x_ticks;
-        SDL_RenderDrawLine(rend, x, win_h - margin_bottom,
-                          x, win_h - margin_bottom + 5);
+        draw::line(rend, x, win_h - margin_bottom,
+                  x, win_h - margin_bottom + 5);
 
         double pos = (i * info.L) / num_x_ticks;
         draw_number(rend, x - 10, win_h - margin_bottom + 10, pos);
@@ -531,7 +709,7 @@ void SDLHeatmap::draw_1d_fullscreen(const std::vector<double>& temps, const SimI
     int num_y_ticks = 5;
     for (int i = 0; i <= num_y_ticks; i++) {
         int y = win_h - margin_bottom - (i * plot_h) / num_y_ticks;
-        SDL_RenderDrawLine(rend, margin_left - 5, y, margin_left, y);
+        draw::line(rend, margin_left - 5, y, margin_left, y);
 
         double temp = t_min_ + (i * (t_max_ - t_min_)) / num_y_ticks;
         draw_number(rend, margin_left - 50, y - 5, temp);
@@ -561,34 +739,34 @@ void SDLHeatmap::draw_1d_fullscreen(const std::vector<double>& temps, const SimI
     // Source 1 
     SDL_SetRenderDrawColor(rend, 0, 255, 255, 255);
     SDL_Rect src1_rect = {src1_x1, margin_top, src1_x2 - src1_x1, plot_h};
-    SDL_RenderDrawRect(rend, &src1_rect);
+    draw::rect(rend, &src1_rect);
 
     // Source 2 
     SDL_Rect src2_rect = {src2_x1, margin_top, src2_x2 - src2_x1, plot_h};
-    SDL_RenderDrawRect(rend, &src2_rect);
+    draw::rect(rend, &src2_rect);
 
     // Draw source region brackets at bottom
     int bracket_y = win_h - margin_bottom + 35;
 
     // Source 1 bracket with arrow pointing up
-    SDL_RenderDrawLine(rend, src1_x1, bracket_y, src1_x1, bracket_y - 5);
-    SDL_RenderDrawLine(rend, src1_x1, bracket_y - 5, src1_x2, bracket_y - 5);
-    SDL_RenderDrawLine(rend, src1_x2, bracket_y, src1_x2, bracket_y - 5);
+    draw::line(rend, src1_x1, bracket_y, src1_x1, bracket_y - 5);
+    draw::line(rend, src1_x1, bracket_y - 5, src1_x2, bracket_y - 5);
+    draw::line(rend, src1_x2, bracket_y, src1_x2, bracket_y - 5);
 
     // Arrow pointing to source region
     int arrow_x1 = src1_center;
-    SDL_RenderDrawLine(rend, arrow_x1, bracket_y - 5, arrow_x1, bracket_y - 12);
-    SDL_RenderDrawLine(rend, arrow_x1 - 3, bracket_y - 9, arrow_x1, bracket_y - 12);
-    SDL_RenderDrawLine(rend, arrow_x1 + 3, bracket_y - 9, arrow_x1, bracket_y - 12);
+    draw::line(rend, arrow_x1, bracket_y - 5, arrow_x1, bracket_y - 12);
+    draw::line(rend, arrow_x1 - 3, bracket_y - 9, arrow_x1, bracket_y - 12);
+    draw::line(rend, arrow_x1 + 3, bracket_y - 9, arrow_x1, bracket_y - 12);
 
     // Source 2 bracket with arrow
-    SDL_RenderDrawLine(rend, src2_x1, bracket_y, src2_x1, bracket_y - 5);
-    SDL_RenderDrawLine(rend, src2_x1, bracket_y - 5, src2_x2, bracket_y - 5);
-    SDL_RenderDrawLine(rend, src2_x2, bracket_y, src2_x2, bracket_y - 5);
+    draw::line(rend, src2_x1, bracket_y, src2_x1, bracket_y - 5);
+    draw::line(rend, src2_x1, bracket_y - 5, src2_x2, bracket_y - 5);
+    draw::line(rend, src2_x2, bracket_y, src2_x2, bracket_y - 5);
     int arrow_x2 = src2_center;
-    SDL_RenderDrawLine(rend, arrow_x2, bracket_y - 5, arrow_x2, bracket_y - 12);
-    SDL_RenderDrawLine(rend, arrow_x2 - 3, bracket_y - 9, arrow_x2, bracket_y - 12);
-    SDL_RenderDrawLine(rend, arrow_x2 + 3, bracket_y - 9, arrow_x2, bracket_y - 12);
+    draw::line(rend, arrow_x2, bracket_y - 5, arrow_x2, bracket_y - 12);
+    draw::line(rend, arrow_x2 - 3, bracket_y - 9, arrow_x2, bracket_y - 12);
+    draw::line(rend, arrow_x2 + 3, bracket_y - 9, arrow_x2, bracket_y - 12);
 
     // Draw source labels with power percentage
     SDL_SetRenderDrawColor(rend, 255, 200, 0, 255);  // Yellow for high power
@@ -617,6 +795,16 @@ void SDLHeatmap::draw_2d_fullscreen(const std::vector<std::vector<double>>& temp
     int plot_w = win_w - margin_left - margin_right;
     int plot_h = win_h - margin_top - margin_bottom;
 
+    // Keep the plate proportions, centring the plot in the free space
+    int free_w = plot_w;
+    int free_h = plot_h;
+    fit_aspect(info.L, info.Ly, plot_w, plot_h);
+    double plate_h = info.Ly > 0.0 ? info.Ly : info.L;
+    margin_left += (free_w - plot_w) / 2;
+    margin_right += free_w - plot_w - (free_w - plot_w) / 2;
+    margin_top += (free_h - plot_h) / 2;
+    margin_bottom += free_h - plot_h - (free_h - plot_h) / 2;
+
     // Draw panel at top
     draw_info_panel(rend, info);
 
@@ -625,37 +813,40 @@ void SDLHeatmap::draw_2d_fullscreen(const std::vector<std::vector<double>>& temp
     int render_nx = (nx - 1) * sub;
     int render_ny = (ny - 1) * sub;
 
-    for (int sj = 0; sj < render_ny; ++sj) {
-        for (int si = 0; si < render_nx; ++si) {
-            double fi = static_cast<double>(si) / sub;
-            double fj = static_cast<double>(sj) / sub;
+    {
+        PROFILE_ZONE("field raster");
+        for (int sj = 0; sj < render_ny; ++sj) {
+            for (int si = 0; si < render_nx; ++si) {
+                double fi = static_cast<double>(si) / sub;
+                double fj = static_cast<double>(sj) / sub;
 
-            int i0 = static_cast<int>(fi);
-            int j0 = static_cast<int>(fj);
-            int i1 = std::min(i0 + 1, nx - 1);
-            int j1 = std::min(j0 + 1, ny - 1);
+                int i0 = static_cast<int>(fi);
+                int j0 = static_cast<int>(fj);
+                int i1 = std::min(i0 + 1, nx - 1);
+                int j1 = std::min(j0 + 1, ny - 1);
 
-            double fx = fi - i0;
-            double fy = fj - j0;
+                double fx = fi - i0;
+                double fy = fj - j0;
 
-            double t = temps[j0][i0] * (1-fx) * (1-fy)
-                     + temps[j0][i1] * fx * (1-fy)
-                     + temps[j1][i0] * (1-fx) * fy
-                     + temps[j1][i1] * fx * fy;
+                double t = temps[j0][i0] * (1-fx) * (1-fy)
+                         + temps[j0][i1] * fx * (1-fy)
+                         + temps[j1][i0] * (1-fx) * fy
+                         + temps[j1][i1] * fx * fy;
 
-            Uint8 r, g, b;
-            temp_to_rgb(t, r, g, b);
+                Uint8 r, g, b;
+                temp_to_rgb(t, r, g, b);
 
-            int x1 = margin_left + (si * plot_w) / render_nx;
-            int x2 = margin_left + ((si + 1) * plot_w) / render_nx;
+                int x1 = margin_left + (si * plot_w) / render_nx;
+                int x2 = margin_left + ((si + 1) * plot_w) / render_nx;
 
-            // Flip Y-axis: y=0 (Neumann) at bottom, y=L (Dirichlet) at top
-            int y1 = margin_top + plot_h - ((sj + 1) * plot_h) / render_ny;
-            int y2 = margin_top + plot_h - (sj * plot_h) / render_ny;
+                // Flip Y-axis: y=0 (Neumann) at bottom, y=L (Dirichlet) at top
+                int y1 = margin_top + plot_h - ((sj + 1) * plot_h) / render_ny;
+                int y2 = margin_top + plot_h - (sj * plot_h) / render_ny;
 
-            SDL_SetRenderDrawColor(rend, r, g, b, 255);
-            SDL_Rect rect = {x1, y1, x2 - x1 + 1, y2 - y1 + 1};
-            SDL_RenderFillRect(rend, &rect);
+                SDL_SetRenderDrawColor(rend, r, g, b, 255);
+                SDL_Rect rect = {x1, y1, x2 - x1 + 1, y2 - y1 + 1};
+                draw::fill_rect(rend, &rect);
+            }
         }
     }
 
@@ -679,7 +870,7 @@ void SDLHeatmap::draw_2d_fullscreen(const std::vector<std::vector<double>>& temp
     for (int dx = -5; dx <= 5; dx++) {
         for (int dy = -5; dy <= 5; dy++) {
             if (dx*dx + dy*dy <= 25 && dx*dx + dy*dy >= 9)
-                SDL_RenderDrawPoint(rend, min_x + dx, min_y + dy);
+                draw::point(rend, min_x + dx, min_y + dy);
         }
     }
 
@@ -690,7 +881,7 @@ void SDLHeatmap::draw_2d_fullscreen(const std::vector<std::vector<double>>& temp
     for (int dx = -5; dx <= 5; dx++) {
         for (int dy = -5; dy <= 5; dy++) {
             if (dx*dx + dy*dy <= 25 && dx*dx + dy*dy >= 9)
-                SDL_RenderDrawPoint(rend, max_x + dx, max_y + dy);
+                draw::point(rend, max_x + dx, max_y + dy);
         }
     }
 
@@ -701,19 +892,19 @@ void SDLHeatmap::draw_2d_fullscreen(const std::vector<std::vector<double>>& temp
     SDL_SetRenderDrawColor(rend, 255, 255, 255, 255);
 
     // X-axis
-    SDL_RenderDrawLine(rend, margin_left, win_h - margin_bottom,
-                       margin_left + plot_w, win_h - margin_bottom);
+    draw::line(rend, margin_left, win_h - margin_bottom,
+               margin_left + plot_w, win_h - margin_bottom);
 
     // Y-axis
-    SDL_RenderDrawLine(rend, margin_left, margin_top,
-                       margin_left, win_h - margin_bottom);
+    draw::line(rend, margin_left, margin_top,
+               margin_left, win_h - margin_bottom);
 
     // X-axis ticks
     int num_ticks = 5;
     for (int i = 0; i <= num_ticks; i++) {
         int x = margin_left + (i * plot_w) / num_ticks;
-        SDL_RenderDrawLine(rend, x, win_h - margin_bottom,
-                          x, win_h - margin_bottom + 5);
+        draw::line(rend, x, win_h - margin_bottom,
+                  x, win_h - margin_bottom + 5);
 
         double pos = (i * info.L) / num_ticks;
         draw_number(rend, x - 10, win_h - margin_bottom + 10, pos);
@@ -727,9 +918,9 @@ void SDLHeatmap::draw_2d_fullscreen(const std::vector<std::vector<double>>& temp
     SDL_SetRenderDrawColor(rend, 255, 255, 255, 255);
     for (int i = 0; i <= num_ticks; i++) {
         int y = win_h - margin_bottom - (i * plot_h) / num_ticks;
-        SDL_RenderDrawLine(rend, margin_left - 5, y, margin_left, y);
+        draw::line(rend, margin_left - 5, y, margin_left, y);
 
-        double pos = (i * info.L) / num_ticks;
+        double pos = (i * plate_h) / num_ticks;
         draw_number(rend, 10, y - 5, pos);
     }
 
@@ -773,29 +964,29 @@ void SDLHeatmap::draw_2d_fullscreen(const std::vector<std::vector<double>>& temp
     SDL_Rect src_tr = {sx3, sy3, sx4 - sx3, sy4 - sy3};  // Top-right
 
     // Outer border
-    SDL_RenderDrawRect(rend, &src_bl);
-    SDL_RenderDrawRect(rend, &src_br);
-    SDL_RenderDrawRect(rend, &src_tl);
-    SDL_RenderDrawRect(rend, &src_tr);
+    draw::rect(rend, &src_bl);
+    draw::rect(rend, &src_br);
+    draw::rect(rend, &src_tl);
+    draw::rect(rend, &src_tr);
 
     // Inner border
     SDL_Rect src_bl_inner = {sx1 + 1, sy1 + 1, sx2 - sx1 - 2, sy2 - sy1 - 2};
     SDL_Rect src_br_inner = {sx3 + 1, sy1 + 1, sx4 - sx3 - 2, sy2 - sy1 - 2};
     SDL_Rect src_tl_inner = {sx1 + 1, sy3 + 1, sx2 - sx1 - 2, sy4 - sy3 - 2};
     SDL_Rect src_tr_inner = {sx3 + 1, sy3 + 1, sx4 - sx3 - 2, sy4 - sy3 - 2};
-    SDL_RenderDrawRect(rend, &src_bl_inner);
-    SDL_RenderDrawRect(rend, &src_br_inner);
-    SDL_RenderDrawRect(rend, &src_tl_inner);
-    SDL_RenderDrawRect(rend, &src_tr_inner);
+    draw::rect(rend, &src_bl_inner);
+    draw::rect(rend, &src_br_inner);
+    draw::rect(rend, &src_tl_inner);
+    draw::rect(rend, &src_tr_inner);
 
     // Draw corner marks for each source
     int mark_len = 5;
 
     // Bottom-left source corners
-    SDL_RenderDrawLine(rend, sx1 - mark_len, sy1, sx1, sy1);
-    SDL_RenderDrawLine(rend, sx1, sy1 - mark_len, sx1, sy1);
-    SDL_RenderDrawLine(rend, sx2, sy2, sx2 + mark_len, sy2);
-    SDL_RenderDrawLine(rend, sx2, sy2, sx2, sy2 + mark_len);
+    draw::line(rend, sx1 - mark_len, sy1, sx1, sy1);
+    draw::line(rend, sx1, sy1 - mark_len, sx1, sy1);
+    draw::line(rend, sx2, sy2, sx2 + mark_len, sy2);
+    draw::line(rend, sx2, sy2, sx2, sy2 + mark_len);
 
     // Draw source labels with "F" for flux/heat source
     SDL_SetRenderDrawColor(rend, 255, 200, 0, 255);  // Yellow
@@ -837,16 +1028,19 @@ void SDLHeatmap::draw_1d_cell(const std::vector<double>& temps, const SimInfo& i
     draw_text(rend, cell_x + cell_w - 70, cell_y + 5, time_buf);
 
     // Draw heatmap
-    for (int i = 0; i < n; i++) {
-        Uint8 r, g, b;
-        temp_to_rgb(temps[i], r, g, b);
+    {
+        PROFILE_ZONE("field raster");
+        for (int i = 0; i < n; i++) {
+            Uint8 r, g, b;
+            temp_to_rgb(temps[i], r, g, b);
 
-        int x1 = plot_x + (i * plot_w) / n;
-        int x2 = plot_x + ((i + 1) * plot_w) / n;
+            int x1 = plot_x + (i * plot_w) / n;
+            int x2 = plot_x + ((i + 1) * plot_w) / n;
 
-        SDL_SetRenderDrawColor(rend, r, g, b, 255);
-        SDL_Rect rect = {x1, plot_y, x2 - x1 + 1, plot_h};
-        SDL_RenderFillRect(rend, &rect);
+            SDL_SetRenderDrawColor(rend, r, g, b, 255);
+            SDL_Rect rect = {x1, plot_y, x2 - x1 + 1, plot_h};
+            draw::fill_rect(rend, &rect);
+        }
     }
 
     // Draw temperature profile line (white curve)
@@ -862,7 +1056,7 @@ void SDLHeatmap::draw_1d_cell(const std::vector<double>& temps, const SimInfo& i
         int y1 = plot_y + plot_h - static_cast<int>(norm1 * plot_h);
         int y2 = plot_y + plot_h - static_cast<int>(norm2 * plot_h);
 
-        SDL_RenderDrawLine(rend, x1, y1, x2, y2);
+        draw::line(rend, x1, y1, x2, y2);
     }
 
     // Temperature value projections at key positions
@@ -884,13 +1078,13 @@ void SDLHeatmap::draw_1d_cell(const std::vector<double>& temps, const SimInfo& i
         // Draw projection line to Y-axis (dashed)
         SDL_SetRenderDrawColor(rend, 180, 180, 180, 255);
         for (int x = plot_x; x < px; x += 4) {
-            SDL_RenderDrawPoint(rend, x, py);
+            draw::point(rend, x, py);
         }
 
         // Draw small marker at the point
         SDL_SetRenderDrawColor(rend, 255, 255, 0, 255);
         SDL_Rect marker = {px - 2, py - 2, 5, 5};
-        SDL_RenderFillRect(rend, &marker);
+        draw::fill_rect(rend, &marker);
 
         // Draw temperature value near the projection on Y-axis
         SDL_SetRenderDrawColor(rend, 255, 255, 150, 255);
@@ -916,11 +1110,11 @@ void SDLHeatmap::draw_1d_cell(const std::vector<double>& temps, const SimInfo& i
         Uint8 r, g, b;
         temp_to_rgb(t, r, g, b);
         SDL_SetRenderDrawColor(rend, r, g, b, 255);
-        SDL_RenderDrawLine(rend, cb_x, plot_y + i, cb_x + cb_w, plot_y + i);
+        draw::line(rend, cb_x, plot_y + i, cb_x + cb_w, plot_y + i);
     }
     SDL_SetRenderDrawColor(rend, 255, 255, 255, 255);
     SDL_Rect cb_border = {cb_x - 1, plot_y - 1, cb_w + 2, cb_h + 2};
-    SDL_RenderDrawRect(rend, &cb_border);
+    draw::rect(rend, &cb_border);
 
     // Colorbar labels (min/max)
     draw_number(rend, cb_x + cb_w + 3, plot_y - 3, t_max_);
@@ -928,8 +1122,8 @@ void SDLHeatmap::draw_1d_cell(const std::vector<double>& temps, const SimInfo& i
 
     // Draw axes
     SDL_SetRenderDrawColor(rend, 255, 255, 255, 255);
-    SDL_RenderDrawLine(rend, plot_x, plot_y + plot_h, plot_x + plot_w, plot_y + plot_h);  // X-axis
-    SDL_RenderDrawLine(rend, plot_x, plot_y, plot_x, plot_y + plot_h);  // Y-axis
+    draw::line(rend, plot_x, plot_y + plot_h, plot_x + plot_w, plot_y + plot_h);  // X-axis
+    draw::line(rend, plot_x, plot_y, plot_x, plot_y + plot_h);  // Y-axis
 
     // X-axis labels (0 and L)
     draw_number(rend, plot_x - 5, plot_y + plot_h + 5, 0.0);
@@ -966,13 +1160,13 @@ void SDLHeatmap::draw_1d_cell(const std::vector<double>& temps, const SimInfo& i
     // Source 1 
     for (int y = plot_y; y < plot_y + plot_h; y += 3) {
         for (int x = src1_x1; x < src1_x2; x += 3) {
-            SDL_RenderDrawPoint(rend, x, y);
+            draw::point(rend, x, y);
         }
     }
     // Source 2 
     for (int y = plot_y; y < plot_y + plot_h; y += 3) {
         for (int x = src2_x1; x < src2_x2; x += 3) {
-            SDL_RenderDrawPoint(rend, x, y);
+            draw::point(rend, x, y);
         }
     }
 
@@ -982,14 +1176,14 @@ void SDLHeatmap::draw_1d_cell(const std::vector<double>& temps, const SimInfo& i
     // Source 1
     SDL_Rect src1 = {src1_x1, plot_y, src1_x2 - src1_x1, plot_h};
     SDL_Rect src1_inner = {src1_x1 + 1, plot_y + 1, src1_x2 - src1_x1 - 2, plot_h - 2};
-    SDL_RenderDrawRect(rend, &src1);
-    SDL_RenderDrawRect(rend, &src1_inner);
+    draw::rect(rend, &src1);
+    draw::rect(rend, &src1_inner);
 
     // Source 2
     SDL_Rect src2 = {src2_x1, plot_y, src2_x2 - src2_x1, plot_h};
     SDL_Rect src2_inner = {src2_x1 + 1, plot_y + 1, src2_x2 - src2_x1 - 2, plot_h - 2};
-    SDL_RenderDrawRect(rend, &src2);
-    SDL_RenderDrawRect(rend, &src2_inner);
+    draw::rect(rend, &src2);
+    draw::rect(rend, &src2_inner);
 
     // Draw arrows pointing down into the sources (heat input indicator)
     SDL_SetRenderDrawColor(rend, 255, 255, 0, 255);  // Bright yellow arrows
@@ -998,14 +1192,14 @@ void SDLHeatmap::draw_1d_cell(const std::vector<double>& temps, const SimInfo& i
     int src2_cx = (src2_x1 + src2_x2) / 2;
 
     // Arrow 1 pointing down
-    SDL_RenderDrawLine(rend, src1_cx, arrow_y, src1_cx, plot_y - 2);
-    SDL_RenderDrawLine(rend, src1_cx - 3, plot_y - 5, src1_cx, plot_y - 2);
-    SDL_RenderDrawLine(rend, src1_cx + 3, plot_y - 5, src1_cx, plot_y - 2);
+    draw::line(rend, src1_cx, arrow_y, src1_cx, plot_y - 2);
+    draw::line(rend, src1_cx - 3, plot_y - 5, src1_cx, plot_y - 2);
+    draw::line(rend, src1_cx + 3, plot_y - 5, src1_cx, plot_y - 2);
 
     // Arrow 2 pointing down
-    SDL_RenderDrawLine(rend, src2_cx, arrow_y, src2_cx, plot_y - 2);
-    SDL_RenderDrawLine(rend, src2_cx - 3, plot_y - 5, src2_cx, plot_y - 2);
-    SDL_RenderDrawLine(rend, src2_cx + 3, plot_y - 5, src2_cx, plot_y - 2);
+    draw::line(rend, src2_cx, arrow_y, src2_cx, plot_y - 2);
+    draw::line(rend, src2_cx - 3, plot_y - 5, src2_cx, plot_y - 2);
+    draw::line(rend, src2_cx + 3, plot_y - 5, src2_cx, plot_y - 2);
 
     // Find and draw min/max temperature markers
     int min_idx = 0, max_idx = 0;
@@ -1023,7 +1217,7 @@ void SDLHeatmap::draw_1d_cell(const std::vector<double>& temps, const SimInfo& i
     SDL_SetRenderDrawColor(rend, 100, 150, 255, 255);
     for (int dx = -3; dx <= 3; dx++) {
         for (int dy = -3; dy <= 3; dy++) {
-            if (dx*dx + dy*dy <= 9) SDL_RenderDrawPoint(rend, min_x + dx, min_y + dy);
+            if (dx*dx + dy*dy <= 9) draw::point(rend, min_x + dx, min_y + dy);
         }
     }
 
@@ -1035,7 +1229,7 @@ void SDLHeatmap::draw_1d_cell(const std::vector<double>& temps, const SimInfo& i
     SDL_SetRenderDrawColor(rend, 255, 100, 100, 255);
     for (int dx = -3; dx <= 3; dx++) {
         for (int dy = -3; dy <= 3; dy++) {
-            if (dx*dx + dy*dy <= 9) SDL_RenderDrawPoint(rend, max_x + dx, max_y + dy);
+            if (dx*dx + dy*dy <= 9) draw::point(rend, max_x + dx, max_y + dy);
         }
     }
 
@@ -1048,12 +1242,12 @@ void SDLHeatmap::draw_1d_cell(const std::vector<double>& temps, const SimInfo& i
 
     SDL_SetRenderDrawColor(rend, 60, 60, 60, 255);
     SDL_Rect bar_bg = {bar_x, bar_y, bar_w, bar_h};
-    SDL_RenderFillRect(rend, &bar_bg);
+    draw::fill_rect(rend, &bar_bg);
     SDL_SetRenderDrawColor(rend, 80, 180, 80, 255);
     SDL_Rect bar_fg = {bar_x, bar_y, static_cast<int>(bar_w * progress), bar_h};
-    SDL_RenderFillRect(rend, &bar_fg);
+    draw::fill_rect(rend, &bar_fg);
     SDL_SetRenderDrawColor(rend, 200, 200, 200, 255);
-    SDL_RenderDrawRect(rend, &bar_bg);
+    draw::rect(rend, &bar_bg);
 
     // Speed indicator
     char speed_buf[16];
@@ -1070,7 +1264,7 @@ void SDLHeatmap::draw_1d_cell(const std::vector<double>& temps, const SimInfo& i
     // Draw border
     SDL_SetRenderDrawColor(rend, 100, 100, 100, 255);
     SDL_Rect border = {plot_x, plot_y, plot_w, plot_h};
-    SDL_RenderDrawRect(rend, &border);
+    draw::rect(rend, &border);
 }
 
 void SDLHeatmap::draw_2d_cell(const std::vector<std::vector<double>>& temps, const SimInfo& info,
@@ -1093,6 +1287,14 @@ void SDLHeatmap::draw_2d_cell(const std::vector<std::vector<double>>& temps, con
     int plot_w = cell_w - margin_left - margin_right;
     int plot_h = cell_h - margin_top - margin_bottom;
 
+    // Keep the plate proportions, centring the plot in the free space
+    int free_w = plot_w;
+    int free_h = plot_h;
+    fit_aspect(info.L, info.Ly, plot_w, plot_h);
+    double plate_h = info.Ly > 0.0 ? info.Ly : info.L;
+    plot_x += (free_w - plot_w) / 2;
+    plot_y += (free_h - plot_h) / 2;
+
     // Draw material name and alpha at top
     SDL_SetRenderDrawColor(rend, 200, 200, 200, 255);
     draw_text(rend, cell_x + 5, cell_y + 5, info.material_name.c_str());
@@ -1111,36 +1313,39 @@ void SDLHeatmap::draw_2d_cell(const std::vector<std::vector<double>>& temps, con
     int render_nx = (nx - 1) * sub;
     int render_ny = (ny - 1) * sub;
 
-    for (int sj = 0; sj < render_ny; ++sj) {
-        for (int si = 0; si < render_nx; ++si) {
-            double fi = static_cast<double>(si) / sub;
-            double fj = static_cast<double>(sj) / sub;
-
-            int i0 = static_cast<int>(fi);
-            int j0 = static_cast<int>(fj);
-            int i1 = std::min(i0 + 1, nx - 1);
-            int j1 = std::min(j0 + 1, ny - 1);
-
-            double fx = fi - i0;
-            double fy = fj - j0;
-
-            double t = temps[j0][i0] * (1-fx) * (1-fy)
-                     + temps[j0][i1] * fx * (1-fy)
-                     + temps[j1][i0] * (1-fx) * fy
-                     + temps[j1][i1] * fx * fy;
-
-            Uint8 r, g, b;
-            temp_to_rgb(t, r, g, b);
-
-            int x1 = plot_x + (si * plot_w) / render_nx;
-            int x2 = plot_x + ((si + 1) * plot_w) / render_nx;
-            // Flip Y-axis
-            int y1 = plot_y + plot_h - ((sj + 1) * plot_h) / render_ny;
-            int y2 = plot_y + plot_h - (sj * plot_h) / render_ny;
-
-            SDL_SetRenderDrawColor(rend, r, g, b, 255);
-            SDL_Rect rect = {x1, y1, x2 - x1 + 1, y2 - y1 + 1};
-            SDL_RenderFillRect(rend, &rect);
+    {
+        PROFILE_ZONE("field raster");
+        for (int sj = 0; sj < render_ny; ++sj) {
+            for (int si = 0; si < render_nx; ++si) {
+                double fi = static_cast<double>(si) / sub;
+                double fj = static_cast<double>(sj) / sub;
+
+                int i0 = static_cast<int>(fi);
+                int j0 = static_cast<int>(fj);
+                int i1 = std::min(i0 + 1, nx - 1);
+                int j1 = std::min(j0 + 1, ny - 1);
+
+                double fx = fi - i0;
+                double fy = fj - j0;
+
+                double t = temps[j0][i0] * (1-fx) * (1-fy)
+                         + temps[j0][i1] * fx * (1-fy)
+                         + temps[j1][i0] * (1-fx) * fy
+                         + temps[j1][i1] * fx * fy;
+
+                Uint8 r, g, b;
+                temp_to_rgb(t, r, g, b);
+
+                int x1 = plot_x + (si * plot_w) / render_nx;
+                int x2 = plot_x + ((si + 1) * plot_w) / render_nx;
+                // Flip Y-axis
+                int y1 = plot_y + plot_h - ((sj + 1) * plot_h) / render_ny;
+                int y2 = plot_y + plot_h - (sj * plot_h) / render_ny;
+
+                SDL_SetRenderDrawColor(rend, r, g, b, 255);
+                SDL_Rect rect = {x1, y1, x2 - x1 + 1, y2 - y1 + 1};
+                draw::fill_rect(rend, &rect);
+            }
         }
     }
 
@@ -1159,7 +1364,7 @@ void SDLHeatmap::draw_2d_cell(const std::vector<std::vector<double>>& temps, con
 
             // Calculate gradient
             double dTdx = (temps[j][i+1] - temps[j][i-1]) / (2.0 * (info.L / nx));
-            double dTdy = (temps[j+1][i] - temps[j-1][i]) / (2.0 * (info.L / ny));
+            double dTdy = (temps[j+1][i] - temps[j-1][i]) / (2.0 * (plate_h / ny));
 
             // Heat flow is 
             double flow_x = -dTdx;
@@ -1185,7 +1390,7 @@ void SDLHeatmap::draw_2d_cell(const std::vector<std::vector<double>>& temps, con
 
             // Draw arrow line 
             SDL_SetRenderDrawColor(rend, 0, 255, 200, 255);
-            SDL_RenderDrawLine(rend, bx, by, tx, ty);
+            draw::line(rend, bx, by, tx, ty);
 
             // Draw arrowhead
             double angle = std::atan2(-ay, ax);
@@ -1194,8 +1399,8 @@ void SDLHeatmap::draw_2d_cell(const std::vector<std::vector<double>>& temps, con
             int hy1 = ty - static_cast<int>(head_len * std::sin(angle - 0.5));
             int hx2 = tx - static_cast<int>(head_len * std::cos(angle + 0.5));
             int hy2 = ty - static_cast<int>(head_len * std::sin(angle + 0.5));
-            SDL_RenderDrawLine(rend, tx, ty, hx1, hy1);
-            SDL_RenderDrawLine(rend, tx, ty, hx2, hy2);
+            draw::line(rend, tx, ty, hx1, hy1);
+            draw::line(rend, tx, ty, hx2, hy2);
         }
     }
 
@@ -1223,11 +1428,11 @@ void SDLHeatmap::draw_2d_cell(const std::vector<std::vector<double>>& temps, con
                     int cx = plot_x + ((i * 2 + 1) * plot_w) / (2 * nx);
                     int cy = plot_y + plot_h - ((j * 2 + 1) * plot_h) / (2 * ny);
                     // Draw small cross for contour point
-                    SDL_RenderDrawPoint(rend, cx, cy);
-                    SDL_RenderDrawPoint(rend, cx+1, cy);
-                    SDL_RenderDrawPoint(rend, cx-1, cy);
-                    SDL_RenderDrawPoint(rend, cx, cy+1);
-                    SDL_RenderDrawPoint(rend, cx, cy-1);
+                    draw::point(rend, cx, cy);
+                    draw::point(rend, cx+1, cy);
+                    draw::point(rend, cx-1, cy);
+                    draw::point(rend, cx, cy+1);
+                    draw::point(rend, cx, cy-1);
                 }
             }
         }
@@ -1252,7 +1457,7 @@ void SDLHeatmap::draw_2d_cell(const std::vector<std::vector<double>>& temps, con
         int y1 = profile_y + profile_h - static_cast<int>(norm1 * profile_h);
         int y2 = profile_y + profile_h - static_cast<int>(norm2 * profile_h);
 
-        SDL_RenderDrawLine(rend, x1, y1, x2, y2);
+        draw::line(rend, x1, y1, x2, y2);
     }
 
     // Draw temperature profile along left edge (X=0, varying Y)
@@ -1273,7 +1478,7 @@ void SDLHeatmap::draw_2d_cell(const std::vector<std::vector<double>>& temps, con
         int x1 = profile_x + static_cast<int>(norm1 * profile_w);
         int x2 = profile_x + static_cast<int>(norm2 * profile_w);
 
-        SDL_RenderDrawLine(rend, x1, y1, x2, y2);
+        draw::line(rend, x1, y1, x2, y2);
     }
 
     // Temperature values at key positions
@@ -1296,7 +1501,7 @@ void SDLHeatmap::draw_2d_cell(const std::vector<std::vector<double>>& temps, con
         SDL_SetRenderDrawColor(rend, 255, 255, 0, 255);
         for (int dx = -2; dx <= 2; dx++) {
             for (int dy = -2; dy <= 2; dy++) {
-                if (dx*dx + dy*dy <= 4) SDL_RenderDrawPoint(rend, px + dx, py + dy);
+                if (dx*dx + dy*dy <= 4) draw::point(rend, px + dx, py + dy);
             }
         }
 
@@ -1322,13 +1527,13 @@ void SDLHeatmap::draw_2d_cell(const std::vector<std::vector<double>>& temps, con
         Uint8 r, g, b;
         temp_to_rgb(t, r, g, b);
         SDL_SetRenderDrawColor(rend, r, g, b, 255);
-        SDL_RenderDrawLine(rend, cb_x, plot_y + i, cb_x + cb_w, plot_y + i);
+        draw::line(rend, cb_x, plot_y + i, cb_x + cb_w, plot_y + i);
     }
 
     SDL_SetRenderDrawColor(rend, 255, 255, 255, 255);
 
     SDL_Rect cb_border = {cb_x - 1, plot_y - 1, cb_w + 2, cb_h + 2};
-    SDL_RenderDrawRect(rend, &cb_border);
+    draw::rect(rend, &cb_border);
 
     // Colorbar labels (min/max)
     draw_number(rend, cb_x + cb_w + 3, plot_y - 3, t_max_);
@@ -1336,8 +1541,8 @@ void SDLHeatmap::draw_2d_cell(const std::vector<std::vector<double>>& temps, con
 
     // Draw axes
     SDL_SetRenderDrawColor(rend, 255, 255, 255, 255);
-    SDL_RenderDrawLine(rend, plot_x, plot_y + plot_h, plot_x + plot_w, plot_y + plot_h);  // X-axis
-    SDL_RenderDrawLine(rend, plot_x, plot_y, plot_x, plot_y + plot_h);  // Y-axis
+    draw::line(rend, plot_x, plot_y + plot_h, plot_x + plot_w, plot_y + plot_h);  // X-axis
+    draw::line(rend, plot_x, plot_y, plot_x, plot_y + plot_h);  // Y-axis
 
     // X-axis labels (0 and L)
     draw_number(rend, plot_x - 5, plot_y + plot_h + 5, 0.0);
@@ -1345,7 +1550,7 @@ void SDLHeatmap::draw_2d_cell(const std::vector<std::vector<double>>& temps, con
 
     // Y-axis labels (0 and L)
     draw_number(rend, plot_x - 30, plot_y + plot_h - 8, 0.0);
-    draw_number(rend, plot_x - 30, plot_y - 3, info.L);
+    draw_number(rend, plot_x - 30, plot_y - 3, plate_h);
 
     // Axis labels with ΔT for temperature increase (colorbar)
     SDL_SetRenderDrawColor(rend, 180, 180, 180, 255);
@@ -1384,25 +1589,25 @@ void SDLHeatmap::draw_2d_cell(const std::vector<std::vector<double>>& temps, con
     // Bottom-left source
     for (int y = sy1; y < sy2; y += 4) {
         for (int x = sx1; x < sx2; x += 4) {
-            SDL_RenderDrawPoint(rend, x, y);
+            draw::point(rend, x, y);
         }
     }
     // Bottom-right source
     for (int y = sy1; y < sy2; y += 4) {
         for (int x = sx3; x < sx4; x += 4) {
-            SDL_RenderDrawPoint(rend, x, y);
+            draw::point(rend, x, y);
         }
     }
     // Top-left source
     for (int y = sy3; y < sy4; y += 4) {
         for (int x = sx1; x < sx2; x += 4) {
-            SDL_RenderDrawPoint(rend, x, y);
+            draw::point(rend, x, y);
         }
     }
     // Top-right source
     for (int y = sy3; y < sy4; y += 4) {
         for (int x = sx3; x < sx4; x += 4) {
-            SDL_RenderDrawPoint(rend, x, y);
+            draw::point(rend, x, y);
         }
     }
 
@@ -1414,18 +1619,18 @@ void SDLHeatmap::draw_2d_cell(const std::vector<std::vector<double>>& temps, con
     SDL_Rect src_tr = {sx3, sy3, sx4 - sx3, sy4 - sy3};
 
     // Double border for visibility
-    SDL_RenderDrawRect(rend, &src_bl);
-    SDL_RenderDrawRect(rend, &src_br);
-    SDL_RenderDrawRect(rend, &src_tl);
-    SDL_RenderDrawRect(rend, &src_tr);
+    draw::rect(rend, &src_bl);
+    draw::rect(rend, &src_br);
+    draw::rect(rend, &src_tl);
+    draw::rect(rend, &src_tr);
     SDL_Rect src_bl_in = {sx1+1, sy1+1, sx2-sx1-2, sy2-sy1-2};
     SDL_Rect src_br_in = {sx3+1, sy1+1, sx4-sx3-2, sy2-sy1-2};
     SDL_Rect src_tl_in = {sx1+1, sy3+1, sx2-sx1-2, sy4-sy3-2};
     SDL_Rect src_tr_in = {sx3+1, sy3+1, sx4-sx3-2, sy4-sy3-2};
-    SDL_RenderDrawRect(rend, &src_bl_in);
-    SDL_RenderDrawRect(rend, &src_br_in);
-    SDL_RenderDrawRect(rend, &src_tl_in);
-    SDL_RenderDrawRect(rend, &src_tr_in);
+    draw::rect(rend, &src_bl_in);
+    draw::rect(rend, &src_br_in);
+    draw::rect(rend, &src_tl_in);
+    draw::rect(rend, &src_tr_in);
 
     // Find and draw min/max temperature markers
     int min_i = 0, min_j = 0, max_i = 0, max_j = 0;
@@ -1444,7 +1649,7 @@ void SDLHeatmap::draw_2d_cell(const std::vector<std::vector<double>>& temps, con
     for (int dx = -4; dx <= 4; dx++) {
         for (int dy = -4; dy <= 4; dy++) {
             if (dx*dx + dy*dy <= 16 && dx*dx + dy*dy >= 4)
-                SDL_RenderDrawPoint(rend, minx + dx, miny + dy);
+                draw::point(rend, minx + dx, miny + dy);
         }
     }
 
@@ -1455,7 +1660,7 @@ void SDLHeatmap::draw_2d_cell(const std::vector<std::vector<double>>& temps, con
     for (int dx = -4; dx <= 4; dx++) {
         for (int dy = -4; dy <= 4; dy++) {
             if (dx*dx + dy*dy <= 16 && dx*dx + dy*dy >= 4)
-                SDL_RenderDrawPoint(rend, maxx + dx, maxy + dy);
+                draw::point(rend, maxx + dx, maxy + dy);
         }
     }
 
@@ -1469,12 +1674,12 @@ void SDLHeatmap::draw_2d_cell(const std::vector<std::vector<double>>& temps, con
 
     SDL_SetRenderDrawColor(rend, 60, 60, 60, 255);
     SDL_Rect bar_bg = {bar_x, bar_y, bar_w, bar_h};
-    SDL_RenderFillRect(rend, &bar_bg);
+    draw::fill_rect(rend, &bar_bg);
     SDL_SetRenderDrawColor(rend, 80, 180, 80, 255);
     SDL_Rect bar_fg = {bar_x, bar_y, static_cast<int>(bar_w * progress), bar_h};
-    SDL_RenderFillRect(rend, &bar_fg);
+    draw::fill_rect(rend, &bar_fg);
     SDL_SetRenderDrawColor(rend, 200, 200, 200, 255);
-    SDL_RenderDrawRect(rend, &bar_bg);
+    draw::rect(rend, &bar_bg);
 
     // Speed indicator
     char speed_buf[16];
@@ -1491,7 +1696,7 @@ void SDLHeatmap::draw_2d_cell(const std::vector<std::vector<double>>& temps, con
     // Draw border
     SDL_SetRenderDrawColor(rend, 100, 100, 100, 255);
     SDL_Rect border = {plot_x, plot_y, plot_w, plot_h};
-    SDL_RenderDrawRect(rend, &border);
+    draw::rect(rend, &border);
 }
 
 }
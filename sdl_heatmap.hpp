@@ -7,8 +7,10 @@
 #define SDL_HEATMAP_HPP
 
 #include "sdl_window.hpp"
+#include <array>
 #include <vector>
 #include <string>
+#include <utility>
 
 namespace sdl {
 
@@ -23,12 +25,43 @@ struct SimInfo {
     double alpha;               ///< Thermal diffusivity [m²/s]
     double time;                ///< Current simulation time [s]
     double tmax;                ///< Maximum simulation time [s]
-    double L;                   ///< Domain length [m]
+    double L;                   ///< Domain length / plate width [m]
+    double Ly = 0.0;            ///< Plate height [m] (0 = square plate)
     double u0;                  ///< Boundary temperature [K]
     int speed;                  ///< Simulation speed multiplier
     bool paused;                ///< Simulation pause state
 };
 
+/// Bins of the frame time histogram: 4 ms wide, the last one open
+constexpr int HUD_BINS = 8;
+
+/**
+ * @brief Stepping cost of one material's solver, for the performance HUD
+ */
+struct SolverLoad {
+    std::string material_name;  ///< Material of the solver
+    double ms_per_frame;        ///< Stepping time per frame [ms] (smoothed)
+    double steps_per_second;    ///< Steps per second of stepping time
+    int iterations;             ///< Iterations of the last step (-1: direct solve)
+    double residual;            ///< Last convergence measure of the last step [K]
+    long unconverged;           ///< Steps that hit their iteration limit since the last reset
+};
+
+/**
+ * @brief Performance figures shown by the HUD overlay
+ */
+struct PerfInfo {
+    double steps_per_second = 0.0;  ///< Steps of all solvers per wall-clock second
+    double frame_ms = 0.0;          ///< Frame time, stepping and drawing [ms] (smoothed)
+    long draw_calls = 0;            ///< Draw calls of the last frame
+    double memory_mb = -1.0;        ///< Resident memory [MB] (negative: unknown)
+    std::vector<SolverLoad> solvers;                     ///< One per material
+    bool profiled = false;                               ///< Phases are measured (-DHEAT_PROFILE)
+    double step_ms = 0.0;                                ///< Mean step time from the zones [ms]
+    std::vector<std::pair<std::string, double>> phases;  ///< Zones inside a step, ms per step
+    std::array<int, HUD_BINS> frame_histogram{};         ///< Recent frames per bin
+};
+
 /**
  * @class SDLHeatmap
  * @brief Fullscreen temperature visualization
@@ -175,6 +208,12 @@ public:
      * @return Maximum temperature [K]
      */
     double get_max() const { return t_max_; }
+
+    /**
+     * @brief Draw the performance overlay in the top-right corner
+     * @param perf Figures to display
+     */
+    void draw_hud(const PerfInfo& perf) const;
 };
 
 }
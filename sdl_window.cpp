@@ -5,12 +5,15 @@
 
 #include "sdl_window.hpp"
 #include "sdl_core.hpp"
+#include "sdl_draw.hpp"
+#include "profile.hpp"
 
 namespace sdl {
 
 SDLWindow::SDLWindow(const std::string& title, int width, int height, bool fullscreen)
     : window_(nullptr)
     , renderer_(nullptr)
+    , surface_(nullptr)
     , width_(width)
     , height_(height)
     , fullscreen_(fullscreen)
@@ -58,25 +61,49 @@ SDLWindow::SDLWindow(const std::string& title, int width, int height, bool fulls
     }
 }
 
+SDLWindow::SDLWindow(const Offscreen& size)
+    : window_(nullptr)
+    , renderer_(nullptr)
+    , surface_(nullptr)
+    , width_(size.width)
+    , height_(size.height)
+    , fullscreen_(false)
+{
+    surface_ = SDL_CreateRGBSurfaceWithFormat(0, width_, height_, 32, SDL_PIXELFORMAT_ARGB8888);
+    if (!surface_) {
+        throw SDLException("SDL_CreateRGBSurfaceWithFormat failed");
+    }
+
+    renderer_ = SDL_CreateSoftwareRenderer(surface_);
+    if (!renderer_) {
+        SDL_FreeSurface(surface_);
+        throw SDLException("SDL_CreateSoftwareRenderer failed");
+    }
+}
+
 SDLWindow::~SDLWindow() {
     if (renderer_) SDL_DestroyRenderer(renderer_);
     if (window_) SDL_DestroyWindow(window_);
+    if (surface_) SDL_FreeSurface(surface_);
 }
 
 void SDLWindow::clear(Uint8 r, Uint8 g, Uint8 b) {
     SDL_SetRenderDrawColor(renderer_, r, g, b, 255);
-    SDL_RenderClear(renderer_);
+    draw::clear(renderer_);
 }
 
 void SDLWindow::present() {
+    PROFILE_ZONE("present");
     SDL_RenderPresent(renderer_);
 }
 
 void SDLWindow::set_title(const std::string& title) {
+    if (!window_) return;
     SDL_SetWindowTitle(window_, title.c_str());
 }
 
 void SDLWindow::toggle_fullscreen() {
+    if (!window_) return;
     fullscreen_ = !fullscreen_;
     SDL_SetWindowFullscreen(window_, fullscreen_ ? SDL_WINDOW_FULLSCREEN : 0);
     SDL_GetWindowSize(window_, &width_, &height_);
@@ -11,6 +11,15 @@
 
 namespace sdl {
 
+/**
+ * @struct Offscreen
+ * @brief Size of an offscreen render target
+ */
+struct Offscreen {
+    int width;   ///< Width in pixels
+    int height;  ///< Height in pixels
+};
+
 /**
  * @class SDLWindow
  * @brief Encapsulates an SDL window and renderer.
@@ -18,11 +27,15 @@ namespace sdl {
  * This class manages the lifetime of an SDL_Window and SDL_Renderer.
  * It provides helper methods for clearing, presenting, fullscreen
  * toggling, and window title management.
+ *
+ * An offscreen window has no SDL_Window: a software renderer draws into
+ * a surface, so frames can be rendered without a display.
  */
 class SDLWindow {
 private:
     SDL_Window* window_;     ///< SDL window handle
     SDL_Renderer* renderer_; ///< SDL renderer handle
+    SDL_Surface* surface_;   ///< Offscreen target (nullptr for a window)
     int width_;              ///< Window width in pixels
     int height_;             ///< Window height in pixels
     bool fullscreen_;        ///< Fullscreen state
@@ -37,6 +50,14 @@ public:
      */
     SDLWindow(const std::string& title, int width, int height, bool fullscreen = false);
 
+    /**
+     * @brief Construct an offscreen target with a software renderer.
+     *
+     * Needs no video subsystem; title and fullscreen changes are ignored.
+     * @param size Surface size in pixels
+     */
+    explicit SDLWindow(const Offscreen& size);
+
     /**
      * @brief Destroy the SDL window and renderer.
      */
@@ -74,6 +95,11 @@ public:
      */
     bool is_fullscreen() const { return fullscreen_; }
 
+    /**
+     * @brief Check if frames are drawn into an offscreen surface.
+     */
+    bool is_offscreen() const { return surface_ != nullptr; }
+
     /**
      * @brief Get the underlying SDL window.
      */
@@ -0,0 +1,348 @@
+/**
+ * @file source.cpp
+ * @brief Heat source modulations, trajectories and rasterisation.
+ */
+
+#include "source.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace ensiie {
+
+namespace {
+
+/**
+ * @brief One axis of the rasterisation grid.
+ *
+ * Nodes sit at x_i = i·h, or at the given coordinates on a stretched grid.
+ */
+struct Axis {
+    int n;                         ///< Number of nodes
+    double h;                      ///< Uniform spacing
+    const std::vector<double>& x;  ///< Node coordinates (empty: uniform)
+    bool periodic;                 ///< Node n is node 0: no end cells
+
+    /// Coordinate of node i
+    double at(int i) const { return x.empty() ? i * h : x[i]; }
+
+    /// Width of the finite-volume cell around node i (half a cell at the ends)
+    double width(int i) const {
+        const bool end = !periodic && (i == 0 || i == n - 1);
+        if (x.empty()) return end ? 0.5 * h : h;
+        // Periodic: x[n] is the period, and node 0 also borrows from the last interval
+        if (i == 0) return periodic ? 0.5 * (x[1] - x[0] + x[n] - x[n - 1]) : 0.5 * (x[1] - x[0]);
+        if (end) return 0.5 * (x[i] - x[i - 1]);
+        return 0.5 * (x[i + 1] - x[i - 1]);
+    }
+};
+
+/**
+ * @brief Node range [lo, hi] that may lie inside [a, b].
+ *
+ * The range is widened by one node on each side; callers test the exact
+ * membership themselves.
+ */
+void node_range(double a, double b, const Axis& ax, int& lo, int& hi) {
+    if (ax.x.empty()) {
+        lo = std::max(0, static_cast<int>(std::floor(a / ax.h)) - 1);
+        hi = std::min(ax.n - 1, static_cast<int>(std::ceil(b / ax.h)) + 1);
+        return;
+    }
+    auto first = ax.x.begin();
+    lo = std::max(0, static_cast<int>(std::lower_bound(first, first + ax.n, a) - first) - 1);
+    hi = std::min(ax.n - 1, static_cast<int>(std::upper_bound(first, first + ax.n, b) - first));
+}
+
+/**
+ * @brief Exact node range [lo, hi] with a <= x_i <= b (empty if lo > hi).
+ */
+void box_nodes(double a, double b, const Axis& ax, int& lo, int& hi) {
+    const int n = ax.n;
+    if (!ax.x.empty()) {
+        auto first = ax.x.begin();
+        lo = static_cast<int>(std::lower_bound(first, first + n, a) - first);
+        hi = static_cast<int>(std::upper_bound(first, first + n, b) - first) - 1;
+        return;
+    }
+
+    const double h = ax.h;
+    lo = std::clamp(static_cast<int>(std::floor(a / h)), 0, n);
+    while (lo < n && lo * h < a) lo++;
+    while (lo > 0 && (lo - 1) * h >= a) lo--;
+
+    hi = std::clamp(static_cast<int>(std::ceil(b / h)), -1, n - 1);
+    while (hi >= 0 && hi * h > b) hi--;
+    while (hi < n - 1 && (hi + 1) * h <= b) hi++;
+}
+
+/**
+ * @brief Nearest node of x.
+ */
+int nearest_node(double x, const Axis& ax) {
+    if (ax.x.empty()) {
+        int i = static_cast<int>(std::lround(x / ax.h));
+        return std::clamp(i, 0, ax.n - 1);
+    }
+    auto first = ax.x.begin();
+    int i = static_cast<int>(std::lower_bound(first, first + ax.n, x) - first);
+    if (i == ax.n) return ax.n - 1;
+    if (i > 0 && x - ax.x[i - 1] <= ax.x[i] - x) return i - 1;
+    return i;
+}
+
+/**
+ * @brief Check the parameters of a source.
+ * @throws std::invalid_argument on an empty box or a non-positive σ
+ */
+void check_source(const HeatSource& s, bool two_d) {
+    if (s.shape == SourceShape::BOX && (s.x1 < s.x0 || (two_d && s.y1 < s.y0))) {
+        throw std::invalid_argument("heat source box has a negative extent");
+    }
+    if (s.shape == SourceShape::GAUSSIAN && !(s.sigma > 0.0)) {
+        throw std::invalid_argument("gaussian heat source needs sigma > 0");
+    }
+}
+
+/**
+ * @brief Number of entries in exactly one of two sorted index lists.
+ */
+std::size_t count_changes(const std::vector<int>& a, const std::vector<int>& b) {
+    std::size_t count = 0;
+    auto ia = a.begin();
+    auto ib = b.begin();
+    while (ia != a.end() && ib != b.end()) {
+        if (*ia < *ib)      { ++count; ++ia; }
+        else if (*ib < *ia) { ++count; ++ib; }
+        else                { ++ia; ++ib; }
+    }
+    return count + (a.end() - ia) + (b.end() - ib);
+}
+
+} // namespace
+
+namespace trajectory {
+
+Trajectory linear(double x0, double y0, double x1, double y1, double t0, double t1) {
+    return [=](double t) {
+        double s = (t1 > t0) ? std::clamp((t - t0) / (t1 - t0), 0.0, 1.0) : 1.0;
+        return std::make_pair(x0 + s * (x1 - x0), y0 + s * (y1 - y0));
+    };
+}
+
+Trajectory circle(double cx, double cy, double r, double period) {
+    if (!(period > 0.0)) {
+        throw std::invalid_argument("trajectory period must be positive");
+    }
+    const double omega = 2.0 * std::acos(-1.0) / period;
+    return [=](double t) {
+        return std::make_pair(cx + r * std::cos(omega * t), cy + r * std::sin(omega * t));
+    };
+}
+
+} // namespace trajectory
+
+namespace modulation {
+
+std::function<double(double)> pulsed(double period, double duty, double delay) {
+    if (!(period > 0.0)) {
+        throw std::invalid_argument("pulse period must be positive");
+    }
+    return [period, duty, delay](double t) {
+        if (t < delay) return 0.0;
+        double phase = std::fmod(t - delay, period) / period;
+        return phase < duty ? 1.0 : 0.0;
+    };
+}
+
+std::function<double(double)> ramp(double t_ramp) {
+    return [t_ramp](double t) {
+        if (t_ramp <= 0.0 || t >= t_ramp) return 1.0;
+        return std::max(0.0, t / t_ramp);
+    };
+}
+
+} // namespace modulation
+
+void SparseSource::fill(const HeatSource& s, const Grid& g, Term& term) {
+    const bool two_d = g.ny > 1;
+    const Axis ax{g.nx, g.dx, g.x, g.px};
+    const Axis ay{g.ny, g.dy, g.y, g.py};
+    term.index.clear();
+    term.weight.clear();
+
+    if (s.shape == SourceShape::POINT) {
+        int i = nearest_node(s.x0, ax);
+        int j = two_d ? nearest_node(s.y0, ay) : 0;
+        term.index.push_back(j * g.nx + i);
+        term.weight.push_back(two_d ? s.intensity / (ax.width(i) * ay.width(j))
+                                    : s.intensity / ax.width(i));
+        return;
+    }
+
+    if (s.shape == SourceShape::BOX) {
+        int key[4];
+        block(s, g, key);
+        for (int j = key[2]; j <= key[3]; j++) {
+            for (int i = key[0]; i <= key[1]; i++) {
+                term.index.push_back(j * g.nx + i);
+                term.weight.push_back(s.intensity);
+            }
+        }
+        return;
+    }
+
+    // Gaussian, cut at GAUSSIAN_CUTOFF·σ
+    const double cut = GAUSSIAN_CUTOFF * s.sigma;
+    int i0, i1, j0 = 0, j1 = 0;
+    node_range(s.x0 - cut, s.x0 + cut, ax, i0, i1);
+    if (two_d) node_range(s.y0 - cut, s.y0 + cut, ay, j0, j1);
+
+    for (int j = j0; j <= j1; j++) {
+        double ry = two_d ? (ay.at(j) - s.y0) / s.sigma : 0.0;
+        for (int i = i0; i <= i1; i++) {
+            double rx = (ax.at(i) - s.x0) / s.sigma;
+            double r2 = rx * rx + ry * ry;
+            if (r2 > GAUSSIAN_CUTOFF * GAUSSIAN_CUTOFF) continue;
+            term.index.push_back(j * g.nx + i);
+            term.weight.push_back(s.intensity * std::exp(-0.5 * r2));
+        }
+    }
+}
+
+void SparseSource::block(const HeatSource& s, const Grid& g, int key[4]) {
+    const bool two_d = g.ny > 1;
+    const Axis ax{g.nx, g.dx, g.x, g.px};
+    const Axis ay{g.ny, g.dy, g.y, g.py};
+    key[2] = key[3] = 0;
+
+    if (s.shape == SourceShape::POINT) {
+        key[0] = key[1] = nearest_node(s.x0, ax);
+        if (two_d) key[2] = key[3] = nearest_node(s.y0, ay);
+    } else {
+        box_nodes(s.x0, s.x1, ax, key[0], key[1]);
+        if (two_d) box_nodes(s.y0, s.y1, ay, key[2], key[3]);
+    }
+}
+
+void SparseSource::rasterise_1d(const std::vector<HeatSource>& sources, int n, double dx,
+                                const std::vector<double>& x, bool periodic) {
+    Grid g;
+    g.nx = n;
+    g.dx = dx;
+    g.x = x;
+    g.px = periodic;
+
+    terms_.clear();
+    terms_.reserve(sources.size());
+    for (const HeatSource& s : sources) {
+        check_source(s, false);
+        Term term;
+        term.amplitude = s.amplitude;
+        fill(s, g, term);
+        if (!term.index.empty()) terms_.push_back(std::move(term));
+    }
+}
+
+void SparseSource::rasterise_2d(const std::vector<HeatSource>& sources,
+                                int nx, int ny, double dx, double dy,
+                                const std::vector<double>& x, const std::vector<double>& y,
+                                bool px, bool py) {
+    Grid g;
+    g.nx = nx;
+    g.ny = ny;
+    g.dx = dx;
+    g.dy = dy;
+    g.x = x;
+    g.y = y;
+    g.px = px;
+    g.py = py;
+
+    terms_.clear();
+    terms_.reserve(sources.size());
+    for (const HeatSource& s : sources) {
+        check_source(s, true);
+        Term term;
+        term.amplitude = s.amplitude;
+        fill(s, g, term);
+        if (!term.index.empty()) terms_.push_back(std::move(term));
+    }
+}
+
+void SparseSource::set_moving_1d(const std::vector<MovingSource>& sources, int n, double dx,
+                                 const std::vector<double>& x, bool periodic) {
+    set_moving_2d(sources, n, 1, dx, 0.0, x, {}, periodic);
+}
+
+void SparseSource::set_moving_2d(const std::vector<MovingSource>& sources,
+                                 int nx, int ny, double dx, double dy,
+                                 const std::vector<double>& x, const std::vector<double>& y,
+                                 bool px, bool py) {
+    grid_.nx = nx;
+    grid_.ny = ny;
+    grid_.dx = dx;
+    grid_.dy = dy;
+    grid_.x = x;
+    grid_.y = y;
+    grid_.px = px;
+    grid_.py = py;
+
+    moving_.clear();
+    moving_.reserve(sources.size());
+    for (const MovingSource& src : sources) {
+        check_source(src.footprint, ny > 1);
+        if (!src.path) {
+            throw std::invalid_argument("moving heat source needs a trajectory");
+        }
+        Moving mov;
+        mov.footprint = src.footprint;
+        mov.path = src.path;
+        mov.term.amplitude = src.footprint.amplitude;
+        moving_.push_back(std::move(mov));
+    }
+    changes_ = 0;
+}
+
+void SparseSource::move_to(double t) {
+    changes_ = 0;
+    Term next;
+
+    for (Moving& mov : moving_) {
+        auto [cx, cy] = mov.path(t);
+
+        HeatSource s = mov.footprint;
+        s.x0 += cx;
+        s.x1 += cx;
+        s.y0 += cy;
+        s.y1 += cy;
+
+        // Uniform footprints: nothing to do while the covered block is unchanged
+        if (s.shape != SourceShape::GAUSSIAN) {
+            int key[4];
+            block(s, grid_, key);
+            if (std::equal(key, key + 4, mov.key)) continue;
+            std::copy(key, key + 4, mov.key);
+        }
+
+        fill(s, grid_, next);
+        changes_ += count_changes(mov.term.index, next.index);
+        mov.term.index.swap(next.index);
+        mov.term.weight.swap(next.weight);
+    }
+}
+
+std::size_t SparseSource::nnz() const {
+    std::size_t count = 0;
+    for (const Term& term : terms_) count += term.index.size();
+    for (const Moving& mov : moving_) count += mov.term.index.size();
+    return count;
+}
+
+std::vector<double> SparseSource::footprint(std::size_t s, std::size_t n, double coef) const {
+    std::vector<double> f(n, 0.0);
+    const Term& term = terms_[s];
+    for (std::size_t m = 0; m < term.index.size(); m++) f[term.index[m]] += coef * term.weight[m];
+    return f;
+}
+
+} // namespace ensiie
@@ -0,0 +1,332 @@
+/**
+ * @file source.hpp
+ * @brief Heat source shapes and their sparse rasterisation.
+ *
+ * A heat source is described by a shape (box, Gaussian or point), an
+ * intensity and an optional amplitude modulation a(t). The solvers do
+ * not store a dense source field: every source is rasterised once into
+ * a list of (index, weight) pairs covering only the nodes it touches,
+ * and each step adds a(t)·weight to the right-hand side of those nodes.
+ *
+ * Units:
+ * - Box and Gaussian intensities are volumetric powers [W/m³]
+ *   (peak value for the Gaussian)
+ * - Point powers are per unit cross-section [W/m²] in 1D and per unit
+ *   thickness [W/m] in 2D; they are spread over the nearest node cell
+ *   (whose size varies on a stretched grid, see grid.hpp)
+ *
+ * Moving sources (laser, weld torch) carry a footprint defined around
+ * the origin and a trajectory giving its centre over time. Their node
+ * lists are updated in place as the footprint travels.
+ */
+
+#ifndef SOURCE_HPP
+#define SOURCE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace ensiie {
+
+/// Gaussian sources are cut at this many standard deviations
+constexpr double GAUSSIAN_CUTOFF = 3.0;
+
+/**
+ * @brief Geometry of a heat source
+ */
+enum class SourceShape {
+    BOX,       ///< Uniform intensity over [x0, x1] × [y0, y1]
+    GAUSSIAN,  ///< exp(-r² / 2σ²) profile around (x0, y0), cut at 3σ
+    POINT      ///< Concentrated power at (x0, y0)
+};
+
+/**
+ * @struct HeatSource
+ * @brief Runtime description of one heat source.
+ *
+ * 1D solvers only use the x coordinates.
+ */
+struct HeatSource {
+    SourceShape shape = SourceShape::BOX;  ///< Geometry
+    double x0 = 0.0;         ///< Box start / centre along x [m]
+    double x1 = 0.0;         ///< Box end along x [m]
+    double y0 = 0.0;         ///< Box start / centre along y [m]
+    double y1 = 0.0;         ///< Box end along y [m]
+    double sigma = 0.0;      ///< Gaussian standard deviation [m]
+    double intensity = 0.0;  ///< Power density (see file header for units)
+    std::function<double(double)> amplitude;  ///< Modulation a(t), 1 if unset
+
+    /**
+     * @brief Modulation factor at time t
+     */
+    double amplitude_at(double t) const { return amplitude ? amplitude(t) : 1.0; }
+
+    /**
+     * @brief Attach a modulation a(t) to the source
+     * @return *this, for chaining with the factories
+     */
+    HeatSource& modulate(std::function<double(double)> a) {
+        amplitude = std::move(a);
+        return *this;
+    }
+
+    /// Uniform source over [x0, x1] (1D)
+    static HeatSource box(double x0, double x1, double intensity) {
+        return box(x0, x1, 0.0, 0.0, intensity);
+    }
+
+    /// Uniform source over [x0, x1] × [y0, y1] (2D)
+    static HeatSource box(double x0, double x1, double y0, double y1, double intensity) {
+        HeatSource s;
+        s.shape = SourceShape::BOX;
+        s.x0 = x0;
+        s.x1 = x1;
+        s.y0 = y0;
+        s.y1 = y1;
+        s.intensity = intensity;
+        return s;
+    }
+
+    /// Gaussian source centred on (cx, cy) with peak intensity
+    static HeatSource gaussian(double cx, double cy, double sigma, double peak) {
+        HeatSource s;
+        s.shape = SourceShape::GAUSSIAN;
+        s.x0 = cx;
+        s.y0 = cy;
+        s.sigma = sigma;
+        s.intensity = peak;
+        return s;
+    }
+
+    /// Concentrated source at (x, y)
+    static HeatSource point(double x, double y, double power) {
+        HeatSource s;
+        s.shape = SourceShape::POINT;
+        s.x0 = x;
+        s.y0 = y;
+        s.intensity = power;
+        return s;
+    }
+};
+
+/**
+ * @brief Position (x, y) [m] of a moving source centre at time t
+ */
+using Trajectory = std::function<std::pair<double, double>(double)>;
+
+/**
+ * @struct MovingSource
+ * @brief Heat source whose footprint follows a trajectory.
+ *
+ * The footprint coordinates are relative to the centre, e.g.
+ * HeatSource::gaussian(0, 0, σ, peak) for a laser spot or
+ * HeatSource::box(-w/2, w/2, -w/2, w/2, q) for a top-hat torch.
+ * The footprint amplitude a(t) still applies.
+ */
+struct MovingSource {
+    HeatSource footprint;  ///< Shape centred on the origin
+    Trajectory path;       ///< Centre position over time
+};
+
+/**
+ * @namespace trajectory
+ * @brief Common paths for MovingSource.
+ */
+namespace trajectory {
+
+/**
+ * @brief Straight pass from (x0, y0) at t0 to (x1, y1) at t1, parked at the ends.
+ */
+Trajectory linear(double x0, double y0, double x1, double y1, double t0, double t1);
+
+/**
+ * @brief Circle of radius r around (cx, cy), one turn per period.
+ */
+Trajectory circle(double cx, double cy, double r, double period);
+
+} // namespace trajectory
+
+/**
+ * @namespace modulation
+ * @brief Common amplitude functions a(t) for HeatSource::modulate.
+ */
+namespace modulation {
+
+/**
+ * @brief Square pulses: 1 during the first duty·period of every period, 0 otherwise.
+ */
+std::function<double(double)> pulsed(double period, double duty, double delay = 0.0);
+
+/**
+ * @brief Linear ramp from 0 at t = 0 to 1 at t = t_ramp, then constant.
+ */
+std::function<double(double)> ramp(double t_ramp);
+
+} // namespace modulation
+
+/**
+ * @class SparseSource
+ * @brief Rasterised heat sources as sparse (index, weight) lists.
+ *
+ * Each source keeps its own list so that its amplitude is evaluated once
+ * per step. Memory and per-step cost are proportional to the number of
+ * nodes covered by the sources, not to the grid size.
+ */
+class SparseSource {
+public:
+    /**
+     * @brief Rasterise sources on a 1D grid of n nodes x_i = i·dx.
+     *
+     * A point source spreads its power over the finite-volume cell of its
+     * node, which is half a spacing wide at a non-periodic end.
+     *
+     * @param x Node coordinates of a stretched grid (empty: uniform spacing)
+     * @param periodic Node n is node 0 (the end nodes have whole cells)
+     */
+    void rasterise_1d(const std::vector<HeatSource>& sources, int n, double dx,
+                      const std::vector<double>& x = {}, bool periodic = false);
+
+    /**
+     * @brief Rasterise sources on a 2D grid, node (i, j) at index j·nx + i.
+     *
+     * @param x, y Node coordinates of a stretched grid (empty: uniform spacing)
+     * @param px, py Periodic along x / y
+     */
+    void rasterise_2d(const std::vector<HeatSource>& sources,
+                      int nx, int ny, double dx, double dy,
+                      const std::vector<double>& x = {}, const std::vector<double>& y = {},
+                      bool px = false, bool py = false);
+
+    /**
+     * @brief Install moving sources on a 1D grid (the path's x coordinate is used).
+     */
+    void set_moving_1d(const std::vector<MovingSource>& sources, int n, double dx,
+                       const std::vector<double>& x = {}, bool periodic = false);
+
+    /**
+     * @brief Install moving sources on a 2D grid.
+     */
+    void set_moving_2d(const std::vector<MovingSource>& sources,
+                       int nx, int ny, double dx, double dy,
+                       const std::vector<double>& x = {}, const std::vector<double>& y = {},
+                       bool px = false, bool py = false);
+
+    /**
+     * @brief Move every moving footprint to its position at time t.
+     *
+     * Uniform footprints (box, point) are only re-rasterised when the set
+     * of covered nodes changes, which costs O(1) while the source stays
+     * within the same cells; Gaussian footprints have position-dependent
+     * weights and are refreshed every call.
+     */
+    void move_to(double t);
+
+    /**
+     * @brief Nodes that entered or left a moving footprint during the last move_to().
+     */
+    std::size_t last_changes() const { return changes_; }
+
+    /**
+     * @brief Add coef · a(t) · weight to the right-hand side of every covered node.
+     *
+     * @param rhs Right-hand side (any floating-point element type)
+     * @param t Time at which the amplitudes are evaluated
+     * @param coef Scaling of the power density (Δt / ρc)
+     */
+    template <typename T>
+    void add_to(std::vector<T>& rhs, double t, double coef) const {
+        for (const Term& term : terms_) {
+            double a = coef * term.amplitude_at(t);
+            if (a == 0.0) continue;
+            for (std::size_t m = 0; m < term.index.size(); m++) {
+                rhs[term.index[m]] += static_cast<T>(a * term.weight[m]);
+            }
+        }
+        for (const Moving& mov : moving_) {
+            double a = coef * mov.term.amplitude_at(t);
+            if (a == 0.0) continue;
+            for (std::size_t m = 0; m < mov.term.index.size(); m++) {
+                rhs[mov.term.index[m]] += static_cast<T>(a * mov.term.weight[m]);
+            }
+        }
+    }
+
+    /**
+     * @brief Number of stored (index, weight) pairs.
+     */
+    std::size_t nnz() const;
+
+    /**
+     * @brief Number of fixed sources (sources covering no node are dropped).
+     */
+    std::size_t size() const { return terms_.size(); }
+
+    /**
+     * @brief Whether moving sources are installed.
+     */
+    bool has_moving() const { return !moving_.empty(); }
+
+    /**
+     * @brief Dense footprint coef · weight of fixed source s, without its amplitude.
+     *
+     * @param n Number of grid nodes
+     */
+    std::vector<double> footprint(std::size_t s, std::size_t n, double coef) const;
+
+    /**
+     * @brief Modulation a(t) of fixed source s (empty: constant).
+     */
+    const std::function<double(double)>& modulation(std::size_t s) const { return terms_[s].amplitude; }
+
+    /**
+     * @brief Remove every source.
+     */
+    void clear() {
+        terms_.clear();
+        moving_.clear();
+    }
+
+private:
+    /// Footprint of one source
+    struct Term {
+        std::vector<int> index;      ///< Covered nodes
+        std::vector<double> weight;  ///< Power density at each node [W/m³]
+        std::function<double(double)> amplitude;  ///< Modulation a(t)
+
+        double amplitude_at(double t) const { return amplitude ? amplitude(t) : 1.0; }
+    };
+
+    /// Moving footprint and the node block it covered last
+    struct Moving {
+        HeatSource footprint;  ///< Shape centred on the origin
+        Trajectory path;       ///< Centre position over time
+        Term term;             ///< Current node list
+        int key[4] = {-1, -1, -1, -1};  ///< Covered node block (i0, i1, j0, j1)
+    };
+
+    /// Grid on which the sources are rasterised
+    struct Grid {
+        int nx = 0;         ///< Nodes along x
+        int ny = 1;         ///< Nodes along y (1 in 1D)
+        double dx = 0.0;    ///< Spacing along x
+        double dy = 0.0;    ///< Spacing along y
+        std::vector<double> x;  ///< Node coordinates along x (empty: uniform)
+        std::vector<double> y;  ///< Node coordinates along y (empty: uniform)
+        bool px = false;        ///< Periodic along x
+        bool py = false;        ///< Periodic along y
+    };
+
+    static void fill(const HeatSource& s, const Grid& g, Term& term);
+    static void block(const HeatSource& s, const Grid& g, int key[4]);
+
+    std::vector<Term> terms_;     ///< One footprint per fixed source
+    std::vector<Moving> moving_;  ///< Moving sources
+    Grid grid_;                   ///< Grid of the moving sources
+    std::size_t changes_ = 0;     ///< Nodes changed by the last move_to()
+};
+
+} // namespace ensiie
+
+#endif
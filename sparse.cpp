@@ -0,0 +1,136 @@
+/**
+ * @file sparse.cpp
+ * @brief CSR and SELL-C-σ storage and products.
+ */
+
+#include "sparse.hpp"
+#include "parallel.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+
+namespace ensiie {
+
+void CsrMatrix::apply(const std::vector<double>& x, std::vector<double>& y) const {
+    y.resize(n);
+    parallel::for_range(n, [&](int begin, int end) {
+        for (int i = begin; i < end; i++) {
+            double s = 0.0;
+            for (int k = row_ptr[i]; k < row_ptr[i + 1]; k++) s += val[k] * x[col[k]];
+            y[i] = s;
+        }
+    });
+}
+
+int CsrMatrix::find(int i, int j) const {
+    auto first = col.begin() + row_ptr[i];
+    auto last = col.begin() + row_ptr[i + 1];
+    auto it = std::lower_bound(first, last, j);
+    return (it != last && *it == j) ? static_cast<int>(it - col.begin()) : -1;
+}
+
+std::vector<double> CsrMatrix::diagonal() const {
+    std::vector<double> d(n, 0.0);
+    for (int i = 0; i < n; i++) {
+        int k = find(i, i);
+        if (k >= 0) d[i] = val[k];
+    }
+    return d;
+}
+
+int CsrMatrix::bandwidth() const {
+    int band = 0;
+    for (int i = 0; i < n; i++) {
+        for (int k = row_ptr[i]; k < row_ptr[i + 1]; k++) band = std::max(band, std::abs(col[k] - i));
+    }
+    return band;
+}
+
+CsrMatrix CsrMatrix::transpose() const {
+    CsrMatrix t;
+    t.n = n;
+    t.row_ptr.assign(n + 1, 0);
+    for (int c : col) t.row_ptr[c + 1]++;
+    for (int i = 0; i < n; i++) t.row_ptr[i + 1] += t.row_ptr[i];
+    t.col.resize(col.size());
+    t.val.resize(val.size());
+
+    // Rows are visited in order, so the columns of t come out sorted
+    std::vector<int> next(t.row_ptr.begin(), t.row_ptr.end() - 1);
+    for (int i = 0; i < n; i++) {
+        for (int k = row_ptr[i]; k < row_ptr[i + 1]; k++) {
+            const int m = next[col[k]]++;
+            t.col[m] = i;
+            t.val[m] = val[k];
+        }
+    }
+    return t;
+}
+
+SellMatrix::SellMatrix(const CsrMatrix& A, int sigma)
+    : n_(A.n)
+    , nnz_(A.nnz())
+{
+    constexpr int C = SELL_CHUNK;
+    const int chunks = (n_ + C - 1) / C;
+    sigma = std::max(1, (sigma + C - 1) / C * C);
+
+    // Rows sorted by decreasing length within each window of σ rows
+    std::vector<int> order(n_);
+    std::iota(order.begin(), order.end(), 0);
+    auto length = [&](int i) { return A.row_ptr[i + 1] - A.row_ptr[i]; };
+    if (sigma > 1) {
+        for (int w = 0; w < n_; w += sigma) {
+            std::stable_sort(order.begin() + w, order.begin() + std::min(n_, w + sigma),
+                             [&](int a, int b) { return length(a) > length(b); });
+        }
+    }
+
+    row_.assign(chunks * C, -1);
+    chunk_ptr_.assign(chunks + 1, 0);
+    chunk_len_.assign(chunks, 0);
+    for (int c = 0; c < chunks; c++) {
+        int len = 0;
+        for (int r = 0; r < C && c * C + r < n_; r++) {
+            row_[c * C + r] = order[c * C + r];
+            len = std::max(len, length(order[c * C + r]));
+        }
+        chunk_len_[c] = len;
+        chunk_ptr_[c + 1] = chunk_ptr_[c] + len * C;
+    }
+
+    col_.assign(chunk_ptr_[chunks], 0);
+    val_.assign(chunk_ptr_[chunks], 0.0);
+    for (int c = 0; c < chunks; c++) {
+        for (int r = 0; r < C; r++) {
+            const int i = row_[c * C + r];
+            if (i < 0) continue;
+            for (int m = 0; m < length(i); m++) {
+                col_[chunk_ptr_[c] + m * C + r] = A.col[A.row_ptr[i] + m];
+                val_[chunk_ptr_[c] + m * C + r] = A.val[A.row_ptr[i] + m];
+            }
+        }
+    }
+}
+
+void SellMatrix::apply(const std::vector<double>& x, std::vector<double>& y) const {
+    constexpr int C = SELL_CHUNK;
+    y.resize(n_);
+    const int chunks = static_cast<int>(chunk_len_.size());
+    parallel::for_range(chunks, [&](int begin, int end) {
+        for (int c = begin; c < end; c++) {
+            double s[C] = {};
+            const int* col = col_.data() + chunk_ptr_[c];
+            const double* val = val_.data() + chunk_ptr_[c];
+            for (int m = 0; m < chunk_len_[c]; m++) {
+                for (int r = 0; r < C; r++) s[r] += val[m * C + r] * x[col[m * C + r]];
+            }
+            for (int r = 0; r < C; r++) {
+                const int i = row_[c * C + r];
+                if (i >= 0) y[i] = s[r];
+            }
+        }
+    });
+}
+
+} // namespace ensiie
@@ -0,0 +1,397 @@
+/**
+ * @file uq.cpp
+ * @brief Sampling, streaming statistics and batched ensemble runs.
+ */
+
+#include "uq.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <thread>
+
+namespace ensiie {
+
+namespace {
+
+/**
+ * @brief Primitive polynomial degree s, coefficients a and initial m_k of
+ *        Sobol dimensions 2..16 (Joe & Kuo, new-joe-kuo-6.21201).
+ */
+struct DirectionSeed {
+    int s;
+    unsigned a;
+    std::uint32_t m[6];
+};
+
+constexpr DirectionSeed DIRECTION_SEEDS[SobolSequence::MAX_DIMENSIONS - 1] = {
+    {1, 0, {1}},
+    {2, 1, {1, 3}},
+    {3, 1, {1, 3, 1}},
+    {3, 2, {1, 1, 1}},
+    {4, 1, {1, 1, 3, 3}},
+    {4, 4, {1, 3, 5, 13}},
+    {5, 2, {1, 1, 5, 5, 17}},
+    {5, 4, {1, 1, 5, 5, 5}},
+    {5, 7, {1, 1, 7, 11, 19}},
+    {5, 11, {1, 1, 5, 1, 1}},
+    {5, 13, {1, 1, 1, 3, 11}},
+    {5, 14, {1, 3, 5, 5, 31}},
+    {6, 1, {1, 3, 3, 9, 7, 49}},
+    {6, 13, {1, 1, 1, 15, 21, 21}},
+    {6, 16, {1, 3, 1, 13, 27, 49}},
+};
+
+/**
+ * @brief Standard normal quantile: Acklam's rational approximation and one Halley step.
+ */
+double normal_quantile(double p) {
+    static const double a[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                               1.383577518672690e+02, -3.066479806614716e+01, 2.506628277459239e+00};
+    static const double b[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                               6.680131188771972e+01, -1.328068155288572e+01};
+    static const double c[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                               -2.549732539343734e+00, 4.374664141464968e+00, 2.938163982698783e+00};
+    static const double d[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                               3.754408661907416e+00};
+    constexpr double P_LOW = 0.02425;
+
+    double x;
+    if (p < P_LOW || p > 1.0 - P_LOW) {
+        const double q = std::sqrt(-2.0 * std::log(std::min(p, 1.0 - p)));
+        x = (((((c[0] * q + c[1]) * q + c[2]) * q + c[3]) * q + c[4]) * q + c[5]) /
+            ((((d[0] * q + d[1]) * q + d[2]) * q + d[3]) * q + 1.0);
+        if (p > 0.5) x = -x;
+    } else {
+        const double q = p - 0.5;
+        const double r = q * q;
+        x = (((((a[0] * r + a[1]) * r + a[2]) * r + a[3]) * r + a[4]) * r + a[5]) * q /
+            (((((b[0] * r + b[1]) * r + b[2]) * r + b[3]) * r + b[4]) * r + 1.0);
+    }
+
+    const double e = 0.5 * std::erfc(-x / std::sqrt(2.0)) - p;
+    const double u = e * std::sqrt(2.0 * std::acos(-1.0)) * std::exp(0.5 * x * x);
+    return x - u / (1.0 + 0.5 * x * u);
+}
+
+/**
+ * @brief Point in (0, 1)^d of member `index`.
+ */
+std::vector<double> unit_point(const UqOptions& options, const SobolSequence* sobol, int dims,
+                               std::uint64_t index) {
+    if (sobol) return sobol->point(index);
+    std::seed_seq seq{options.seed, static_cast<unsigned>(index), static_cast<unsigned>(index >> 32)};
+    std::mt19937_64 engine(seq);
+    std::vector<double> u(dims);
+    for (double& v : u) v = (static_cast<double>(engine() >> 11) + 0.5) * 0x1.0p-53;
+    return u;
+}
+
+/**
+ * @brief Batched ensemble runs shared by bars and plates.
+ *
+ * @tparam Ensemble EnsembleHeatSolver1D or EnsembleHeatSolver2D
+ * @param probe probe(ensemble, m, p): temperature of member m at probe p
+ * @param grid grid(ensemble, result): node coordinates of the result
+ */
+template <typename Ensemble, typename Factory, typename Probe, typename Grid>
+UqResult propagate(const Factory& make, const std::vector<Distribution>& inputs, int nprobe,
+                   const Probe& probe, const Grid& grid, const UqOptions& options) {
+    if (options.members < 1 || options.batch < 1 || options.stride < 1) {
+        throw std::invalid_argument("uncertainty propagation options out of range");
+    }
+    for (double p : options.probabilities) {
+        if (!(p > 0.0 && p < 1.0)) throw std::invalid_argument("quantile probabilities must lie in (0, 1)");
+    }
+    const int dims = static_cast<int>(inputs.size());
+    std::unique_ptr<SobolSequence> sobol;
+    if (options.sampling == Sampling::SOBOL && dims > 0) {
+        sobol = std::make_unique<SobolSequence>(dims, options.seed);
+    }
+
+    const int batches = (options.members + options.batch - 1) / options.batch;
+    const int threads = std::min(batches, options.threads > 0
+        ? options.threads : std::max(1, static_cast<int>(std::thread::hardware_concurrency())));
+
+    // Statistics, created by the first batch folded in (sizes come from the run)
+    UqResult result;
+    std::unique_ptr<StreamingStatistics> field;
+    std::vector<StreamingStatistics> series;
+
+    std::mutex mutex;
+    std::condition_variable turn;
+    int folded = 0;             // Batches folded in so far
+    std::exception_ptr error;
+    std::atomic<int> next{0};
+
+    auto work = [&] {
+        for (int b = next++; b < batches; b = next++) {
+            std::vector<double> final_fields, records, times;
+            int k = 0, n = 0;
+            try {
+                const int first = b * options.batch;
+                k = std::min(options.batch, options.members - first);
+                std::vector<decltype(make(std::vector<double>()))> members;
+                for (int m = 0; m < k; m++) {
+                    const std::vector<double> u = unit_point(options, sobol.get(), dims, first + m);
+                    std::vector<double> sample(dims);
+                    for (int i = 0; i < dims; i++) sample[i] = inputs[i].quantile(u[i]);
+                    members.push_back(make(sample));
+                }
+
+                // records[(r·P + p)·K + m]: probe p of member m at record r
+                Ensemble ensemble(members);
+                members.clear();
+                for (int s = 1; ensemble.step(); s++) {
+                    if (s % options.stride != 0 && ensemble.get_time() < ensemble.get_tmax()) continue;
+                    times.push_back(ensemble.get_time());
+                    for (int p = 0; p < nprobe; p++) {
+                        for (int m = 0; m < k; m++) records.push_back(probe(ensemble, m, p));
+                    }
+                }
+                for (int m = 0; m < k; m++) {
+                    const std::vector<double> u = ensemble.get_temperature(m);
+                    n = static_cast<int>(u.size());
+                    final_fields.insert(final_fields.end(), u.begin(), u.end());
+                }
+                if (b == 0) grid(ensemble, result);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) error = std::current_exception();
+                turn.notify_all();
+                return;
+            }
+
+            // Fold in batch order, so that the results do not depend on the threads
+            std::unique_lock<std::mutex> lock(mutex);
+            turn.wait(lock, [&] { return folded == b || error; });
+            if (error) return;
+            if (b == 0) {
+                field = std::make_unique<StreamingStatistics>(n, options.probabilities);
+                series.assign(nprobe, StreamingStatistics(static_cast<int>(times.size()), options.probabilities));
+                result.times = times;
+            }
+            std::vector<double> values(times.size());
+            for (int m = 0; m < k; m++) {
+                field->add(&final_fields[static_cast<std::size_t>(m) * n]);
+                for (int p = 0; p < nprobe; p++) {
+                    for (std::size_t r = 0; r < times.size(); r++) values[r] = records[(r * nprobe + p) * k + m];
+                    series[p].add(values.data());
+                }
+            }
+            folded++;
+            turn.notify_all();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int w = 1; w < threads; w++) pool.emplace_back(work);
+    work();
+    for (std::thread& t : pool) t.join();
+    if (error) std::rethrow_exception(error);
+
+    result.members = options.members;
+    result.field = field->result();
+    for (const StreamingStatistics& s : series) result.probes.push_back(s.result());
+    return result;
+}
+
+} // namespace
+
+// =============================================================================
+// SAMPLING
+// =============================================================================
+
+double Distribution::quantile(double u) const {
+    switch (kind) {
+        case DistributionKind::FIXED:     return a;
+        case DistributionKind::UNIFORM:   return a + u * (b - a);
+        case DistributionKind::NORMAL:    return a + b * normal_quantile(u);
+        case DistributionKind::LOGNORMAL: return a * std::exp(b * normal_quantile(u));
+    }
+    return a;
+}
+
+SobolSequence::SobolSequence(int dimensions, unsigned seed)
+    : dims_(dimensions)
+{
+    if (dimensions < 1 || dimensions > MAX_DIMENSIONS) {
+        throw std::invalid_argument("Sobol sequence supports 1 to 16 dimensions");
+    }
+    v_.assign(static_cast<std::size_t>(dims_) * 32, 0);
+    for (int k = 0; k < 32; k++) v_[k] = 1u << (31 - k);
+    for (int d = 1; d < dims_; d++) {
+        const DirectionSeed& ds = DIRECTION_SEEDS[d - 1];
+        std::uint32_t* v = &v_[static_cast<std::size_t>(d) * 32];
+        for (int k = 0; k < ds.s; k++) v[k] = ds.m[k] << (31 - k);
+        for (int k = ds.s; k < 32; k++) {
+            v[k] = v[k - ds.s] ^ (v[k - ds.s] >> ds.s);
+            for (int l = 1; l < ds.s; l++) {
+                if ((ds.a >> (ds.s - 1 - l)) & 1u) v[k] ^= v[k - l];
+            }
+        }
+    }
+
+    shift_.assign(dims_, 0);
+    if (seed != 0) {
+        std::mt19937 engine(seed);
+        for (std::uint32_t& s : shift_) s = static_cast<std::uint32_t>(engine());
+    }
+}
+
+std::vector<double> SobolSequence::point(std::uint64_t index) const {
+    const std::uint64_t gray = index ^ (index >> 1);
+    std::vector<double> u(dims_);
+    for (int d = 0; d < dims_; d++) {
+        std::uint32_t x = shift_[d];
+        for (int k = 0; k < 32; k++) {
+            if ((gray >> k) & 1u) x ^= v_[static_cast<std::size_t>(d) * 32 + k];
+        }
+        u[d] = (static_cast<double>(x) + 0.5) * 0x1.0p-32;
+    }
+    return u;
+}
+
+// =============================================================================
+// STREAMING STATISTICS
+// =============================================================================
+
+P2Quantile::P2Quantile(double p)
+    : p_(p)
+    , count_(0)
+    , q_{}
+    , n_{0.0, 1.0, 2.0, 3.0, 4.0}
+    , want_{0.0, 2.0 * p, 4.0 * p, 2.0 + 2.0 * p, 4.0}
+    , step_{0.0, 0.5 * p, p, 0.5 * (1.0 + p), 1.0}
+{
+}
+
+void P2Quantile::add(double x) {
+    if (count_ < 5) {
+        // Keep the first observations sorted
+        int i = static_cast<int>(count_++);
+        while (i > 0 && q_[i - 1] > x) {
+            q_[i] = q_[i - 1];
+            i--;
+        }
+        q_[i] = x;
+        return;
+    }
+    count_++;
+
+    // Cell of x; the extreme markers track the minimum and maximum
+    int k;
+    if (x < q_[0]) {
+        q_[0] = x;
+        k = 0;
+    } else if (x >= q_[4]) {
+        q_[4] = x;
+        k = 3;
+    } else {
+        k = 0;
+        while (x >= q_[k + 1]) k++;
+    }
+    for (int i = k + 1; i < 5; i++) n_[i] += 1.0;
+    for (int i = 0; i < 5; i++) want_[i] += step_[i];
+
+    // Move the middle markers towards their desired positions
+    for (int i = 1; i < 4; i++) {
+        const double d = want_[i] - n_[i];
+        if ((d >= 1.0 && n_[i + 1] - n_[i] > 1.0) || (d <= -1.0 && n_[i - 1] - n_[i] < -1.0)) {
+            const double s = (d > 0.0) ? 1.0 : -1.0;
+            const double parabolic = q_[i] + s / (n_[i + 1] - n_[i - 1]) *
+                ((n_[i] - n_[i - 1] + s) * (q_[i + 1] - q_[i]) / (n_[i + 1] - n_[i]) +
+                 (n_[i + 1] - n_[i] - s) * (q_[i] - q_[i - 1]) / (n_[i] - n_[i - 1]));
+            if (q_[i - 1] < parabolic && parabolic < q_[i + 1]) {
+                q_[i] = parabolic;
+            } else {
+                const int j = i + static_cast<int>(s);
+                q_[i] += s * (q_[j] - q_[i]) / (n_[j] - n_[i]);
+            }
+            n_[i] += s;
+        }
+    }
+}
+
+double P2Quantile::value() const {
+    if (count_ == 0) return 0.0;
+    if (count_ < 5) {
+        const double pos = p_ * (count_ - 1);
+        const int i = static_cast<int>(pos);
+        const double s = pos - i;
+        return (i + 1 < count_) ? (1.0 - s) * q_[i] + s * q_[i + 1] : q_[i];
+    }
+    return q_[2];
+}
+
+StreamingStatistics::StreamingStatistics(int size, const std::vector<double>& probabilities)
+    : size_(size)
+    , nq_(static_cast<int>(probabilities.size()))
+    , count_(0)
+    , mean_(size, 0.0)
+    , m2_(size, 0.0)
+{
+    quantiles_.reserve(static_cast<std::size_t>(size) * nq_);
+    for (int i = 0; i < size; i++) {
+        for (double p : probabilities) quantiles_.emplace_back(p);
+    }
+}
+
+void StreamingStatistics::add(const double* values) {
+    count_++;
+    for (int i = 0; i < size_; i++) {
+        const double delta = values[i] - mean_[i];
+        mean_[i] += delta / count_;
+        m2_[i] += delta * (values[i] - mean_[i]);
+        for (int q = 0; q < nq_; q++) quantiles_[static_cast<std::size_t>(i) * nq_ + q].add(values[i]);
+    }
+}
+
+FieldStatistics StreamingStatistics::result() const {
+    FieldStatistics s;
+    s.mean = mean_;
+    s.variance.resize(size_);
+    for (int i = 0; i < size_; i++) s.variance[i] = (count_ > 1) ? m2_[i] / (count_ - 1) : 0.0;
+    s.quantiles.assign(nq_, std::vector<double>(size_));
+    for (int q = 0; q < nq_; q++) {
+        for (int i = 0; i < size_; i++) s.quantiles[q][i] = quantiles_[static_cast<std::size_t>(i) * nq_ + q].value();
+    }
+    return s;
+}
+
+// =============================================================================
+// ENSEMBLE RUNS
+// =============================================================================
+
+UqResult propagate_uncertainty_1d(const SampleFactory1D& make,
+                                  const std::vector<Distribution>& inputs,
+                                  const std::vector<double>& probes,
+                                  const UqOptions& options) {
+    return propagate<EnsembleHeatSolver1D>(
+        make, inputs, static_cast<int>(probes.size()),
+        [&](const EnsembleHeatSolver1D& e, int m, int p) { return e.probe(m, probes[p]); },
+        [](const EnsembleHeatSolver1D& e, UqResult& r) { r.x = e.get_x(); },
+        options);
+}
+
+UqResult propagate_uncertainty_2d(const SampleFactory2D& make,
+                                  const std::vector<Distribution>& inputs,
+                                  const std::vector<std::pair<double, double>>& probes,
+                                  const UqOptions& options) {
+    return propagate<EnsembleHeatSolver2D>(
+        make, inputs, static_cast<int>(probes.size()),
+        [&](const EnsembleHeatSolver2D& e, int m, int p) {
+            return e.probe(m, probes[p].first, probes[p].second);
+        },
+        [](const EnsembleHeatSolver2D& e, UqResult& r) {
+            r.x = e.get_x();
+            r.y = e.get_y();
+        },
+        options);
+}
+
+} // namespace ensiie
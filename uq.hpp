@@ -0,0 +1,251 @@
+/**
+ * @file uq.hpp
+ * @brief Monte Carlo propagation of parameter uncertainty through bars and plates.
+ *
+ * Uncertain inputs (material properties, source powers, edge values...)
+ * are described by distributions and sampled either at random or along a
+ * Sobol sequence (quasi-Monte Carlo, with a random digital shift): the
+ * error of the mean then decreases close to 1/N instead of 1/√N for
+ * smooth responses.
+ *
+ * Members are grouped in batches run by an ensemble solver
+ * (EnsembleHeatSolver1D or EnsembleHeatSolver2D), one batch per thread.
+ * Their probe series and final fields are folded into streaming
+ * statistics as soon as a batch ends: mean and variance by Welford's
+ * update, quantiles by the P² estimator (Jain & Chlamtac), which tracks
+ * one quantile with five markers. Memory depends on the
+ * batch size and the grid, not on the number of members, and batches
+ * are folded in order, so the results do not depend on the thread count.
+ */
+
+#ifndef UQ_HPP
+#define UQ_HPP
+
+#include "ensemble.hpp"
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ensiie {
+
+/**
+ * @brief Family of an input distribution
+ */
+enum class DistributionKind {
+    FIXED,     ///< Constant a
+    UNIFORM,   ///< Uniform over [a, b]
+    NORMAL,    ///< Mean a, standard deviation b
+    LOGNORMAL  ///< Median a, standard deviation b of the logarithm
+};
+
+/**
+ * @struct Distribution
+ * @brief Probability law of one uncertain input.
+ */
+struct Distribution {
+    DistributionKind kind = DistributionKind::FIXED;  ///< Family
+    double a = 0.0;  ///< Value, lower bound, mean or median
+    double b = 0.0;  ///< Upper bound or standard deviation
+
+    /**
+     * @brief Inverse cumulative distribution function at u ∈ (0, 1).
+     */
+    double quantile(double u) const;
+
+    /// Constant input
+    static Distribution fixed(double value) { return {DistributionKind::FIXED, value, value}; }
+
+    /// Uniform over [lo, hi]
+    static Distribution uniform(double lo, double hi) { return {DistributionKind::UNIFORM, lo, hi}; }
+
+    /// Nominal value ± a relative tolerance, uniform
+    static Distribution tolerance(double nominal, double relative) {
+        return uniform(nominal * (1.0 - relative), nominal * (1.0 + relative));
+    }
+
+    /// Gaussian with mean and standard deviation
+    static Distribution normal(double mean, double sd) { return {DistributionKind::NORMAL, mean, sd}; }
+
+    /// Log-normal with median and standard deviation of ln X
+    static Distribution lognormal(double median, double sigma) {
+        return {DistributionKind::LOGNORMAL, median, sigma};
+    }
+};
+
+/**
+ * @brief How sample points are drawn
+ */
+enum class Sampling {
+    MONTE_CARLO,  ///< Independent pseudo-random points
+    SOBOL         ///< Digitally shifted Sobol sequence (quasi-Monte Carlo)
+};
+
+/**
+ * @class SobolSequence
+ * @brief Sobol points in [0, 1)^d (Joe & Kuo direction numbers).
+ */
+class SobolSequence {
+public:
+    /// Largest supported dimension
+    static constexpr int MAX_DIMENSIONS = 16;
+
+    /**
+     * @param dimensions Coordinates per point (1 to MAX_DIMENSIONS)
+     * @param seed Seed of the random digital shift (0: unshifted)
+     * @throws std::invalid_argument if the dimension is out of range
+     */
+    explicit SobolSequence(int dimensions, unsigned seed = 0);
+
+    /**
+     * @brief Point number index (Gray code order), coordinates in (0, 1).
+     */
+    std::vector<double> point(std::uint64_t index) const;
+
+private:
+    int dims_;                         ///< Dimension d
+    std::vector<std::uint32_t> v_;     ///< Direction numbers, 32 per dimension
+    std::vector<std::uint32_t> shift_; ///< Digital shift of each dimension
+};
+
+/**
+ * @class P2Quantile
+ * @brief Streaming estimate of one quantile with five markers (P² algorithm).
+ */
+class P2Quantile {
+public:
+    /**
+     * @param p Probability of the quantile, in (0, 1)
+     */
+    explicit P2Quantile(double p = 0.5);
+
+    /**
+     * @brief Fold one observation in.
+     */
+    void add(double x);
+
+    /**
+     * @brief Current estimate (exact while fewer than five observations).
+     */
+    double value() const;
+
+private:
+    double p_;        ///< Probability
+    long count_;      ///< Observations so far
+    double q_[5];     ///< Marker heights
+    double n_[5];     ///< Marker positions
+    double want_[5];  ///< Desired marker positions
+    double step_[5];  ///< Increments of the desired positions
+};
+
+/**
+ * @struct FieldStatistics
+ * @brief Moments and quantiles of a vector-valued output.
+ */
+struct FieldStatistics {
+    std::vector<double> mean;                    ///< Mean of each component
+    std::vector<double> variance;                ///< Unbiased variance of each component
+    std::vector<std::vector<double>> quantiles;  ///< quantiles[q][i]: quantile q of component i
+};
+
+/**
+ * @class StreamingStatistics
+ * @brief Running mean, variance and quantiles of a vector output, in constant memory.
+ */
+class StreamingStatistics {
+public:
+    /**
+     * @param size Components of one sample
+     * @param probabilities Quantiles to track
+     */
+    StreamingStatistics(int size, const std::vector<double>& probabilities);
+
+    /**
+     * @brief Fold one sample of `size` components in.
+     */
+    void add(const double* values);
+
+    long count() const { return count_; }
+
+    /**
+     * @brief Current estimates.
+     */
+    FieldStatistics result() const;
+
+private:
+    int size_;                        ///< Components
+    int nq_;                          ///< Tracked quantiles
+    long count_;                      ///< Samples so far
+    std::vector<double> mean_;        ///< Running means
+    std::vector<double> m2_;          ///< Sums of squared deviations (Welford)
+    std::vector<P2Quantile> quantiles_;  ///< Component-major: quantiles_[i·nq + q]
+};
+
+/**
+ * @struct UqOptions
+ * @brief Ensemble size, sampling and recorded statistics.
+ */
+struct UqOptions {
+    int members = 256;             ///< Ensemble size N
+    int batch = 16;                ///< Members stepped together by one ensemble solver
+    Sampling sampling = Sampling::SOBOL;  ///< Sample points
+    unsigned seed = 5489;          ///< Random points or digital shift
+    std::vector<double> probabilities{0.05, 0.5, 0.95};  ///< Quantiles to estimate
+    int stride = 10;               ///< Time steps between two recorded probe values (the last step is recorded too)
+    int threads = 0;               ///< Batches run at once (<= 0: one per hardware thread)
+};
+
+/**
+ * @struct UqResult
+ * @brief Statistics of an ensemble run (temperatures in K).
+ */
+struct UqResult {
+    int members = 0;                      ///< Members run
+    std::vector<double> x;                ///< Node coordinates along x
+    std::vector<double> y;                ///< Node coordinates along y (plates only)
+    FieldStatistics field;                ///< Temperature field at tmax (plates: row-major, k = j·nx + i)
+    std::vector<double> times;            ///< Recorded probe times
+    std::vector<FieldStatistics> probes;  ///< Per probe, components over times
+};
+
+/// Builds the bar solver of one sample of the uncertain inputs (called concurrently)
+using SampleFactory1D = std::function<std::unique_ptr<HeatSolver1D>(const std::vector<double>& sample)>;
+
+/// Builds the plate solver of one sample of the uncertain inputs (called concurrently)
+using SampleFactory2D = std::function<std::unique_ptr<HeatSolver2D>(const std::vector<double>& sample)>;
+
+/**
+ * @brief Propagate input uncertainty through a linear bar.
+ *
+ * @param make Solver factory; sample[i] is drawn from inputs[i]. All
+ *        solvers must share the grid and tmax
+ * @param inputs Distribution of each uncertain input
+ * @param probes Positions whose temperature series are summarised
+ * @param options Ensemble size, sampling and statistics
+ * @throws std::invalid_argument on invalid options, too many Sobol
+ *         dimensions, or solvers an ensemble cannot hold
+ */
+UqResult propagate_uncertainty_1d(const SampleFactory1D& make,
+                                  const std::vector<Distribution>& inputs,
+                                  const std::vector<double>& probes,
+                                  const UqOptions& options = {});
+
+/**
+ * @brief Propagate input uncertainty through a linear plate.
+ *
+ * @param make Solver factory; all solvers must share the grid, tmax,
+ *        edge kinds and mask
+ * @param inputs Distribution of each uncertain input
+ * @param probes Positions (x, y) whose temperature series are summarised
+ * @param options Ensemble size, sampling and statistics
+ * @throws std::invalid_argument as propagate_uncertainty_1d()
+ */
+UqResult propagate_uncertainty_2d(const SampleFactory2D& make,
+                                  const std::vector<Distribution>& inputs,
+                                  const std::vector<std::pair<double, double>>& probes,
+                                  const UqOptions& options = {});
+
+} // namespace ensiie
+
+#endif